@@ -539,6 +539,187 @@ typename ArrayType1::value_type
 dotc(const ArrayType1& x,
      const ArrayType2& y);
 
+/*! \cond */
+template <typename DerivedPolicy,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ScalarType>
+typename ArrayType2::value_type
+axpy_dotc(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+          const ArrayType1& x,
+                ArrayType2& y,
+          const ArrayType3& z,
+          const ScalarType alpha);
+/*! \endcond */
+
+/**
+ * \brief fused update and conjugate dot product (y = alpha * x + y, returns conjugate(z)^T * y)
+ *
+ * \tparam ArrayType1 Type of the first input array
+ * \tparam ArrayType2 Type of the input/output array
+ * \tparam ArrayType3 Type of the third input array
+ * \tparam ScalarType Type of the scale factor
+ *
+ * \param x The first input array
+ * \param y The input/output array
+ * \param z The array the updated y is multiplied with, may be y itself
+ * \param alpha The scale factor applied to array x
+ *
+ * \par Overview
+ * Equivalent to \p axpy followed by \p dotc(z, y) but reads each
+ * array only once.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array1d.h>
+ *
+ * // include cusp blas header file
+ * #include <cusp/blas/blas.h>
+ *
+ * int main()
+ * {
+ *   cusp::array1d<float,cusp::host_memory> x(10, 1);
+ *   cusp::array1d<float,cusp::host_memory> y(10, 2);
+ *
+ *   // compute y += -0.5*x and the squared norm of the result
+ *   float value = cusp::blas::axpy_dotc(x, y, y, -0.5f);
+ *
+ *   return 0;
+ * }
+ * \endcode
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ScalarType>
+typename ArrayType2::value_type
+axpy_dotc(const ArrayType1& x,
+                ArrayType2& y,
+          const ArrayType3& z,
+          const ScalarType alpha);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ScalarType1,
+          typename ScalarType2>
+typename cusp::norm_type<typename ArrayType3::value_type>::type
+axpby_nrm2(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+           const ArrayType1& x,
+           const ArrayType2& y,
+                 ArrayType3& z,
+                 ScalarType1 alpha,
+                 ScalarType2 beta);
+/*! \endcond */
+
+/**
+ * \brief fused linear combination and norm (z = alpha * x + beta * y, returns ||z||)
+ *
+ * \tparam ArrayType1 Type of the first input array
+ * \tparam ArrayType2 Type of the second input array
+ * \tparam ArrayType3 Type of the output array
+ * \tparam ScalarType1 Type of the first scale factor
+ * \tparam ScalarType2 Type of the second scale factor
+ *
+ * \param x The first input array
+ * \param y The second input array
+ * \param z The output array to store the result, may be x or y
+ * \param alpha The scale factor applied to array x
+ * \param beta The scale factor applied to array y
+ *
+ * \par Overview
+ * Equivalent to \p axpby followed by \p nrm2(z) but reads each
+ * array only once.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array1d.h>
+ *
+ * // include cusp blas header file
+ * #include <cusp/blas/blas.h>
+ *
+ * int main()
+ * {
+ *   cusp::array1d<float,cusp::host_memory> x(10, 1);
+ *   cusp::array1d<float,cusp::host_memory> y(10, 2);
+ *   cusp::array1d<float,cusp::host_memory> z(10);
+ *
+ *   // compute z = 1.5*x + 2.0*y and its 2-norm
+ *   float norm = cusp::blas::axpby_nrm2(x, y, z, 1.5f, 2.0f);
+ *
+ *   return 0;
+ * }
+ * \endcode
+ */
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ScalarType1,
+          typename ScalarType2>
+typename cusp::norm_type<typename ArrayType3::value_type>::type
+axpby_nrm2(const ArrayType1& x,
+           const ArrayType2& y,
+                 ArrayType3& z,
+                 ScalarType1 alpha,
+                 ScalarType2 beta);
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename Array1d1,
+          typename Array2d,
+          typename Array1d2>
+void mdotc(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+           const Array1d1& x,
+           const Array2d& Y,
+                 Array1d2& result);
+/*! \endcond */
+
+/**
+ * \brief conjugate dot products of one vector with several others (result[j] = conjugate(x)^T * Y(:,j))
+ *
+ * \tparam Array1d1 Type of the input array
+ * \tparam Array2d Type of the matrix whose columns are the other vectors
+ * \tparam Array1d2 Type of the output array
+ *
+ * \param x The input array
+ * \param Y The matrix holding one vector per column
+ * \param result The output array with one entry per column of Y
+ *
+ * \par Overview
+ * Computes all dot products in a single reduction. Column-major
+ * matrices are read in a single pass.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array1d.h>
+ * #include <cusp/array2d.h>
+ *
+ * // include cusp blas header file
+ * #include <cusp/blas/blas.h>
+ *
+ * int main()
+ * {
+ *   cusp::array1d<float,cusp::host_memory> x(10, 2);
+ *   cusp::array2d<float,cusp::host_memory,cusp::column_major> Y(10, 3, 1);
+ *   cusp::array1d<float,cusp::host_memory> result(3);
+ *
+ *   // compute the dot products of x with the 3 columns of Y
+ *   cusp::blas::mdotc(x, Y, result);
+ *
+ *   return 0;
+ * }
+ * \endcode
+ */
+template <typename Array1d1,
+          typename Array2d,
+          typename Array1d2>
+void mdotc(const Array1d1& x,
+           const Array2d& Y,
+                 Array1d2& result);
+
 /*! \cond */
 template <typename DerivedPolicy,
           typename ArrayType,
@@ -357,6 +357,132 @@ dotc(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
     return dotc(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), x, y);
 }
 
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ScalarType>
+typename ArrayType2::value_type
+axpy_dotc(const ArrayType1& x,
+                ArrayType2& y,
+          const ArrayType3& z,
+          const ScalarType alpha)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename ArrayType1::memory_space System1;
+    typedef typename ArrayType2::memory_space System2;
+    typedef typename ArrayType3::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    return cusp::blas::axpy_dotc(select_system(system1,system2,system3), x, y, z, alpha);
+}
+
+template <typename DerivedPolicy,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ScalarType>
+typename ArrayType2::value_type
+axpy_dotc(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+          const ArrayType1& x,
+                ArrayType2& y,
+          const ArrayType3& z,
+          const ScalarType alpha)
+{
+    using cusp::blas::thrustblas::axpy_dotc;
+
+    cusp::assert_same_dimensions(x, y, z);
+
+    return axpy_dotc(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), x, y, z, alpha);
+}
+
+template <typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ScalarType1,
+          typename ScalarType2>
+typename cusp::norm_type<typename ArrayType3::value_type>::type
+axpby_nrm2(const ArrayType1& x,
+           const ArrayType2& y,
+                 ArrayType3& z,
+                 ScalarType1 alpha,
+                 ScalarType2 beta)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename ArrayType1::memory_space System1;
+    typedef typename ArrayType2::memory_space System2;
+    typedef typename ArrayType3::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    return cusp::blas::axpby_nrm2(select_system(system1,system2,system3), x, y, z, alpha, beta);
+}
+
+template <typename DerivedPolicy,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3,
+          typename ScalarType1,
+          typename ScalarType2>
+typename cusp::norm_type<typename ArrayType3::value_type>::type
+axpby_nrm2(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+           const ArrayType1& x,
+           const ArrayType2& y,
+                 ArrayType3& z,
+                 ScalarType1 alpha,
+                 ScalarType2 beta)
+{
+    using cusp::blas::thrustblas::axpby_nrm2;
+
+    cusp::assert_same_dimensions(x, y, z);
+
+    return axpby_nrm2(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                      x, y, z, alpha, beta);
+}
+
+template <typename Array1d1,
+          typename Array2d,
+          typename Array1d2>
+void mdotc(const Array1d1& x,
+           const Array2d& Y,
+                 Array1d2& result)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename Array1d1::memory_space System1;
+    typedef typename Array2d::memory_space  System2;
+    typedef typename Array1d2::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    cusp::blas::mdotc(select_system(system1,system2,system3), x, Y, result);
+}
+
+template <typename DerivedPolicy,
+          typename Array1d1,
+          typename Array2d,
+          typename Array1d2>
+void mdotc(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+           const Array1d1& x,
+           const Array2d& Y,
+                 Array1d2& result)
+{
+    using cusp::blas::thrustblas::mdotc;
+
+    if (x.size() != Y.num_rows || result.size() != Y.num_cols)
+        throw cusp::invalid_input_exception("array dimensions do not match");
+
+    mdotc(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), x, Y, result);
+}
+
 template <typename RandomAccessIterator,
           typename ScalarType>
 void fill(cusp::array1d_view<RandomAccessIterator> x,
@@ -18,6 +18,7 @@
 
 #include <cusp/array1d.h>
 #include <cusp/exception.h>
+#include <cusp/functional.h>
 
 #include <cusp/blas/cblas/defs.h>
 #include <cusp/blas/cblas/execution_policy.h>
@@ -25,6 +26,12 @@
 #include <cusp/blas/cblas/complex_stubs.h>
 #include <cusp/blas/cblas/stubs.h>
 
+#include <thrust/fill.h>
+#include <thrust/transform.h>
+
+#include <algorithm>
+#include <cmath>
+
 namespace cusp
 {
 namespace blas
@@ -110,6 +117,133 @@ dot(cblas::execution_policy& exec,
     return cblas::detail::dot(n, x_p, 1, y_p, 1);
 }
 
+// the fused routines below process the arrays in blocks small enough
+// to remain in cache between the two BLAS calls applied to each block
+
+template <typename Array1,
+          typename Array2,
+          typename Array3,
+          typename ScalarType>
+typename Array2::value_type
+axpy_dotc(cblas::execution_policy& exec,
+          const Array1& x,
+                Array2& y,
+          const Array3& z,
+          const ScalarType alpha)
+{
+    typedef typename Array2::value_type ValueType;
+
+    const int block_size = 2048;
+
+    int n = y.size();
+
+    const ValueType* x_p = thrust::raw_pointer_cast(&x[0]);
+    ValueType* y_p = thrust::raw_pointer_cast(&y[0]);
+    const ValueType* z_p = thrust::raw_pointer_cast(&z[0]);
+
+    ValueType result = 0;
+
+    for (int i = 0; i < n; i += block_size)
+    {
+        int m = std::min(block_size, n - i);
+
+        cblas::detail::axpy(m, ValueType(alpha), x_p + i, 1, y_p + i, 1);
+        result += cblas::detail::dot(m, z_p + i, 1, y_p + i, 1);
+    }
+
+    return result;
+}
+
+template <typename Array1,
+          typename Array2,
+          typename Array3,
+          typename ScalarType1,
+          typename ScalarType2>
+typename cusp::norm_type<typename Array3::value_type>::type
+axpby_nrm2(cblas::execution_policy& exec,
+           const Array1& x,
+           const Array2& y,
+                 Array3& z,
+                 ScalarType1 alpha,
+                 ScalarType2 beta)
+{
+    typedef typename Array3::value_type               ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+
+    const int block_size = 2048;
+
+    int n = z.size();
+
+    const ValueType* x_p = thrust::raw_pointer_cast(&x[0]);
+    const ValueType* y_p = thrust::raw_pointer_cast(&y[0]);
+    ValueType* z_p = thrust::raw_pointer_cast(&z[0]);
+
+    ValueType a = alpha;
+    ValueType b = beta;
+
+    // z = b * y + a * x is formed in place, so z must not alias x
+    if (z_p == x_p)
+    {
+        std::swap(x_p, y_p);
+        std::swap(a, b);
+    }
+
+    NormType sum = 0;
+
+    for (int i = 0; i < n; i += block_size)
+    {
+        int m = std::min(block_size, n - i);
+
+        if (z_p != y_p)
+            cblas::detail::copy(m, y_p + i, 1, z_p + i, 1);
+
+        cblas::detail::scal(m, b, z_p + i, 1);
+        cblas::detail::axpy(m, a, x_p + i, 1, z_p + i, 1);
+
+        NormType norm = cblas::detail::nrm2(m, z_p + i, 1);
+        sum += norm * norm;
+    }
+
+    return std::sqrt(sum);
+}
+
+template <typename Array1d1,
+          typename Array2d,
+          typename Array1d2>
+void mdotc(cblas::execution_policy& exec,
+           const Array1d1& x,
+           const Array2d& Y,
+                 Array1d2& result)
+{
+    typedef typename Array2d::value_type ValueType;
+
+    if (Y.num_rows == 0 || Y.num_cols == 0)
+    {
+        thrust::fill(result.begin(), result.end(), ValueType(0));
+        return;
+    }
+
+    // result = conj(Y^H * x) = Y^T * conj(x) reads Y once
+    enum CBLAS_ORDER order = cblas::Orientation<typename Array2d::orientation>::type;
+    enum CBLAS_TRANSPOSE trans = CblasConjTrans;
+
+    int m = Y.num_rows;
+    int n = Y.num_cols;
+    int lda = Y.pitch;
+
+    ValueType alpha = 1.0;
+    ValueType beta = 0.0;
+
+    const ValueType * Y_p = thrust::raw_pointer_cast(&Y(0,0));
+    const ValueType * x_p = thrust::raw_pointer_cast(&x[0]);
+    ValueType * result_p = thrust::raw_pointer_cast(&result[0]);
+
+    cblas::detail::gemv(order, trans, m, n, alpha,
+                        Y_p, lda, x_p, 1, beta, result_p, 1);
+
+    thrust::transform(result.begin(), result.begin() + n, result.begin(), cusp::conj_functor<ValueType>());
+}
+
 // template <typename Array1,
 //           typename Array2>
 // typename Array1::value_type
@@ -27,8 +27,12 @@
 #include <thrust/transform.h>
 #include <thrust/transform_reduce.h>
 #include <thrust/inner_product.h>
+#include <thrust/reduce.h>
 
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/discard_iterator.h>
 #include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
 
 #include <cmath>
 
@@ -133,6 +137,76 @@ struct AMAX : public thrust::binary_function<T,T,bool>
     }
 };
 
+
+// y <- alpha * x + y on tuples (x,y,z), returns conj(z) * y
+template <typename T>
+struct AXPY_DOTC
+{
+    typedef T result_type;
+
+    T alpha;
+
+    AXPY_DOTC(T _alpha)
+        : alpha(_alpha) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    T operator()(Tuple t) const
+    {
+        T y = alpha * thrust::get<0>(t) + thrust::get<1>(t);
+        thrust::get<1>(t) = y;
+
+        // z may alias y, read it after the update
+        return cusp::conj(T(thrust::get<2>(t))) * y;
+    }
+};
+
+// z <- alpha * x + beta * y on tuples (x,y,z), returns |z|^2
+template <typename T1, typename T2>
+struct AXPBY_NRM2
+{
+    typedef T1 ValueType;
+    typedef typename cusp::norm_type<ValueType>::type result_type;
+
+    T1 alpha;
+    T2 beta;
+
+    AXPBY_NRM2(T1 _alpha, T2 _beta)
+        : alpha(_alpha), beta(_beta) {}
+
+    template <typename Tuple>
+    __host__ __device__
+    result_type operator()(Tuple t) const
+    {
+        ValueType z = alpha * thrust::get<0>(t) + beta * thrust::get<1>(t);
+        thrust::get<2>(t) = z;
+
+        return cusp::abs(z) * cusp::abs(z);
+    }
+};
+
+// conj(x[i]) * Y[n] for the entry n of a column-major matrix Y,
+// with padding entries contributing zero
+template <typename Iterator1, typename Iterator2, typename T>
+struct MDOTC : public thrust::unary_function<size_t,T>
+{
+    Iterator1 x;
+    Iterator2 Y;
+    size_t num_rows;
+    size_t pitch;
+
+    MDOTC(Iterator1 _x, Iterator2 _Y, size_t _num_rows, size_t _pitch)
+        : x(_x), Y(_Y), num_rows(_num_rows), pitch(_pitch) {}
+
+    __host__ __device__
+    T operator()(size_t n) const
+    {
+        size_t i = n % pitch;
+
+        return i < num_rows ? cusp::conj(T(x[i])) * T(Y[n]) : T(0);
+    }
+};
+
 } // end detail thrustblas
 
 template <typename DerivedPolicy,
@@ -301,6 +375,116 @@ dotc(thrust::execution_policy<DerivedPolicy>& exec,
                                  OutputType(0));
 }
 
+template <typename DerivedPolicy,
+          typename Array1,
+          typename Array2,
+          typename Array3,
+          typename ScalarType>
+typename Array2::value_type
+axpy_dotc(thrust::execution_policy<DerivedPolicy>& exec,
+          const Array1& x,
+                Array2& y,
+          const Array3& z,
+          const ScalarType alpha)
+{
+    typedef typename Array2::value_type ValueType;
+
+    size_t N = y.size();
+
+    return thrust::transform_reduce(exec,
+                                    thrust::make_zip_iterator(thrust::make_tuple(x.begin(), y.begin(), z.begin())),
+                                    thrust::make_zip_iterator(thrust::make_tuple(x.begin(), y.begin(), z.begin())) + N,
+                                    detail::AXPY_DOTC<ValueType>(alpha),
+                                    ValueType(0),
+                                    thrust::plus<ValueType>());
+}
+
+template <typename DerivedPolicy,
+          typename Array1,
+          typename Array2,
+          typename Array3,
+          typename ScalarType1,
+          typename ScalarType2>
+typename cusp::norm_type<typename Array3::value_type>::type
+axpby_nrm2(thrust::execution_policy<DerivedPolicy>& exec,
+           const Array1& x,
+           const Array2& y,
+                 Array3& z,
+                 ScalarType1 alpha,
+                 ScalarType2 beta)
+{
+    typedef typename Array3::value_type               ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+
+    size_t N = z.size();
+
+    return std::sqrt(thrust::transform_reduce(exec,
+                                              thrust::make_zip_iterator(thrust::make_tuple(x.begin(), y.begin(), z.begin())),
+                                              thrust::make_zip_iterator(thrust::make_tuple(x.begin(), y.begin(), z.begin())) + N,
+                                              detail::AXPBY_NRM2<ValueType,ValueType>(alpha, beta),
+                                              NormType(0),
+                                              thrust::plus<NormType>()));
+}
+
+template <typename DerivedPolicy,
+          typename Array1d1,
+          typename Array2d,
+          typename Array1d2>
+void mdotc(thrust::execution_policy<DerivedPolicy>& exec,
+           const Array1d1& x,
+           const Array2d& Y,
+                 Array1d2& result,
+           cusp::column_major)
+{
+    typedef typename Array1d2::value_type                           ValueType;
+    typedef typename Array1d1::const_iterator                       Iterator1;
+    typedef typename Array2d::values_array_type::const_iterator     Iterator2;
+    typedef detail::MDOTC<Iterator1,Iterator2,ValueType>            UnaryOp;
+
+    if (Y.num_rows == 0 || Y.num_cols == 0)
+    {
+        thrust::fill(exec, result.begin(), result.end(), ValueType(0));
+        return;
+    }
+
+    // reduce all columns at once, the key of each entry is its column
+    thrust::counting_iterator<size_t> indices(0);
+
+    thrust::reduce_by_key(exec,
+                          thrust::make_transform_iterator(indices, cusp::divide_value<size_t>(Y.pitch)),
+                          thrust::make_transform_iterator(indices, cusp::divide_value<size_t>(Y.pitch)) + Y.pitch * Y.num_cols,
+                          thrust::make_transform_iterator(indices, UnaryOp(x.begin(), Y.values.begin(), Y.num_rows, Y.pitch)),
+                          thrust::make_discard_iterator(),
+                          result.begin());
+}
+
+template <typename DerivedPolicy,
+          typename Array1d1,
+          typename Array2d,
+          typename Array1d2>
+void mdotc(thrust::execution_policy<DerivedPolicy>& exec,
+           const Array1d1& x,
+           const Array2d& Y,
+                 Array1d2& result,
+           cusp::row_major)
+{
+    // the columns of a row-major matrix are strided
+    for (size_t j = 0; j < Y.num_cols; j++)
+        result[j] = cusp::blas::thrustblas::dotc(exec, x, Y.column(j));
+}
+
+template <typename DerivedPolicy,
+          typename Array1d1,
+          typename Array2d,
+          typename Array1d2>
+void mdotc(thrust::execution_policy<DerivedPolicy>& exec,
+           const Array1d1& x,
+           const Array2d& Y,
+                 Array1d2& result)
+{
+    cusp::blas::thrustblas::mdotc(exec, x, Y, result, typename Array2d::orientation());
+}
+
 template <typename DerivedPolicy,
           typename Array1,
           typename ScalarType>
@@ -0,0 +1,281 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file block_monitor.h
+ *  \brief Monitor convergence of block iterative solvers
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+
+#include <limits>
+#include <iostream>
+#include <iomanip>
+
+namespace cusp
+{
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup monitors Monitors
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/**
+ * \brief Tracks per-column convergence of block iterative solvers.
+ *
+ * \tparam ValueType scalar type used in the solver (e.g. \c float or \c cusp::complex<double>).
+ *
+ * \par Overview
+ *  The \p block_monitor applies the criteria of \p monitor to every
+ *  column j of a block of right-hand sides B independently,
+ *       ||B(:,j) - A X(:,j)|| <= absolute_tolerance + relative_tolerance * ||B(:,j)||
+ *  and terminates iteration once every column has converged or the
+ *  iteration limit is reached. Block solvers query \p converged(j)
+ *  to deflate columns that have converged from the active block.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to configure
+ *  the \p block_monitor and use it with a block solver.
+ *
+ *  \code
+ *  #include <cusp/array2d.h>
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/block_monitor.h>
+ *  #include <cusp/krylov/block_cg.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      // create an empty sparse matrix structure (CSR format)
+ *      cusp::csr_matrix<int, float, cusp::device_memory> A;
+ *
+ *      // initialize matrix
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      // allocate storage for 4 solutions (X) and right hand sides (B)
+ *      cusp::array2d<float, cusp::device_memory, cusp::column_major> X(A.num_rows, 4, 0);
+ *      cusp::array2d<float, cusp::device_memory, cusp::column_major> B(A.num_rows, 4, 1);
+ *
+ *      // set stopping criteria of every column:
+ *      //  iteration_limit    = 100
+ *      //  relative_tolerance = 1e-6
+ *      cusp::block_monitor<float> monitor(B, 100, 1e-6);
+ *
+ *      // solve the linear systems A X = B
+ *      cusp::krylov::block_cg(A, X, B, monitor);
+ *
+ *      // report solver results
+ *      std::cout << monitor.num_converged() << " of " << monitor.num_columns();
+ *      std::cout << " columns converged after " << monitor.iteration_count() << " iterations" << std::endl;
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ */
+template <typename ValueType>
+class block_monitor
+{
+public:
+    typedef typename cusp::norm_type<ValueType>::type Real;
+
+    /**
+     *  \brief Constructs a \p block_monitor for a given block of right-hand-sides \p B
+     *
+     *  \tparam Array2dType Type of the right-hand-side block
+     *
+     *  \param B right-hand-sides of the linear systems A X = B
+     *  \param iteration_limit maximum number of solver iterations to allow
+     *  \param relative_tolerance determines convergence criteria
+     *  \param absolute_tolerance determines convergence criteria
+     *  \param verbose Controls printing status updates during execution
+     */
+    template <typename Array2dType>
+    block_monitor(const Array2dType& B,
+                  const size_t iteration_limit = 500,
+                  const Real relative_tolerance = 1e-5,
+                  const Real absolute_tolerance = 0,
+                  const bool verbose = false);
+
+    /**
+     * \brief Increments the iteration count
+     */
+    void operator++(void);
+
+    /**
+     * \brief Indicates whether every column satisfies the convergence tolerance
+     *
+     * \return Boolean convergence indicator
+     */
+    bool converged(void) const;
+
+    /**
+     * \brief Indicates whether column \p j satisfies the convergence tolerance
+     *
+     * \param j column of the right-hand-side block
+     * \return Boolean convergence indicator
+     */
+    bool converged(const size_t j) const;
+
+    /**
+     * \brief Largest Euclidean norm of the last residuals of all columns
+     *
+     * \return The residual norm
+     */
+    Real residual_norm(void) const;
+
+    /**
+     * \brief Euclidean norm of the last residual of column \p j
+     *
+     * \param j column of the right-hand-side block
+     * \return The residual norm
+     */
+    Real residual_norm(const size_t j) const;
+
+    /**
+     * \brief Returns the number of columns of the right-hand-side block
+     *
+     * \return Number of columns
+     */
+    size_t num_columns(void) const;
+
+    /**
+     * \brief Returns the number of columns that have converged
+     *
+     * \return Number of converged columns
+     */
+    size_t num_converged(void) const;
+
+    /**
+     * \brief Returns the number of iterations that the monitor has executed
+     *
+     * \return Number of iterations
+     */
+    size_t iteration_count(void) const;
+
+    /**
+     * \brief Returns the maximum number of iterations
+     *
+     * \return Maximum number of allowed iterations
+     */
+    size_t iteration_limit(void) const;
+
+    /**
+     * \brief Returns the relative tolerance
+     *
+     * \return relative_tolerance set for monitor
+     */
+    Real relative_tolerance(void) const;
+
+    /**
+     * \brief Returns the absolute tolerance
+     *
+     * \return absolute_tolerance set for monitor
+     */
+    Real absolute_tolerance(void) const;
+
+    /**
+     *  \brief Return the tolerance of column \p j equal to absolute_tolerance() + relative_tolerance() * ||B(:,j)||
+     *
+     * \param j column of the right-hand-side block
+     * \return tolerance of column \p j
+     */
+    Real tolerance(const size_t j) const;
+
+    /**
+     *  \brief Applies convergence criteria to every column of the residual block
+     *
+     *  \tparam Array2dType Type of the residual block
+     *  \param R residual block of the linear systems (R = B - A X)
+     *  \return \c true once every column has converged or the iteration limit is reached
+     */
+    template <typename Array2dType>
+    bool finished(const Array2dType& R);
+
+    /**
+     *  \brief Applies convergence criteria to a subset of the columns
+     *
+     *  Column \c k of \p R holds the residual of column \c columns[k] of the
+     *  right-hand-side block. Columns that are not listed keep their state,
+     *  which allows solvers to stop updating columns that have converged.
+     *
+     *  \tparam Array2dType Type of the residual block
+     *  \tparam Array1dType Type of the column index array
+     *  \param R residual block of the active columns
+     *  \param columns column of the right-hand-side block for every column of \p R
+     *  \return \c true once every column has converged or the iteration limit is reached
+     */
+    template <typename Array2dType, typename Array1dType>
+    bool finished(const Array2dType& R, const Array1dType& columns);
+
+    /**
+     *  \brief Sets the verbosity level of the monitor
+     *
+     *  \param verbose_ If \c true print convergence messages during
+     *  iterations.
+     */
+    void set_verbose(bool verbose_ = true);
+
+    /**
+     *  \brief Gets the verbosity level of the monitor
+     *
+     *  \return verbosity of this monitor.
+     */
+    bool is_verbose(void);
+
+    /**
+     *  \brief Resets the monitor using the same convergence criteria
+     *
+     *  \tparam Array2dType Type of the right-hand-side block
+     *  \param B right-hand-sides of the linear systems A X = B
+     */
+    template <typename Array2dType>
+    void reset(const Array2dType& B);
+
+    /**
+     *  \brief Prints the number of iterations and convergence history information.
+     */
+    void print(void);
+
+    /**
+     *  \brief Largest residual norm of the active columns at every iteration
+     */
+    cusp::array1d<Real,cusp::host_memory> residuals;
+
+private:
+
+    /*! \cond */
+    template <typename Array2dType>
+    void initialize(const Array2dType& B);
+
+    cusp::array1d<Real,cusp::host_memory> b_norms;
+    cusp::array1d<Real,cusp::host_memory> r_norms;
+    cusp::array1d<bool,cusp::host_memory> converged_columns;
+    size_t iteration_limit_;
+    size_t iteration_count_;
+    Real relative_tolerance_;
+    Real absolute_tolerance_;
+    bool verbose;
+    /*! \endcond */
+};
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/block_monitor.inl>
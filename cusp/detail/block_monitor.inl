@@ -0,0 +1,296 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/blas/blas.h>
+
+#include <thrust/sequence.h>
+
+#include <algorithm>
+#include <limits>
+#include <iostream>
+#include <iomanip>
+
+namespace cusp
+{
+
+template <typename ValueType>
+template <typename Array2dType>
+block_monitor<ValueType>
+::block_monitor(const Array2dType& B, size_t iteration_limit, Real relative_tolerance, Real absolute_tolerance, bool verbose)
+    : iteration_limit_(iteration_limit),
+      iteration_count_(0),
+      relative_tolerance_(relative_tolerance),
+      absolute_tolerance_(absolute_tolerance),
+      verbose(verbose)
+{
+    initialize(B);
+
+    if(verbose)
+    {
+        std::cout << "Solver will continue until the residual norm of all ";
+        std::cout << num_columns() << " columns " << relative_tolerance << " or reaching ";
+        std::cout << iteration_limit << " iterations " << std::endl;
+        std::cout << "  Iteration Number  | Converged Columns | Max Residual Norm" << std::endl;
+    }
+
+    residuals.reserve(iteration_limit);
+}
+
+template <typename ValueType>
+template <typename Array2dType>
+void
+block_monitor<ValueType>
+::initialize(const Array2dType& B)
+{
+    b_norms.resize(B.num_cols);
+    r_norms.resize(B.num_cols);
+    converged_columns.resize(B.num_cols);
+
+    for(size_t j = 0; j < B.num_cols; j++)
+    {
+        b_norms[j] = cusp::blas::nrm2(B.column(j));
+        r_norms[j] = std::numeric_limits<Real>::max();
+        converged_columns[j] = false;
+    }
+}
+
+template <typename ValueType>
+void
+block_monitor<ValueType>
+::operator++(void)
+{
+    ++iteration_count_;
+}
+
+template <typename ValueType>
+bool
+block_monitor<ValueType>
+::converged(void) const
+{
+    return num_converged() == num_columns();
+}
+
+template <typename ValueType>
+bool
+block_monitor<ValueType>
+::converged(const size_t j) const
+{
+    return converged_columns[j];
+}
+
+template <typename ValueType>
+typename block_monitor<ValueType>::Real
+block_monitor<ValueType>
+::residual_norm(void) const
+{
+    Real r_max(0);
+
+    for(size_t j = 0; j < num_columns(); j++)
+        r_max = std::max(r_max, r_norms[j]);
+
+    return r_max;
+}
+
+template <typename ValueType>
+typename block_monitor<ValueType>::Real
+block_monitor<ValueType>
+::residual_norm(const size_t j) const
+{
+    return r_norms[j];
+}
+
+template <typename ValueType>
+size_t
+block_monitor<ValueType>
+::num_columns(void) const
+{
+    return b_norms.size();
+}
+
+template <typename ValueType>
+size_t
+block_monitor<ValueType>
+::num_converged(void) const
+{
+    size_t count = 0;
+
+    for(size_t j = 0; j < num_columns(); j++)
+        if(converged_columns[j]) count++;
+
+    return count;
+}
+
+template <typename ValueType>
+size_t
+block_monitor<ValueType>
+::iteration_count(void) const
+{
+    return iteration_count_;
+}
+
+template <typename ValueType>
+size_t
+block_monitor<ValueType>
+::iteration_limit(void) const
+{
+    return iteration_limit_;
+}
+
+template <typename ValueType>
+typename block_monitor<ValueType>::Real
+block_monitor<ValueType>
+::relative_tolerance(void) const
+{
+    return relative_tolerance_;
+}
+
+template <typename ValueType>
+typename block_monitor<ValueType>::Real
+block_monitor<ValueType>
+::absolute_tolerance(void) const
+{
+    return absolute_tolerance_;
+}
+
+template <typename ValueType>
+typename block_monitor<ValueType>::Real
+block_monitor<ValueType>
+::tolerance(const size_t j) const
+{
+    return absolute_tolerance() + relative_tolerance() * b_norms[j];
+}
+
+template <typename ValueType>
+void
+block_monitor<ValueType>
+::set_verbose(bool verbose_)
+{
+    verbose = verbose_;
+}
+
+template <typename ValueType>
+bool
+block_monitor<ValueType>
+::is_verbose(void)
+{
+    return verbose;
+}
+
+template <typename ValueType>
+template <typename Array2dType>
+void
+block_monitor<ValueType>
+::reset(const Array2dType& B)
+{
+    initialize(B);
+    iteration_count_ = 0;
+    residuals.resize(0);
+}
+
+template <typename ValueType>
+void
+block_monitor<ValueType>
+::print(void)
+{
+    if(iteration_count() == 0 && residuals.size() == 0)
+    {
+        std::cout << "Block monitor configured with " << num_columns() << " columns, ";
+        std::cout << relative_tolerance() << " relative tolerance ";
+        std::cout << "and iteration limit " << iteration_limit() << std::endl;
+        return;
+    }
+
+    // report solver results
+    if (converged())
+    {
+        std::cout << "Solver converged all " << num_columns() << " columns";
+    }
+    else if(iteration_count() >= iteration_limit())
+    {
+        std::cout << "Solver reached iteration limit " << iteration_limit() << " with ";
+        std::cout << num_converged() << " of " << num_columns() << " columns converged";
+    }
+    else
+    {
+        throw cusp::runtime_exception("Monitor is in inconsistent state.");
+    }
+
+    std::cout << " to (" << residual_norm() << " largest final residual)" << std::endl;
+
+    std::cout << "Ran " << iteration_count() << " iterations" << std::endl;
+
+    for(size_t j = 0; j < num_columns(); j++)
+    {
+        std::cout << "  column " << std::setw(4) << j << " : residual ";
+        std::cout << std::scientific << residual_norm(j) << " tolerance " << tolerance(j);
+        std::cout << (converged(j) ? " (converged)" : "") << std::endl;
+    }
+}
+
+template <typename ValueType>
+template <typename Array2dType>
+bool block_monitor<ValueType>
+::finished(const Array2dType& R)
+{
+    cusp::array1d<size_t,cusp::host_memory> columns(R.num_cols);
+    thrust::sequence(columns.begin(), columns.end());
+
+    return finished(R, columns);
+}
+
+template <typename ValueType>
+template <typename Array2dType, typename Array1dType>
+bool block_monitor<ValueType>
+::finished(const Array2dType& R, const Array1dType& columns)
+{
+    Real r_max(0);
+
+    for(size_t k = 0; k < R.num_cols; k++)
+    {
+        const size_t j = columns[k];
+
+        r_norms[j] = cusp::blas::nrm2(R.column(k));
+        converged_columns[j] = r_norms[j] <= tolerance(j);
+
+        r_max = std::max(r_max, r_norms[j]);
+    }
+
+    residuals.push_back(r_max);
+
+    if(verbose)
+    {
+        std::cout << "       "  << std::setw(10) << iteration_count();
+        std::cout << "       "  << std::setw(10) << num_converged() << " / " << num_columns();
+        std::cout << "       "  << std::setw(10) << std::scientific << r_max << std::endl;
+    }
+
+    if (converged())
+    {
+        if(verbose) std::cout << "Successfully converged after " << iteration_count() << " iterations." << std::endl;
+        return true;
+    }
+    else if (iteration_count() >= iteration_limit())
+    {
+        if(verbose) std::cout << "Failed to converge after " << iteration_count() << " iterations." << std::endl;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+} // end namespace cusp
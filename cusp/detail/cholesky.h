@@ -0,0 +1,271 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/linear_operator.h>
+#include <cusp/permutation_matrix.h>
+#include <cusp/reorder.h>
+
+#include <cusp/graph/nested_dissection.h>
+
+#include <thrust/fill.h>
+
+#include <cmath>
+
+namespace cusp
+{
+namespace detail
+{
+
+// Elimination tree of a symmetric matrix, only the entries below the
+// diagonal of each row of A are referenced.
+template <typename MatrixType, typename ArrayType1, typename ArrayType2>
+void cholesky_etree(const MatrixType& A, ArrayType1& parent, ArrayType2& ancestor)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType n = A.num_rows;
+
+    for (IndexType k = 0; k < n; k++)
+    {
+        parent[k]   = -1;
+        ancestor[k] = -1;
+
+        for (IndexType jj = A.row_offsets[k]; jj < A.row_offsets[k + 1]; jj++)
+        {
+            // follow the path from i to the root of its subtree and
+            // compress it to k
+            IndexType i = A.column_indices[jj];
+
+            while (i != -1 && i < k)
+            {
+                IndexType next = ancestor[i];
+                ancestor[i] = k;
+
+                if (next == -1)
+                    parent[i] = k;
+
+                i = next;
+            }
+        }
+    }
+}
+
+// Pattern of row k of L, without the diagonal, in topological order in
+// stack[top, n). Returns top.
+template <typename MatrixType, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+typename MatrixType::index_type
+cholesky_row_pattern(const MatrixType& A, const typename MatrixType::index_type k,
+                     const ArrayType1& parent, ArrayType2& stack, ArrayType3& marker)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    IndexType top = A.num_rows;
+
+    marker[k] = k;
+
+    for (IndexType jj = A.row_offsets[k]; jj < A.row_offsets[k + 1]; jj++)
+    {
+        IndexType i = A.column_indices[jj];
+
+        if (i > k)
+            continue;
+
+        // walk up the elimination tree until a visited node
+        IndexType len = 0;
+
+        for (; marker[i] != k; i = parent[i])
+        {
+            stack[len++] = i;
+            marker[i] = k;
+        }
+
+        // push the path onto the stack
+        while (len > 0)
+            stack[--top] = stack[--len];
+    }
+
+    return top;
+}
+
+/*! Sparse Cholesky factorization A = L * L^T of a real symmetric positive
+ *  definite matrix. The matrix is reordered with nested dissection to
+ *  reduce fill and L is computed one row at a time by an up-looking
+ *  factorization, so the work only depends on the nonzeros of L rather than
+ *  on the cube of the dimension. A \p cusp::runtime_exception is thrown when
+ *  the matrix is not positive definite.
+ */
+template <typename ValueType, typename MemorySpace>
+class cholesky_solver : public cusp::linear_operator<ValueType,MemorySpace>
+{
+private:
+    typedef cusp::linear_operator<ValueType,MemorySpace> Parent;
+
+    template <typename ValueType2, typename MemorySpace2> friend class cholesky_solver;
+
+    cusp::array1d<int,cusp::host_memory>       permutation;
+    cusp::array1d<int,cusp::host_memory>       column_offsets;   // columns of L, diagonal first
+    cusp::array1d<int,cusp::host_memory>       row_indices;
+    cusp::array1d<ValueType,cusp::host_memory> values;
+
+    mutable cusp::array1d<ValueType,cusp::host_memory> work;
+
+public:
+    cholesky_solver()
+        : Parent()
+    { }
+
+    template <typename ValueType2, typename MemorySpace2>
+    cholesky_solver(const cholesky_solver<ValueType2,MemorySpace2>& M)
+        : Parent(M.num_rows, M.num_cols, M.num_entries),
+          permutation(M.permutation), column_offsets(M.column_offsets),
+          row_indices(M.row_indices), values(M.values), work(M.work)
+    { }
+
+    template <typename MatrixType>
+    cholesky_solver(const MatrixType& A)
+        : Parent(A.num_rows, A.num_cols, A.num_entries)
+    {
+        if (A.num_rows != A.num_cols)
+            throw cusp::invalid_input_exception("cholesky_solver requires a square matrix");
+
+        const int n = A.num_rows;
+
+        cusp::csr_matrix<int,ValueType,cusp::host_memory> S(A);
+
+        // fill reducing ordering, row i of A is row permutation[i] of B
+        cusp::permutation_matrix<int,cusp::host_memory> P(n);
+        cusp::graph::nested_dissection(S, P);
+        permutation = P.permutation;
+
+        cusp::csr_matrix<int,ValueType,cusp::host_memory> B;
+        cusp::reorder(S, permutation, B);
+
+        cusp::array1d<int,cusp::host_memory> parent(n);
+        cusp::array1d<int,cusp::host_memory> marker(n);
+        cusp::array1d<int,cusp::host_memory> stack(n);
+
+        cholesky_etree(B, parent, marker);
+
+        thrust::fill(marker.begin(), marker.end(), -1);
+
+        // count the entries of every column of L from the row patterns
+        column_offsets.resize(n + 1);
+        thrust::fill(column_offsets.begin(), column_offsets.end(), 0);
+
+        for (int k = 0; k < n; k++)
+        {
+            int top = cholesky_row_pattern(B, k, parent, stack, marker);
+
+            for (int p = top; p < n; p++)
+                column_offsets[stack[p] + 1]++;
+
+            column_offsets[k + 1]++;
+        }
+
+        for (int k = 0; k < n; k++)
+            column_offsets[k + 1] += column_offsets[k];
+
+        row_indices.resize(column_offsets[n]);
+        values.resize(column_offsets[n]);
+        work.resize(n);
+
+        // next free position of every column
+        cusp::array1d<int,cusp::host_memory> next(column_offsets.begin(), column_offsets.end() - 1);
+
+        thrust::fill(marker.begin(), marker.end(), -1);
+        thrust::fill(work.begin(), work.end(), ValueType(0));
+
+        for (int k = 0; k < n; k++)
+        {
+            int top = cholesky_row_pattern(B, k, parent, stack, marker);
+
+            // scatter the lower triangular part of row k
+            for (int jj = B.row_offsets[k]; jj < B.row_offsets[k + 1]; jj++)
+                if (B.column_indices[jj] <= k)
+                    work[B.column_indices[jj]] += B.values[jj];
+
+            ValueType d = work[k];
+            work[k] = ValueType(0);
+
+            // solve L(0:k,0:k) * x = A(0:k,k) along the pattern of row k
+            for (int p = top; p < n; p++)
+            {
+                const int i = stack[p];
+
+                const ValueType lki = work[i] / values[column_offsets[i]];
+                work[i] = ValueType(0);
+
+                for (int q = column_offsets[i] + 1; q < next[i]; q++)
+                    work[row_indices[q]] -= values[q] * lki;
+
+                d -= lki * lki;
+
+                const int q = next[i]++;
+                row_indices[q] = k;
+                values[q]      = lki;
+            }
+
+            if (d <= ValueType(0))
+                throw cusp::runtime_exception("cholesky_solver requires a positive definite matrix");
+
+            const int q = next[k]++;
+            row_indices[q] = k;
+            values[q]      = std::sqrt(d);
+        }
+    }
+
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& b, VectorType2& x) const
+    {
+        const int n = permutation.size();
+
+        for (int i = 0; i < n; i++)
+            work[permutation[i]] = b[i];
+
+        // solve L * y = b
+        for (int j = 0; j < n; j++)
+        {
+            const ValueType y = work[j] / values[column_offsets[j]];
+            work[j] = y;
+
+            for (int q = column_offsets[j] + 1; q < column_offsets[j + 1]; q++)
+                work[row_indices[q]] -= values[q] * y;
+        }
+
+        // solve L^T * x = y
+        for (int j = n - 1; j >= 0; j--)
+        {
+            ValueType sum = work[j];
+
+            for (int q = column_offsets[j] + 1; q < column_offsets[j + 1]; q++)
+                sum -= values[q] * work[row_indices[q]];
+
+            work[j] = sum / values[column_offsets[j]];
+        }
+
+        for (int i = 0; i < n; i++)
+            x[i] = work[permutation[i]];
+    }
+};
+
+} // end namespace detail
+} // end namespace cusp
+
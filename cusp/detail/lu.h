@@ -21,6 +21,7 @@
 #include <cusp/complex.h>
 #include <cusp/linear_operator.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace cusp
@@ -28,6 +29,9 @@ namespace cusp
 namespace detail
 {
 
+// rows and columns of the diagonal blocks factored at once by lu_factor
+const int lu_block_size = 64;
+
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Orientation>
 int lu_factor(cusp::array2d<ValueType,MemorySpace,Orientation>& A,
               cusp::array1d<IndexType,MemorySpace>& pivot)
@@ -36,40 +40,72 @@ int lu_factor(cusp::array2d<ValueType,MemorySpace,Orientation>& A,
 
     const int n = A.num_rows;
 
-    // For each row and column, k = 0, ..., n-1,
-    for (int k = 0; k < n; k++)
+    // Factor a panel of columns at a time and defer the update of the
+    // trailing matrix to a single pass over its rows, so every row of the
+    // trailing matrix is streamed once per panel instead of once per column.
+    for (int kb = 0; kb < n; kb += lu_block_size)
     {
-        // find the pivot row
-        pivot[k] = k;
-        NormType max = cusp::abs(A(k,k));
+        const int kend = std::min(kb + lu_block_size, n);
 
-        for (int j = k + 1; j < n; j++)
+        // For each column of the panel, k = kb, ..., kend-1,
+        for (int k = kb; k < kend; k++)
         {
-            if (max < cusp::abs(A(j,k)))
+            // find the pivot row
+            pivot[k] = k;
+            NormType max = cusp::abs(A(k,k));
+
+            for (int j = k + 1; j < n; j++)
+            {
+                if (max < cusp::abs(A(j,k)))
+                {
+                    max = cusp::abs(A(j,k));
+                    pivot[k] = j;
+                }
+            }
+
+            // and if the pivot row differs from the current row, then
+            // interchange the two rows.
+            if (pivot[k] != k)
+                for (int j = 0; j < n; j++)
+                    std::swap(A(k,j), A(pivot[k],j));
+
+            // and if the matrix is singular, return error
+            if (A(k,k) == ValueType(0))
+                return -1;
+
+            // otherwise find the lower triangular matrix elements for column k
+            // and update the remaining columns of the panel.
+            for (int i = k + 1; i < n; i++)
             {
-                max = cusp::abs(A(j,k));
-                pivot[k] = j;
+                A(i,k) /= A(k,k);
+
+                for (int j = k + 1; j < kend; j++)
+                    A(i,j) -= A(i,k) * A(k,j);
             }
         }
 
-        // and if the pivot row differs from the current row, then
-        // interchange the two rows.
-        if (pivot[k] != k)
-            for (int j = 0; j < n; j++)
-                std::swap(A(k,j), A(pivot[k],j));
+        // compute the rows of U to the right of the panel, U12 = inv(L11) * A12
+        for (int k = kb + 1; k < kend; k++)
+            for (int p = kb; p < k; p++)
+            {
+                const ValueType l = A(k,p);
 
-        // and if the matrix is singular, return error
-        if (A(k,k) == ValueType(0))
-            return -1;
+                for (int j = kend; j < n; j++)
+                    A(k,j) -= l * A(p,j);
+            }
 
-        // otherwise find the lower triangular matrix elements for column k.
-        for (int i = k + 1; i < n; i++)
-            A(i,k) /= A(k,k);
+        // update the trailing matrix, A22 -= L21 * U12
+        for (int i = kend; i < n; i++)
+            for (int p = kb; p < kend; p++)
+            {
+                const ValueType l = A(i,p);
 
-        // update remaining matrix
-        for (int i = k + 1; i < n; i++)
-            for (int j = k + 1; j < n; j++)
-                A(i,j) -= A(i,k) * A(k,j);
+                if (l == ValueType(0))
+                    continue;
+
+                for (int j = kend; j < n; j++)
+                    A(i,j) -= l * A(p,j);
+            }
     }
 
     return 0;
@@ -77,16 +113,18 @@ int lu_factor(cusp::array2d<ValueType,MemorySpace,Orientation>& A,
 
 
 
-template <typename IndexType, typename ValueType, typename MemorySpace, typename Orientation>
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Orientation,
+          typename ArrayType1, typename ArrayType2>
 int lu_solve(const cusp::array2d<ValueType,MemorySpace,Orientation>& A,
              const cusp::array1d<IndexType,MemorySpace>& pivot,
-             const cusp::array1d<ValueType,MemorySpace>& b,
-             cusp::array1d<ValueType,MemorySpace>& x)
+             const ArrayType1& b,
+             ArrayType2& x)
 {
     const int n = A.num_rows;
 
     // copy rhs to x
-    x = b;
+    for (int k = 0; k < n; k++)
+        x[k] = b[k];
 
     // Solve the linear equation Lx = b for x, where L is a lower
     // triangular matrix with an implied 1 along the diagonal.
@@ -180,7 +180,14 @@ template <typename Vector>
 bool monitor<ValueType>
 ::finished(const Vector& r)
 {
-    r_norm = cusp::blas::nrm2(r);
+    return finished_norm(cusp::blas::nrm2(r));
+}
+
+template <typename ValueType>
+bool monitor<ValueType>
+::finished_norm(const Real norm)
+{
+    r_norm = norm;
     residuals.push_back(r_norm);
 
     if(verbose)
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/cholesky.h>
 #include <cusp/detail/lu.h>
 #include <cusp/detail/type_traits.h>
 
@@ -32,6 +33,8 @@
 
 #include <thrust/detail/use_default.h>
 
+#include <vector>
+
 namespace cusp
 {
 namespace detail
@@ -77,6 +80,26 @@ namespace detail
   };
 } // end detail namespace
 
+/*! \p cycle_type : order in which a \p multilevel hierarchy visits its
+ *  levels during one cycle.
+ *
+ *  \p v_cycle visits every coarse level once. \p w_cycle corrects twice
+ *  on every coarse level. \p f_cycle follows the F-cycle on the next
+ *  level by a V-cycle. \p k_cycle accelerates the correction of every
+ *  coarse level by one or two steps of flexible conjugate gradients
+ *  preconditioned by the cycle on that level, and requires symmetric
+ *  positive definite matrices. The K-cycle is a nonlinear preconditioner:
+ *  use it through \p multilevel::solve or a flexible Krylov method, plain
+ *  \p cg loses its convergence guarantees with it.
+ */
+enum cycle_type
+{
+    v_cycle,
+    w_cycle,
+    f_cycle,
+    k_cycle
+};
+
 /*! \addtogroup iterative_solvers Iterative Solvers
  *  \addtogroup preconditioners Preconditioners
  *  \ingroup iterative_solvers
@@ -85,6 +108,21 @@ namespace detail
 
 /*! \p multilevel : multilevel hierarchy
  *
+ *  The coarsest level is solved by \p SolverType, a linear operator
+ *  constructed from the coarsest matrix. The default
+ *  \p cusp::detail::lu_solver factors a dense copy of the matrix,
+ *  \p cusp::detail::cholesky_solver factors symmetric positive definite
+ *  coarse matrices in sparse form and the solvers in
+ *  \p cusp/lapack/solver.h use the blocked lapack factorizations. On the
+ *  host the coarse solver works directly on the level vectors, other
+ *  memory spaces stage them through host memory.
+ *
+ *  Every vector used while cycling, including the K-cycle workspace, is
+ *  sized when the hierarchy is set up or the cycle is selected, so
+ *  applying the hierarchy on the sequential host system does not
+ *  allocate memory. On the OpenMP and TBB systems the inner products of
+ *  the K-cycle and of the polynomial smoother still allocate reduction
+ *  temporaries inside thrust.
  *
  *  TODO
  */
@@ -118,6 +156,11 @@ public:
         cusp::array1d<ValueType,MemorySpace> b;               // per-level rhs
         cusp::array1d<ValueType,MemorySpace> residual;        // per-level residual
 
+        // K-cycle workspace
+        cusp::array1d<ValueType,MemorySpace> k_residual;      // residual after the first step
+        cusp::array1d<ValueType,MemorySpace> k_direction;     // second preconditioned direction
+        cusp::array1d<ValueType,MemorySpace> k_product;       // A times the first direction
+
         Smoother smoother;
 
         level(void) {}
@@ -126,6 +169,7 @@ public:
         level(const LevelType& level)
           : R(level.R), A(level.A), P(level.P),
             x(level.x), b(level.b), residual(level.residual),
+            k_residual(level.k_residual), k_direction(level.k_direction), k_product(level.k_product),
             smoother(level.smoother) {}
     };
     /* \endcond */
@@ -135,11 +179,16 @@ public:
     size_t min_level_size;
     size_t max_levels;
 
+    cycle_type cycle;
+    size_t k_cycle_iterations;
+
     Solver solver;
 
     std::vector<level> levels;
 
-    multilevel(size_t min_level_size=500, size_t max_levels=10) : A_ptr(NULL), min_level_size(min_level_size), max_levels(max_levels) {};
+    multilevel(size_t min_level_size=500, size_t max_levels=10)
+      : A_ptr(NULL), min_level_size(min_level_size), max_levels(max_levels),
+        cycle(v_cycle), k_cycle_iterations(2) {};
 
     template <typename MemorySpace2, typename Format2, typename SmootherType2, typename SolverType2>
     multilevel(const multilevel<IndexType,ValueType,MemorySpace2,Format2,SmootherType2,SolverType2>& M);
@@ -159,10 +208,30 @@ public:
 
     void set_max_levels(size_t max_depth);
 
+    /*! Select the cycle applied by \p solve and \p operator().
+     *
+     *  \param cycle \p v_cycle (default), \p w_cycle, \p f_cycle or \p k_cycle
+     *  \param k_cycle_iterations number of inner flexible CG steps of the
+     *  K-cycle on every coarse level, 1 or 2
+     */
+    void set_cycle(cycle_type cycle, size_t k_cycle_iterations = 2);
+
     double operator_complexity( void );
 
     double grid_complexity( void );
 
+    /*! Number of times every level is visited by one cycle, the coarsest
+     *  level counts its direct solves. The K-cycle is counted with all of
+     *  its inner steps.
+     */
+    std::vector<size_t> level_visits( void );
+
+    /*! Nonzeros of the level matrices processed by one cycle, weighted by
+     *  the visits of every level, relative to the nonzeros of the finest
+     *  matrix. The V-cycle equals the operator complexity.
+     */
+    double cycle_complexity( void );
+
 protected:
 
     SolveMatrixType A;
@@ -175,6 +244,23 @@ protected:
     template <typename Array1, typename Array2>
     void _solve(const Array1& b, Array2& x, const size_t i);
 
+    template <typename Array1, typename Array2>
+    void _cycle(const Array1& b, Array2& x, const size_t i, const cycle_type c, const bool zero_guess);
+
+    void coarse_correction(const size_t i, const cycle_type c);
+
+    void k_cycle_correction(const size_t i);
+
+    void allocate_k_cycle_workspace(const size_t lvl);
+
+    void count_visits(const size_t i, const cycle_type c, const size_t count, std::vector<size_t>& visits);
+
+    template <typename Array1, typename Array2>
+    void coarse_solve(const Array1& b, Array2& x, thrust::detail::true_type);
+
+    template <typename Array1, typename Array2>
+    void coarse_solve(const Array1& b, Array2& x, thrust::detail::false_type);
+
     template <typename MatrixType2, typename Level>
     void setup_level(const size_t lvl, const MatrixType2& A, const Level& L);
 
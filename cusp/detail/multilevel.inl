@@ -17,6 +17,7 @@
 #include <cusp/multiply.h>
 #include <cusp/monitor.h>
 #include <cusp/blas/blas.h>
+#include <cusp/exception.h>
 
 namespace cusp
 {
@@ -25,7 +26,8 @@ template <typename IndexType, typename ValueType, typename MemorySpace, typename
 template <typename MemorySpace2, typename Format2, typename SmootherType2, typename SolverType2>
 multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 ::multilevel(const multilevel<IndexType,ValueType,MemorySpace2,Format2,SmootherType2,SolverType2>& M)
-    : min_level_size(M.min_level_size), max_levels(M.max_levels), solver(M.solver)
+    : min_level_size(M.min_level_size), max_levels(M.max_levels),
+      cycle(M.cycle), k_cycle_iterations(M.k_cycle_iterations), solver(M.solver)
 {
     for( size_t lvl = 0; lvl < M.levels.size(); lvl++ )
         levels.push_back(M.levels[lvl]);
@@ -35,8 +37,12 @@ multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 
     residual.resize(A_ptr->num_rows);
     update.resize(A_ptr->num_rows);
-    temp_b.resize(levels.back().A.num_rows);
-    temp_x.resize(levels.back().A.num_rows);
+
+    if(!thrust::detail::is_same<MemorySpace, cusp::host_memory>::value)
+    {
+        temp_b.resize(levels.back().A.num_rows);
+        temp_x.resize(levels.back().A.num_rows);
+    }
 }
 
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
@@ -62,6 +68,10 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 
         // Initialize smoother for each level
         levels[lvl].smoother.initialize(levels[lvl].A, L);
+
+        // sized from the level matrix once it is assigned
+        if(cycle == k_cycle)
+            allocate_k_cycle_workspace(lvl);
     }
 }
 
@@ -121,12 +131,42 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
     max_levels = max_depth;
 }
 
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::set_cycle(cycle_type cycle, size_t k_cycle_iterations)
+{
+    if(k_cycle_iterations < 1 || k_cycle_iterations > 2)
+        throw cusp::invalid_input_exception("K-cycle supports 1 or 2 inner iterations");
+
+    this->cycle = cycle;
+    this->k_cycle_iterations = k_cycle_iterations;
+
+    if(cycle == k_cycle)
+        for(size_t lvl = 1; lvl < levels.size(); lvl++)
+            allocate_k_cycle_workspace(lvl);
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::allocate_k_cycle_workspace(const size_t lvl)
+{
+    size_t N = levels[lvl].A.num_rows;
+
+    levels[lvl].k_residual.resize(N);
+    levels[lvl].k_direction.resize(N);
+    levels[lvl].k_product.resize(N);
+}
+
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
 void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 ::initialize_coarse_solver(void)
 {
-    temp_b.resize(levels.back().A.num_rows);
-    temp_x.resize(levels.back().A.num_rows);
+    // only needed to stage the coarse solve through host memory
+    if(!thrust::detail::is_same<MemorySpace, cusp::host_memory>::value)
+    {
+        temp_b.resize(levels.back().A.num_rows);
+        temp_x.resize(levels.back().A.num_rows);
+    }
 
     solver = Solver(levels.back().A);
 }
@@ -136,7 +176,7 @@ template <typename Array1, typename Array2>
 void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 ::operator()(const Array1& b, Array2& x)
 {
-    // perform 1 V-cycle
+    // perform 1 cycle
     _solve(b, x, 0);
 }
 
@@ -182,12 +222,20 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
     if (i + 1 == levels.size())
     {
         // coarse grid solve
-        // TODO streamline
-        cusp::copy(b, temp_b);
-        solver(temp_b, temp_x);
-        cusp::copy(temp_x, x);
+        coarse_solve(b, x, typename thrust::detail::is_same<MemorySpace, cusp::host_memory>::type());
     }
     else
+    {
+        _cycle(b, x, i, cycle, true);
+    }
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+template <typename Array1, typename Array2>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::_cycle(const Array1& b, Array2& x, const size_t i, const cycle_type c, const bool zero_guess)
+{
+    if (zero_guess)
     {
         // initialize solution
         cusp::blas::fill(x, ValueType(0));
@@ -197,33 +245,143 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
             levels[i].smoother.presmooth(*A_ptr, b, x);
         else
             levels[i].smoother.presmooth(levels[i].A, b, x);
-
-        // compute residual <- b - A*x
+    }
+    else
+    {
+        // presmoothers assume a zero initial guess, smooth the current
+        // solution instead
         if(i == 0)
-            cusp::multiply(*A_ptr, x, levels[i].residual);
+            levels[i].smoother.postsmooth(*A_ptr, b, x);
         else
-            cusp::multiply(levels[i].A, x, levels[i].residual);
+            levels[i].smoother.postsmooth(levels[i].A, b, x);
+    }
 
-        cusp::blas::axpby(b, levels[i].residual, levels[i].residual, ValueType(1.0), ValueType(-1.0));
+    // compute residual <- b - A*x
+    if(i == 0)
+        cusp::multiply(*A_ptr, x, levels[i].residual);
+    else
+        cusp::multiply(levels[i].A, x, levels[i].residual);
 
-        // restrict to coarse grid
-        cusp::multiply(levels[i].R, levels[i].residual, levels[i + 1].b);
+    cusp::blas::axpby(b, levels[i].residual, levels[i].residual, ValueType(1.0), ValueType(-1.0));
 
-        // compute coarse grid solution
-        _solve(levels[i + 1].b, levels[i + 1].x, i + 1);
+    // restrict to coarse grid
+    cusp::multiply(levels[i].R, levels[i].residual, levels[i + 1].b);
 
-        // apply coarse grid correction
-        cusp::multiply(levels[i].P, levels[i + 1].x, levels[i].residual);
-        cusp::blas::axpy(levels[i].residual, x, ValueType(1.0));
+    // compute coarse grid solution
+    coarse_correction(i + 1, c);
 
-        // postsmooth
-        if(i == 0)
-            levels[i].smoother.postsmooth(*A_ptr, b, x);
-        else
-            levels[i].smoother.postsmooth(levels[i].A, b, x);
+    // apply coarse grid correction
+    cusp::multiply(levels[i].P, levels[i + 1].x, levels[i].residual);
+    cusp::blas::axpy(levels[i].residual, x, ValueType(1.0));
+
+    // postsmooth
+    if(i == 0)
+        levels[i].smoother.postsmooth(*A_ptr, b, x);
+    else
+        levels[i].smoother.postsmooth(levels[i].A, b, x);
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::coarse_correction(const size_t i, const cycle_type c)
+{
+    level& L = levels[i];
+
+    if (i + 1 == levels.size())
+    {
+        coarse_solve(L.b, L.x, typename thrust::detail::is_same<MemorySpace, cusp::host_memory>::type());
+        return;
+    }
+
+    switch(c)
+    {
+    case w_cycle:
+        _cycle(L.b, L.x, i, w_cycle, true);
+        _cycle(L.b, L.x, i, w_cycle, false);
+        break;
+    case f_cycle:
+        _cycle(L.b, L.x, i, f_cycle, true);
+        _cycle(L.b, L.x, i, v_cycle, false);
+        break;
+    case k_cycle:
+        k_cycle_correction(i);
+        break;
+    default:
+        _cycle(L.b, L.x, i, v_cycle, true);
+        break;
     }
 }
 
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::k_cycle_correction(const size_t i)
+{
+    level& L = levels[i];
+
+    // first direction c1 = B * b, stored in x
+    _cycle(L.b, L.x, i, k_cycle, true);
+
+    // v1 = A * c1
+    cusp::multiply(L.A, L.x, L.k_product);
+
+    const ValueType rho1   = cusp::blas::dotc(L.x, L.k_product);
+    const ValueType alpha1 = cusp::blas::dotc(L.x, L.b);
+
+    if (rho1 == ValueType(0))
+        return;
+
+    if (k_cycle_iterations < 2)
+    {
+        // x = alpha1 / rho1 * c1
+        cusp::blas::scal(L.x, alpha1 / rho1);
+        return;
+    }
+
+    // r2 = b - alpha1 / rho1 * v1
+    cusp::blas::axpby(L.b, L.k_product, L.k_residual, ValueType(1), -alpha1 / rho1);
+
+    // second direction c2 = B * r2
+    _cycle(L.k_residual, L.k_direction, i, k_cycle, true);
+
+    const ValueType gamma  = cusp::blas::dotc(L.k_direction, L.k_product);
+    const ValueType alpha2 = cusp::blas::dotc(L.k_direction, L.k_residual);
+
+    // v2 = A * c2, r2 is no longer needed
+    cusp::multiply(L.A, L.k_direction, L.k_residual);
+
+    const ValueType beta = cusp::blas::dotc(L.k_direction, L.k_residual);
+    const ValueType rho2 = beta - gamma * gamma / rho1;
+
+    if (rho2 == ValueType(0))
+    {
+        cusp::blas::scal(L.x, alpha1 / rho1);
+        return;
+    }
+
+    // minimize the energy norm of the error over span{c1, c2}
+    cusp::blas::axpby(L.x, L.k_direction, L.x,
+                      alpha1 / rho1 - gamma * alpha2 / (rho1 * rho2),
+                      alpha2 / rho2);
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+template <typename Array1, typename Array2>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::coarse_solve(const Array1& b, Array2& x, thrust::detail::true_type)
+{
+    solver(b, x);
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+template <typename Array1, typename Array2>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::coarse_solve(const Array1& b, Array2& x, thrust::detail::false_type)
+{
+    cusp::copy(b, temp_b);
+    solver(temp_b, temp_x);
+    cusp::copy(temp_x, x);
+}
+
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
 void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 ::print( void )
@@ -231,10 +389,13 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
     size_t num_levels = levels.size();
     double nnz = this->num_entries;
 
+    std::vector<size_t> visits = level_visits();
+
     std::cout << "\tNumber of Levels    :\t" << num_levels << std::endl;
     std::cout << "\tOperator Complexity :\t" << operator_complexity() << std::endl;
     std::cout << "\tGrid Complexity     :\t" << grid_complexity() << std::endl;
-    std::cout << "\tlevel\tunknowns\tnonzeros" << std::endl;
+    std::cout << "\tCycle Complexity    :\t" << cycle_complexity() << std::endl;
+    std::cout << "\tlevel\tunknowns\tnonzeros\t\tvisits" << std::endl;
 
     for(size_t index = 1; index < num_levels; index++)
         nnz += levels[index].A.num_entries;
@@ -243,17 +404,80 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 
     std::cout << "\t" << 0 << "\t" << std::setw(8) << std::right << this->num_cols << "\t" \
               << std::setw(8) << std::right << this->num_entries << "  [" << 100*percent << "%]" \
-              << std::endl;
+              << "\t" << std::setw(6) << std::right << (num_levels > 0 ? visits[0] : 0) << std::endl;
 
     for(size_t index = 1; index < num_levels; index++)
     {
         percent = levels[index].A.num_entries / nnz;
         std::cout << "\t" << index << "\t" << std::setw(8) << std::right << levels[index].A.num_cols << "\t" \
                   << std::setw(8) << std::right << levels[index].A.num_entries << "  [" << 100*percent << "%]" \
-                  << std::endl;
+                  << "\t" << std::setw(6) << std::right << visits[index] << std::endl;
     }
 }
 
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+std::vector<size_t> multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::level_visits( void )
+{
+    std::vector<size_t> visits(levels.size(), 0);
+
+    if (levels.size() > 0)
+        count_visits(0, cycle, 1, visits);
+
+    return visits;
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::count_visits(const size_t i, const cycle_type c, const size_t count, std::vector<size_t>& visits)
+{
+    visits[i] += count;
+
+    if (i + 1 == levels.size())
+        return;
+
+    // the coarsest level is solved once per correction
+    if (i + 2 == levels.size())
+    {
+        visits[i + 1] += count;
+        return;
+    }
+
+    switch(c)
+    {
+    case w_cycle:
+        count_visits(i + 1, w_cycle, 2 * count, visits);
+        break;
+    case f_cycle:
+        count_visits(i + 1, f_cycle, count, visits);
+        count_visits(i + 1, v_cycle, count, visits);
+        break;
+    case k_cycle:
+        count_visits(i + 1, k_cycle, k_cycle_iterations * count, visits);
+        break;
+    default:
+        count_visits(i + 1, v_cycle, count, visits);
+        break;
+    }
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+double multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::cycle_complexity( void )
+{
+    if(this->num_entries == 0)
+        return 0;
+
+    std::vector<size_t> visits = level_visits();
+
+    double nnz = this->num_entries * (visits.size() > 0 ? visits[0] : 0);
+
+    for(size_t index = 1; index < levels.size(); index++)
+        nnz += double(visits[index]) * levels[index].A.num_entries;
+
+    return nnz / (double) this->num_entries;
+}
+
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
 double multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 ::operator_complexity( void )
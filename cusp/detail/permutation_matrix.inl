@@ -14,16 +14,48 @@
  *  limitations under the License.
  */
 
-#include <cusp/coo_matrix.h>
-#include <cusp/sort.h>
+#include <cusp/reorder.h>
 
-#include <cusp/format_utils.h>
-
-#include <thrust/gather.h>
-#include <thrust/sort.h>
+#include <cusp/detail/type_traits.h>
 
 namespace cusp
 {
+namespace detail
+{
+
+template <typename MatrixType, typename ArrayType>
+void symmetric_permute(MatrixType& A, const ArrayType& permutation, thrust::detail::true_type)
+{
+    typename MatrixType::container B;
+
+    // reorder rows and column according to permutation
+    cusp::reorder(A, permutation, B);
+
+    // store permuted matrix
+    A = B;
+}
+
+// A lives in another memory space, reorder a copy in the memory space of
+// the permutation
+template <typename MatrixType, typename ArrayType>
+void symmetric_permute(MatrixType& A, const ArrayType& permutation, thrust::detail::false_type)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::value_type   ValueType;
+    typedef typename MatrixType::format       Format;
+    typedef typename ArrayType::memory_space  MemorySpace;
+
+    typename cusp::detail::matrix_type<IndexType,ValueType,MemorySpace,Format>::type S(A);
+    typename cusp::detail::matrix_type<IndexType,ValueType,MemorySpace,Format>::type B;
+
+    // reorder rows and column according to permutation
+    cusp::reorder(S, permutation, B);
+
+    // store permuted matrix
+    A = B;
+}
+
+} // end namespace detail
 
 template <typename IndexType, typename MemorySpace>
 void
@@ -48,20 +80,10 @@ template <typename MatrixType>
 void permutation_matrix<IndexType,MemorySpace>
 ::symmetric_permute(MatrixType& A)
 {
-    typedef typename MatrixType::index_type IndexType2;
-    typedef typename MatrixType::value_type ValueType2;
-
-    cusp::coo_matrix<IndexType2,ValueType2,MemorySpace> B(A);
-
-    // reorder rows and column according to permutation
-    thrust::gather(B.row_indices.begin(), B.row_indices.end(), permutation.begin(), B.row_indices.begin());
-    thrust::gather(B.column_indices.begin(), B.column_indices.end(), permutation.begin(), B.column_indices.begin());
-
-    // order COO matrix
-    cusp::sort_by_row_and_column(B.row_indices, B.column_indices, B.values);
+    typedef typename MatrixType::memory_space MemorySpace2;
 
-    // store permuted matrix
-    A = B;
+    cusp::detail::symmetric_permute(A, permutation,
+                                    typename thrust::detail::is_same<MemorySpace, MemorySpace2>::type());
 }
 
 ///////////////////////////
@@ -83,20 +105,10 @@ void
 permutation_matrix_view<Array,IndexType,MemorySpace>
 ::symmetric_permute(MatrixType& A)
 {
-    typedef typename MatrixType::index_type IndexType2;
-    typedef typename MatrixType::value_type ValueType2;
-
-    cusp::coo_matrix<IndexType2,ValueType2,MemorySpace> B(A);
-
-    // reorder rows and column according to permutation
-    thrust::gather(B.row_indices.begin(), B.row_indices.end(), permutation.begin(), B.row_indices.begin());
-    thrust::gather(B.column_indices.begin(), B.column_indices.end(), permutation.begin(), B.column_indices.begin());
-
-    // order COO matrix
-    cusp::sort_by_row_and_column(B.row_indices, B.column_indices, B.values);
+    typedef typename MatrixType::memory_space MemorySpace2;
 
-    // store permuted matrix
-    A = B;
+    cusp::detail::symmetric_permute(A, permutation,
+                                    typename thrust::detail::is_same<MemorySpace, MemorySpace2>::type());
 }
 
 } // end namespace cusp
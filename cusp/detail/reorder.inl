@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file reorder.inl
+ *  \brief Inline file for reorder.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/generic/select_system.h>
+
+#include <cusp/reorder.h>
+
+#include <cusp/system/detail/generic/reorder.h>
+
+#include <thrust/gather.h>
+#include <thrust/scatter.h>
+
+#include <thrust/iterator/counting_iterator.h>
+
+namespace cusp
+{
+
+template <typename DerivedPolicy, typename MatrixType1, typename ArrayType, typename MatrixType2>
+void reorder(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+             const MatrixType1& A, const ArrayType& permutation, MatrixType2& B)
+{
+    using cusp::system::detail::generic::reorder;
+
+    reorder(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, permutation, B);
+}
+
+template <typename MatrixType1, typename ArrayType, typename MatrixType2>
+void reorder(const MatrixType1& A, const ArrayType& permutation, MatrixType2& B)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType1::memory_space System1;
+    typedef typename ArrayType::memory_space   System2;
+    typedef typename MatrixType2::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    cusp::reorder(select_system(system1,system2,system3), A, permutation, B);
+}
+
+template <typename MatrixType, typename ArrayType>
+cusp::reordering<typename ArrayType::value_type, typename ArrayType::memory_space>
+reorder(MatrixType& A, const ArrayType& permutation)
+{
+    cusp::reordering<typename ArrayType::value_type, typename ArrayType::memory_space> R(permutation);
+
+    R.permute_matrix(A);
+
+    return R;
+}
+
+//////////////////////////////
+// Reordering Member Functions
+//////////////////////////////
+
+template <typename IndexType, typename MemorySpace>
+template <typename ArrayType>
+reordering<IndexType,MemorySpace>
+::reordering(const ArrayType& permutation)
+    : permutation(permutation), inverse(permutation.size())
+{
+    thrust::scatter(thrust::counting_iterator<IndexType>(0),
+                    thrust::counting_iterator<IndexType>(permutation.size()),
+                    this->permutation.begin(),
+                    inverse.begin());
+}
+
+template <typename IndexType, typename MemorySpace>
+template <typename MatrixType>
+void
+reordering<IndexType,MemorySpace>
+::permute_matrix(MatrixType& A) const
+{
+    MatrixType B;
+
+    cusp::reorder(A, permutation, B);
+
+    A.swap(B);
+}
+
+template <typename IndexType, typename MemorySpace>
+template <typename ArrayType>
+void
+reordering<IndexType,MemorySpace>
+::permute(ArrayType& x) const
+{
+    typedef typename ArrayType::value_type ValueType;
+
+    cusp::array1d<ValueType, MemorySpace> temp(x);
+
+    // x[permutation[i]] = temp[i]
+    thrust::gather(inverse.begin(), inverse.end(), temp.begin(), x.begin());
+}
+
+template <typename IndexType, typename MemorySpace>
+template <typename ArrayType>
+void
+reordering<IndexType,MemorySpace>
+::unpermute(ArrayType& x) const
+{
+    typedef typename ArrayType::value_type ValueType;
+
+    cusp::array1d<ValueType, MemorySpace> temp(x);
+
+    // x[i] = temp[permutation[i]]
+    thrust::gather(permutation.begin(), permutation.end(), temp.begin(), x.begin());
+}
+
+} // end namespace cusp
@@ -41,6 +41,21 @@ void hilbert_curve(const thrust::detail::execution_policy_base<DerivedPolicy>& e
     hilbert_curve(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, num_parts, parts);
 }
 
+template <typename DerivedPolicy,
+          typename Array2dType,
+          typename ArrayType,
+          typename PermutationArrayType>
+void hilbert_curve(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                   const Array2dType& G,
+                   const size_t num_parts,
+                   ArrayType& parts,
+                   PermutationArrayType& permutation)
+{
+    using cusp::system::detail::generic::hilbert_curve;
+
+    hilbert_curve(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, num_parts, parts, permutation);
+}
+
 template<typename Array2dType,
          typename ArrayType>
 void hilbert_curve(const Array2dType& G,
@@ -58,6 +73,27 @@ void hilbert_curve(const Array2dType& G,
     cusp::graph::hilbert_curve(select_system(system1,system2), G, num_parts, parts);
 }
 
+template<typename Array2dType,
+         typename ArrayType,
+         typename PermutationArrayType>
+void hilbert_curve(const Array2dType& G,
+                   const size_t num_parts,
+                   ArrayType& parts,
+                   PermutationArrayType& permutation)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename Array2dType::memory_space          System1;
+    typedef typename ArrayType::memory_space            System2;
+    typedef typename PermutationArrayType::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    cusp::graph::hilbert_curve(select_system(system1,system2,system3), G, num_parts, parts, permutation);
+}
+
 } // end namespace graph
 } // end namespace cusp
 
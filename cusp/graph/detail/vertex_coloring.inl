@@ -44,6 +44,78 @@ size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy
                            G, colors);
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const vertex_ordering ordering)
+{
+    using cusp::system::detail::generic::vertex_coloring;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    return vertex_coloring(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                           G, colors, ordering);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const vertex_ordering ordering,
+                       const size_t distance)
+{
+    using cusp::system::detail::generic::vertex_coloring;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if(distance == 0)
+        throw cusp::invalid_input_exception("coloring distance must be positive");
+
+    return vertex_coloring(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                           G, colors, ordering, distance);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2>
+size_t block_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors)
+{
+    return cusp::graph::block_coloring(exec, G, blocks, colors, natural_ordering);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2>
+size_t block_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors,
+                      const vertex_ordering ordering)
+{
+    using cusp::system::detail::generic::block_coloring;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if(blocks.size() != G.num_rows)
+        throw cusp::invalid_input_exception("blocks size must match the number of vertices");
+
+    return block_coloring(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                          G, blocks, colors, ordering);
+}
+
 template<typename MatrixType,
          typename ArrayType>
 size_t vertex_coloring(const MatrixType& G,
@@ -60,6 +132,72 @@ size_t vertex_coloring(const MatrixType& G,
     return cusp::graph::vertex_coloring(select_system(system1,system2), G, colors);
 }
 
+template<typename MatrixType,
+         typename ArrayType>
+size_t vertex_coloring(const MatrixType& G,
+                       ArrayType& colors,
+                       const vertex_ordering ordering)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType::memory_space  System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::graph::vertex_coloring(select_system(system1,system2), G, colors, ordering);
+}
+
+template<typename MatrixType,
+         typename ArrayType>
+size_t vertex_coloring(const MatrixType& G,
+                       ArrayType& colors,
+                       const vertex_ordering ordering,
+                       const size_t distance)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType::memory_space  System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::graph::vertex_coloring(select_system(system1,system2), G, colors, ordering, distance);
+}
+
+template<typename MatrixType,
+         typename ArrayType1,
+         typename ArrayType2>
+size_t block_coloring(const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors)
+{
+    return cusp::graph::block_coloring(G, blocks, colors, natural_ordering);
+}
+
+template<typename MatrixType,
+         typename ArrayType1,
+         typename ArrayType2>
+size_t block_coloring(const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors,
+                      const vertex_ordering ordering)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType1::memory_space System2;
+    typedef typename ArrayType2::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    return cusp::graph::block_coloring(select_system(system1,system2,system3), G, blocks, colors, ordering);
+}
+
 } // end namespace graph
 } // end namespace cusp
 
@@ -43,6 +43,16 @@ void hilbert_curve(const thrust::detail::execution_policy_base<DerivedPolicy>& e
                    const Array2dType& coord,
                    const size_t num_parts,
                    ArrayType& parts);
+
+template <typename DerivedPolicy,
+          typename Array2dType,
+          typename ArrayType,
+          typename PermutationArrayType>
+void hilbert_curve(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                   const Array2dType& coord,
+                   const size_t num_parts,
+                   ArrayType& parts,
+                   PermutationArrayType& permutation);
 /*! \endcond */
 
 /**
@@ -58,6 +68,9 @@ void hilbert_curve(const thrust::detail::execution_policy_base<DerivedPolicy>& e
  * \par Overview
  * Uses a Hilbert space filling curve to partition
  * a set of points in 2 or 3 dimensional space.
+ * The points are sorted along the curve and every part receives a
+ * consecutive run of num_points / num_parts points. The OpenMP and TBB
+ * systems compute the keys and radix sort them in parallel.
  *
  * \see http://en.wikipedia.org/wiki/Hilbert_curve
  *
@@ -104,6 +117,26 @@ void hilbert_curve(const thrust::detail::execution_policy_base<DerivedPolicy>& e
  */
 template <class Array2dType, class ArrayType>
 void hilbert_curve(const Array2dType& coord, const size_t num_parts, ArrayType& parts);
+
+/**
+ * \brief Partition a graph using Hilbert curve and return the curve order
+ *
+ * \param coord Set of points in 2 or 3-D space
+ * \param num_parts Number of partitions to construct
+ * \param parts Partition assigned to each point
+ * \param permutation Position of each point along the curve
+ *
+ * \tparam Array2dType Type of input coordinates array
+ * \tparam ArrayType Type of output partition indicator array, parts
+ * \tparam PermutationArrayType Type of output permutation array
+ *
+ * \par Overview
+ * Same as the partitioning above, additionally returning the order of the
+ * points along the curve. The permutation can be passed to
+ * \p cusp::reorder to reorder a matrix for locality.
+ */
+template <class Array2dType, class ArrayType, class PermutationArrayType>
+void hilbert_curve(const Array2dType& coord, const size_t num_parts, ArrayType& parts, PermutationArrayType& permutation);
 /*! \}
  */
 
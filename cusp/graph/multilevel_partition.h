@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file multilevel_partition.h
+ *  \brief Multilevel k-way partitioning of a graph
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <thrust/execution_policy.h>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t multilevel_partition(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            const size_t num_parts,
+                            ArrayType& parts);
+/*! \endcond */
+
+/**
+ * \brief Partition a graph into parts of equal size with few cut edges
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of output partition indicator array, parts
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param num_parts Number of partitions to construct
+ * \param parts Partition assigned to each vertex
+ *
+ * \return Number of edges between vertices of distinct parts
+ *
+ * \par Overview
+ * Computes a k-way partitioning of a graph by recursive multilevel
+ * bisection. Every bisection coarsens the graph by heavy edge matching,
+ * with the coarse graphs formed by Galerkin products, bisects the
+ * coarsest graph by greedy graph growing and refines the bisection
+ * with the Fiduccia-Mattheyses algorithm while projecting it back to
+ * the original graph. Unlike \p hilbert_curve no coordinates are needed.
+ *
+ * The partitioning is computed on the host, device matrices are copied
+ * to the host and the parts are copied back.
+ *
+ * \see http://glaros.dtc.umn.edu/gkhome/metis/metis/overview
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array1d.h>
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/print.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * //include multilevel partition header file
+ * #include <cusp/graph/multilevel_partition.h>
+ *
+ * #include <iostream>
+ *
+ * int main()
+ * {
+ *    // Build a 2D grid on the host
+ *    cusp::csr_matrix<int,float,cusp::host_memory> G;
+ *    cusp::gallery::poisson5pt(G, 16, 16);
+ *
+ *    // Array that indicates partition each vertex belongs
+ *    cusp::array1d<int,cusp::host_memory> parts(G.num_rows);
+ *
+ *    // Partition the graph into 4 parts
+ *    size_t edge_cut = cusp::graph::multilevel_partition(G, 4, parts);
+ *
+ *    // Print the number of cut edges and the per vertex membership
+ *    std::cout << "Edge cut : " << edge_cut << std::endl;
+ *    cusp::print(parts);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename MatrixType, typename ArrayType>
+size_t multilevel_partition(const MatrixType& G, const size_t num_parts, ArrayType& parts);
+/*! \}
+ */
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/multilevel_partition.inl>
@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file nested_dissection.h
+ *  \brief Nested dissection ordering of a sparse matrix
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <thrust/execution_policy.h>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename PermutationType>
+void nested_dissection(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       PermutationType& P);
+/*! \endcond */
+
+/**
+ * \brief Compute a nested dissection reordering
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam PermutationType Type of permutation matrix
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param P The permutation matrix that is generated by the reordering
+ *
+ * \par Overview
+ *
+ * Performs a fill reducing reordering on a graph represented by a
+ * symmetric sparse adjacency matrix. The graph is split by a vertex
+ * separator derived from a multilevel bisection, see \p multilevel_partition,
+ * both halves are ordered recursively and the separator is numbered last.
+ * Subgraphs of at most 64 vertices keep their original order.
+ *
+ * The ordering is computed on the host, device matrices are copied
+ * to the host and the permutation is copied back.
+ *
+ * \see http://en.wikipedia.org/wiki/Nested_dissection
+ *
+ * \par Example
+ *
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/permutation_matrix.h>
+ * #include <cusp/print.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * //include nested dissection header file
+ * #include <cusp/graph/nested_dissection.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D grid on the host
+ *    cusp::csr_matrix<int,float,cusp::host_memory> G;
+ *    cusp::gallery::poisson5pt(G, 32, 32);
+ *
+ *    // Allocate permutation matrix P
+ *    cusp::permutation_matrix<int,cusp::host_memory> P(G.num_rows);
+ *
+ *    // Construct nested dissection permutation matrix
+ *    cusp::graph::nested_dissection(G, P);
+ *
+ *    // Reorder the matrix
+ *    P.symmetric_permute(G);
+ *
+ *    cusp::print(P.permutation);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template<typename MatrixType, typename PermutationType>
+void nested_dissection(const MatrixType& G, PermutationType& P);
+/*! \}
+ */
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/nested_dissection.inl>
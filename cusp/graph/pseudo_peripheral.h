@@ -71,6 +71,10 @@ pseudo_peripheral_vertex(const thrust::detail::execution_policy_base<DerivedPoli
  * is the vertex which achieves the diameter of the graph, i.e. achieves the
  * maximum separation distance.
  *
+ * Level structures are rooted at vertices of smallest degree in the last
+ * level of the previous one until the eccentricity stops growing. The
+ * OpenMP and TBB systems root several of them concurrently per iteration.
+ *
  * \see http://en.wikipedia.org/wiki/Distance_(graph_theory)
  *
  * \par Example
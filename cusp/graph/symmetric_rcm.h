@@ -59,6 +59,12 @@ void symmetric_rcm(const thrust::detail::execution_policy_base<DerivedPolicy>& e
  * adjacency matrix in order to decrease the bandwidth. The reordering is computed
  * using the Cuthill-McKee algorithm and reversing the resulting index numbers.
  *
+ * The vertices are numbered one BFS level at a time and the unvisited
+ * neighbors of every vertex are numbered in order of increasing degree,
+ * which yields the same ordering as the sequential Cuthill-McKee algorithm.
+ * Every connected component of a disconnected graph is ordered separately
+ * and occupies a contiguous range of the permutation.
+ *
  * \see http://en.wikipedia.org/wiki/Cuthill-McKee_algorithm
  *
  * \par Example
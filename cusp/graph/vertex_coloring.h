@@ -35,6 +35,24 @@ namespace graph
  *  \{
  */
 
+/**
+ * \brief Order in which the vertices are colored.
+ *
+ * The greedy colorings assign every vertex the smallest color not used
+ * by its neighbors, so the order of the vertices decides the number of
+ * colors. The orderings are listed from fastest to fewest colors.
+ */
+enum vertex_ordering
+{
+    /*! color the vertices by increasing index */
+    natural_ordering,
+    /*! color the vertices by decreasing degree */
+    largest_degree_first,
+    /*! color the vertices in reverse of their removal order when the
+     *  vertex of smallest remaining degree is removed repeatedly */
+    smallest_last
+};
+
 /*! \cond */
 template <typename DerivedPolicy,
           typename MatrixType,
@@ -42,6 +60,42 @@ template <typename DerivedPolicy,
 size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
                        const MatrixType& G,
                        ArrayType& colors);
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const vertex_ordering ordering);
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const vertex_ordering ordering,
+                       const size_t distance);
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2>
+size_t block_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors);
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2>
+size_t block_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors,
+                      const vertex_ordering ordering);
 /*! \endcond */
 
 /**
@@ -53,6 +107,11 @@ size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy
  * \param G A symmetric matrix that represents the graph
  * \param colors Contains to the color associated with each vertex
  * computed during the coloring routine
+ * \return The number of colors used
+ *
+ * The sequential system colors the vertices greedily, the OpenMP and
+ * TBB systems color them speculatively in parallel and recolor the
+ * conflicting vertices until none remain.
  *
  *  \see http://en.wikipedia.org/wiki/Graph_coloring
  *
@@ -87,6 +146,125 @@ size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy
 template<typename MatrixType, typename ArrayType>
 size_t vertex_coloring(const MatrixType& G,
                        ArrayType& colors);
+
+/**
+ * \brief Performs a vertex coloring a graph using a given vertex ordering.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of colors array
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param colors Contains to the color associated with each vertex
+ * computed during the coloring routine
+ * \param ordering Order in which the vertices are colored,
+ * \c largest_degree_first and \c smallest_last usually need fewer colors
+ * than \c natural_ordering but take longer to compute
+ * \return The number of colors used
+ */
+template<typename MatrixType, typename ArrayType>
+size_t vertex_coloring(const MatrixType& G,
+                       ArrayType& colors,
+                       const vertex_ordering ordering);
+
+/**
+ * \brief Performs a distance-k vertex coloring of a graph.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of colors array
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param colors Contains to the color associated with each vertex
+ * computed during the coloring routine
+ * \param ordering Order in which the vertices are colored
+ * \param distance Vertices joined by a path of at most \p distance edges
+ * receive different colors
+ * \return The number of colors used
+ *
+ * \par Overview
+ * A distance-1 coloring is the usual coloring, in which neighbors differ.
+ * In a distance-2 coloring the neighbors of every vertex also differ from
+ * each other, so the rows of one color share no column of the matrix.
+ * The rows of a color class can then be updated concurrently by
+ * multicolor Gauss-Seidel, SOR or ILU sweeps without races, also when a
+ * row update writes to the rows of its neighbors.
+ */
+template<typename MatrixType, typename ArrayType>
+size_t vertex_coloring(const MatrixType& G,
+                       ArrayType& colors,
+                       const vertex_ordering ordering,
+                       const size_t distance);
+
+/**
+ * \brief Colors the blocks of a partitioned graph.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType1 Type of blocks array
+ * \tparam ArrayType2 Type of colors array
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param blocks Block of every vertex, such as the aggregate or the part
+ * computed by an aggregation or partitioning routine
+ * \param colors Contains the color of the block of every vertex
+ * \return The number of colors used
+ *
+ * \par Overview
+ * Two blocks are adjacent when an edge of \p G joins them. Adjacent blocks
+ * receive different colors, so the blocks of one color can be relaxed
+ * concurrently by block smoothers.
+ *
+ * \par Example
+ *
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/print.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * #include <cusp/graph/multilevel_partition.h>
+ * #include <cusp/graph/vertex_coloring.h>
+ *
+ * int main()
+ * {
+ *    cusp::csr_matrix<int,float,cusp::host_memory> G;
+ *    cusp::gallery::poisson5pt(G, 16, 16);
+ *
+ *    // split the grid into 16 blocks
+ *    cusp::array1d<int,cusp::host_memory> blocks(G.num_rows);
+ *    cusp::graph::multilevel_partition(G, 16, blocks);
+ *
+ *    // color the blocks
+ *    cusp::array1d<int,cusp::host_memory> colors(G.num_rows);
+ *    cusp::graph::block_coloring(G, blocks, colors);
+ *
+ *    cusp::print(colors);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template<typename MatrixType, typename ArrayType1, typename ArrayType2>
+size_t block_coloring(const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors);
+
+/**
+ * \brief Colors the blocks of a partitioned graph using a given ordering
+ * of the blocks.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType1 Type of blocks array
+ * \tparam ArrayType2 Type of colors array
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param blocks Block of every vertex
+ * \param colors Contains the color of the block of every vertex
+ * \param ordering Order in which the blocks are colored
+ * \return The number of colors used
+ */
+template<typename MatrixType, typename ArrayType1, typename ArrayType2>
+size_t block_coloring(const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors,
+                      const vertex_ordering ordering);
 /*! \}
  */
 
@@ -173,6 +173,156 @@ void write_binary_file(const Matrix& mtx, const std::string& filename);
 template <typename Matrix, typename Stream>
 void write_binary_stream(const Matrix& mtx, Stream& output);
 
+/**
+ * \brief Write a matrix to a file in the CSR binary format
+ *
+ * \tparam Matrix matrix container
+ *
+ * \param mtx a matrix container (e.g. \p csr_matrix or \p coo_matrix)
+ * \param filename file name of the CSR binary file
+ *
+ * \par Overview
+ * The CSR binary format begins with a fixed 128-byte header holding a magic
+ * string, a format version, a byte order mark, tags describing the index
+ * and value types, the matrix shape and the offsets of the row offsets,
+ * column indices and values arrays. Each array is stored verbatim and
+ * aligned to a 64-byte boundary so the file can be memory mapped and used
+ * in place by \p mapped_csr_matrix.
+ *
+ * \note if the file already exists it will be overwritten
+ *
+ * \par Example
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/gallery/poisson.h>
+ * #include <cusp/io/binary.h>
+ *
+ * int main(void)
+ * {
+ *     cusp::csr_matrix<int, float, cusp::host_memory> A;
+ *     cusp::gallery::poisson5pt(A, 100, 100);
+ *
+ *     // save A into a CSR binary file
+ *     cusp::io::write_csr_binary_file(A, "A.csr");
+ *
+ *     return 0;
+ * }
+ * \endcode
+ *
+ * \see \p read_csr_binary_file
+ * \see \p mapped_csr_matrix
+ */
+template <typename Matrix>
+void write_csr_binary_file(const Matrix& mtx, const std::string& filename);
+
+/**
+ * \brief Write a matrix to a stream in the CSR binary format
+ *
+ * \tparam Matrix matrix container
+ * \tparam Stream stream type
+ *
+ * \param mtx a matrix container (e.g. \p csr_matrix or \p coo_matrix)
+ * \param output stream to which the binary contents will be written
+ *
+ * \see \p write_csr_binary_file
+ */
+template <typename Matrix, typename Stream>
+void write_csr_binary_stream(const Matrix& mtx, Stream& output);
+
+/**
+ * \brief Read a file in the CSR binary format
+ *
+ * \tparam Matrix matrix container
+ *
+ * \param mtx a matrix container (e.g. \p csr_matrix or \p coo_matrix)
+ * \param filename file name of the CSR binary file
+ *
+ * \par Overview
+ * The arrays are read in bulk and no sorting is performed. The index and
+ * value types of \p mtx must match the types recorded in the file,
+ * otherwise an \p io_exception is thrown.
+ *
+ * \note any contents of \p mtx will be overwritten
+ *
+ * \par Example
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/io/binary.h>
+ *
+ * int main(void)
+ * {
+ *     // read matrix stored in A.csr into a csr_matrix
+ *     cusp::csr_matrix<int, float, cusp::device_memory> A;
+ *     cusp::io::read_csr_binary_file(A, "A.csr");
+ *
+ *     return 0;
+ * }
+ * \endcode
+ *
+ * \see \p write_csr_binary_file
+ * \see \p mapped_csr_matrix
+ */
+template <typename Matrix>
+void read_csr_binary_file(Matrix& mtx, const std::string& filename);
+
+/**
+ * \brief Read CSR binary data from a stream
+ *
+ * \tparam Matrix matrix container
+ * \tparam Stream stream type
+ *
+ * \param mtx a matrix container (e.g. \p csr_matrix or \p coo_matrix)
+ * \param input stream from which to read the binary contents
+ *
+ * \see \p read_csr_binary_file
+ */
+template <typename Matrix, typename Stream>
+void read_csr_binary_stream(Matrix& mtx, Stream& input);
+
+/**
+ * \brief A read-only mapping of a CSR binary file into host memory
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ *
+ * \par Overview
+ * \p mapped_csr_matrix maps a file written by \p write_csr_binary_file
+ * into the address space of the process and wraps the stored arrays
+ * with a \p csr_matrix_view, so no data is copied, converted or sorted
+ * when the matrix is opened. Pages are loaded lazily by the operating
+ * system on first access. The mapping is private: modifying the entries
+ * through the view never changes the file. On platforms without
+ * \c mmap the file is read into host memory with a single read.
+ *
+ * The mapping is released when the object is destroyed, after which
+ * views taken from it must not be used.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array1d.h>
+ * #include <cusp/multiply.h>
+ * #include <cusp/io/binary.h>
+ *
+ * int main(void)
+ * {
+ *     // map the matrix stored in A.csr
+ *     cusp::io::mapped_csr_matrix<int, float> A("A.csr");
+ *
+ *     cusp::array1d<float, cusp::host_memory> x(A.num_cols, 1);
+ *     cusp::array1d<float, cusp::host_memory> y(A.num_rows);
+ *
+ *     // use the mapped matrix like any other csr_matrix_view
+ *     cusp::multiply(A, x, y);
+ *
+ *     return 0;
+ * }
+ * \endcode
+ *
+ * \see \p write_csr_binary_file
+ */
+template <typename IndexType, typename ValueType>
+class mapped_csr_matrix;
+
 /*! \}
  */
 
@@ -17,8 +17,11 @@
 
 #pragma once
 
+#include <cusp/array1d.h>
 #include <cusp/array2d.h>
+#include <cusp/complex.h>
 #include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
 #include <cusp/convert.h>
 #include <cusp/exception.h>
 #include <cusp/io/matrix_market.h>
@@ -26,12 +29,23 @@
 #include <thrust/sort.h>
 #include <thrust/tuple.h>
 
+#include <thrust/detail/static_assert.h>
+
 #include <vector>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <limits>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 namespace cusp
 {
@@ -116,6 +130,320 @@ void write_binary_stream(const Matrix& mtx, Stream& output, cusp::sparse_format)
     cusp::io::detail::write_binary_stream(coo, output);
 }
 
+/////////////////////////
+// CSR binary format   //
+/////////////////////////
+
+const unsigned int csr_binary_version    = 1;
+const unsigned int csr_binary_byte_order = 0x01020304;
+const unsigned int csr_binary_alignment  = 64;
+
+const char csr_binary_magic[8] = {'C', 'U', 'S', 'P', 'C', 'S', 'R', '\0'};
+
+// tag = (kind << 16) | size, where kind is 1 for signed integers,
+// 2 for unsigned integers, 3 for real and 4 for complex values
+template <typename T>
+struct csr_binary_type_tag
+{
+    static const unsigned int kind  = std::numeric_limits<T>::is_integer ? (std::numeric_limits<T>::is_signed ? 1 : 2) : 3;
+    static const unsigned int value = (kind << 16) | sizeof(T);
+};
+
+template <typename T>
+struct csr_binary_type_tag< cusp::complex<T> >
+{
+    static const unsigned int value = (4 << 16) | sizeof(cusp::complex<T>);
+};
+
+// fixed-size header at the beginning of every CSR binary file
+struct csr_binary_header
+{
+    char               magic[8];
+    unsigned int       version;
+    unsigned int       byte_order;
+    unsigned int       index_type;
+    unsigned int       value_type;
+    unsigned long long num_rows;
+    unsigned long long num_cols;
+    unsigned long long num_entries;
+    unsigned long long row_offsets_offset;
+    unsigned long long column_indices_offset;
+    unsigned long long values_offset;
+    char               reserved[56];
+};
+
+// the header is part of the on-disk layout and must stay 128 bytes
+THRUST_STATIC_ASSERT(sizeof(csr_binary_header) == 128);
+
+inline unsigned long long csr_binary_align(unsigned long long offset)
+{
+    return (offset + csr_binary_alignment - 1) / csr_binary_alignment * csr_binary_alignment;
+}
+
+template <typename IndexType, typename ValueType>
+csr_binary_header make_csr_binary_header(size_t num_rows, size_t num_cols, size_t num_entries)
+{
+    csr_binary_header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, csr_binary_magic, sizeof(header.magic));
+
+    header.version     = csr_binary_version;
+    header.byte_order  = csr_binary_byte_order;
+    header.index_type  = csr_binary_type_tag<IndexType>::value;
+    header.value_type  = csr_binary_type_tag<ValueType>::value;
+    header.num_rows    = num_rows;
+    header.num_cols    = num_cols;
+    header.num_entries = num_entries;
+
+    header.row_offsets_offset    = csr_binary_align(sizeof(csr_binary_header));
+    header.column_indices_offset = csr_binary_align(header.row_offsets_offset    + (num_rows + 1) * sizeof(IndexType));
+    header.values_offset         = csr_binary_align(header.column_indices_offset + num_entries    * sizeof(IndexType));
+
+    return header;
+}
+
+// validates the header against the requested types and, when known,
+// the size of the file holding it
+inline void check_csr_binary_header(const csr_binary_header& header,
+                                    unsigned int index_type,
+                                    unsigned int value_type,
+                                    unsigned long long file_size = 0)
+{
+    if (std::memcmp(header.magic, csr_binary_magic, sizeof(header.magic)) != 0)
+        throw cusp::io_exception("invalid CSR binary header: bad magic string");
+
+    if (header.version > csr_binary_version)
+        throw cusp::io_exception("unsupported CSR binary format version");
+
+    if (header.byte_order != csr_binary_byte_order)
+        throw cusp::io_exception("CSR binary file byte order does not match the host");
+
+    if (header.index_type != index_type)
+        throw cusp::io_exception("CSR binary file index type does not match the matrix index type");
+
+    if (header.value_type != value_type)
+        throw cusp::io_exception("CSR binary file value type does not match the matrix value type");
+
+    const unsigned long long index_size = index_type & 0xFFFF;
+    const unsigned long long value_size = value_type & 0xFFFF;
+
+    if (header.row_offsets_offset    % csr_binary_alignment != 0 ||
+        header.column_indices_offset % csr_binary_alignment != 0 ||
+        header.values_offset         % csr_binary_alignment != 0)
+        throw cusp::io_exception("invalid CSR binary header: misaligned array offsets");
+
+    if (file_size > 0 &&
+        (header.row_offsets_offset    + (header.num_rows + 1) * index_size > file_size ||
+         header.column_indices_offset + header.num_entries    * index_size > file_size ||
+         header.values_offset         + header.num_entries    * value_size > file_size))
+        throw cusp::io_exception("CSR binary file is truncated");
+}
+
+template <typename Stream, typename Array>
+unsigned long long write_csr_binary_section(Stream& output,
+                                            unsigned long long position,
+                                            unsigned long long offset,
+                                            const Array& array)
+{
+    typedef typename Array::value_type ValueType;
+
+    const char padding[csr_binary_alignment] = {0};
+
+    output.write(padding, offset - position);
+
+    if (array.size() > 0)
+        output.write(reinterpret_cast<const char *>(&array[0]), array.size() * sizeof(ValueType));
+
+    return offset + array.size() * sizeof(ValueType);
+}
+
+template <typename Stream, typename Array>
+unsigned long long read_csr_binary_section(Stream& input,
+                                           unsigned long long position,
+                                           unsigned long long offset,
+                                           Array& array)
+{
+    typedef typename Array::value_type ValueType;
+
+    input.ignore(offset - position);
+
+    if (array.size() > 0)
+        input.read(reinterpret_cast<char *>(&array[0]), array.size() * sizeof(ValueType));
+
+    if (!input)
+        throw cusp::io_exception("CSR binary file is truncated");
+
+    return offset + array.size() * sizeof(ValueType);
+}
+
+template <typename IndexType, typename ValueType, typename Stream>
+void write_csr_binary_stream(const cusp::csr_matrix<IndexType,ValueType,cusp::host_memory>& csr,
+                             Stream& output,
+                             cusp::csr_format)
+{
+    csr_binary_header header =
+        make_csr_binary_header<IndexType,ValueType>(csr.num_rows, csr.num_cols, csr.num_entries);
+
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    unsigned long long position = sizeof(header);
+    position = write_csr_binary_section(output, position, header.row_offsets_offset,    csr.row_offsets);
+    position = write_csr_binary_section(output, position, header.column_indices_offset, csr.column_indices);
+    position = write_csr_binary_section(output, position, header.values_offset,         csr.values);
+}
+
+template <typename Matrix, typename Stream, typename Format>
+void write_csr_binary_stream(const Matrix& mtx, Stream& output, Format)
+{
+    // general case
+    typedef typename Matrix::index_type IndexType;
+    typedef typename Matrix::value_type ValueType;
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> csr(mtx);
+
+    cusp::io::detail::write_csr_binary_stream(csr, output, cusp::csr_format());
+}
+
+template <typename IndexType, typename ValueType, typename Stream>
+void read_csr_binary_stream(cusp::csr_matrix<IndexType,ValueType,cusp::host_memory>& csr,
+                            Stream& input,
+                            cusp::csr_format)
+{
+    csr_binary_header header;
+
+    input.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+    if (!input)
+        throw cusp::io_exception("unable to read CSR binary header");
+
+    check_csr_binary_header(header,
+                            csr_binary_type_tag<IndexType>::value,
+                            csr_binary_type_tag<ValueType>::value);
+
+    csr.resize(header.num_rows, header.num_cols, header.num_entries);
+
+    unsigned long long position = sizeof(header);
+    position = read_csr_binary_section(input, position, header.row_offsets_offset,    csr.row_offsets);
+    position = read_csr_binary_section(input, position, header.column_indices_offset, csr.column_indices);
+    position = read_csr_binary_section(input, position, header.values_offset,         csr.values);
+}
+
+template <typename Matrix, typename Stream, typename Format>
+void read_csr_binary_stream(Matrix& mtx, Stream& input, Format)
+{
+    // general case
+    typedef typename Matrix::index_type IndexType;
+    typedef typename Matrix::value_type ValueType;
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> temp;
+
+    cusp::io::detail::read_csr_binary_stream(temp, input, cusp::csr_format());
+
+    cusp::convert(temp, mtx);
+}
+
+// Owns the memory holding a CSR binary file, either as a private
+// (copy-on-write) mapping or, where mmap is unavailable, as a buffer
+class csr_binary_mapping
+{
+public:
+
+    csr_binary_mapping(const std::string& filename, unsigned int index_type, unsigned int value_type)
+        : data(NULL), size(0)
+    {
+#if defined(_WIN32)
+        std::ifstream file(filename.c_str(), std::ios::binary);
+
+        if (!file)
+            throw cusp::io_exception(std::string("unable to open file \"") + filename + std::string("\" for reading"));
+
+        file.seekg(0, std::ios::end);
+        size = size_t(file.tellg());
+        file.seekg(0, std::ios::beg);
+
+        buffer.resize(std::max<size_t>(size, sizeof(csr_binary_header)));
+        file.read(&buffer[0], size);
+
+        if (!file)
+            throw cusp::io_exception(std::string("unable to read file \"") + filename + std::string("\""));
+
+        data = &buffer[0];
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+
+        if (fd < 0)
+            throw cusp::io_exception(std::string("unable to open file \"") + filename + std::string("\" for reading"));
+
+        struct stat status;
+
+        if (fstat(fd, &status) != 0 || size_t(status.st_size) < sizeof(csr_binary_header))
+        {
+            close(fd);
+            throw cusp::io_exception(std::string("file \"") + filename + std::string("\" is not a CSR binary file"));
+        }
+
+        size = status.st_size;
+
+        void * address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+        close(fd);
+
+        if (address == MAP_FAILED)
+            throw cusp::io_exception(std::string("unable to map file \"") + filename + std::string("\""));
+
+        data = static_cast<char *>(address);
+#endif
+
+        try
+        {
+            if (size < sizeof(csr_binary_header))
+                throw cusp::io_exception(std::string("file \"") + filename + std::string("\" is not a CSR binary file"));
+
+            check_csr_binary_header(header(), index_type, value_type, size);
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    ~csr_binary_mapping(void)
+    {
+        release();
+    }
+
+    const csr_binary_header& header(void) const
+    {
+        return *reinterpret_cast<const csr_binary_header *>(data);
+    }
+
+    template <typename T>
+    T * section(unsigned long long offset) const
+    {
+        return reinterpret_cast<T *>(data + offset);
+    }
+
+private:
+
+    char * data;
+    size_t size;
+    std::vector<char> buffer;
+
+    void release(void)
+    {
+#if !defined(_WIN32)
+        if (data != NULL)
+            munmap(data, size);
+#endif
+        data = NULL;
+    }
+
+    // mappings are not copyable
+    csr_binary_mapping(const csr_binary_mapping&);
+    csr_binary_mapping& operator=(const csr_binary_mapping&);
+};
+
 } // end namespace detail
 
 
@@ -173,6 +501,77 @@ void write_binary_stream(const Matrix& mtx, Stream& output)
     cusp::io::detail::write_binary_stream(mtx, output, typename Matrix::format());
 }
 
+template <typename Matrix>
+void write_csr_binary_file(const Matrix& mtx, const std::string& filename)
+{
+    std::ofstream file(filename.c_str(), std::ios::binary);
+
+    if (!file)
+        throw cusp::io_exception(std::string("unable to open file \"") + filename + std::string("\" for writing"));
+
+    cusp::io::write_csr_binary_stream(mtx, file);
+}
+
+template <typename Matrix, typename Stream>
+void write_csr_binary_stream(const Matrix& mtx, Stream& output)
+{
+    cusp::io::detail::write_csr_binary_stream(mtx, output, typename Matrix::format());
+}
+
+template <typename Matrix>
+void read_csr_binary_file(Matrix& mtx, const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+
+    if (!file)
+        throw cusp::io_exception(std::string("unable to open file \"") + filename + std::string("\" for reading"));
+
+    cusp::io::read_csr_binary_stream(mtx, file);
+}
+
+template <typename Matrix, typename Stream>
+void read_csr_binary_stream(Matrix& mtx, Stream& input)
+{
+    cusp::io::detail::read_csr_binary_stream(mtx, input, typename Matrix::format());
+}
+
+template <typename IndexType, typename ValueType>
+class mapped_csr_matrix
+    : private cusp::io::detail::csr_binary_mapping,
+      public cusp::csr_matrix_view< cusp::array1d_view<IndexType*>,
+                                    cusp::array1d_view<IndexType*>,
+                                    cusp::array1d_view<ValueType*> >
+{
+private:
+
+    typedef cusp::io::detail::csr_binary_mapping Mapping;
+
+    typedef cusp::array1d_view<IndexType*> IndexArrayView;
+    typedef cusp::array1d_view<ValueType*> ValueArrayView;
+
+    typedef cusp::csr_matrix_view<IndexArrayView,IndexArrayView,ValueArrayView> Parent;
+
+public:
+
+    /*! Map a CSR binary file
+     *
+     *  \param filename file name of the CSR binary file
+     */
+    mapped_csr_matrix(const std::string& filename)
+        : Mapping(filename,
+                  cusp::io::detail::csr_binary_type_tag<IndexType>::value,
+                  cusp::io::detail::csr_binary_type_tag<ValueType>::value),
+          Parent(Mapping::header().num_rows,
+                 Mapping::header().num_cols,
+                 Mapping::header().num_entries,
+                 IndexArrayView(Mapping::template section<IndexType>(Mapping::header().row_offsets_offset),
+                                Mapping::template section<IndexType>(Mapping::header().row_offsets_offset) + Mapping::header().num_rows + 1),
+                 IndexArrayView(Mapping::template section<IndexType>(Mapping::header().column_indices_offset),
+                                Mapping::template section<IndexType>(Mapping::header().column_indices_offset) + Mapping::header().num_entries),
+                 ValueArrayView(Mapping::template section<ValueType>(Mapping::header().values_offset),
+                                Mapping::template section<ValueType>(Mapping::header().values_offset) + Mapping::header().num_entries)) {}
+};
+
 } //end namespace io
 } //end namespace cusp
 
@@ -19,12 +19,20 @@
 
 #include <cusp/array2d.h>
 #include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
 #include <cusp/complex.h>
 #include <cusp/convert.h>
 #include <cusp/exception.h>
+#include <cusp/format_utils.h>
+
+#include <cusp/system/omp/detail/utils.h>
 
 #include <thrust/sort.h>
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
 #include <vector>
 #include <string>
 #include <fstream>
@@ -111,16 +119,17 @@ void assign_complex(cusp::complex<ScalarType>& value, double real, double imag)
     value.imag(imag);
 }
 
-template <typename Stream, typename ScalarType>
-void write_value(Stream& output, const ScalarType& value)
+// value of the entry (j,i) implied by the entry (i,j) of a
+// symmetric, skew-symmetric or hermitian matrix
+template <typename ValueType>
+ValueType mirror_value(const ValueType& value, bool skew, bool hermitian)
 {
-    output << value;
-}
-
-template <typename Stream, typename ScalarType>
-void write_value(Stream& output, const cusp::complex<ScalarType>& value)
-{
-    output << value.real() << " " << value.imag();
+    if (skew)
+        return -value;
+    else if (hermitian)
+        return cusp::conj(value);
+    else
+        return value;
 }
 
 template<typename Stream>
@@ -254,38 +263,28 @@ void read_coordinate_stream(MatrixType& coo,
 
         cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> general(num_rows, num_cols, general_num_entries);
 
-        if (banner.symmetry == "symmetric")
-        {
-            size_t nnz = 0;
+        bool skew      = banner.symmetry == "skew-symmetric";
+        bool hermitian = banner.symmetry == "hermitian";
+
+        size_t nnz = 0;
 
-            for (size_t n = 0; n < coo.num_entries; n++)
+        for (size_t n = 0; n < coo.num_entries; n++)
+        {
+            // copy entry over
+            general.row_indices[nnz]    = coo.row_indices[n];
+            general.column_indices[nnz] = coo.column_indices[n];
+            general.values[nnz]         = coo.values[n];
+            nnz++;
+
+            // duplicate off-diagonals
+            if (coo.row_indices[n] != coo.column_indices[n])
             {
-                // copy entry over
-                general.row_indices[nnz]    = coo.row_indices[n];
-                general.column_indices[nnz] = coo.column_indices[n];
-                general.values[nnz]         = coo.values[n];
+                general.row_indices[nnz]    = coo.column_indices[n];
+                general.column_indices[nnz] = coo.row_indices[n];
+                general.values[nnz]         = mirror_value(coo.values[n], skew, hermitian);
                 nnz++;
-
-                // duplicate off-diagonals
-                if (coo.row_indices[n] != coo.column_indices[n])
-                {
-                    general.row_indices[nnz]    = coo.column_indices[n];
-                    general.column_indices[nnz] = coo.row_indices[n];
-                    general.values[nnz]         = coo.values[n];
-                    nnz++;
-                }
             }
         }
-        else if (banner.symmetry == "hermitian")
-        {
-            throw cusp::not_implemented_exception("MatrixMarket I/O does not currently support hermitian matrices");
-            //TODO
-        }
-        else if (banner.symmetry == "skew-symmetric")
-        {
-            //TODO
-            throw cusp::not_implemented_exception("MatrixMarket I/O does not currently support skew-symmetric matrices");
-        }
 
         // store full matrix in coo
         coo.swap(general);
@@ -340,6 +339,421 @@ void read_coordinate_stream(Matrix& mtx, Stream& input, const matrix_market_bann
     cusp::convert(temp, mtx);
 }
 
+/*
+ * Block parser for the body of coordinate MatrixMarket files
+ *
+ * The whole file is read into memory with a single block read and the
+ * entries are split into line-aligned chunks. Each chunk is scanned once
+ * to count its entries and once more to parse them directly into the
+ * COO arrays at the offset given by the prefix sum of the counts. Numbers
+ * are parsed in place without allocating, which is what makes the reader
+ * fast compared to the stream based one. When OpenMP is enabled the
+ * chunks are processed in parallel.
+ */
+
+inline bool is_blank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char * skip_blanks(const char * p)
+{
+    while (is_blank(*p)) p++;
+    return p;
+}
+
+// returns the start of the line following p
+inline const char * next_line(const char * p, const char * end)
+{
+    const char * q = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    return q == NULL ? end : q + 1;
+}
+
+// true if the line starting at p holds neither data nor a comment
+inline bool is_data_line(const char * p, const char * end)
+{
+    p = skip_blanks(p);
+    return p < end && *p != '\n' && *p != '%' && *p != '\0';
+}
+
+// parse an unsigned integer, returns NULL on failure
+inline const char * parse_index(const char * p, size_t& value)
+{
+    p = skip_blanks(p);
+
+    if (*p < '0' || *p > '9')
+        return NULL;
+
+    size_t result = 0;
+    while (*p >= '0' && *p <= '9')
+        result = 10 * result + (*p++ - '0');
+
+    value = result;
+    return p;
+}
+
+// parse a floating point number, returns NULL on failure
+//
+// Numbers with at most 15 significant digits and a decimal exponent
+// within [-22,22] are exactly representable as a mantissa and a power of
+// ten, so a single multiplication or division yields the correctly rounded
+// result. Everything else is deferred to strtod.
+inline const char * parse_real(const char * p, double& value)
+{
+    static const double powers_of_ten[] =
+    {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    p = skip_blanks(p);
+
+    // a missing value must not be taken from the next line, which strtod
+    // would do since it skips newlines as whitespace
+    if (*p == '\n' || *p == '\r' || *p == '\0')
+        return NULL;
+
+    const char * start = p;
+
+    bool negative = false;
+    if (*p == '+' || *p == '-')
+        negative = (*p++ == '-');
+
+    unsigned long long mantissa = 0;
+    int num_digits = 0;
+    int exponent = 0;
+
+    for (; *p >= '0' && *p <= '9'; p++, num_digits++)
+        mantissa = 10 * mantissa + (*p - '0');
+
+    if (*p == '.')
+    {
+        for (p++; *p >= '0' && *p <= '9'; p++, num_digits++, exponent--)
+            mantissa = 10 * mantissa + (*p - '0');
+    }
+
+    if (num_digits > 0 && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+
+        bool negative_exponent = false;
+        if (*p == '+' || *p == '-')
+            negative_exponent = (*p++ == '-');
+
+        if (*p < '0' || *p > '9')
+            return NULL;
+
+        int e = 0;
+        for (; *p >= '0' && *p <= '9'; p++)
+            if (e < 100000) e = 10 * e + (*p - '0');
+
+        exponent += negative_exponent ? -e : e;
+    }
+
+    if (num_digits == 0 || num_digits > 15 || exponent < -22 || exponent > 22)
+    {
+        // slow path (long mantissas, large exponents, inf and nan)
+        char * stop;
+        value = std::strtod(start, &stop);
+        return stop == start ? NULL : stop;
+    }
+
+    double result = double(mantissa);
+
+    if (exponent < 0)
+        result /= powers_of_ten[-exponent];
+    else
+        result *= powers_of_ten[exponent];
+
+    value = negative ? -result : result;
+
+    return p;
+}
+
+// number of entries stored in the lines of [begin,end)
+inline size_t count_coordinate_entries(const char * begin, const char * end)
+{
+    size_t count = 0;
+
+    for (const char * p = begin; p < end; p = next_line(p, end))
+        if (is_data_line(p, end))
+            count++;
+
+    return count;
+}
+
+enum coordinate_parse_status
+{
+    coordinate_parse_success,
+    coordinate_parse_invalid_entry,
+    coordinate_parse_invalid_index
+};
+
+// parse the entries in the lines of [begin,end) into base-0 coordinates
+template <typename IndexType, typename ValueType>
+coordinate_parse_status
+parse_coordinate_entries(const char * begin, const char * end,
+                         const matrix_market_banner& banner,
+                         size_t num_rows, size_t num_cols,
+                         IndexType * row_indices,
+                         IndexType * column_indices,
+                         ValueType * values)
+{
+    bool is_pattern = banner.type == "pattern";
+    bool is_complex = banner.type == "complex";
+
+    size_t n = 0;
+
+    for (const char * p = begin; p < end; p = next_line(p, end))
+    {
+        if (!is_data_line(p, end))
+            continue;
+
+        size_t i, j;
+
+        if ((p = parse_index(p, i)) == NULL) return coordinate_parse_invalid_entry;
+        if ((p = parse_index(p, j)) == NULL) return coordinate_parse_invalid_entry;
+
+        if (i < 1 || i > num_rows || j < 1 || j > num_cols)
+            return coordinate_parse_invalid_index;
+
+        row_indices[n]    = i - 1;
+        column_indices[n] = j - 1;
+
+        if (is_pattern)
+        {
+            values[n] = ValueType(1);
+        }
+        else if (is_complex)
+        {
+            double real, imag;
+
+            if ((p = parse_real(p, real)) == NULL) return coordinate_parse_invalid_entry;
+            if ((p = parse_real(p, imag)) == NULL) return coordinate_parse_invalid_entry;
+
+            assign_complex(values[n], real, imag);
+        }
+        else
+        {
+            double real;
+
+            if ((p = parse_real(p, real)) == NULL) return coordinate_parse_invalid_entry;
+
+            values[n] = real;
+        }
+
+        n++;
+    }
+
+    return coordinate_parse_success;
+}
+
+template <typename IndexType, typename ValueType>
+struct column_less
+{
+    bool operator()(const std::pair<IndexType,ValueType>& a, const std::pair<IndexType,ValueType>& b) const
+    {
+        return a.first < b.first;
+    }
+};
+
+template <typename IndexType, typename ValueType>
+void read_coordinate_buffer(cusp::csr_matrix<IndexType,ValueType,cusp::host_memory>& csr,
+                            const char * begin,
+                            const char * end,
+                            const matrix_market_banner& banner)
+{
+    if (banner.type != "pattern" && banner.type != "real" &&
+        banner.type != "integer" && banner.type != "complex")
+        throw cusp::io_exception("invalid MatrixMarket data type");
+
+    // skip over comments and blank lines
+    const char * p = begin;
+    while (p < end && !is_data_line(p, end))
+        p = next_line(p, end);
+
+    // line contains [num_rows num_columns num_entries]
+    size_t num_rows, num_cols, num_entries;
+    const char * q = p;
+
+    if (p == end ||
+        (q = parse_index(q, num_rows))    == NULL ||
+        (q = parse_index(q, num_cols))    == NULL ||
+        (q = parse_index(q, num_entries)) == NULL ||
+        is_data_line(q, end))
+        throw cusp::io_exception("invalid MatrixMarket coordinate format");
+
+    const char * body = next_line(p, end);
+
+    // split the entries into line-aligned chunks
+    const size_t min_chunk_size = 1 << 16;
+    size_t body_size  = end - body;
+    int    num_chunks = std::max<int>(1, std::min<size_t>(8 * cusp::system::omp::detail::max_threads(),
+                                                          body_size / min_chunk_size));
+
+    std::vector<const char *> chunks(num_chunks + 1);
+    chunks[0] = body;
+    chunks[num_chunks] = end;
+    for (int k = 1; k < num_chunks; k++)
+        chunks[k] = std::max(chunks[k - 1], next_line(body + (body_size / num_chunks) * k - 1, end));
+
+    // count the entries in each chunk
+    std::vector<size_t> offsets(num_chunks + 1, 0);
+
+#if defined(_OPENMP)
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int k = 0; k < num_chunks; k++)
+        offsets[k + 1] = count_coordinate_entries(chunks[k], chunks[k + 1]);
+
+    for (int k = 0; k < num_chunks; k++)
+        offsets[k + 1] += offsets[k];
+
+    if (offsets[num_chunks] != num_entries)
+    {
+        std::cerr << " Read " << offsets[num_chunks] << " out of " << num_entries << " expected entries!" << std::endl;
+        throw cusp::io_exception("unexpected number of MatrixMarket entries");
+    }
+
+    // parse the chunks into coordinate format
+    cusp::array1d<IndexType,cusp::host_memory> row_indices(num_entries);
+    cusp::array1d<IndexType,cusp::host_memory> column_indices(num_entries);
+    cusp::array1d<ValueType,cusp::host_memory> values(num_entries);
+
+    std::vector<int> status(num_chunks, coordinate_parse_success);
+
+    if (num_entries > 0)
+    {
+        IndexType * I = &row_indices[0];
+        IndexType * J = &column_indices[0];
+        ValueType * V = &values[0];
+
+#if defined(_OPENMP)
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (int k = 0; k < num_chunks; k++)
+            status[k] = parse_coordinate_entries(chunks[k], chunks[k + 1], banner, num_rows, num_cols,
+                                                 I + offsets[k], J + offsets[k], V + offsets[k]);
+    }
+
+    for (int k = 0; k < num_chunks; k++)
+    {
+        if (status[k] == coordinate_parse_invalid_entry)
+            throw cusp::io_exception("invalid MatrixMarket entry");
+        if (status[k] == coordinate_parse_invalid_index)
+            throw cusp::io_exception("found invalid row or column index");
+    }
+
+    // expand symmetric formats to "general" format while assembling
+    // the entries into CSR format
+    bool expand    = banner.symmetry != "general";
+    bool skew      = banner.symmetry == "skew-symmetric";
+    bool hermitian = banner.symmetry == "hermitian";
+
+    size_t general_num_entries = num_entries;
+    if (expand)
+        for (size_t n = 0; n < num_entries; n++)
+            if (row_indices[n] != column_indices[n])
+                general_num_entries++;
+
+    csr.resize(num_rows, num_cols, general_num_entries);
+
+    std::vector<size_t> next(num_rows + 1, 0);
+
+    for (size_t n = 0; n < num_entries; n++)
+    {
+        next[row_indices[n] + 1]++;
+
+        if (expand && row_indices[n] != column_indices[n])
+            next[column_indices[n] + 1]++;
+    }
+
+    for (size_t i = 0; i < num_rows; i++)
+        next[i + 1] += next[i];
+
+    for (size_t i = 0; i <= num_rows; i++)
+        csr.row_offsets[i] = next[i];
+
+    for (size_t n = 0; n < num_entries; n++)
+    {
+        IndexType i = row_indices[n];
+        IndexType j = column_indices[n];
+
+        csr.column_indices[next[i]] = j;
+        csr.values[next[i]]         = values[n];
+        next[i]++;
+
+        if (expand && i != j)
+        {
+            csr.column_indices[next[j]] = i;
+            csr.values[next[j]]         = mirror_value(values[n], skew, hermitian);
+            next[j]++;
+        }
+    }
+
+    // sort the entries of each row by column, duplicates keep file order
+#if defined(_OPENMP)
+    #pragma omp parallel for schedule(dynamic, 1024)
+#endif
+    for (long i = 0; i < long(num_rows); i++)
+    {
+        size_t row_start = csr.row_offsets[i];
+        size_t row_end   = csr.row_offsets[i + 1];
+
+        bool sorted = true;
+        for (size_t n = row_start + 1; n < row_end && sorted; n++)
+            sorted = csr.column_indices[n - 1] <= csr.column_indices[n];
+
+        if (sorted)
+            continue;
+
+        std::vector< std::pair<IndexType,ValueType> > row(row_end - row_start);
+
+        for (size_t n = row_start; n < row_end; n++)
+            row[n - row_start] = std::make_pair(csr.column_indices[n], csr.values[n]);
+
+        std::stable_sort(row.begin(), row.end(), column_less<IndexType,ValueType>());
+
+        for (size_t n = row_start; n < row_end; n++)
+        {
+            csr.column_indices[n] = row[n - row_start].first;
+            csr.values[n]         = row[n - row_start].second;
+        }
+    }
+}
+
+template <typename IndexType, typename ValueType>
+void read_coordinate_buffer(cusp::coo_matrix<IndexType,ValueType,cusp::host_memory>& coo,
+                            const char * begin,
+                            const char * end,
+                            const matrix_market_banner& banner)
+{
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> csr;
+
+    read_coordinate_buffer(csr, begin, end, banner);
+
+    coo.resize(csr.num_rows, csr.num_cols, csr.num_entries);
+    cusp::offsets_to_indices(csr.row_offsets, coo.row_indices);
+    coo.column_indices.swap(csr.column_indices);
+    coo.values.swap(csr.values);
+}
+
+template <typename Matrix>
+void read_coordinate_buffer(Matrix& mtx,
+                            const char * begin,
+                            const char * end,
+                            const matrix_market_banner& banner)
+{
+    typedef typename Matrix::index_type IndexType;
+    typedef typename Matrix::value_type ValueType;
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> temp;
+
+    read_coordinate_buffer(temp, begin, end, banner);
+
+    cusp::convert(temp, mtx);
+}
+
 template <typename ValueType, typename Stream>
 void read_array_stream(cusp::array2d<ValueType,cusp::host_memory>& mtx, Stream& input, const matrix_market_banner& banner)
 {
@@ -420,9 +834,168 @@ void read_array_stream(cusp::array2d<ValueType,cusp::host_memory>& mtx, Stream&
 
 
 
+/*
+ * Block formatter for MatrixMarket output
+ *
+ * Lines are formatted into preallocated per-block buffers, in parallel
+ * when OpenMP is enabled, and the buffers are written to the stream in
+ * order. Values are printed with the fewest significant digits that
+ * read back to the same number, or with a fixed number of digits in
+ * fast_precision mode.
+ */
+
+// upper bound on the length of a formatted line: two 20-digit indices
+// and two values of at most 24 characters plus separators
+const size_t max_formatted_line_length = 128;
+
+inline char * format_index(char * p, size_t value)
+{
+    char digits[20];
+    int num_digits = 0;
+
+    do
+    {
+        digits[num_digits++] = char('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    while (num_digits > 0)
+        *p++ = digits[--num_digits];
+
+    return p;
+}
+
+inline char * format_real(char * p, double value, matrix_market_precision precision)
+{
+    if (precision == fast_precision)
+        return p + std::sprintf(p, "%.9g", value);
+
+    // 15 significant digits always round-trip for values with a shorter
+    // representation since %g drops trailing zeros
+    for (int digits = 15; ; digits++)
+    {
+        int length = std::sprintf(p, "%.*g", digits, value);
+
+        if (digits == 17 || std::strtod(p, NULL) == value)
+            return p + length;
+    }
+}
+
+inline char * format_real(char * p, float value, matrix_market_precision precision)
+{
+    if (precision == fast_precision)
+        return p + std::sprintf(p, "%.9g", double(value));
+
+    for (int digits = 6; ; digits++)
+    {
+        int length = std::sprintf(p, "%.*g", digits, double(value));
+
+        if (digits == 9 || float(std::strtod(p, NULL)) == value)
+            return p + length;
+    }
+}
+
+template <typename ScalarType>
+char * format_value(char * p, const ScalarType& value, matrix_market_precision precision)
+{
+    return format_real(p, double(value), precision);
+}
+
+inline char * format_value(char * p, const float& value, matrix_market_precision precision)
+{
+    return format_real(p, value, precision);
+}
+
+template <typename ScalarType>
+char * format_value(char * p, const cusp::complex<ScalarType>& value, matrix_market_precision precision)
+{
+    p = format_value(p, value.real(), precision);
+    *p++ = ' ';
+    return format_value(p, value.imag(), precision);
+}
+
+template <typename MatrixType>
+struct coordinate_line_formatter
+{
+    const MatrixType& coo;
+    matrix_market_precision precision;
+
+    coordinate_line_formatter(const MatrixType& coo, matrix_market_precision precision)
+        : coo(coo), precision(precision) {}
+
+    char * operator()(char * p, size_t n) const
+    {
+        p = format_index(p, coo.row_indices[n] + 1);
+        *p++ = ' ';
+        p = format_index(p, coo.column_indices[n] + 1);
+        *p++ = ' ';
+        p = format_value(p, coo.values[n], precision);
+        *p++ = '\n';
+        return p;
+    }
+};
+
+template <typename ArrayType>
+struct array_line_formatter
+{
+    const ArrayType& values;
+    matrix_market_precision precision;
+
+    array_line_formatter(const ArrayType& values, matrix_market_precision precision)
+        : values(values), precision(precision) {}
+
+    char * operator()(char * p, size_t n) const
+    {
+        p = format_value(p, values[n], precision);
+        *p++ = '\n';
+        return p;
+    }
+};
+
+template <typename Stream, typename LineFormatter>
+void write_formatted_lines(Stream& output, size_t num_lines, const LineFormatter& format_line)
+{
+    if (num_lines == 0)
+        return;
+
+    // lines per block and blocks formatted before each write
+    const size_t block_size = 4096;
+    size_t num_blocks = std::min<size_t>(4 * cusp::system::omp::detail::max_threads(),
+                                         (num_lines + block_size - 1) / block_size);
+
+    std::vector< std::vector<char> > buffers(num_blocks, std::vector<char>(block_size * max_formatted_line_length));
+    std::vector<size_t> lengths(num_blocks);
+
+    for (size_t base = 0; base < num_lines; base += num_blocks * block_size)
+    {
+#if defined(_OPENMP)
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (int k = 0; k < int(num_blocks); k++)
+        {
+            size_t first = std::min(num_lines, base + k * block_size);
+            size_t last  = std::min(num_lines, first + block_size);
+
+            char * begin = &buffers[k][0];
+            char * p     = begin;
+
+            for (size_t n = first; n < last; n++)
+                p = format_line(p, n);
+
+            lengths[k] = p - begin;
+        }
+
+        for (size_t k = 0; k < num_blocks; k++)
+            output.write(&buffers[k][0], lengths[k]);
+    }
+}
+
 template <typename IndexType, typename ValueType, typename Stream>
-void write_coordinate_stream(const cusp::coo_matrix<IndexType,ValueType,cusp::host_memory>& coo, Stream& output)
+void write_coordinate_stream(const cusp::coo_matrix<IndexType,ValueType,cusp::host_memory>& coo, Stream& output,
+                             matrix_market_precision precision)
 {
+    typedef cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> MatrixType;
+
     bool is_complex = thrust::detail::is_same<ValueType, cusp::complex<typename cusp::norm_type<ValueType>::type> >::value;
 
     if (is_complex)
@@ -432,13 +1005,7 @@ void write_coordinate_stream(const cusp::coo_matrix<IndexType,ValueType,cusp::ho
 
     output << "\t" << coo.num_rows << "\t" << coo.num_cols << "\t" << coo.num_entries << "\n";
 
-    for(size_t i = 0; i < coo.num_entries; i++)
-    {
-        output << (coo.row_indices[i]    + 1) << " ";
-        output << (coo.column_indices[i] + 1) << " ";
-        cusp::io::detail::write_value(output, coo.values[i]);
-        output << "\n";
-    }
+    write_formatted_lines(output, coo.num_entries, coordinate_line_formatter<MatrixType>(coo, precision));
 }
 
 
@@ -480,8 +1047,41 @@ void read_matrix_market_stream(Matrix& mtx, Stream& input, cusp::array1d_format)
     cusp::convert(temp, mtx);
 }
 
+template <typename Matrix, typename Format>
+void read_matrix_market_buffer(Matrix& mtx, const std::vector<char>& buffer, Format)
+{
+    // general case
+    const char * begin = &buffer[0];
+    const char * end   = begin + buffer.size() - 1;
+    const char * body  = next_line(begin, end);
+
+    // read banner
+    matrix_market_banner banner;
+    std::istringstream banner_stream(std::string(begin, body));
+    read_matrix_market_banner(banner, banner_stream);
+
+    if (banner.storage == "coordinate")
+    {
+        read_coordinate_buffer(mtx, body, end, banner);
+    }
+    else // banner.storage == "array"
+    {
+        std::istringstream input(std::string(begin, end));
+        cusp::io::detail::read_matrix_market_stream(mtx, input, Format());
+    }
+}
+
+template <typename Matrix>
+void read_matrix_market_buffer(Matrix& mtx, const std::vector<char>& buffer, cusp::array1d_format)
+{
+    // array1d case
+    std::istringstream input(std::string(&buffer[0], buffer.size() - 1));
+    cusp::io::detail::read_matrix_market_stream(mtx, input, cusp::array1d_format());
+}
+
 template <typename Matrix, typename Stream>
-void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::sparse_format)
+void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::sparse_format,
+                                matrix_market_precision precision)
 {
     // general sparse case
     typedef typename Matrix::index_type IndexType;
@@ -489,13 +1089,15 @@ void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::sparse_
 
     cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> coo(mtx);
 
-    cusp::io::detail::write_coordinate_stream(coo, output);
+    cusp::io::detail::write_coordinate_stream(coo, output, precision);
 }
 
 template <typename Matrix, typename Stream>
-void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::array1d_format)
+void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::array1d_format,
+                                matrix_market_precision precision)
 {
     typedef typename Matrix::value_type ValueType;
+    typedef cusp::array1d<ValueType,cusp::host_memory> ArrayType;
 
     bool is_complex = thrust::detail::is_same<ValueType, cusp::complex<typename cusp::norm_type<ValueType>::type> >::value;
 
@@ -506,17 +1108,17 @@ void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::array1d
 
     output << "\t" << mtx.size() << "\t1\n";
 
-    for(size_t i = 0; i < mtx.size(); i++)
-    {
-        write_value(output, mtx[i]);
-        output << "\n";
-    }
+    ArrayType values(mtx);
+
+    write_formatted_lines(output, values.size(), array_line_formatter<ArrayType>(values, precision));
 }
 
 template <typename Matrix, typename Stream>
-void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::array2d_format)
+void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::array2d_format,
+                                matrix_market_precision precision)
 {
     typedef typename Matrix::value_type ValueType;
+    typedef cusp::array1d<ValueType,cusp::host_memory> ArrayType;
 
     bool is_complex = thrust::detail::is_same<ValueType, cusp::complex<typename cusp::norm_type<ValueType>::type> >::value;
 
@@ -527,14 +1129,10 @@ void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::array2d
 
     output << "\t" << mtx.num_rows << "\t" << mtx.num_cols << "\n";
 
-    for(size_t j = 0; j < mtx.num_cols; j++)
-    {
-        for(size_t i = 0; i < mtx.num_rows; i++)
-        {
-            write_value(output, mtx(i,j));
-            output << "\n";
-        }
-    }
+    // MatrixMarket arrays are stored in column-major order
+    cusp::array2d<ValueType,cusp::host_memory,cusp::column_major> dense(mtx);
+
+    write_formatted_lines(output, dense.values.size(), array_line_formatter<ArrayType>(dense.values, precision));
 }
 
 } // end namespace detail
@@ -543,23 +1141,25 @@ void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::array2d
 template <typename Matrix>
 void read_matrix_market_file(Matrix& mtx, const std::string& filename)
 {
-    std::ifstream file(filename.c_str());
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
 
     if (!file)
         throw cusp::io_exception(std::string("unable to open file \"") + filename + std::string("\" for reading"));
 
-#ifdef __APPLE__
-    // WAR OSX-specific issue using rdbuf
-    std::stringstream file_string (std::stringstream::in | std::stringstream::out);
-    std::vector<char> buffer(file.rdbuf()->pubseekoff(0, std::ios::end,std::ios::in));
+    // read the entire file with a single block read, the buffer
+    // is null-terminated so the parser never runs past its end
+    std::streamoff size = file.rdbuf()->pubseekoff(0, std::ios::end, std::ios::in);
     file.rdbuf()->pubseekpos(0, std::ios::in);
-    file.rdbuf()->sgetn(&buffer[0], buffer.size());
-    file_string.write(&buffer[0], buffer.size());
 
-    cusp::io::read_matrix_market_stream(mtx, file_string);
-#else
-    cusp::io::read_matrix_market_stream(mtx, file);
-#endif
+    if (size < 0)
+        throw cusp::io_exception(std::string("unable to determine size of file \"") + filename + std::string("\""));
+
+    std::vector<char> buffer(size_t(size) + 1, '\0');
+
+    if (size > 0 && file.rdbuf()->sgetn(&buffer[0], size) != size)
+        throw cusp::io_exception(std::string("unable to read file \"") + filename + std::string("\""));
+
+    cusp::io::detail::read_matrix_market_buffer(mtx, buffer, typename Matrix::format());
 }
 
 template <typename Matrix, typename Stream>
@@ -571,7 +1171,14 @@ void read_matrix_market_stream(Matrix& mtx, Stream& input)
 template <typename Matrix>
 void write_matrix_market_file(const Matrix& mtx, const std::string& filename)
 {
-    std::ofstream file(filename.c_str());
+    cusp::io::write_matrix_market_file(mtx, filename, exact_precision);
+}
+
+template <typename Matrix>
+void write_matrix_market_file(const Matrix& mtx, const std::string& filename,
+                              matrix_market_precision precision)
+{
+    std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
 
     if (!file)
         throw cusp::io_exception(std::string("unable to open file \"") + filename + std::string("\" for writing"));
@@ -580,18 +1187,25 @@ void write_matrix_market_file(const Matrix& mtx, const std::string& filename)
     // WAR OSX-specific issue using rdbuf
     std::stringstream file_string (std::stringstream::in | std::stringstream::out);
 
-    cusp::io::write_matrix_market_stream(mtx, file_string);
+    cusp::io::write_matrix_market_stream(mtx, file_string, precision);
 
     file.rdbuf()->sputn(file_string.str().c_str(), file_string.str().size());
 #else
-    cusp::io::write_matrix_market_stream(mtx, file);
+    cusp::io::write_matrix_market_stream(mtx, file, precision);
 #endif
 }
 
 template <typename Matrix, typename Stream>
 void write_matrix_market_stream(const Matrix& mtx, Stream& output)
 {
-    cusp::io::detail::write_matrix_market_stream(mtx, output, typename Matrix::format());
+    cusp::io::write_matrix_market_stream(mtx, output, exact_precision);
+}
+
+template <typename Matrix, typename Stream>
+void write_matrix_market_stream(const Matrix& mtx, Stream& output,
+                                matrix_market_precision precision)
+{
+    cusp::io::detail::write_matrix_market_stream(mtx, output, typename Matrix::format(), precision);
 }
 
 } //end namespace io
@@ -36,6 +36,23 @@ namespace io
  *  \{
  */
 
+/**
+ * \brief Formatting of values written to MatrixMarket files
+ *
+ * \par Overview
+ * \p exact_precision writes the shortest representation of each value
+ * that reads back to the identical floating point number.
+ * \p fast_precision writes every value with a fixed number of significant
+ * digits (enough to recover single precision values) and skips the
+ * round-trip check, trading accuracy of double precision values for
+ * speed and file size.
+ */
+enum matrix_market_precision
+{
+    exact_precision,
+    fast_precision
+};
+
 /**
  * \brief Read a MatrixMarket file
  *
@@ -139,6 +156,25 @@ void read_matrix_market_stream(Matrix& mtx, Stream& input);
 template <typename Matrix>
 void write_matrix_market_file(const Matrix& mtx, const std::string& filename);
 
+/**
+ * \brief Write a MatrixMarket file with the given value precision
+ *
+ * \tparam Matrix matrix container
+ *
+ * \param mtx a matrix container (e.g. \p csr_matrix or \p coo_matrix)
+ * \param filename file name of the MatrixMarket file
+ * \param precision \p exact_precision or \p fast_precision
+ *
+ * \par Overview
+ * Entries are formatted in blocks, in parallel when OpenMP is enabled,
+ * and the blocks are written to the file in order.
+ *
+ * \see \p matrix_market_precision
+ */
+template <typename Matrix>
+void write_matrix_market_file(const Matrix& mtx, const std::string& filename,
+                              matrix_market_precision precision);
+
 /**
  * \brief Write MatrixMarket data to a stream.
  *
@@ -174,6 +210,22 @@ void write_matrix_market_file(const Matrix& mtx, const std::string& filename);
 template <typename Matrix, typename Stream>
 void write_matrix_market_stream(const Matrix& mtx, Stream& output);
 
+/**
+ * \brief Write MatrixMarket data to a stream with the given value precision
+ *
+ * \tparam Matrix matrix container
+ * \tparam Stream stream type
+ *
+ * \param mtx a matrix container (e.g. \p csr_matrix or \p coo_matrix)
+ * \param output stream to which the MatrixMarket contents will be written
+ * \param precision \p exact_precision or \p fast_precision
+ *
+ * \see \p matrix_market_precision
+ */
+template <typename Matrix, typename Stream>
+void write_matrix_market_stream(const Matrix& mtx, Stream& output,
+                                matrix_market_precision precision);
+
 /*! \}
  */
 
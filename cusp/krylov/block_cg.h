@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file block_cg.h
+ *  \brief Block Conjugate Gradient method for multiple right-hand sides
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <thrust/execution_policy.h>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/* \cond */
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d>
+void block_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              LinearOperator& A,
+              Array2d& X,
+              Array2d& B);
+
+/*! \p block_cg : Block Conjugate Gradient method
+ *
+ * Solves the symmetric, positive-definite linear systems A X = B
+ * using the default convergence criteria.
+ */
+template <class LinearOperator,
+          class Array2d>
+void block_cg(LinearOperator& A,
+              Array2d& X,
+              Array2d& B);
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor>
+void block_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              LinearOperator& A,
+              Array2d& X,
+              Array2d& B,
+              Monitor& monitor);
+
+/*! \p block_cg : Block Conjugate Gradient method
+ *
+ * Solves the symmetric, positive-definite linear systems A X = B without preconditioning.
+ */
+template <class LinearOperator,
+          class Array2d,
+          class Monitor>
+void block_cg(LinearOperator& A,
+              Array2d& X,
+              Array2d& B,
+              Monitor& monitor);
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor,
+          class Preconditioner>
+void block_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              LinearOperator& A,
+              Array2d& X,
+              Array2d& B,
+              Monitor& monitor,
+              Preconditioner& M);
+/* \endcond */
+
+/**
+ * \brief Block Conjugate Gradient method
+ *
+ * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam Array2d dense block of vectors
+ * \tparam Monitor is a \p block_monitor
+ * \tparam Preconditioner is a matrix or subclass of \p linear_operator
+ *
+ * \param A matrix of the linear systems
+ * \param X approximate solutions of the linear systems, one per column
+ * \param B right-hand sides of the linear systems, one per column
+ * \param monitor monitors iteration and determines stopping conditions
+ * \param M preconditioner for A
+ *
+ * \par Overview
+ * Solves the symmetric, positive-definite linear systems A X = B
+ * with preconditioner \p M using the block variant of CG due to
+ * O'Leary. All columns share one block Krylov space, so every iteration
+ * applies \p A once to a block of vectors through \p cusp::multiply
+ * instead of once per right-hand side, and information gained from one
+ * right-hand side accelerates the others. The small dense systems that
+ * determine the step sizes are solved with \p cusp::lapack, which makes
+ * this solver depend on an external LAPACK implementation.
+ *
+ * Columns reported as converged by the \p monitor are deflated from the
+ * active block, which shrinks the cost of every following iteration.
+ *
+ * \note \p A and \p M must be symmetric and positive-definite.
+ * \note The residuals of the active columns must remain linearly
+ * independent, otherwise the small Cholesky factorizations fail.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to use \p block_cg to
+ *  solve a 10x10 Poisson problem with 8 right-hand sides.
+ *
+ *  \code
+ *  #include <cusp/array2d.h>
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/block_monitor.h>
+ *  #include <cusp/krylov/block_cg.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      // create an empty sparse matrix structure (CSR format)
+ *      cusp::csr_matrix<int, float, cusp::device_memory> A;
+ *
+ *      // initialize matrix
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      // allocate storage for solutions (X) and right hand sides (B)
+ *      cusp::array2d<float, cusp::device_memory, cusp::column_major> X(A.num_rows, 8, 0);
+ *      cusp::array2d<float, cusp::device_memory, cusp::column_major> B(A.num_rows, 8, 1);
+ *
+ *      // set stopping criteria of every column:
+ *      //  iteration_limit    = 100
+ *      //  relative_tolerance = 1e-6
+ *      //  absolute_tolerance = 0
+ *      //  verbose            = true
+ *      cusp::block_monitor<float> monitor(B, 100, 1e-6, 0, true);
+ *
+ *      // set preconditioner (identity)
+ *      cusp::identity_operator<float, cusp::device_memory> M(A.num_rows, A.num_rows);
+ *
+ *      // solve the linear systems A X = B
+ *      cusp::krylov::block_cg(A, X, B, monitor, M);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p cg
+ *  \see \p block_monitor
+ *
+ */
+template <class LinearOperator,
+          class Array2d,
+          class Monitor,
+          class Preconditioner>
+void block_cg(LinearOperator& A,
+              Array2d& X,
+              Array2d& B,
+              Monitor& monitor,
+              Preconditioner& M);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/block_cg.inl>
@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file block_gmres.h
+ *  \brief Block Generalized Minimum Residual (GMRES) method for multiple right-hand sides
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <thrust/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/* \cond */
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d>
+void block_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart);
+
+/*! \p block_gmres : Block GMRES method
+ *
+ * Solves the nonsymmetric linear systems A X = B
+ * using the default convergence criteria.
+ */
+template <class LinearOperator,
+          class Array2d>
+void block_gmres(LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart);
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor>
+void block_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart,
+                 Monitor& monitor);
+
+/*! \p block_gmres : Block GMRES method
+ *
+ * Solves the nonsymmetric linear systems A X = B without preconditioning.
+ */
+template <class LinearOperator,
+          class Array2d,
+          class Monitor>
+void block_gmres(LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart,
+                 Monitor& monitor);
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor,
+          class Preconditioner>
+void block_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart,
+                 Monitor& monitor,
+                 Preconditioner& M);
+/* \endcond */
+
+/**
+ * \brief Block GMRES method
+ *
+ * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam Array2d dense block of vectors
+ * \tparam Monitor is a \p block_monitor
+ * \tparam Preconditioner is a matrix or subclass of \p linear_operator
+ *
+ * \param A matrix of the linear systems
+ * \param X approximate solutions of the linear systems, one per column
+ * \param B right-hand sides of the linear systems, one per column
+ * \param restart the method every restart inner block iterations
+ * \param monitor monitors iteration and determines stopping conditions
+ * \param M preconditioner for A
+ *
+ * \par Overview
+ * Solves the nonsymmetric linear systems A X = B with preconditioner
+ * \p M by minimizing the residual of every column over a common block
+ * Krylov space. Every inner iteration applies \p A and \p M once to a
+ * block of vectors through \p cusp::multiply. The block Hessenberg
+ * matrix is reduced by Givens rotations, which yields the residual norm
+ * of every column without forming the residuals, and the triangular
+ * system of each cycle is solved with \p cusp::lapack, which makes this
+ * solver depend on an external LAPACK implementation.
+ *
+ * Columns reported as converged by the \p monitor are deflated from the
+ * active block at the next restart.
+ *
+ * \note The residuals of the active columns must remain linearly
+ * independent, otherwise the block Arnoldi process breaks down.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to use \p block_gmres to
+ *  solve a 10x10 Poisson problem with 8 right-hand sides.
+ *
+ *  \code
+ *  #include <cusp/array2d.h>
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/block_monitor.h>
+ *  #include <cusp/krylov/block_gmres.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      // create an empty sparse matrix structure (CSR format)
+ *      cusp::csr_matrix<int, float, cusp::device_memory> A;
+ *
+ *      // initialize matrix
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      // allocate storage for solutions (X) and right hand sides (B)
+ *      cusp::array2d<float, cusp::device_memory, cusp::column_major> X(A.num_rows, 8, 0);
+ *      cusp::array2d<float, cusp::device_memory, cusp::column_major> B(A.num_rows, 8, 1);
+ *
+ *      // set stopping criteria of every column:
+ *      //  iteration_limit    = 100
+ *      //  relative_tolerance = 1e-6
+ *      //  absolute_tolerance = 0
+ *      //  verbose            = true
+ *      cusp::block_monitor<float> monitor(B, 100, 1e-6, 0, true);
+ *
+ *      // set preconditioner (identity)
+ *      cusp::identity_operator<float, cusp::device_memory> M(A.num_rows, A.num_rows);
+ *
+ *      // solve the linear systems A X = B with 10 block iterations per cycle
+ *      cusp::krylov::block_gmres(A, X, B, 10, monitor, M);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p gmres
+ *  \see \p block_monitor
+ *
+ */
+template <class LinearOperator,
+          class Array2d,
+          class Monitor,
+          class Preconditioner>
+void block_gmres(LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart,
+                 Monitor& monitor,
+                 Preconditioner& M);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/block_gmres.inl>
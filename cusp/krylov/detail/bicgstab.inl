@@ -16,6 +16,7 @@
 
 
 #include <cusp/array1d.h>
+#include <cusp/array2d.h>
 #include <cusp/multiply.h>
 #include <cusp/monitor.h>
 #include <cusp/linear_operator.h>
@@ -55,15 +56,24 @@ void bicgstab(thrust::execution_policy<DerivedPolicy> &exec,
 
     const size_t N = A.num_rows;
 
+    typedef typename cusp::detail::temporary_array<ValueType, DerivedPolicy>::view ArrayView;
+
     // allocate workspace
     cusp::detail::temporary_array<ValueType, DerivedPolicy>   p(exec, N);
-    cusp::detail::temporary_array<ValueType, DerivedPolicy>   r(exec, N);
     cusp::detail::temporary_array<ValueType, DerivedPolicy> r_star(exec, N);
-    cusp::detail::temporary_array<ValueType, DerivedPolicy>   s(exec, N);
     cusp::detail::temporary_array<ValueType, DerivedPolicy>  Mp(exec, N);
     cusp::detail::temporary_array<ValueType, DerivedPolicy> AMp(exec, N);
     cusp::detail::temporary_array<ValueType, DerivedPolicy>  Ms(exec, N);
-    cusp::detail::temporary_array<ValueType, DerivedPolicy> AMs(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> dots(exec, 2);
+
+    // r and AMs are the columns of W so that both inner products
+    // needed for omega are computed in a single reduction. s_j is
+    // formed in place of r_j, which is not needed afterwards.
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> W_values(exec, 2 * N);
+    cusp::array2d_view<ArrayView, cusp::column_major> W(N, 2, N, ArrayView(W_values.begin(), W_values.end()));
+
+    ArrayView   r(W_values.begin(),     W_values.begin() + N);
+    ArrayView AMs(W_values.begin() + N, W_values.end());
 
     // r <- Ax
     cusp::multiply(exec, A, x, r);
@@ -72,7 +82,7 @@ void bicgstab(thrust::execution_policy<DerivedPolicy> &exec,
     blas::axpby(exec, b, r, r, ValueType(1), ValueType(-1));
 
     // p <- r
-    blas::copy(r, p);
+    blas::copy(exec, r, p);
 
     // r_star <- r
     blas::copy(exec, r, r_star);
@@ -90,32 +100,32 @@ void bicgstab(thrust::execution_policy<DerivedPolicy> &exec,
         // alpha = (r_j, r_star) / (A*M*p, r_star)
         ValueType alpha = r_r_star_old / blas::dotc(exec, r_star, AMp);
 
-        // s_j = r_j - alpha * AMp
-        blas::axpby(exec, r, AMp, s, ValueType(1), ValueType(-alpha));
+        // s_j = r_j - alpha * AMp, stored in r
+        blas::axpy(exec, AMp, r, ValueType(-alpha));
 
-        if (monitor.finished(s)) {
+        if (monitor.finished(r)) {
             // x += alpha*M*p_j
             blas::axpby(exec, x, Mp, x, ValueType(1), ValueType(alpha));
             break;
         }
 
         // Ms = M*s_j
-        cusp::multiply(exec, M, s, Ms);
+        cusp::multiply(exec, M, r, Ms);
 
         // AMs = A*Ms
         cusp::multiply(exec, A, Ms, AMs);
 
         // omega = (AMs, s) / (AMs, AMs)
-        ValueType omega = blas::dotc(exec, AMs, s) / blas::dotc(exec, AMs, AMs);
+        blas::mdotc(exec, AMs, W, dots);
+        ValueType omega = ValueType(dots[0]) / ValueType(dots[1]);
 
         // x_{j+1} = x_j + alpha*M*p_j + omega*M*s_j
         blas::axpbypcz(exec, x, Mp, Ms, x, ValueType(1), alpha, omega);
 
-        // r_{j+1} = s_j - omega*A*M*s
-        blas::axpby(exec, s, AMs, r, ValueType(1), -omega);
+        // r_{j+1} = s_j - omega*A*M*s and (r_{j+1}, r_star) in a single pass
+        ValueType r_r_star_new = blas::axpy_dotc(exec, AMs, r, r_star, -omega);
 
         // beta_j = (r_{j+1}, r_star) / (r_j, r_star) * (alpha/omega)
-        ValueType r_r_star_new = blas::dotc(exec, r_star, r);
         ValueType beta = (r_r_star_new / r_r_star_old) * (alpha / omega);
         r_r_star_old = r_r_star_new;
 
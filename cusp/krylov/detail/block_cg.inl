@@ -0,0 +1,368 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/block_monitor.h>
+#include <cusp/complex.h>
+#include <cusp/linear_operator.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/lapack/lapack.h>
+
+#include <cusp/krylov/detail/block_utils.h>
+
+#include <thrust/sequence.h>
+
+/*
+ * Block preconditioned conjugate gradient method
+ *
+ * All columns of X are advanced in a common block Krylov space. With
+ * Gamma = Z^H R the recurrences are
+ *     Alpha = (P^H A P)^{-1} Gamma
+ *     X     = X + P Alpha
+ *     R     = R - A P Alpha
+ *     Beta  = Gamma_old^{-1} Gamma
+ *     P     = Z + P Beta
+ * where both small Hermitian systems are solved by Cholesky factorization.
+ * Converged columns are dropped from X and R. On the next iteration the
+ * new directions are made A-conjugate to the previous block explicitly,
+ * Beta = -(P^H A P)^{-1} (A P)^H Z, since Gamma_old no longer matches.
+ *
+ * The method is described in:
+ *     The block conjugate gradient algorithm and related methods
+ *     D. P. O'Leary, Linear Algebra and its Applications 29 (1980)
+ */
+
+namespace cusp
+{
+namespace krylov
+{
+namespace block_cg_detail
+{
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor,
+          class Preconditioner>
+void block_cg(thrust::execution_policy<DerivedPolicy> &exec,
+              LinearOperator& A,
+              Array2d& X,
+              Array2d& B,
+              Monitor& monitor,
+              Preconditioner& M)
+{
+    typedef typename LinearOperator::value_type                                     ValueType;
+    typedef typename cusp::minimum_space<
+            typename LinearOperator::memory_space, typename Array2d::memory_space,
+            typename Preconditioner::memory_space>::type                            MemorySpace;
+    typedef cusp::array2d<ValueType, MemorySpace, cusp::column_major>               Block;
+    typedef cusp::array2d<ValueType, cusp::host_memory, cusp::column_major>         HostBlock;
+    typedef typename Block::column_view                                             BlockColumn;
+    typedef typename Array2d::column_view                                           Column;
+
+    assert(A.num_rows == A.num_cols);        // sanity check
+
+    const size_t N = A.num_rows;
+    const size_t S = B.num_cols;
+
+    // workspace holding the active columns only
+    Block X_(N, S);
+    Block R(N, S);
+    Block Z(N, S);
+    Block P;
+    Block Q(N, S);
+    Block T;
+
+    // small block coefficients
+    HostBlock gamma;
+    HostBlock gamma_factor;
+    HostBlock delta;
+    HostBlock alpha;
+    HostBlock beta;
+
+    // column of X for every active column
+    cusp::array1d<size_t, cusp::host_memory> columns(S);
+    thrust::sequence(columns.begin(), columns.end());
+
+    for (size_t j = 0; j < S; j++)
+    {
+        BlockColumn x_j(X_.column(j));
+        cusp::blas::copy(exec, X.column(j), x_j);
+    }
+
+    // R <- B - A*X
+    cusp::multiply(exec, A, X_, Q);
+
+    for (size_t j = 0; j < S; j++)
+    {
+        BlockColumn r_j(R.column(j));
+        cusp::blas::axpby(exec, B.column(j), Q.column(j), r_j, ValueType(1), ValueType(-1));
+    }
+
+    bool first_iteration = true;
+
+    while (!monitor.finished(R, columns))
+    {
+        // deflate the columns that have converged
+        size_t k = 0;
+
+        for (size_t a = 0; a < columns.size(); a++)
+        {
+            if (monitor.converged(columns[a]))
+            {
+                Column x(X.column(columns[a]));
+                cusp::blas::copy(exec, X_.column(a), x);
+            }
+            else
+            {
+                if (k != a)
+                {
+                    BlockColumn x_k(X_.column(k));
+                    BlockColumn r_k(R.column(k));
+                    cusp::blas::copy(exec, X_.column(a), x_k);
+                    cusp::blas::copy(exec, R.column(a), r_k);
+                    columns[k] = columns[a];
+                }
+
+                k++;
+            }
+        }
+
+        bool deflated = k < columns.size();
+
+        if (deflated)
+        {
+            columns.resize(k);
+            X_.resize(N, k);
+            R.resize(N, k);
+            Z.resize(N, k);
+        }
+
+        // Z <- M*R
+        cusp::multiply(exec, M, R, Z);
+
+        // gamma <- Z^H R
+        cusp::krylov::block_detail::block_dotc(exec, Z, R, gamma);
+
+        if (first_iteration)
+        {
+            // P <- Z
+            P = Z;
+            first_iteration = false;
+        }
+        else
+        {
+            if (deflated)
+            {
+                // the block size changed, make the new directions
+                // A-conjugate to P explicitly
+                // beta <- -(P^H Q)^{-1} Q^H Z
+                cusp::krylov::block_detail::block_dotc(exec, Q, Z, beta);
+                cusp::lapack::potrs(delta, beta);
+                cusp::blas::scal(beta.values, ValueType(-1));
+            }
+            else
+            {
+                // beta <- gamma_old^{-1} gamma
+                beta = gamma;
+                cusp::lapack::potrs(gamma_factor, beta);
+            }
+
+            // P <- Z + P*beta
+            T = Z;
+            cusp::krylov::block_detail::block_axpy(exec, P, 0, beta, T);
+            P.swap(T);
+        }
+
+        // Q <- A*P
+        Q.resize(N, P.num_cols);
+        cusp::multiply(exec, A, P, Q);
+
+        // alpha <- (P^H Q)^{-1} gamma, as P^H R = Z^H R
+        cusp::krylov::block_detail::block_dotc(exec, P, Q, delta);
+        cusp::lapack::potrf(delta);
+
+        alpha = gamma;
+        cusp::lapack::potrs(delta, alpha);
+
+        // X <- X + P*alpha
+        cusp::krylov::block_detail::block_axpy(exec, P, 0, alpha, X_);
+
+        // R <- R - Q*alpha
+        cusp::blas::scal(alpha.values, ValueType(-1));
+        cusp::krylov::block_detail::block_axpy(exec, Q, 0, alpha, R);
+
+        // keep the factorization of gamma for the next beta
+        gamma_factor = gamma;
+        cusp::lapack::potrf(gamma_factor);
+
+        ++monitor;
+    }
+
+    // write back the columns that are still active
+    for (size_t a = 0; a < columns.size(); a++)
+    {
+        Column x(X.column(columns[a]));
+        cusp::blas::copy(exec, X_.column(a), x);
+    }
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor>
+void block_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              LinearOperator& A,
+              Array2d& X,
+              Array2d& B,
+              Monitor& monitor)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    cusp::krylov::block_cg_detail::block_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, X, B, monitor, M);
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d>
+void block_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              LinearOperator& A,
+              Array2d& X,
+              Array2d& B)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+
+    cusp::block_monitor<ValueType> monitor(B);
+
+    cusp::krylov::block_cg_detail::block_cg(exec, A, X, B, monitor);
+}
+
+} // end block_cg_detail namespace
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d>
+void block_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              LinearOperator& A,
+              Array2d& X,
+              Array2d& B)
+{
+    using cusp::krylov::block_cg_detail::block_cg;
+
+    block_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+             A, X, B);
+}
+
+template <class LinearOperator,
+          class Array2d>
+void block_cg(LinearOperator& A,
+              Array2d& X,
+              Array2d& B)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Array2d::memory_space        System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::krylov::block_cg(select_system(system1,system2), A, X, B);
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor>
+void block_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              LinearOperator& A,
+              Array2d& X,
+              Array2d& B,
+              Monitor& monitor)
+{
+    using cusp::krylov::block_cg_detail::block_cg;
+
+    block_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+             A, X, B, monitor);
+}
+
+template <class LinearOperator,
+          class Array2d,
+          class Monitor>
+void block_cg(LinearOperator& A,
+              Array2d& X,
+              Array2d& B,
+              Monitor& monitor)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Array2d::memory_space        System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::krylov::block_cg(select_system(system1,system2), A, X, B, monitor);
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor,
+          class Preconditioner>
+void block_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              LinearOperator& A,
+              Array2d& X,
+              Array2d& B,
+              Monitor& monitor,
+              Preconditioner& M)
+{
+    using cusp::krylov::block_cg_detail::block_cg;
+
+    block_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+             A, X, B, monitor, M);
+}
+
+template <class LinearOperator,
+          class Array2d,
+          class Monitor,
+          class Preconditioner>
+void block_cg(LinearOperator& A,
+              Array2d& X,
+              Array2d& B,
+              Monitor& monitor,
+              Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Array2d::memory_space        System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::krylov::block_cg(select_system(system1,system2), A, X, B, monitor, M);
+}
+
+} // end namespace krylov
+} // end namespace cusp
+
@@ -0,0 +1,442 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/block_monitor.h>
+#include <cusp/complex.h>
+#include <cusp/linear_operator.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/lapack/lapack.h>
+#include <cusp/krylov/gmres.h>
+
+#include <cusp/krylov/detail/block_utils.h>
+
+#include <thrust/sequence.h>
+
+/*
+ * Block preconditioned GMRES method
+ *
+ * Every cycle builds an orthonormal basis V = [V_0, ..., V_m] of the block
+ * Krylov space generated by the preconditioned residual block W = V_0 S_0
+ * with the block Arnoldi process. The block Hessenberg matrix has k
+ * subdiagonals for k active columns and is reduced to triangular form by
+ * k Givens rotations per column, which are applied to [S_0; 0] as well.
+ * The trailing k-by-k block of the rotated right-hand side then holds the
+ * residuals of the least squares problems, one column per right-hand side.
+ *
+ * The method is described in:
+ *     Iterative Methods for Sparse Linear Systems, 2nd edition, Section 6.12
+ *     Y. Saad, SIAM (2003)
+ */
+
+namespace cusp
+{
+namespace krylov
+{
+namespace block_gmres_detail
+{
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor,
+          class Preconditioner>
+void block_gmres(thrust::execution_policy<DerivedPolicy> &exec,
+                 LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart,
+                 Monitor& monitor,
+                 Preconditioner& M)
+{
+    typedef typename LinearOperator::value_type                                     ValueType;
+    typedef typename cusp::minimum_space<
+            typename LinearOperator::memory_space, typename Array2d::memory_space,
+            typename Preconditioner::memory_space>::type                            MemorySpace;
+    typedef cusp::array2d<ValueType, MemorySpace, cusp::column_major>               Block;
+    typedef cusp::array2d<ValueType, cusp::host_memory, cusp::column_major>         HostBlock;
+    typedef cusp::array2d_view<typename Block::values_array_type::view,
+                               cusp::column_major>                                  BlockView;
+    typedef typename Block::column_view                                             BlockColumn;
+    typedef typename Array2d::column_view                                           Column;
+
+    using cusp::krylov::gmres_detail::ApplyPlaneRotation;
+    using cusp::krylov::gmres_detail::GeneratePlaneRotation;
+
+    assert(A.num_rows == A.num_cols);        // sanity check
+
+    const size_t N = A.num_rows;
+    const size_t S = B.num_cols;
+    const size_t m = restart;
+
+    // workspace holding the active columns only
+    Block X_(N, S);
+    Block B_(N, S);
+    Block T(N, S);
+    Block V;
+
+    // block Hessenberg matrix, rotated right-hand side and rotations
+    HostBlock H;
+    HostBlock G;
+    HostBlock G_tail;
+    HostBlock Y;
+    cusp::array1d<ValueType, cusp::host_memory> cs;
+    cusp::array1d<ValueType, cusp::host_memory> sn;
+
+    // column of X for every active column
+    cusp::array1d<size_t, cusp::host_memory> columns(S);
+    thrust::sequence(columns.begin(), columns.end());
+
+    for (size_t j = 0; j < S; j++)
+    {
+        BlockColumn x_j(X_.column(j));
+        BlockColumn b_j(B_.column(j));
+        cusp::blas::copy(exec, X.column(j), x_j);
+        cusp::blas::copy(exec, B.column(j), b_j);
+    }
+
+    while (true)
+    {
+        const size_t k = columns.size();
+
+        V.resize(N, (m + 1) * k);
+
+        H.resize((m + 1) * k, m * k);
+        G.resize((m + 1) * k, k);
+        G_tail.resize(k, k);
+        cs.resize(m * k * k);
+        sn.resize(m * k * k);
+
+        cusp::blas::fill(H.values, ValueType(0));
+        cusp::blas::fill(G.values, ValueType(0));
+
+        // V_0 <- M*(B - A*X)
+        BlockView V_0(N, k, N, cusp::make_array1d_view(V.values.begin(), V.values.begin() + N * k));
+
+        cusp::multiply(exec, A, X_, T);
+        cusp::blas::axpby(exec, B_.values, T.values, T.values, ValueType(1), ValueType(-1));
+        cusp::multiply(exec, M, T, V_0);
+
+        // V_0 S_0 <- V_0 by modified Gram-Schmidt
+        for (size_t c = 0; c < k; c++)
+        {
+            BlockColumn w(V.column(c));
+
+            for (size_t a = 0; a < c; a++)
+            {
+                G(a, c) = cusp::blas::dotc(exec, V.column(a), w);
+                cusp::blas::axpy(exec, V.column(a), w, -G(a, c));
+            }
+
+            G(c, c) = cusp::blas::nrm2(exec, w);
+
+            if (G(c, c) != ValueType(0))
+                cusp::blas::scal(exec, w, ValueType(1) / G(c, c));
+        }
+
+        // the column norms of S_0 are the residual norms
+        for (size_t a = 0; a < k; a++)
+            for (size_t c = 0; c < k; c++)
+                G_tail(a, c) = G(a, c);
+
+        if (monitor.finished(G_tail, columns))
+            break;
+
+        // deflate the columns that have converged and restart on the others
+        size_t active = 0;
+
+        for (size_t a = 0; a < k; a++)
+        {
+            if (monitor.converged(columns[a]))
+            {
+                Column x(X.column(columns[a]));
+                cusp::blas::copy(exec, X_.column(a), x);
+            }
+            else
+            {
+                if (active != a)
+                {
+                    BlockColumn x_active(X_.column(active));
+                    BlockColumn b_active(B_.column(active));
+                    cusp::blas::copy(exec, X_.column(a), x_active);
+                    cusp::blas::copy(exec, B_.column(a), b_active);
+                    columns[active] = columns[a];
+                }
+
+                active++;
+            }
+        }
+
+        if (active < k)
+        {
+            columns.resize(active);
+            X_.resize(N, active);
+            B_.resize(N, active);
+            T.resize(N, active);
+            continue;
+        }
+
+        size_t j = 0;
+
+        while (j < m)
+        {
+            ++monitor;
+
+            // V_{j+1} <- M*A*V_j
+            BlockView V_j(N, k, N, cusp::make_array1d_view(V.values.begin() + j * k * N,
+                                                           V.values.begin() + (j + 1) * k * N));
+            BlockView V_next(N, k, N, cusp::make_array1d_view(V.values.begin() + (j + 1) * k * N,
+                                                              V.values.begin() + (j + 2) * k * N));
+
+            cusp::multiply(exec, A, V_j, T);
+            cusp::multiply(exec, M, T, V_next);
+
+            // orthonormalize V_{j+1} against all previous basis vectors
+            for (size_t c = 0; c < k; c++)
+            {
+                const size_t q_next = (j + 1) * k + c;
+                const size_t q_col  = j * k + c;
+
+                BlockColumn w(V.column(q_next));
+
+                for (size_t q = 0; q < q_next; q++)
+                {
+                    H(q, q_col) = cusp::blas::dotc(exec, V.column(q), w);
+                    cusp::blas::axpy(exec, V.column(q), w, -H(q, q_col));
+                }
+
+                H(q_next, q_col) = cusp::blas::nrm2(exec, w);
+
+                if (H(q_next, q_col) != ValueType(0))
+                    cusp::blas::scal(exec, w, ValueType(1) / H(q_next, q_col));
+            }
+
+            // reduce the new block column to upper triangular form
+            for (size_t c = 0; c < k; c++)
+            {
+                const size_t q = j * k + c;
+
+                // apply the rotations of the previous columns
+                for (size_t p = 0; p < q; p++)
+                    for (size_t t = 0; t < k; t++)
+                        ApplyPlaneRotation(H(p + k - t - 1, q), H(p + k - t, q), cs[p * k + t], sn[p * k + t]);
+
+                // eliminate the k subdiagonal entries from the bottom up
+                for (size_t t = 0; t < k; t++)
+                {
+                    const size_t r = q + k - t;
+
+                    GeneratePlaneRotation(H(r - 1, q), H(r, q), cs[q * k + t], sn[q * k + t]);
+                    ApplyPlaneRotation(H(r - 1, q), H(r, q), cs[q * k + t], sn[q * k + t]);
+
+                    for (size_t a = 0; a < k; a++)
+                        ApplyPlaneRotation(G(r - 1, a), G(r, a), cs[q * k + t], sn[q * k + t]);
+                }
+            }
+
+            j++;
+
+            // residual norms of the least squares problems
+            for (size_t a = 0; a < k; a++)
+                for (size_t c = 0; c < k; c++)
+                    G_tail(a, c) = G(j * k + a, c);
+
+            if (monitor.finished(G_tail, columns))
+                break;
+        }
+
+        // Y <- R^{-1} G for the triangular part R of the rotated H
+        const size_t n = j * k;
+
+        HostBlock R(n, n);
+        Y.resize(n, k);
+
+        for (size_t c = 0; c < n; c++)
+            for (size_t a = 0; a < n; a++)
+                R(a, c) = H(a, c);
+
+        for (size_t c = 0; c < k; c++)
+            for (size_t a = 0; a < n; a++)
+                Y(a, c) = G(a, c);
+
+        cusp::lapack::trtrs(R, Y);
+
+        // X <- X + V*Y
+        cusp::krylov::block_detail::block_axpy(exec, V, 0, Y, X_);
+    }
+
+    // write back the columns that are still active
+    for (size_t a = 0; a < columns.size(); a++)
+    {
+        Column x(X.column(columns[a]));
+        cusp::blas::copy(exec, X_.column(a), x);
+    }
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor>
+void block_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart,
+                 Monitor& monitor)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    cusp::krylov::block_gmres_detail::block_gmres(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, X, B, restart, monitor, M);
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d>
+void block_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+
+    cusp::block_monitor<ValueType> monitor(B);
+
+    cusp::krylov::block_gmres_detail::block_gmres(exec, A, X, B, restart, monitor);
+}
+
+} // end block_gmres_detail namespace
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d>
+void block_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart)
+{
+    using cusp::krylov::block_gmres_detail::block_gmres;
+
+    block_gmres(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                A, X, B, restart);
+}
+
+template <class LinearOperator,
+          class Array2d>
+void block_gmres(LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Array2d::memory_space        System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::krylov::block_gmres(select_system(system1,system2), A, X, B, restart);
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor>
+void block_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart,
+                 Monitor& monitor)
+{
+    using cusp::krylov::block_gmres_detail::block_gmres;
+
+    block_gmres(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                A, X, B, restart, monitor);
+}
+
+template <class LinearOperator,
+          class Array2d,
+          class Monitor>
+void block_gmres(LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart,
+                 Monitor& monitor)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Array2d::memory_space        System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::krylov::block_gmres(select_system(system1,system2), A, X, B, restart, monitor);
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Array2d,
+          class Monitor,
+          class Preconditioner>
+void block_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart,
+                 Monitor& monitor,
+                 Preconditioner& M)
+{
+    using cusp::krylov::block_gmres_detail::block_gmres;
+
+    block_gmres(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                A, X, B, restart, monitor, M);
+}
+
+template <class LinearOperator,
+          class Array2d,
+          class Monitor,
+          class Preconditioner>
+void block_gmres(LinearOperator& A,
+                 Array2d& X,
+                 Array2d& B,
+                 const size_t restart,
+                 Monitor& monitor,
+                 Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Array2d::memory_space        System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::krylov::block_gmres(select_system(system1,system2), A, X, B, restart, monitor, M);
+}
+
+} // end namespace krylov
+} // end namespace cusp
+
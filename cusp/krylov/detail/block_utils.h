@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+
+#include <cusp/blas/blas.h>
+
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+// Dense kernels shared by the block Krylov solvers. All blocks are
+// column-major; the small coefficient matrices live in host memory.
+
+namespace cusp
+{
+namespace krylov
+{
+namespace block_detail
+{
+
+// Y(i,:) += X(i,:) * C for one row i of the tall blocks X and Y
+template <typename ValueType>
+struct BLOCK_AXPY
+{
+    const ValueType* X;
+    const ValueType* C;
+    ValueType* Y;
+    const int ldx;
+    const int ldc;
+    const int ldy;
+    const int k;
+    const int m;
+
+    BLOCK_AXPY(const ValueType* _X, const int _ldx,
+               const ValueType* _C, const int _ldc,
+               ValueType* _Y, const int _ldy,
+               const int _k, const int _m)
+        : X(_X), C(_C), Y(_Y), ldx(_ldx), ldc(_ldc), ldy(_ldy), k(_k), m(_m) {}
+
+    __host__ __device__
+    void operator()(const int i) const
+    {
+        for(int j = 0; j < m; j++)
+        {
+            ValueType sum(0);
+
+            for(int l = 0; l < k; l++)
+                sum += X[i + l * ldx] * C[l + j * ldc];
+
+            Y[i + j * ldy] += sum;
+        }
+    }
+};
+
+// Y += X(:, offset : offset + C.num_rows) * C
+template <typename DerivedPolicy, typename Array2d1, typename Array2d2, typename Array2d3>
+void block_axpy(thrust::execution_policy<DerivedPolicy>& exec,
+                const Array2d1& X,
+                const size_t offset,
+                const Array2d2& C,
+                Array2d3& Y)
+{
+    typedef typename Array2d3::value_type   ValueType;
+    typedef typename Array2d3::memory_space MemorySpace;
+
+    if(C.num_rows == 0 || C.num_cols == 0)
+        return;
+
+    // move the coefficients next to the blocks
+    cusp::array2d<ValueType, MemorySpace, cusp::column_major> C_(C);
+
+    BLOCK_AXPY<ValueType> op(thrust::raw_pointer_cast(&X.values[0]) + offset * X.pitch, X.pitch,
+                             thrust::raw_pointer_cast(&C_.values[0]), C_.pitch,
+                             thrust::raw_pointer_cast(&Y.values[0]), Y.pitch,
+                             C.num_rows, C.num_cols);
+
+    thrust::for_each(exec,
+                     thrust::counting_iterator<int>(0),
+                     thrust::counting_iterator<int>(Y.num_rows),
+                     op);
+}
+
+// G(a,b) = conj(X(:,a))^T Y(:,b)
+template <typename DerivedPolicy, typename Array2d1, typename Array2d2, typename Array2d3>
+void block_dotc(thrust::execution_policy<DerivedPolicy>& exec,
+                const Array2d1& X,
+                const Array2d2& Y,
+                Array2d3& G)
+{
+    typedef typename Array2d3::value_type   ValueType;
+    typedef typename Array2d2::memory_space MemorySpace;
+
+    G.resize(X.num_cols, Y.num_cols);
+
+    cusp::array1d<ValueType, MemorySpace> dots(Y.num_cols);
+
+    for(size_t a = 0; a < X.num_cols; a++)
+    {
+        cusp::blas::mdotc(exec, X.column(a), Y, dots);
+
+        cusp::array1d<ValueType, cusp::host_memory> dots_h(dots);
+
+        for(size_t b = 0; b < Y.num_cols; b++)
+            G(a, b) = dots_h[b];
+    }
+}
+
+} // end namespace block_detail
+} // end namespace krylov
+} // end namespace cusp
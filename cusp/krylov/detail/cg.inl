@@ -30,6 +30,50 @@ namespace krylov
 namespace cg_detail
 {
 
+// r <- r - alpha * y, z <- M*r and returns <r^H, z>
+template <typename DerivedPolicy,
+          class Preconditioner,
+          class Array1,
+          class Array2,
+          class Array3,
+          typename ScalarType>
+ScalarType update_residual(thrust::execution_policy<DerivedPolicy> &exec,
+                           Preconditioner& M,
+                           const Array1& y,
+                                 Array2& r,
+                                 Array3& z,
+                           const ScalarType alpha)
+{
+    blas::axpy(exec, y, r, -alpha);
+
+    cusp::multiply(exec, M, r, z);
+
+    return blas::dotc(exec, r, z);
+}
+
+// without preconditioning <r^H, r> is computed while r is updated
+template <typename DerivedPolicy,
+          typename ValueType,
+          typename MemorySpace,
+          typename IndexType,
+          class Array1,
+          class Array2,
+          class Array3,
+          typename ScalarType>
+ScalarType update_residual(thrust::execution_policy<DerivedPolicy> &exec,
+                           cusp::identity_operator<ValueType,MemorySpace,IndexType>& M,
+                           const Array1& y,
+                                 Array2& r,
+                                 Array3& z,
+                           const ScalarType alpha)
+{
+    ScalarType rr = blas::axpy_dotc(exec, y, r, r, -alpha);
+
+    blas::copy(exec, r, z);
+
+    return rr;
+}
+
 template <typename DerivedPolicy,
           class LinearOperator,
           class Vector,
@@ -86,16 +130,10 @@ void cg(thrust::execution_policy<DerivedPolicy> &exec,
         // x <- x + alpha * p
         blas::axpy(exec, p, x, alpha);
 
-        // r <- r - alpha * y
-        blas::axpy(exec, y, r, -alpha);
-
-        // z <- M*r
-        cusp::multiply(exec, M, r, z);
-
         ValueType rz_old = rz;
 
-        // rz = <r^H, z>
-        rz = blas::dotc(exec, r, z);
+        // r <- r - alpha * y, z <- M*r and rz = <r^H, z>
+        rz = update_residual(exec, M, y, r, z, alpha);
 
         // beta <- <r_{i+1},r_{i+1}>/<r,r>
         ValueType beta = rz / rz_old;
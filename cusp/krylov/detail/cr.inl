@@ -43,6 +43,7 @@ void cr(thrust::execution_policy<DerivedPolicy> &exec,
         Preconditioner& M)
 {
     typedef typename LinearOperator::value_type           ValueType;
+    typedef typename cusp::norm_type<ValueType>::type     NormType;
     typedef typename cusp::minimum_space<
     typename LinearOperator::memory_space,
              typename Vector::memory_space,
@@ -82,10 +83,13 @@ void cr(thrust::execution_policy<DerivedPolicy> &exec,
     // rz = <r^H, z>
     ValueType rz = blas::dotc(exec, r, Az);
 
+    // yy = <y^H, y>
+    ValueType yy = blas::dotc(exec, y, y);
+
     while (!monitor.finished(r))
     {
         // alpha <- <r,z>/<y,p>
-        ValueType alpha =  rz / blas::dotc(exec, y, y);
+        ValueType alpha =  rz / yy;
 
         // x <- x + alpha * p
         blas::axpy(exec, p, x, alpha);
@@ -94,7 +98,7 @@ void cr(thrust::execution_policy<DerivedPolicy> &exec,
         if( (iter % recompute_r) && (iter > 0) )
         {
             // r <- r - alpha * y
-            blas::axpy(y, r, -alpha);
+            blas::axpy(exec, y, r, -alpha);
         }
         else
         {
@@ -114,7 +118,7 @@ void cr(thrust::execution_policy<DerivedPolicy> &exec,
         ValueType rz_old = rz;
 
         // rz = <r^H, z>
-        rz = blas::dotc(r, Az);
+        rz = blas::dotc(exec, r, Az);
 
         // beta <- <r_{i+1},r_{i+1}>/<r,r>
         ValueType beta = rz / rz_old;
@@ -122,8 +126,9 @@ void cr(thrust::execution_policy<DerivedPolicy> &exec,
         // p <- r + beta*p
         blas::axpby(exec, z, p, p, ValueType(1), beta);
 
-        // y <- z + beta*p
-        blas::axpby(exec, Az, y, y, ValueType(1), beta);
+        // y <- z + beta*p and yy = <y^H, y> in a single pass
+        NormType y_norm = blas::axpby_nrm2(exec, Az, y, y, ValueType(1), beta);
+        yy = y_norm * y_norm;
 
         ++monitor;
     }
@@ -0,0 +1,389 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <thrust/for_each.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/zip_iterator.h>
+
+#include <cmath>
+
+/*
+ * Pipelined preconditioned conjugate gradient method
+ *
+ * Rearranges the CG recurrences so that both inner products of an
+ * iteration are computed in a single reduction, which is independent of
+ * the matrix-vector and preconditioner products of the same iteration.
+ * The extra recurrences for s = Ap, q = Ms and z = Aq replace the second
+ * reduction and are applied together with the x, r, u and w updates in
+ * a single sweep over memory.
+ *
+ * The method is described in:
+ *     Hiding global synchronization latency in the preconditioned
+ *     Conjugate Gradient algorithm
+ *     P. Ghysels and W. Vanroose, Parallel Computing 40 (2014)
+ */
+
+namespace cusp
+{
+namespace krylov
+{
+namespace pipelined_cg_detail
+{
+
+// computes (<r^H,u>, <w^H,u>, <r^H,r>) from tuples (r,u,w)
+template <typename ValueType>
+struct KERNEL_DOTS
+{
+    typedef typename cusp::norm_type<ValueType>::type           NormType;
+    typedef thrust::tuple<ValueType,ValueType,NormType>         result_type;
+
+    template <typename Tuple>
+    __host__ __device__
+    result_type operator()(const Tuple& t) const
+    {
+        ValueType r = thrust::get<0>(t);
+        ValueType u = thrust::get<1>(t);
+
+        return result_type(cusp::conj(r) * u,
+                           cusp::conj(ValueType(thrust::get<2>(t))) * u,
+                           cusp::abs(r) * cusp::abs(r));
+    }
+};
+
+template <typename ValueType>
+struct KERNEL_DOTS_PLUS
+{
+    typedef typename cusp::norm_type<ValueType>::type           NormType;
+    typedef thrust::tuple<ValueType,ValueType,NormType>         result_type;
+
+    __host__ __device__
+    result_type operator()(const result_type& a, const result_type& b) const
+    {
+        return result_type(thrust::get<0>(a) + thrust::get<0>(b),
+                           thrust::get<1>(a) + thrust::get<1>(b),
+                           thrust::get<2>(a) + thrust::get<2>(b));
+    }
+};
+
+// updates tuples (z,n,q,m,s,w,p,u,x,r) for the current alpha and beta
+template <typename ValueType>
+struct KERNEL_UPDATE
+{
+    ValueType alpha;
+    ValueType beta;
+
+    KERNEL_UPDATE(ValueType _alpha, ValueType _beta)
+        : alpha(_alpha), beta(_beta)
+    {}
+
+    template <typename Tuple>
+    __host__ __device__
+    void operator()(Tuple t) const
+    {
+        // z <- n + beta * z
+        ValueType z = thrust::get<1>(t) + beta * thrust::get<0>(t);
+        // q <- m + beta * q
+        ValueType q = thrust::get<3>(t) + beta * thrust::get<2>(t);
+        // s <- w + beta * s
+        ValueType s = thrust::get<5>(t) + beta * thrust::get<4>(t);
+        // p <- u + beta * p
+        ValueType p = thrust::get<7>(t) + beta * thrust::get<6>(t);
+
+        thrust::get<0>(t) = z;
+        thrust::get<2>(t) = q;
+        thrust::get<4>(t) = s;
+        thrust::get<6>(t) = p;
+
+        // x <- x + alpha * p
+        thrust::get<8>(t) = thrust::get<8>(t) + alpha * p;
+        // r <- r - alpha * s
+        thrust::get<9>(t) = thrust::get<9>(t) - alpha * s;
+        // u <- u - alpha * q
+        thrust::get<7>(t) = thrust::get<7>(t) - alpha * q;
+        // w <- w - alpha * z
+        thrust::get<5>(t) = thrust::get<5>(t) - alpha * z;
+    }
+};
+
+// cusp::monitor takes the residual norm from the fused reduction
+template <typename ValueType, typename Vector, typename NormType>
+bool monitor_finished(cusp::monitor<ValueType>& monitor, const Vector& r, const NormType r_norm)
+{
+    return monitor.finished_norm(r_norm);
+}
+
+// other monitors only accept the residual and compute its norm
+template <typename Monitor, typename Vector, typename NormType>
+bool monitor_finished(Monitor& monitor, const Vector& r, const NormType r_norm)
+{
+    return monitor.finished(r);
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Vector,
+          class Monitor,
+          class Preconditioner>
+void pipelined_cg(thrust::execution_policy<DerivedPolicy> &exec,
+                  LinearOperator& A,
+                  Vector& x,
+                  Vector& b,
+                  Monitor& monitor,
+                  Preconditioner& M)
+{
+    typedef typename LinearOperator::value_type           ValueType;
+    typedef typename cusp::norm_type<ValueType>::type     NormType;
+    typedef thrust::tuple<ValueType,ValueType,NormType>   DotsType;
+
+    assert(A.num_rows == A.num_cols);        // sanity check
+
+    const size_t N = A.num_rows;
+
+    // allocate workspace
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> r(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> u(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> w(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> m(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> n(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> z(exec, N, ValueType(0));
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> q(exec, N, ValueType(0));
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> s(exec, N, ValueType(0));
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> p(exec, N, ValueType(0));
+
+    // w <- Ax
+    cusp::multiply(exec, A, x, w);
+
+    // r <- b - A*x
+    cusp::blas::axpby(exec, b, w, r, ValueType(1), ValueType(-1));
+
+    // u <- M*r
+    cusp::multiply(exec, M, r, u);
+
+    // w <- A*u
+    cusp::multiply(exec, A, u, w);
+
+    ValueType alpha(0);
+    ValueType gamma(0);
+
+    bool first_iteration = true;
+
+    while (true)
+    {
+        // (gamma, delta, ||r||^2) <- (<r^H,u>, <w^H,u>, <r^H,r>), the only
+        // global reduction of the iteration
+        DotsType dots =
+            thrust::transform_reduce(exec,
+                                     thrust::make_zip_iterator(thrust::make_tuple(r.begin(), u.begin(), w.begin())),
+                                     thrust::make_zip_iterator(thrust::make_tuple(r.begin(), u.begin(), w.begin())) + N,
+                                     KERNEL_DOTS<ValueType>(),
+                                     DotsType(ValueType(0), ValueType(0), NormType(0)),
+                                     KERNEL_DOTS_PLUS<ValueType>());
+
+        // m <- M*w, independent of the reduction above
+        cusp::multiply(exec, M, w, m);
+
+        // n <- A*m
+        cusp::multiply(exec, A, m, n);
+
+        // the products of the last iteration are discarded, as in the
+        // original algorithm, rather than waiting for the reduction
+        if (monitor_finished(monitor, r, std::sqrt(thrust::get<2>(dots))))
+            break;
+
+        ValueType gamma_old = gamma;
+        gamma = thrust::get<0>(dots);
+        ValueType delta = thrust::get<1>(dots);
+
+        ValueType beta(0);
+
+        if (first_iteration)
+        {
+            alpha = gamma / delta;
+            first_iteration = false;
+        }
+        else
+        {
+            beta  = gamma / gamma_old;
+            alpha = gamma / (delta - beta * gamma / alpha);
+        }
+
+        // update z, q, s, p, x, r, u and w in one pass
+        thrust::for_each(exec,
+                         thrust::make_zip_iterator(thrust::make_tuple(z.begin(), n.begin(), q.begin(), m.begin(), s.begin(),
+                                                                      w.begin(), p.begin(), u.begin(), x.begin(), r.begin())),
+                         thrust::make_zip_iterator(thrust::make_tuple(z.begin(), n.begin(), q.begin(), m.begin(), s.begin(),
+                                                                      w.begin(), p.begin(), u.begin(), x.begin(), r.begin())) + N,
+                         KERNEL_UPDATE<ValueType>(alpha, beta));
+
+        ++monitor;
+    }
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Vector,
+          class Monitor>
+void pipelined_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  LinearOperator& A,
+                  Vector& x,
+                  Vector& b,
+                  Monitor& monitor)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    cusp::krylov::pipelined_cg_detail::pipelined_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, x, b, monitor, M);
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Vector>
+void pipelined_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  LinearOperator& A,
+                  Vector& x,
+                  Vector& b)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+
+    cusp::monitor<ValueType> monitor(b);
+
+    cusp::krylov::pipelined_cg_detail::pipelined_cg(exec, A, x, b, monitor);
+}
+
+} // end pipelined_cg_detail namespace
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Vector>
+void pipelined_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  LinearOperator& A,
+                  Vector& x,
+                  Vector& b)
+{
+    using cusp::krylov::pipelined_cg_detail::pipelined_cg;
+
+    pipelined_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                 A, x, b);
+}
+
+template <class LinearOperator,
+          class Vector>
+void pipelined_cg(LinearOperator& A,
+                  Vector& x,
+                  Vector& b)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Vector::memory_space         System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::krylov::pipelined_cg(select_system(system1,system2), A, x, b);
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Vector,
+          class Monitor>
+void pipelined_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  LinearOperator& A,
+                  Vector& x,
+                  Vector& b,
+                  Monitor& monitor)
+{
+    using cusp::krylov::pipelined_cg_detail::pipelined_cg;
+
+    pipelined_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                 A, x, b, monitor);
+}
+
+template <class LinearOperator,
+          class Vector,
+          class Monitor>
+void pipelined_cg(LinearOperator& A,
+                  Vector& x,
+                  Vector& b,
+                  Monitor& monitor)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Vector::memory_space         System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::krylov::pipelined_cg(select_system(system1,system2), A, x, b, monitor);
+}
+
+template <typename DerivedPolicy,
+          class LinearOperator,
+          class Vector,
+          class Monitor,
+          class Preconditioner>
+void pipelined_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  LinearOperator& A,
+                  Vector& x,
+                  Vector& b,
+                  Monitor& monitor,
+                  Preconditioner& M)
+{
+    using cusp::krylov::pipelined_cg_detail::pipelined_cg;
+
+    pipelined_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                 A, x, b, monitor, M);
+}
+
+template <class LinearOperator,
+          class Vector,
+          class Monitor,
+          class Preconditioner>
+void pipelined_cg(LinearOperator& A,
+                  Vector& x,
+                  Vector& b,
+                  Monitor& monitor,
+                  Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Vector::memory_space         System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::krylov::pipelined_cg(select_system(system1,system2), A, x, b, monitor, M);
+}
+
+} // end namespace krylov
+} // end namespace cusp
+
@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file solver.h
+ *  \brief Dense direct solvers built on the lapack interface
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/exception.h>
+#include <cusp/linear_operator.h>
+
+#include <cusp/lapack/lapack.h>
+
+namespace cusp
+{
+namespace lapack
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/**
+ * \brief Direct solver based on the blocked LU factorization of lapack
+ *
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * The matrix is copied into a dense host matrix and factored once with
+ * \p getrf, every application solves with \p getrs. The solver can be
+ * used as the coarse grid solver of a \p cusp::multilevel hierarchy.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/gallery/poisson.h>
+ * #include <cusp/krylov/cg.h>
+ * #include <cusp/precond/aggregation/smoothed_aggregation.h>
+ *
+ * // include cusp lapack solver header file
+ * #include <cusp/lapack/solver.h>
+ *
+ * int main()
+ * {
+ *   typedef cusp::lapack::lu_solver<double,cusp::host_memory> CoarseSolver;
+ *   typedef cusp::precond::aggregation::smoothed_aggregation<int,double,cusp::host_memory,
+ *                                                            thrust::use_default,
+ *                                                            CoarseSolver> Preconditioner;
+ *
+ *   cusp::csr_matrix<int,double,cusp::host_memory> A;
+ *   cusp::gallery::poisson5pt(A, 256, 256);
+ *
+ *   cusp::array1d<double,cusp::host_memory> x(A.num_rows, 0);
+ *   cusp::array1d<double,cusp::host_memory> b(A.num_rows, 1);
+ *
+ *   Preconditioner M(A);
+ *
+ *   cusp::monitor<double> monitor(b, 100, 1e-6);
+ *   cusp::krylov::cg(A, x, b, monitor, M);
+ *
+ *   return 0;
+ * }
+ * \endcode
+ */
+template <typename ValueType, typename MemorySpace>
+class lu_solver : public cusp::linear_operator<ValueType,MemorySpace>
+{
+private:
+    typedef cusp::linear_operator<ValueType,MemorySpace> Parent;
+
+    template <typename ValueType2, typename MemorySpace2> friend class lu_solver;
+
+    cusp::array2d<ValueType,cusp::host_memory,cusp::column_major> lu;
+    cusp::array1d<int,cusp::host_memory>                          pivot;
+
+    mutable cusp::array2d<ValueType,cusp::host_memory,cusp::column_major> work;
+
+public:
+    lu_solver()
+        : Parent()
+    { }
+
+    template <typename ValueType2, typename MemorySpace2>
+    lu_solver(const lu_solver<ValueType2,MemorySpace2>& M)
+        : Parent(M.num_rows, M.num_cols, M.num_entries),
+          lu(M.lu), pivot(M.pivot), work(M.work)
+    { }
+
+    template <typename MatrixType>
+    lu_solver(const MatrixType& A)
+        : Parent(A.num_rows, A.num_cols, A.num_entries),
+          lu(A), work(A.num_rows, 1)
+    {
+        if (A.num_rows != A.num_cols)
+            throw cusp::invalid_input_exception("lu_solver requires a square matrix");
+
+        if (A.num_rows > 0)
+            cusp::lapack::getrf(lu, pivot);
+    }
+
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& b, VectorType2& x) const
+    {
+        const size_t n = lu.num_rows;
+
+        if (n == 0)
+            return;
+
+        for (size_t i = 0; i < n; i++)
+            work(i,0) = b[i];
+
+        cusp::lapack::getrs(lu, pivot, work);
+
+        for (size_t i = 0; i < n; i++)
+            x[i] = work(i,0);
+    }
+};
+
+/**
+ * \brief Direct solver based on the blocked Cholesky factorization of lapack
+ *
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * Symmetric positive definite matrices are copied into a dense host
+ * matrix and factored once with \p potrf, every application solves with
+ * \p potrs. The factorization needs half the operations of \p lu_solver.
+ */
+template <typename ValueType, typename MemorySpace>
+class cholesky_solver : public cusp::linear_operator<ValueType,MemorySpace>
+{
+private:
+    typedef cusp::linear_operator<ValueType,MemorySpace> Parent;
+
+    template <typename ValueType2, typename MemorySpace2> friend class cholesky_solver;
+
+    cusp::array2d<ValueType,cusp::host_memory,cusp::column_major> factor;
+
+    mutable cusp::array2d<ValueType,cusp::host_memory,cusp::column_major> work;
+
+public:
+    cholesky_solver()
+        : Parent()
+    { }
+
+    template <typename ValueType2, typename MemorySpace2>
+    cholesky_solver(const cholesky_solver<ValueType2,MemorySpace2>& M)
+        : Parent(M.num_rows, M.num_cols, M.num_entries),
+          factor(M.factor), work(M.work)
+    { }
+
+    template <typename MatrixType>
+    cholesky_solver(const MatrixType& A)
+        : Parent(A.num_rows, A.num_cols, A.num_entries),
+          factor(A), work(A.num_rows, 1)
+    {
+        if (A.num_rows != A.num_cols)
+            throw cusp::invalid_input_exception("cholesky_solver requires a square matrix");
+
+        if (A.num_rows > 0)
+            cusp::lapack::potrf(factor, 'U');
+    }
+
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& b, VectorType2& x) const
+    {
+        const size_t n = factor.num_rows;
+
+        if (n == 0)
+            return;
+
+        for (size_t i = 0; i < n; i++)
+            work(i,0) = b[i];
+
+        cusp::lapack::potrs(factor, work, 'U');
+
+        for (size_t i = 0; i < n; i++)
+            x[i] = work(i,0);
+    }
+};
+/*! \}
+ */
+
+} // end namespace lapack
+} // end namespace cusp
+
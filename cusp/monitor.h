@@ -184,6 +184,14 @@ public:
     template <typename Vector>
     bool finished(const Vector& r);
 
+    /**
+     *  \brief Applies convergence criteria to an already computed residual norm
+     *
+     *  \param norm norm of the residual of the linear system, for
+     *  solvers that obtain it from a fused reduction
+     */
+    bool finished_norm(const Real norm);
+
     /**
      *  \brief Sets the verbosity level of the monitor
      *
@@ -16,8 +16,10 @@
 
 #include <cusp/detail/config.h>
 
+#include <cusp/exception.h>
 #include <cusp/execution_policy.h>
-#include <cusp/multiply.h>
+
+#include <cusp/precond/aggregation/system/detail/generic/galerkin_product.h>
 
 namespace cusp
 {
@@ -25,26 +27,6 @@ namespace precond
 {
 namespace aggregation
 {
-namespace detail
-{
-
-template <typename DerivedPolicy,
-          typename MatrixType1,
-          typename MatrixType2,
-          typename MatrixType3>
-void galerkin_product(thrust::execution_policy<DerivedPolicy> &exec,
-                      const MatrixType1& R,
-                      const MatrixType2& A,
-                      const MatrixType1& P,
-                      MatrixType3& RAP)
-{
-    // TODO test speed of R * (A * P) vs. (R * A) * P
-    MatrixType3 AP;
-    cusp::multiply(A, P, AP);
-    cusp::multiply(R, AP, RAP);
-}
-
-} // end detail
 
 template <typename DerivedPolicy,
           typename MatrixType1,
@@ -82,6 +64,45 @@ void galerkin_product(const MatrixType1& R,
     cusp::precond::aggregation::galerkin_product(select_system(system1,system2,system3), R, A, P, RAP);
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void numeric_galerkin_product(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                              const MatrixType1& R,
+                              const MatrixType2& A,
+                              const MatrixType1& P,
+                              MatrixType3& RAP)
+{
+    using cusp::precond::aggregation::detail::numeric_galerkin_product;
+
+    if(RAP.num_rows != R.num_rows || RAP.num_cols != P.num_cols)
+        throw cusp::invalid_input_exception("RAP does not have the shape of R * A * P");
+
+    numeric_galerkin_product(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), R, A, P, RAP);
+}
+
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void numeric_galerkin_product(const MatrixType1& R,
+                              const MatrixType2& A,
+                              const MatrixType1& P,
+                              MatrixType3& RAP)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType1::memory_space System1;
+    typedef typename MatrixType2::memory_space System2;
+    typedef typename MatrixType3::memory_space System3;
+
+    System1 system1;
+    System2 system2;
+    System3 system3;
+
+    cusp::precond::aggregation::numeric_galerkin_product(select_system(system1,system2,system3), R, A, P, RAP);
+}
+
 } // end namespace aggregation
 } // end namespace precond
 } // end namespace cusp
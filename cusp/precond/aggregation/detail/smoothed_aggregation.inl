@@ -15,6 +15,8 @@
  */
 
 #include <cusp/array1d.h>
+#include <cusp/exception.h>
+#include <cusp/eigen/spectral_radius.h>
 #include <cusp/precond/aggregation/strength.h>
 #include <cusp/precond/aggregation/aggregate.h>
 #include <cusp/precond/aggregation/tentative.h>
@@ -139,6 +141,64 @@ void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverTyp
     ML::initialize_coarse_solver();
 }
 
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+template <typename MatrixType>
+void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::update_values(const MatrixType& A)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System;
+
+    System system;
+
+    update_values(select_system(system), A);
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+template <typename DerivedPolicy, typename MatrixType>
+void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::update_values(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                const MatrixType& A)
+{
+    typedef typename detail::select_sa_matrix_view<MatrixType>::type View;
+
+    // a hierarchy without coarse levels has nothing to reuse
+    if(sa_levels.size() < 2)
+    {
+        if(sa_levels.size() == 0)
+        {
+            initialize(exec, A);
+        }
+        else
+        {
+            cusp::array1d<ValueType,MemorySpace> B(sa_levels[0].B);
+            initialize(exec, A, B);
+        }
+
+        return;
+    }
+
+    if(A.num_rows != sa_levels[0].aggregates.size() || A.num_cols != sa_levels[0].aggregates.size())
+        throw cusp::invalid_input_exception("matrix dimensions do not match the hierarchy");
+
+    {
+        View A_(A);
+        update_level(exec, 0, A_);
+    }
+
+    for( size_t lvl = 1; lvl + 1 < sa_levels.size(); lvl++ )
+        update_level(exec, lvl, sa_levels[lvl].A_);
+
+    // Setup multilevel arrays, matrices and smoothers on each level
+    ML::setup_level(0, A, sa_levels[0]);
+
+    for( size_t lvl = 1; lvl < sa_levels.size(); lvl++ )
+        ML::setup_level(lvl, sa_levels[lvl].A_, sa_levels[lvl]);
+
+    ML::initialize_coarse_solver();
+}
+
 template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
 template <typename DerivedPolicy, typename MatrixType>
 void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
@@ -184,6 +244,48 @@ void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverTyp
     ML::levels.push_back(Level());
 }
 
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+template <typename DerivedPolicy, typename MatrixType>
+void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::update_level(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+               const size_t lvl, const MatrixType& A)
+{
+    sa_level<SetupMatrixType>& L = sa_levels[lvl];
+
+    // estimate once for the prolongator and the smoother
+    L.rho_DinvA = cusp::eigen::estimate_rho_Dinv_A(A);
+
+    // recompute prolongation operator from the tentative prolongator
+    SetupMatrixType P;
+    smooth_prolongator(exec, A, L.T, P, L.rho_DinvA);
+
+    SetupMatrixType R;
+    form_restriction(exec, P, R);
+
+    // recompute the values of R*A*P in the pattern of the coarse matrix
+    reclaim_matrix(sa_levels[lvl + 1].A_, ML::levels[lvl + 1].A);
+    numeric_galerkin_product(exec, R, A, P, sa_levels[lvl + 1].A_);
+
+    ML::copy_or_swap_matrix(ML::levels[lvl].R, R);
+    ML::copy_or_swap_matrix(ML::levels[lvl].P, P);
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::reclaim_matrix(SetupMatrixType& dst, SetupMatrixType& src)
+{
+    // setup_level swapped the coarse matrix into the solve hierarchy
+    dst.swap(src);
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+template <typename MatrixType>
+void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::reclaim_matrix(SetupMatrixType& dst, MatrixType& src)
+{
+    // setup_level copied the coarse matrix, dst still holds it
+}
+
 } // end namespace aggregation
 } // end namespace precond
 } // end namespace cusp
@@ -36,11 +36,31 @@ void galerkin_product(const thrust::detail::execution_policy_base<DerivedPolicy>
                       const MatrixType1& R, const MatrixType2& A, const MatrixType1& P, MatrixType3& RAP);
 /* \endcond */
 
+//   Coarse operator RAP = R * A * P. CSR matrices on the host are
+//   multiplied row by row without forming A * P.
 template <typename MatrixType1,
           typename MatrixType2,
           typename MatrixType3>
 void galerkin_product(const MatrixType1& R, const MatrixType2& A, const MatrixType1& P, MatrixType3& RAP);
 
+/* \cond */
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void numeric_galerkin_product(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                              const MatrixType1& R, const MatrixType2& A, const MatrixType1& P, MatrixType3& RAP);
+/* \endcond */
+
+//   Recomputes the values of RAP = R * A * P when only the values of R, A
+//   and P changed since RAP was formed by galerkin_product. CSR matrices
+//   on the host keep the pattern of RAP, other matrices are multiplied
+//   again.
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void numeric_galerkin_product(const MatrixType1& R, const MatrixType2& A, const MatrixType1& P, MatrixType3& RAP);
+
 } // end namespace aggregation
 } // end namespace precond
 } // end namespace cusp
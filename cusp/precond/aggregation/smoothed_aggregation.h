@@ -64,6 +64,7 @@ struct sa_level
     template<typename SALevelType>
     sa_level(const SALevelType& L)
       : A_(L.A_),
+        T(L.T),
         aggregates(L.aggregates),
         B(L.B),
         num_iters(L.num_iters),
@@ -97,6 +98,13 @@ struct sa_level
  *  on each level of hierarchy and LU to solve the coarse matrix in host
  *  memory.
  *
+ *  Each application performs one V-cycle by default. \p set_cycle selects
+ *  a W-, F- or K-cycle instead, and \p print and \p cycle_complexity
+ *  report the visits of every level and the work of one cycle. The
+ *  K-cycle changes from one application to the next, so it must be used
+ *  through \p solve or by a flexible Krylov method rather than by
+ *  \p cg, which loses its convergence guarantees with it.
+ *
  *  \par Example
  *  The following code snippet demonstrates how to use a
  *  \p smoothed_aggregation preconditioner to solve a linear system.
@@ -131,6 +139,9 @@ struct sa_level
  *
  *      cusp::precond::aggregation::smoothed_aggregation<IndexType, ValueType, MemorySpace> M(A);
  *
+ *      // correct twice on every coarse level
+ *      M.set_cycle(cusp::w_cycle);
+ *
  *      // print AMG statistics
  *      M.print();
  *
@@ -232,12 +243,45 @@ class smoothed_aggregation :
                     const MatrixType& A, const ArrayType& B);
     /* \endcond */
 
+    /*! Update a \p smoothed_aggregation preconditioner after the values of
+     * the matrix changed but not its sparsity pattern. The aggregates, the
+     * tentative prolongators and the sparsity patterns of the coarse
+     * matrices are kept. The smoothed prolongators, the values of the
+     * coarse matrices, the spectral radius estimates, the smoothers and the
+     * coarse solver are recomputed.
+     *
+     *  \param A matrix with the sparsity pattern of the matrix used to
+     *  create the AMG hierarchy.
+     *
+     *  \throws cusp::invalid_input_exception if the dimensions of \p A do
+     *  not match the hierarchy or the new values produce coarse entries
+     *  outside the stored patterns, in which case \p initialize must be
+     *  called instead.
+     */
+    template <typename MatrixType>
+    void update_values(const MatrixType& A);
+
+    /* \cond */
+    template <typename DerivedPolicy, typename MatrixType>
+    void update_values(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                       const MatrixType& A);
+    /* \endcond */
+
 protected:
 
     /* \cond */
     template <typename DerivedPolicy, typename MatrixType>
     void extend_hierarchy(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
                           const MatrixType& A);
+
+    template <typename DerivedPolicy, typename MatrixType>
+    void update_level(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                      const size_t lvl, const MatrixType& A);
+
+    void reclaim_matrix(SetupMatrixType& dst, SetupMatrixType& src);
+
+    template <typename MatrixType>
+    void reclaim_matrix(SetupMatrixType& dst, MatrixType& src);
     /* \endcond */
 };
 /*! \}
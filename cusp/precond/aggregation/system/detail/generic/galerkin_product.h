@@ -0,0 +1,59 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/execution_policy.h>
+
+#include <cusp/precond/aggregation/system/detail/sequential/galerkin_product.h>
+
+namespace cusp
+{
+namespace precond
+{
+namespace aggregation
+{
+namespace detail
+{
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void galerkin_product(thrust::execution_policy<DerivedPolicy> &exec,
+                      const MatrixType1& R,
+                      const MatrixType2& A,
+                      const MatrixType1& P,
+                            MatrixType3& RAP);
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void numeric_galerkin_product(thrust::execution_policy<DerivedPolicy> &exec,
+                              const MatrixType1& R,
+                              const MatrixType2& A,
+                              const MatrixType1& P,
+                                    MatrixType3& RAP);
+
+} // end namespace detail
+} // end namespace aggregation
+} // end namespace precond
+} // end namespace cusp
+
+#include <cusp/precond/aggregation/system/detail/generic/galerkin_product.inl>
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/multiply.h>
+
+namespace cusp
+{
+namespace precond
+{
+namespace aggregation
+{
+namespace detail
+{
+
+// The host systems compute CSR products row by row without forming A * P,
+// every other combination of formats and systems uses two SpGEMMs.
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void galerkin_product(thrust::execution_policy<DerivedPolicy> &exec,
+                      const MatrixType1& R,
+                      const MatrixType2& A,
+                      const MatrixType1& P,
+                      MatrixType3& RAP,
+                      cusp::known_format,
+                      cusp::known_format,
+                      cusp::known_format)
+{
+    MatrixType3 AP;
+    cusp::multiply(exec, A, P, AP);
+    cusp::multiply(exec, R, AP, RAP);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void galerkin_product(thrust::execution_policy<DerivedPolicy> &exec,
+                      const MatrixType1& R,
+                      const MatrixType2& A,
+                      const MatrixType1& P,
+                      MatrixType3& RAP)
+{
+    typedef typename MatrixType1::format Format1;
+    typedef typename MatrixType2::format Format2;
+    typedef typename MatrixType3::format Format3;
+
+    Format1 format1;
+    Format2 format2;
+    Format3 format3;
+
+    galerkin_product(exec, R, A, P, RAP, format1, format2, format3);
+}
+
+// Without a row-wise kernel the product is recomputed with its pattern
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void numeric_galerkin_product(thrust::execution_policy<DerivedPolicy> &exec,
+                              const MatrixType1& R,
+                              const MatrixType2& A,
+                              const MatrixType1& P,
+                              MatrixType3& RAP,
+                              cusp::known_format,
+                              cusp::known_format,
+                              cusp::known_format)
+{
+    galerkin_product(exec, R, A, P, RAP);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void numeric_galerkin_product(thrust::execution_policy<DerivedPolicy> &exec,
+                              const MatrixType1& R,
+                              const MatrixType2& A,
+                              const MatrixType1& P,
+                              MatrixType3& RAP)
+{
+    typedef typename MatrixType1::format Format1;
+    typedef typename MatrixType2::format Format2;
+    typedef typename MatrixType3::format Format3;
+
+    Format1 format1;
+    Format2 format2;
+    Format3 format3;
+
+    numeric_galerkin_product(exec, R, A, P, RAP, format1, format2, format3);
+}
+
+} // end namespace detail
+} // end namespace aggregation
+} // end namespace precond
+} // end namespace cusp
+
@@ -0,0 +1,234 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/exception.h>
+#include <cusp/execution_policy.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace precond
+{
+namespace aggregation
+{
+namespace detail
+{
+
+// rows of R * A * P that the parallel systems compute into one buffer
+const size_t galerkin_chunk_size = 256;
+
+// Rows [row_begin, row_end) of R * A * P computed without forming A * P.
+// The products of every row are summed in a dense accumulator over the
+// columns of P. These are the aggregates of a smoothed aggregation
+// prolongator, far fewer than the rows of A, so every thread can afford
+// one. marker must not hold any row in [row_begin, row_end) on entry.
+// The entries are appended to columns and values in ascending column
+// order and the length of row i is stored in row_offsets[i + 1]. Entries
+// that sum to zero are kept, so the pattern only depends on the patterns
+// of R, A and P.
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename IndexType,
+          typename ValueType,
+          typename ArrayType3>
+void galerkin_rows(const MatrixType1& R,
+                   const MatrixType2& A,
+                   const MatrixType1& P,
+                   const size_t row_begin,
+                   const size_t row_end,
+                   ArrayType1& marker,
+                   ArrayType2& sums,
+                   std::vector<IndexType>& columns,
+                   std::vector<ValueType>& values,
+                   ArrayType3& row_offsets)
+{
+    typedef typename MatrixType1::index_type IndexType1;
+    typedef typename MatrixType2::index_type IndexType2;
+
+    for(size_t row = row_begin; row < row_end; row++)
+    {
+        const IndexType I = row;
+        const size_t row_start = columns.size();
+
+        for(IndexType1 ii = R.row_offsets[row]; ii < R.row_offsets[row + 1]; ii++)
+        {
+            const IndexType1 i  = R.column_indices[ii];
+            const ValueType  Ri = R.values[ii];
+
+            for(IndexType2 jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                const IndexType2 j   = A.column_indices[jj];
+                const ValueType  RAj = Ri * ValueType(A.values[jj]);
+
+                for(IndexType1 kk = P.row_offsets[j]; kk < P.row_offsets[j + 1]; kk++)
+                {
+                    const IndexType K = P.column_indices[kk];
+                    const ValueType v = RAj * ValueType(P.values[kk]);
+
+                    if(marker[K] != I)
+                    {
+                        marker[K] = I;
+                        sums[K]   = v;
+                        columns.push_back(K);
+                    }
+                    else
+                    {
+                        sums[K] += v;
+                    }
+                }
+            }
+        }
+
+        std::sort(columns.begin() + row_start, columns.end());
+
+        for(size_t n = row_start; n < columns.size(); n++)
+            values.push_back(sums[columns[n]]);
+
+        row_offsets[row + 1] = columns.size() - row_start;
+    }
+}
+
+// Values of one row of R * A * P summed into the existing pattern of the
+// row in RAP. marker maps the columns of the row to their positions and
+// needs no initialization. Returns false if a product falls outside the
+// pattern.
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename ArrayType>
+bool galerkin_row_values(const MatrixType1& R,
+                         const MatrixType2& A,
+                         const MatrixType1& P,
+                         const size_t row,
+                         MatrixType3& RAP,
+                         ArrayType& marker)
+{
+    typedef typename MatrixType1::index_type IndexType1;
+    typedef typename MatrixType2::index_type IndexType2;
+    typedef typename MatrixType3::index_type IndexType;
+    typedef typename MatrixType3::value_type ValueType;
+
+    const IndexType row_start = RAP.row_offsets[row];
+    const IndexType row_end   = RAP.row_offsets[row + 1];
+
+    for(IndexType n = row_start; n < row_end; n++)
+    {
+        marker[RAP.column_indices[n]] = n;
+        RAP.values[n] = ValueType(0);
+    }
+
+    for(IndexType1 ii = R.row_offsets[row]; ii < R.row_offsets[row + 1]; ii++)
+    {
+        const IndexType1 i  = R.column_indices[ii];
+        const ValueType  Ri = R.values[ii];
+
+        for(IndexType2 jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const IndexType2 j   = A.column_indices[jj];
+            const ValueType  RAj = Ri * ValueType(A.values[jj]);
+
+            for(IndexType1 kk = P.row_offsets[j]; kk < P.row_offsets[j + 1]; kk++)
+            {
+                const IndexType K = P.column_indices[kk];
+                const IndexType n = marker[K];
+
+                if(n < row_start || n >= row_end || IndexType(RAP.column_indices[n]) != K)
+                    return false;
+
+                RAP.values[n] += RAj * ValueType(P.values[kk]);
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void galerkin_product(thrust::system::detail::sequential::execution_policy<DerivedPolicy> &exec,
+                      const MatrixType1& R,
+                      const MatrixType2& A,
+                      const MatrixType1& P,
+                      MatrixType3& RAP,
+                      cusp::csr_format,
+                      cusp::csr_format,
+                      cusp::csr_format)
+{
+    typedef typename MatrixType3::index_type IndexType;
+    typedef typename MatrixType3::value_type ValueType;
+
+    const size_t num_rows = R.num_rows;
+    const size_t num_cols = P.num_cols;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> marker(exec, num_cols, IndexType(-1));
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> sums(exec, num_cols);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_offsets(exec, num_rows + 1);
+
+    std::vector<IndexType> columns;
+    std::vector<ValueType> values;
+
+    galerkin_rows(R, A, P, 0, num_rows, marker, sums, columns, values, row_offsets);
+
+    row_offsets[0] = 0;
+
+    for(size_t i = 0; i < num_rows; i++)
+        row_offsets[i + 1] += row_offsets[i];
+
+    RAP.resize(num_rows, num_cols, columns.size());
+
+    std::copy(row_offsets.begin(), row_offsets.end(), RAP.row_offsets.begin());
+    std::copy(columns.begin(), columns.end(), RAP.column_indices.begin());
+    std::copy(values.begin(), values.end(), RAP.values.begin());
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void numeric_galerkin_product(thrust::system::detail::sequential::execution_policy<DerivedPolicy> &exec,
+                              const MatrixType1& R,
+                              const MatrixType2& A,
+                              const MatrixType1& P,
+                              MatrixType3& RAP,
+                              cusp::csr_format,
+                              cusp::csr_format,
+                              cusp::csr_format)
+{
+    typedef typename MatrixType3::index_type IndexType;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> marker(exec, P.num_cols);
+
+    for(size_t i = 0; i < RAP.num_rows; i++)
+        if(!galerkin_row_values(R, A, P, i, RAP, marker))
+            throw cusp::invalid_input_exception("sparsity pattern of RAP does not contain R * A * P");
+}
+
+} // end namespace detail
+} // end namespace aggregation
+} // end namespace precond
+} // end namespace cusp
@@ -0,0 +1,223 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file reorder.h
+ *  \brief Symmetric reordering of matrices and vectors
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/execution_policy.h>
+
+namespace cusp
+{
+
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup matrix_algorithms Matrix Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy, typename MatrixType1, typename ArrayType, typename MatrixType2>
+void reorder(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+             const MatrixType1& A, const ArrayType& permutation, MatrixType2& B);
+/*! \endcond */
+
+/**
+ * \brief Symmetrically permute the rows and columns of a matrix
+ *
+ * \tparam MatrixType1 Type of input matrix
+ * \tparam ArrayType Type of permutation array
+ * \tparam MatrixType2 Type of output matrix
+ *
+ * \param A square input matrix
+ * \param permutation new index of every row and column of \p A
+ * \param B output matrix, P * A * P^T
+ *
+ * \par Overview
+ * Row and column \p i of \p A become row and column \p permutation[i]
+ * of \p B, following the convention of the orderings in
+ * \p cusp::graph. COO and CSR matrices are permuted directly by
+ * gathering their entries and sorting the columns of every row, without
+ * forming the permutation matrix products. Other formats are permuted
+ * through COO. \p A and \p B must be distinct matrices.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to use \p reorder.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/permutation_matrix.h>
+ *  #include <cusp/print.h>
+ *  #include <cusp/reorder.h>
+ *
+ *  #include <cusp/gallery/poisson.h>
+ *  #include <cusp/graph/symmetric_rcm.h>
+ *
+ *  int main(void)
+ *  {
+ *      cusp::csr_matrix<int,float,cusp::host_memory> A;
+ *      cusp::gallery::poisson5pt(A, 4, 4);
+ *
+ *      // compute the RCM ordering of A
+ *      cusp::permutation_matrix<int,cusp::host_memory> P(A.num_rows);
+ *      cusp::graph::symmetric_rcm(A, P);
+ *
+ *      // B = P * A * P^T
+ *      cusp::csr_matrix<int,float,cusp::host_memory> B;
+ *      cusp::reorder(A, P.permutation, B);
+ *
+ *      cusp::print(B);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ */
+template <typename MatrixType1, typename ArrayType, typename MatrixType2>
+void reorder(const MatrixType1& A, const ArrayType& permutation, MatrixType2& B);
+
+/**
+ * \brief Symmetric reordering of a linear system
+ *
+ * \tparam IndexType Type used for the permutation indices (e.g. \c int).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * Stores a permutation together with its inverse so a system A x = b
+ * can be solved in the permuted ordering. The matrix and the right-hand
+ * side are permuted once, the solver runs on the reordered system, and
+ * the solution is mapped back to the original ordering with
+ * \p unpermute. Vectors are permuted in place with a single gather.
+ *
+ * \par Example
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/permutation_matrix.h>
+ *  #include <cusp/reorder.h>
+ *
+ *  #include <cusp/gallery/poisson.h>
+ *  #include <cusp/graph/symmetric_rcm.h>
+ *  #include <cusp/krylov/cg.h>
+ *
+ *  int main(void)
+ *  {
+ *      cusp::csr_matrix<int,float,cusp::host_memory> A;
+ *      cusp::gallery::poisson5pt(A, 100, 100);
+ *
+ *      cusp::array1d<float,cusp::host_memory> x(A.num_rows, 0);
+ *      cusp::array1d<float,cusp::host_memory> b(A.num_rows, 1);
+ *
+ *      cusp::permutation_matrix<int,cusp::host_memory> P(A.num_rows);
+ *      cusp::graph::symmetric_rcm(A, P);
+ *
+ *      // reorder A in place and keep the permutation
+ *      cusp::reordering<int,cusp::host_memory> R = cusp::reorder(A, P.permutation);
+ *      R.permute(b);
+ *
+ *      cusp::monitor<float> monitor(b, 100, 1e-6);
+ *      cusp::krylov::cg(A, x, b, monitor);
+ *
+ *      // x in the original ordering
+ *      R.unpermute(x);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ */
+template <typename IndexType, typename MemorySpace>
+class reordering
+{
+public:
+
+    /*! \cond */
+    typedef cusp::array1d<IndexType, MemorySpace> permutation_array_type;
+    /*! \endcond */
+
+    /*! New index of every row of the original system
+     */
+    permutation_array_type permutation;
+
+    /*! Original index of every row of the reordered system
+     */
+    permutation_array_type inverse;
+
+    /*! Construct an empty \p reordering.
+     */
+    reordering(void) {}
+
+    /*! Construct a \p reordering from a permutation.
+     *
+     *  \tparam ArrayType Type of permutation array
+     *
+     *  \param permutation new index of every row
+     */
+    template <typename ArrayType>
+    reordering(const ArrayType& permutation);
+
+    /*! Symmetrically permute a matrix in place, A = P * A * P^T.
+     *
+     *  \tparam MatrixType Type of the matrix container
+     *
+     *  \param A matrix to permute
+     */
+    template <typename MatrixType>
+    void permute_matrix(MatrixType& A) const;
+
+    /*! Permute a vector in place, x = P * x.
+     *
+     *  \tparam ArrayType Type of the vector
+     *
+     *  \param x vector in the original ordering
+     */
+    template <typename ArrayType>
+    void permute(ArrayType& x) const;
+
+    /*! Map a vector back to the original ordering in place, x = P^T * x.
+     *
+     *  \tparam ArrayType Type of the vector
+     *
+     *  \param x vector in the permuted ordering
+     */
+    template <typename ArrayType>
+    void unpermute(ArrayType& x) const;
+};
+
+/**
+ * \brief Symmetrically permute a matrix in place
+ *
+ * \tparam MatrixType Type of the matrix container
+ * \tparam ArrayType Type of permutation array
+ *
+ * \param A square matrix to permute, replaced by P * A * P^T
+ * \param permutation new index of every row and column of \p A
+ *
+ * \return \p reordering that permutes vectors into the new ordering and
+ * maps solutions back to the original one
+ */
+template <typename MatrixType, typename ArrayType>
+cusp::reordering<typename ArrayType::value_type, typename ArrayType::memory_space>
+reorder(MatrixType& A, const ArrayType& permutation);
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/reorder.inl>
@@ -24,10 +24,14 @@
 #include <cusp/system/detail/sequential/execution_policy.h>
 
 #include <thrust/extrema.h>
-#include <thrust/gather.h>
+#include <thrust/scatter.h>
+#include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/transform.h>
 
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+
 namespace cusp
 {
 namespace system
@@ -204,15 +208,33 @@ struct hilbert_transform_3d : public thrust::unary_function<double,double>
     }
 };
 
+// part of the n-th point along the curve
+struct hilbert_part : public thrust::unary_function<size_t,size_t>
+{
+    size_t num_points;
+    size_t num_parts;
+
+    hilbert_part(const size_t num_points, const size_t num_parts)
+        : num_points(num_points), num_parts(num_parts)
+    {}
+
+    __host__ __device__
+    size_t operator()(const size_t n) const
+    {
+        return n * num_parts / num_points;
+    }
+};
+
 } // end namespace detail
 
-template <typename DerivedPolicy, typename Array2d, typename Array1d>
+template <typename DerivedPolicy, typename Array2d, typename Array1d, typename ArrayType>
 void hilbert_curve(cuda::execution_policy<DerivedPolicy>& exec,
                    const Array2d& coord,
                    size_t num_parts,
-                   Array1d& parts)
+                   Array1d& parts,
+                   ArrayType& permutation)
 {
-    typedef typename Array1d::value_type PartType;
+    typedef typename ArrayType::value_type IndexType;
     typedef typename Array2d::const_column_view::iterator Iterator;
     typedef typename Array2d::value_type ValueType;
     typedef typename Array2d::memory_space MemorySpace;
@@ -258,15 +280,18 @@ void hilbert_curve(cuda::execution_policy<DerivedPolicy>& exec,
                           hilbert_keys.begin(), detail::hilbert_transform_3d());
     }
 
-    cusp::detail::temporary_array<PartType, DerivedPolicy> perm(exec, num_points);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> perm(exec, num_points);
     thrust::sequence(exec, perm.begin(), perm.end());
-    thrust::sort_by_key(exec, hilbert_keys.begin(), hilbert_keys.end(), perm.begin());
-
-    cusp::detail::temporary_array<PartType, DerivedPolicy> uniform_parts(exec, num_points);
-    thrust::transform(exec,
-                      thrust::counting_iterator<PartType>(0), thrust::counting_iterator<PartType>(num_points),
-                      thrust::constant_iterator<PartType>(num_points/num_parts), uniform_parts.begin(), thrust::divides<PartType>());
-    thrust::gather(exec, perm.begin(), perm.end(), uniform_parts.begin(), parts.begin());
+    thrust::stable_sort_by_key(exec, hilbert_keys.begin(), hilbert_keys.end(), perm.begin());
+
+    // consecutive runs of the curve form the parts
+    thrust::scatter(exec,
+                    thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(num_points),
+                    perm.begin(), permutation.begin());
+    thrust::scatter(exec,
+                    thrust::make_transform_iterator(thrust::counting_iterator<size_t>(0), detail::hilbert_part(num_points, num_parts)),
+                    thrust::make_transform_iterator(thrust::counting_iterator<size_t>(num_points), detail::hilbert_part(num_points, num_parts)),
+                    perm.begin(), parts.begin());
 }
 
 } // end namespace cuda
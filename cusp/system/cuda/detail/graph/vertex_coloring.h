@@ -36,6 +36,8 @@ template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
 size_t vertex_coloring(cuda::execution_policy<DerivedPolicy>& exec,
                        const MatrixType& G,
                        ArrayType& colors,
+                       const cusp::graph::vertex_ordering ordering,
+                       const size_t distance,
                        csr_format)
 {
   typedef typename ArrayType::value_type IndexType;
@@ -44,7 +46,7 @@ size_t vertex_coloring(cuda::execution_policy<DerivedPolicy>& exec,
   CsrHost G_host(G);
   cusp::array1d<IndexType,cusp::host_memory> colors_host(colors.size());
 
-  size_t max_colors = cusp::graph::vertex_coloring(G_host, colors_host);
+  size_t max_colors = cusp::graph::vertex_coloring(G_host, colors_host, ordering, distance);
   colors = colors_host;
 
   return max_colors;
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
 #include <cusp/exception.h>
 #include <cusp/detail/type_traits.h>
 
@@ -37,6 +38,20 @@ void hilbert_curve(thrust::execution_policy<DerivedPolicy>& exec,
                    const Array2d& coord,
                    size_t num_parts,
                    Array1d& parts)
+{
+    typedef typename Array1d::value_type IndexType;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> permutation(exec, coord.num_rows);
+
+    cusp::graph::hilbert_curve(exec, coord, num_parts, parts, permutation);
+}
+
+template <typename DerivedPolicy, typename Array2d, typename Array1d, typename ArrayType>
+void hilbert_curve(thrust::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                   size_t num_parts,
+                   Array1d& parts,
+                   ArrayType& permutation)
 {
   throw cusp::not_implemented_exception("No generic Hilbert curve");
 }
@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/type_traits.h>
+
+#include <thrust/execution_policy.h>
+
+namespace cusp
+{
+namespace graph
+{
+template <typename DerivedPolicy, typename MatrixType, typename PermutationType, typename Format>
+void nested_dissection(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       PermutationType& P,
+                       Format format);
+} // end graph namespace
+
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+template<typename DerivedPolicy, typename MatrixType, typename PermutationType>
+void nested_dissection(thrust::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       PermutationType& P)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    cusp::graph::nested_dissection(exec, G, P, format);
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename PermutationType>
+void nested_dissection(thrust::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       PermutationType& P,
+                       cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    cusp::graph::nested_dissection(exec, G_csr, P);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+
+namespace graph
+{
+template <typename DerivedPolicy, typename MatrixType, typename PermutationType, typename Format>
+void nested_dissection(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       PermutationType& P,
+                       Format format)
+{
+    using cusp::system::detail::generic::nested_dissection;
+
+    nested_dissection(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, P, format);
+}
+} // end graph namespace
+} // end namespace cusp
@@ -23,6 +23,13 @@
 #include <cusp/graph/breadth_first_search.h>
 
 #include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/tuple.h>
+
+#include <thrust/iterator/counting_iterator.h>
+
+#include <limits>
 
 namespace cusp
 {
@@ -68,6 +75,33 @@ pseudo_peripheral_vertex(thrust::execution_policy<DerivedPolicy>& exec,
     return cusp::graph::pseudo_peripheral_vertex(exec, G, levels, format);
 }
 
+namespace detail
+{
+
+// (-level, degree, index) of a vertex, the smallest key belongs to the
+// vertex of smallest degree in the last level
+template <typename MatrixType, typename ArrayType>
+struct peripheral_key
+{
+    typedef typename MatrixType::index_type          IndexType;
+    typedef thrust::tuple<IndexType,IndexType,IndexType> result_type;
+
+    typename MatrixType::row_offsets_array_type::const_iterator row_offsets;
+    typename ArrayType::const_iterator                          levels;
+
+    peripheral_key(const MatrixType& G, const ArrayType& levels)
+        : row_offsets(G.row_offsets.begin()), levels(levels.begin())
+    {}
+
+    __host__ __device__
+    result_type operator()(const IndexType i) const
+    {
+        return result_type(-levels[i], row_offsets[i + 1] - row_offsets[i], i);
+    }
+};
+
+} // end namespace detail
+
 template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
 typename MatrixType::index_type
 pseudo_peripheral_vertex(thrust::execution_policy<DerivedPolicy>& exec,
@@ -75,60 +109,39 @@ pseudo_peripheral_vertex(thrust::execution_policy<DerivedPolicy>& exec,
                          ArrayType& levels,
                          cusp::csr_format)
 {
-    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::index_type              IndexType;
+    typedef thrust::tuple<IndexType,IndexType,IndexType> KeyType;
+
+    const IndexType max_index = std::numeric_limits<IndexType>::max();
+
+    detail::peripheral_key<MatrixType,ArrayType> key_op(G, levels);
+    KeyType init(max_index, max_index, max_index);
 
-    IndexType delta = 0;
     IndexType x = rand() % G.num_rows;
-    IndexType y;
 
-    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_lengths(exec, G.num_rows);
-    thrust::transform(exec,
-                      G.row_offsets.begin() + 1, G.row_offsets.end(),
-                      G.row_offsets.begin(), row_lengths.begin(),
-                      thrust::minus<IndexType>());
+    cusp::graph::breadth_first_search(exec, G, x, levels);
+    KeyType x_key = thrust::transform_reduce(exec,
+                                             thrust::counting_iterator<IndexType>(0),
+                                             thrust::counting_iterator<IndexType>(G.num_rows),
+                                             key_op, init, thrust::minimum<KeyType>());
 
     while(1)
     {
-        cusp::graph::breadth_first_search(exec, G, x, levels);
-
-        typename ArrayType::iterator max_level_iter = thrust::max_element(exec, levels.begin(), levels.end());
-        int max_level = *max_level_iter;
-        int max_count = thrust::count(exec, levels.begin(), levels.end(), max_level);
-
-        if( max_count > 1 )
-        {
-            cusp::detail::temporary_array<IndexType, DerivedPolicy> max_level_vertices(exec, max_count);
-            cusp::detail::temporary_array<IndexType, DerivedPolicy> max_level_valence(exec, max_count);
-
-            thrust::copy_if(exec,
-                            thrust::counting_iterator<IndexType>(0),
-                            thrust::counting_iterator<IndexType>(G.num_rows),
-                            levels.begin(),
-                            max_level_vertices.begin(),
-                            thrust::placeholders::_1 == max_level);
-
-            thrust::gather(exec,
-                           thrust::counting_iterator<IndexType>(0),
-                           thrust::counting_iterator<IndexType>(max_count),
-                           row_lengths.begin(),
-                           max_level_valence.begin());
-
-            int min_valence_pos = thrust::min_element(exec, max_level_valence.begin(), max_level_valence.end()) - max_level_valence.begin();
-
-            y = max_level_vertices[min_valence_pos];
-        }
-        else
-        {
-            y = max_level_iter - levels.begin();
-        }
-
-        if( levels[y] <= delta ) break;
-
-        x = y;
-        delta = levels[y];
-    }
+        // root the next level structure at the vertex of smallest degree
+        // in the last level, its eccentricity is at least that of x
+        IndexType y = thrust::get<2>(x_key);
+
+        cusp::graph::breadth_first_search(exec, G, y, levels);
+        KeyType y_key = thrust::transform_reduce(exec,
+                                                 thrust::counting_iterator<IndexType>(0),
+                                                 thrust::counting_iterator<IndexType>(G.num_rows),
+                                                 key_op, init, thrust::minimum<KeyType>());
 
-    return y;
+        if( thrust::get<0>(y_key) >= thrust::get<0>(x_key) )
+            return y;
+
+        x_key = y_key;
+    }
 }
 
 } // end namespace generic
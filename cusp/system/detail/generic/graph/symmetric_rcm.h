@@ -15,13 +15,32 @@
  */
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
 
+#include <cusp/graph/connected_components.h>
 #include <cusp/graph/pseudo_peripheral.h>
 
+#include <thrust/binary_search.h>
+#include <thrust/copy.h>
 #include <thrust/execution_policy.h>
-#include <thrust/sequence.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/reduce.h>
+#include <thrust/remove.h>
+#include <thrust/reverse.h>
+#include <thrust/scan.h>
 #include <thrust/scatter.h>
+#include <thrust/sequence.h>
 #include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/unique.h>
+
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
 
 namespace cusp
 {
@@ -41,29 +60,231 @@ namespace detail
 namespace generic
 {
 
+namespace detail
+{
+
+// Returns the k-th out-edge of the frontier when it leads to a vertex
+// not reached yet and -1 otherwise. The tuple holds k and the position
+// of the frontier vertex owning the edge.
+template <typename MatrixType, typename Iterator>
+struct rcm_expand_functor
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    typename MatrixType::row_offsets_array_type::const_iterator    row_offsets;
+    typename MatrixType::column_indices_array_type::const_iterator column_indices;
+    Iterator frontier;
+    Iterator frontier_offsets;
+    Iterator levels;
+
+    rcm_expand_functor(const MatrixType& G, Iterator frontier, Iterator frontier_offsets, Iterator levels)
+        : row_offsets(G.row_offsets.begin()),
+          column_indices(G.column_indices.begin()),
+          frontier(frontier),
+          frontier_offsets(frontier_offsets),
+          levels(levels)
+    {}
+
+    template <typename Tuple>
+    __host__ __device__
+    IndexType operator()(const Tuple& t) const
+    {
+        IndexType k     = thrust::get<0>(t);
+        IndexType owner = thrust::get<1>(t);
+        IndexType u     = frontier[owner];
+        IndexType v     = column_indices[row_offsets[u] + k - frontier_offsets[owner]];
+
+        return (v >= 0 && levels[v] == -1) ? v : IndexType(-1);
+    }
+};
+
+template <typename IndexType>
+struct rcm_is_visited
+{
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) == IndexType(-1);
+    }
+};
+
+} // end namespace detail
+
+////////////////////////////////////////////////////////////////////////
+// Level synchronous Cuthill-McKee ordering
+///////////////////////////////////////////////////////////////////////
+//
+// The vertices are numbered one BFS level at a time. In the sequential
+// algorithm a vertex is numbered when the first of its parents in the
+// previous level is processed, after the other unvisited neighbors of
+// that parent of lower degree. Hence each new level is the ordering of
+// its vertices by (position of the first parent, degree, index), which
+// is computed for a whole level at once by expanding the out-edges of
+// the frontier and sorting.
+//
+// Every connected component is started from its own vertex and all of
+// them advance together. A component is started from a pseudo-peripheral
+// vertex when the graph is connected, otherwise from a vertex of minimum
+// degree. The levels keep the components in order of their labels, so
+// the components are made contiguous with a final stable sort. The
+// ordering is reversed to obtain the RCM permutation.
+//
 template<typename DerivedPolicy, typename MatrixType, typename PermutationType>
 void symmetric_rcm(thrust::execution_policy<DerivedPolicy>& exec,
                    const MatrixType& G,
                    PermutationType& P,
                    cusp::csr_format)
 {
-    typedef typename MatrixType::index_type IndexType;
-    typedef typename MatrixType::value_type ValueType;
-    typedef typename MatrixType::memory_space MemorySpace;
+    using namespace thrust::placeholders;
+
+    typedef typename MatrixType::index_type                       IndexType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> IndexArray;
+    typedef typename IndexArray::iterator                         IndexIterator;
+    typedef thrust::tuple<IndexType,IndexType>                    IndexTuple;
+
+    const IndexType N = G.num_rows;
+
+    if(N == 0)
+        return;
+
+    IndexArray degrees(exec, N);
+    thrust::transform(exec,
+                      G.row_offsets.begin() + 1, G.row_offsets.end(),
+                      G.row_offsets.begin(), degrees.begin(),
+                      thrust::minus<IndexType>());
+
+    IndexArray components(exec, N);
+    const size_t num_components = cusp::graph::connected_components(exec, G, components);
+
+    // Cuthill-McKee ordering and BFS level of every vertex
+    IndexArray order(exec, N);
+    IndexArray levels(exec, N);
+
+    // one start vertex per component, in order of the component labels
+    if(num_components == 1)
+    {
+        order[0] = cusp::graph::pseudo_peripheral_vertex(exec, G, levels);
+    }
+    else
+    {
+        IndexArray vertices(exec, N);
+        IndexArray keys(exec, components.begin(), components.end());
+        IndexArray start_degrees(exec, num_components);
+
+        thrust::sequence(exec, vertices.begin(), vertices.end());
+        thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), vertices.begin());
+
+        thrust::reduce_by_key(exec,
+                              keys.begin(), keys.end(),
+                              thrust::make_zip_iterator(thrust::make_tuple(
+                                  thrust::make_permutation_iterator(degrees.begin(), vertices.begin()),
+                                  vertices.begin())),
+                              thrust::make_discard_iterator(),
+                              thrust::make_zip_iterator(thrust::make_tuple(start_degrees.begin(), order.begin())),
+                              thrust::equal_to<IndexType>(),
+                              thrust::minimum<IndexTuple>());
+    }
+
+    thrust::fill(exec, levels.begin(), levels.end(), IndexType(-1));
+    thrust::scatter(exec,
+                    thrust::constant_iterator<IndexType>(0),
+                    thrust::constant_iterator<IndexType>(0) + num_components,
+                    order.begin(), levels.begin());
+
+    IndexArray offsets(exec, N);
+    IndexArray owners(exec);
+    IndexArray children(exec);
+    IndexArray child_degrees(exec);
+
+    size_t    level_begin = 0;
+    size_t    level_end   = num_components;
+    IndexType depth       = 0;
+
+    while(level_begin < level_end)
+    {
+        const size_t  width    = level_end - level_begin;
+        IndexIterator frontier = order.begin() + level_begin;
+
+        // position of the first out-edge of every frontier vertex
+        thrust::exclusive_scan(exec,
+                               thrust::make_permutation_iterator(degrees.begin(), frontier),
+                               thrust::make_permutation_iterator(degrees.begin(), frontier) + width,
+                               offsets.begin());
+
+        const IndexType last_vertex = order[level_end - 1];
+        const size_t    num_edges   = IndexType(offsets[width - 1]) + IndexType(degrees[last_vertex]);
+
+        if(num_edges == 0)
+            break;
+
+        // frontier vertex owning every out-edge
+        owners.resize(num_edges);
+        children.resize(num_edges);
+
+        thrust::upper_bound(exec,
+                            offsets.begin(), offsets.begin() + width,
+                            thrust::counting_iterator<IndexType>(0),
+                            thrust::counting_iterator<IndexType>(num_edges),
+                            owners.begin());
+        thrust::transform(exec, owners.begin(), owners.end(), owners.begin(), _1 - 1);
+
+        // unvisited neighbors paired with the position of their parent
+        thrust::transform(exec,
+                          thrust::make_zip_iterator(thrust::make_tuple(thrust::counting_iterator<IndexType>(0), owners.begin())),
+                          thrust::make_zip_iterator(thrust::make_tuple(thrust::counting_iterator<IndexType>(0), owners.begin())) + num_edges,
+                          children.begin(),
+                          detail::rcm_expand_functor<MatrixType,IndexIterator>(G, frontier, offsets.begin(), levels.begin()));
+
+        size_t num_children =
+            thrust::remove_if(exec,
+                              thrust::make_zip_iterator(thrust::make_tuple(children.begin(), owners.begin())),
+                              thrust::make_zip_iterator(thrust::make_tuple(children.end(), owners.end())),
+                              detail::rcm_is_visited<IndexType>())
+            - thrust::make_zip_iterator(thrust::make_tuple(children.begin(), owners.begin()));
+
+        if(num_children == 0)
+            break;
+
+        // keep the first parent of every child, the pairs are generated
+        // in parent order so a stable sort leaves it in front
+        thrust::stable_sort_by_key(exec, children.begin(), children.begin() + num_children, owners.begin());
+        num_children = thrust::unique_by_key(exec, children.begin(), children.begin() + num_children, owners.begin()).first
+                       - children.begin();
+
+        // order the children by (parent, degree, index)
+        child_degrees.resize(num_children);
+        thrust::gather(exec, children.begin(), children.begin() + num_children, degrees.begin(), child_degrees.begin());
+        thrust::stable_sort_by_key(exec, child_degrees.begin(), child_degrees.end(),
+                                   thrust::make_zip_iterator(thrust::make_tuple(children.begin(), owners.begin())));
+        thrust::stable_sort_by_key(exec, owners.begin(), owners.begin() + num_children, children.begin());
+
+        // append the new level
+        depth++;
+        thrust::copy(exec, children.begin(), children.begin() + num_children, order.begin() + level_end);
+        thrust::scatter(exec,
+                        thrust::constant_iterator<IndexType>(depth),
+                        thrust::constant_iterator<IndexType>(depth) + num_children,
+                        children.begin(), levels.begin());
 
-    // find peripheral vertex and return BFS levels from vertex
-    cusp::graph::pseudo_peripheral_vertex(exec, G, P.permutation);
+        level_begin = level_end;
+        level_end  += num_children;
+    }
 
-    // sort vertices by level in BFS traversal
-    cusp::detail::temporary_array<IndexType,DerivedPolicy> levels(exec, G.num_rows);
-    thrust::sequence(exec, levels.begin(), levels.end());
-    thrust::sort_by_key(exec, P.permutation.begin(), P.permutation.end(), levels.begin());
+    // make the components contiguous
+    if(num_components > 1)
+    {
+        IndexArray keys(exec, N);
+        thrust::gather(exec, order.begin(), order.end(), components.begin(), keys.begin());
+        thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), order.begin());
+    }
 
     // form RCM permutation matrix
+    thrust::reverse(exec, order.begin(), order.end());
     thrust::scatter(exec,
                     thrust::counting_iterator<IndexType>(0),
-                    thrust::counting_iterator<IndexType>(G.num_rows),
-                    levels.begin(), P.permutation.begin());
+                    thrust::counting_iterator<IndexType>(N),
+                    order.begin(), P.permutation.begin());
 }
 
 template <typename DerivedPolicy, typename MatrixType, typename PermutationType>
@@ -18,9 +18,25 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 #include <cusp/detail/type_traits.h>
 
+#include <cusp/array1d.h>
+#include <cusp/convert.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/format_utils.h>
+#include <cusp/sort.h>
+
+#include <thrust/copy.h>
 #include <thrust/execution_policy.h>
+#include <thrust/extrema.h>
+#include <thrust/gather.h>
+#include <thrust/remove.h>
+#include <thrust/unique.h>
+
+#include <thrust/iterator/zip_iterator.h>
 
 namespace cusp
 {
@@ -28,9 +44,11 @@ namespace graph
 {
 template <typename DerivedPolicy, typename MatrixType, typename ArrayType, typename Format>
 size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
-                     const MatrixType& G,
-                     ArrayType& colors,
-                     Format format);
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const vertex_ordering ordering,
+                       const size_t distance,
+                       Format format);
 } // end graph namespace
 
 namespace system
@@ -39,30 +57,187 @@ namespace detail
 {
 namespace generic
 {
+namespace detail
+{
+
+// entries with a negative column index, which mark unused entries
+struct block_invalid_entry
+{
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<1>(t) < 0;
+    }
+};
+
+// entries inside a single block
+struct block_diagonal_entry
+{
+    template <typename Tuple>
+    __host__ __device__
+    bool operator()(const Tuple& t) const
+    {
+        return thrust::get<0>(t) == thrust::get<1>(t);
+    }
+};
+
+} // end namespace detail
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t vertex_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    return cusp::graph::vertex_coloring(exec, G, colors, cusp::graph::natural_ordering, 1, format);
+}
 
 template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
 size_t vertex_coloring(thrust::execution_policy<DerivedPolicy>& exec,
-                     const MatrixType& G,
-                     ArrayType& colors)
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const cusp::graph::vertex_ordering ordering)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    return cusp::graph::vertex_coloring(exec, G, colors, ordering, 1, format);
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t vertex_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const cusp::graph::vertex_ordering ordering,
+                       const size_t distance)
 {
     typedef typename MatrixType::format Format;
 
     Format format;
 
-    return cusp::graph::vertex_coloring(exec, G, colors, format);
+    return cusp::graph::vertex_coloring(exec, G, colors, ordering, distance, format);
 }
 
 template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
 size_t vertex_coloring(thrust::execution_policy<DerivedPolicy>& exec,
                        const MatrixType& G,
                        ArrayType& colors,
+                       const cusp::graph::vertex_ordering ordering,
+                       const size_t distance,
                        cusp::known_format)
 {
     typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
 
     CsrMatrix G_csr(G);
 
-    return cusp::graph::vertex_coloring(exec, G_csr, colors);
+    return cusp::graph::vertex_coloring(exec, G_csr, colors, ordering, distance);
+}
+
+// Colors the graph of the blocks, in which two blocks are adjacent when
+// an edge of G joins them, and gives every vertex the color of its block
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType1, typename ArrayType2>
+size_t block_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors,
+                      const cusp::graph::vertex_ordering ordering,
+                      cusp::csr_format)
+{
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::memory_space MemorySpace;
+    typedef cusp::coo_matrix<IndexType,IndexType,MemorySpace> BlockGraph;
+
+    if(G.num_rows == 0)
+        return 0;
+
+    const IndexType num_blocks = *thrust::max_element(exec, blocks.begin(), blocks.end()) + 1;
+
+    BlockGraph Q(num_blocks, num_blocks, G.num_entries);
+
+    cusp::offsets_to_indices(exec, G.row_offsets, Q.row_indices);
+    thrust::copy(exec, G.column_indices.begin(), G.column_indices.end(), Q.column_indices.begin());
+
+    // replace the vertices of every edge by their blocks
+    size_t num_entries =
+        thrust::remove_if(exec,
+                          thrust::make_zip_iterator(thrust::make_tuple(Q.row_indices.begin(), Q.column_indices.begin())),
+                          thrust::make_zip_iterator(thrust::make_tuple(Q.row_indices.end(),   Q.column_indices.end())),
+                          detail::block_invalid_entry())
+        - thrust::make_zip_iterator(thrust::make_tuple(Q.row_indices.begin(), Q.column_indices.begin()));
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> vertices(exec, num_entries);
+
+    thrust::copy(exec, Q.row_indices.begin(), Q.row_indices.begin() + num_entries, vertices.begin());
+    thrust::gather(exec, vertices.begin(), vertices.end(), blocks.begin(), Q.row_indices.begin());
+    thrust::copy(exec, Q.column_indices.begin(), Q.column_indices.begin() + num_entries, vertices.begin());
+    thrust::gather(exec, vertices.begin(), vertices.end(), blocks.begin(), Q.column_indices.begin());
+
+    num_entries =
+        thrust::remove_if(exec,
+                          thrust::make_zip_iterator(thrust::make_tuple(Q.row_indices.begin(), Q.column_indices.begin())),
+                          thrust::make_zip_iterator(thrust::make_tuple(Q.row_indices.begin(), Q.column_indices.begin())) + num_entries,
+                          detail::block_diagonal_entry())
+        - thrust::make_zip_iterator(thrust::make_tuple(Q.row_indices.begin(), Q.column_indices.begin()));
+
+    Q.resize(num_blocks, num_blocks, num_entries);
+
+    if(num_entries > 0)
+    {
+        cusp::sort_by_row_and_column(exec, Q.row_indices, Q.column_indices, Q.values,
+                                     IndexType(0), num_blocks - 1, IndexType(0), num_blocks - 1);
+
+        num_entries =
+            thrust::unique(exec,
+                           thrust::make_zip_iterator(thrust::make_tuple(Q.row_indices.begin(), Q.column_indices.begin())),
+                           thrust::make_zip_iterator(thrust::make_tuple(Q.row_indices.end(),   Q.column_indices.end())))
+            - thrust::make_zip_iterator(thrust::make_tuple(Q.row_indices.begin(), Q.column_indices.begin()));
+
+        Q.resize(num_blocks, num_blocks, num_entries);
+    }
+
+    cusp::csr_matrix<IndexType,IndexType,MemorySpace> Q_csr;
+    cusp::convert(exec, Q, Q_csr);
+
+    cusp::array1d<IndexType, MemorySpace> block_colors(num_blocks);
+    const size_t num_colors = cusp::graph::vertex_coloring(exec, Q_csr, block_colors, ordering);
+
+    thrust::gather(exec, blocks.begin(), blocks.end(), block_colors.begin(), colors.begin());
+
+    return num_colors;
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType1, typename ArrayType2>
+size_t block_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors,
+                      const cusp::graph::vertex_ordering ordering,
+                      cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    return block_coloring(exec, G_csr, blocks, colors, ordering, cusp::csr_format());
+}
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType1, typename ArrayType2>
+size_t block_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& blocks,
+                      ArrayType2& colors,
+                      const cusp::graph::vertex_ordering ordering)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    return block_coloring(exec, G, blocks, colors, ordering, format);
 }
 
 } // end namespace generic
@@ -75,11 +250,13 @@ template <typename DerivedPolicy, typename MatrixType, typename ArrayType, typen
 size_t vertex_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
                        const MatrixType& G,
                        ArrayType& colors,
+                       const vertex_ordering ordering,
+                       const size_t distance,
                        Format format)
 {
     using cusp::system::detail::generic::vertex_coloring;
 
-    return vertex_coloring(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, colors, format);
+    return vertex_coloring(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, colors, ordering, distance, format);
 }
 } // end graph namespace
 } // end namespace cusp
@@ -25,6 +25,7 @@
 #include <cusp/system/detail/generic/multiply/generalized_spgemm.h>
 #include <cusp/system/detail/generic/multiply/permute.h>
 #include <cusp/system/detail/generic/multiply/spgemm.h>
+#include <cusp/system/detail/generic/multiply/spmm.h>
 #include <cusp/system/detail/generic/multiply/spmv.h>
 
 #include <thrust/functional.h>
@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <thrust/execution_policy.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace spmm_detail
+{
+
+template <typename DerivedPolicy,
+          typename LinearOperator, typename Vector1, typename Vector2,
+          typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply_column(thrust::execution_policy<DerivedPolicy> &exec,
+                     const LinearOperator& A,
+                     const Vector1& b,
+                     Vector2 c,
+                     UnaryFunction    initialize,
+                     BinaryFunction1  combine,
+                     BinaryFunction2  reduce)
+{
+    cusp::multiply(exec, A, b, c, initialize, combine, reduce);
+}
+
+template <typename LinearOperator, typename Vector1, typename Vector2>
+void apply_column(const LinearOperator& A,
+                  const Vector1& b,
+                  Vector2 c)
+{
+    const_cast<LinearOperator&>(A)(b, c);
+}
+
+} // end namespace spmm_detail
+
+// Sparse matrix times dense block fallback : every column of C is
+// formed by an independent SpMV with the corresponding column of B.
+// Systems with a native SpMM kernel provide a more specific overload.
+template <typename DerivedPolicy,
+          typename LinearOperator, typename MatrixOrVector1, typename MatrixOrVector2,
+          typename UnaryFunction,  typename BinaryFunction1, typename BinaryFunction2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              const LinearOperator&  A,
+              const MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              UnaryFunction    initialize,
+              BinaryFunction1  combine,
+              BinaryFunction2  reduce,
+              cusp::sparse_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    for(size_t j = 0; j < B.num_cols; j++)
+        spmm_detail::multiply_column(exec, A, B.column(j), C.column(j), initialize, combine, reduce);
+}
+
+// user-defined LinearOperator applied to each column of a dense block
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename MatrixOrVector1,
+          typename MatrixOrVector2>
+void multiply(thrust::execution_policy<DerivedPolicy> &exec,
+              const LinearOperator&  A,
+              const MatrixOrVector1& B,
+              MatrixOrVector2& C,
+              cusp::unknown_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    for(size_t j = 0; j < B.num_cols; j++)
+        spmm_detail::apply_column(A, B.column(j), C.column(j));
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,201 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <cusp/convert.h>
+#include <cusp/copy.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/format_utils.h>
+#include <cusp/sort.h>
+
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/transform.h>
+
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace detail
+{
+
+template <typename MatrixType, typename ArrayType>
+void reorder_check(const MatrixType& A, const ArrayType& permutation)
+{
+    if(A.num_rows != A.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if(permutation.size() != A.num_rows)
+        throw cusp::invalid_input_exception("permutation size must match the matrix dimension");
+}
+
+} // end namespace detail
+
+// COO format
+template <typename DerivedPolicy, typename MatrixType1, typename ArrayType, typename MatrixType2>
+void reorder(thrust::execution_policy<DerivedPolicy>& exec,
+             const MatrixType1& A, const ArrayType& permutation, MatrixType2& B, coo_format, coo_format)
+{
+    typedef typename MatrixType2::index_type IndexType;
+
+    detail::reorder_check(A, permutation);
+
+    B.resize(A.num_rows, A.num_cols, A.num_entries);
+
+    thrust::gather(exec, A.row_indices.begin(),    A.row_indices.end(),    permutation.begin(), B.row_indices.begin());
+    thrust::gather(exec, A.column_indices.begin(), A.column_indices.end(), permutation.begin(), B.column_indices.begin());
+    cusp::copy(exec, A.values, B.values);
+
+    if(A.num_entries == 0)
+        return;
+
+    const IndexType max_index = A.num_rows - 1;
+
+    cusp::sort_by_row_and_column(exec, B.row_indices, B.column_indices, B.values,
+                                 IndexType(0), max_index, IndexType(0), max_index);
+}
+
+// CSR format
+template <typename DerivedPolicy, typename MatrixType1, typename ArrayType, typename MatrixType2>
+void reorder(thrust::execution_policy<DerivedPolicy>& exec,
+             const MatrixType1& A, const ArrayType& permutation, MatrixType2& B, csr_format, csr_format)
+{
+    typedef typename MatrixType2::index_type IndexType;
+
+    detail::reorder_check(A, permutation);
+
+    const size_t N = A.num_rows;
+
+    B.resize(A.num_rows, A.num_cols, A.num_entries);
+
+    // inverse[permutation[i]] = i
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> inverse(exec, N);
+    thrust::scatter(exec,
+                    thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(N),
+                    permutation.begin(), inverse.begin());
+
+    // lengths of the permuted rows
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> shift(exec, N);
+    thrust::transform(exec,
+                      A.row_offsets.begin() + 1, A.row_offsets.end(),
+                      A.row_offsets.begin(),
+                      shift.begin(),
+                      thrust::minus<IndexType>());
+    thrust::gather(exec, inverse.begin(), inverse.end(), shift.begin(), B.row_offsets.begin());
+    B.row_offsets[N] = 0;
+    thrust::exclusive_scan(exec, B.row_offsets.begin(), B.row_offsets.end(), B.row_offsets.begin());
+
+    if(A.num_entries == 0)
+        return;
+
+    // every entry of a permuted row is read at a constant shift from
+    // the start of the original row
+    thrust::transform(exec,
+                      thrust::make_permutation_iterator(A.row_offsets.begin(), inverse.begin()),
+                      thrust::make_permutation_iterator(A.row_offsets.begin(), inverse.end()),
+                      B.row_offsets.begin(),
+                      shift.begin(),
+                      thrust::minus<IndexType>());
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_indices(exec, A.num_entries);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> source(exec, A.num_entries);
+
+    cusp::offsets_to_indices(exec, B.row_offsets, row_indices);
+
+    thrust::transform(exec,
+                      thrust::counting_iterator<IndexType>(0), thrust::counting_iterator<IndexType>(A.num_entries),
+                      thrust::make_permutation_iterator(shift.begin(), row_indices.begin()),
+                      source.begin(),
+                      thrust::plus<IndexType>());
+
+    thrust::gather(exec,
+                   thrust::make_permutation_iterator(A.column_indices.begin(), source.begin()),
+                   thrust::make_permutation_iterator(A.column_indices.begin(), source.end()),
+                   permutation.begin(),
+                   B.column_indices.begin());
+    thrust::gather(exec, source.begin(), source.end(), A.values.begin(), B.values.begin());
+
+    // restore the column order inside every row
+    const IndexType max_index = A.num_rows - 1;
+
+    cusp::sort_by_row_and_column(exec, row_indices, B.column_indices, B.values,
+                                 IndexType(0), max_index, IndexType(0), max_index);
+}
+
+template <typename DerivedPolicy, typename MatrixType1, typename ArrayType, typename MatrixType2,
+          typename Format1, typename Format2>
+void reorder(thrust::execution_policy<DerivedPolicy>& exec,
+             const MatrixType1& A, const ArrayType& permutation, MatrixType2& B, Format1, Format2)
+{
+    typedef typename cusp::detail::as_coo_type<MatrixType1>::type  CooType1;
+    typedef typename cusp::detail::as_coo_type<MatrixType2>::type  CooType2;
+
+    CooType1 A_coo;
+    CooType2 B_coo;
+
+    cusp::convert(exec, A, A_coo);
+
+    cusp::reorder(exec, A_coo, permutation, B_coo, coo_format(), coo_format());
+
+    cusp::convert(exec, B_coo, B);
+}
+
+template <typename DerivedPolicy, typename MatrixType1, typename ArrayType, typename MatrixType2>
+void reorder(thrust::execution_policy<DerivedPolicy>& exec,
+             const MatrixType1& A, const ArrayType& permutation, MatrixType2& B)
+{
+    typedef typename MatrixType1::format Format1;
+    typedef typename MatrixType2::format Format2;
+
+    Format1 format1;
+    Format2 format2;
+
+    cusp::reorder(exec, A, permutation, B, format1, format2);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+
+template <typename DerivedPolicy, typename MatrixType1, typename ArrayType, typename MatrixType2,
+          typename Format1, typename Format2>
+void reorder(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+             const MatrixType1& A, const ArrayType& permutation, MatrixType2& B, Format1, Format2)
+{
+    using cusp::system::detail::generic::reorder;
+
+    reorder(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, permutation, B,
+            Format1(), Format2());
+}
+
+} // end namespace cusp
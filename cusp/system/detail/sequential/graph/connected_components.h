@@ -15,18 +15,15 @@
  */
 #pragma once
 
-#include <stack>
-
 #include <cusp/detail/config.h>
 #include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
 #include <cusp/array1d.h>
 #include <cusp/exception.h>
 
 #include <cusp/system/detail/sequential/execution_policy.h>
 
-#include <thrust/fill.h>
-
 namespace cusp
 {
 namespace system
@@ -36,6 +33,12 @@ namespace detail
 namespace sequential
 {
 
+// Union-find connected components
+//
+// Every edge links the roots of its two endpoints, the larger root is
+// always attached below the smaller one and the paths are halved during
+// the searches. Hence parents[v] <= v and the root of each component is
+// its smallest vertex, which gives the labels in a single final sweep.
 template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
 size_t connected_components(sequential::execution_policy<DerivedPolicy>& exec,
                             const MatrixType& G,
@@ -46,32 +49,54 @@ size_t connected_components(sequential::execution_policy<DerivedPolicy>& exec,
 
     VertexId num_nodes = G.num_rows;
 
-    thrust::fill(components.begin(), components.begin() + num_nodes, -1);
-    std::stack<VertexId> DFS;
-    VertexId component = 0;
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> parents(exec, num_nodes);
+
+    for(VertexId i = 0; i < num_nodes; i++)
+        parents[i] = i;
 
     for(VertexId i = 0; i < num_nodes; i++)
     {
-        if(components[i] == -1)
+        for(VertexId jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
         {
-            DFS.push(i);
-            components[i] = component;
+            VertexId u = i;
+            VertexId v = G.column_indices[jj];
 
-            while (!DFS.empty())
+            if(v < 0)
+                continue;
+
+            // find the roots of u and v with path halving
+            while(parents[u] != u)
             {
-                VertexId top = DFS.top();
-                DFS.pop();
-
-                for(VertexId jj = G.row_offsets[top]; jj < G.row_offsets[top + 1]; jj++) {
-                    const VertexId j = G.column_indices[jj];
-                    if(components[j] == -1) {
-                        DFS.push(j);
-                        components[j] = component;
-                    }
-                }
+                parents[u] = parents[parents[u]];
+                u = parents[u];
             }
 
-            component++;
+            while(parents[v] != v)
+            {
+                parents[v] = parents[parents[v]];
+                v = parents[v];
+            }
+
+            if(u < v)
+                parents[v] = u;
+            else if(v < u)
+                parents[u] = v;
+        }
+    }
+
+    // label the components in order of their smallest vertex
+    VertexId component = 0;
+
+    for(VertexId i = 0; i < num_nodes; i++)
+    {
+        if(parents[i] == i)
+        {
+            components[i] = component++;
+        }
+        else
+        {
+            parents[i] = parents[parents[i]];
+            components[i] = components[parents[i]];
         }
     }
 
@@ -25,7 +25,6 @@
 #include <cusp/system/detail/sequential/execution_policy.h>
 
 #include <thrust/extrema.h>
-#include <thrust/gather.h>
 #include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/transform.h>
@@ -135,112 +134,124 @@ static const unsigned int *s3d[] =
     istate3d +160, istate3d +168, istate3d +176, istate3d +184
 };
 
-struct hilbert_transform_2d : public thrust::unary_function<double,double>
+// 2 bits per level in 2D and 3 bits per level in 3D
+typedef unsigned long long hilbert_key_type;
+
+inline hilbert_key_type hilbert_key_2d(const double x, const double y)
 {
-    template<typename Tuple>
-    __host__
-    double operator()(const Tuple& t) const
-    {
-        const double x = thrust::get<0>(t);
-        const double y = thrust::get<1>(t);
+    unsigned int c[2], temp, state;
+    hilbert_key_type key = 0;
+
+    // convert x,y coordinates to integers in range [0, IMAX]
+    c[0] = (unsigned int) (x * (double) IMAX);               // x
+    c[1] = (unsigned int) (y * (double) IMAX);               // y
+
+    // use state tables to convert nested quadrant's coordinates level by level
+    state = 0;
+    for (int level = 0; level < MAXLEVEL_2d; level++) {
+        temp = ((c[0] >> (30-level)) & 2)    // extract 2 bits at current level
+               | ((c[1] >> (31-level)) & 1);
+
+        // shift in converted coordinate
+        key = (key << 2) | *(d2d[state] + temp);
+
+        state = *(s2d[state] + temp);
+    }
+
+    return key;
+}
 
-        int level;
-        unsigned int key[2], c[2], temp, state;
+inline hilbert_key_type hilbert_key_3d(const double x, const double y, const double z)
+{
+    unsigned int c[3], temp, state;
+    hilbert_key_type key = 0;
+
+    // convert x,y,z coordinates to integers in range [0, IMAX]
+    c[0] = (unsigned int) (x * (double) IMAX);         // x
+    c[1] = (unsigned int) (y * (double) IMAX);         // y
+    c[2] = (unsigned int) (z * (double) IMAX);         // z
 
-        // convert x,y coordinates to integers in range [0, IMAX]
-        c[0] = (unsigned int) (x * (double) IMAX);               // x
-        c[1] = (unsigned int) (y * (double) IMAX);               // y
+    // use state tables to convert nested quadrant's coordinates level by level
+    state = 0;
+    for (int level = 0; level < MAXLEVEL_3d; level++) {
+        temp = ((c[0] >> (29-level)) & 4)  // extract 3 bits at current level
+               | ((c[1] >> (30-level)) & 2)
+               | ((c[2] >> (31-level)) & 1);
 
-        // use state tables to convert nested quadrant's coordinates level by level
-        key[0] = key[1] = 0;
-        state = 0;
-        for (level = 0; level < MAXLEVEL_2d; level++) {
-            temp = ((c[0] >> (30-level)) & 2)    // extract 2 bits at current level
-                   | ((c[1] >> (31-level)) & 1);
+        // shift in converted coordinate
+        key = (key << 3) | *(d3d[state] + temp);
 
-            // treat key[] as long shift register, shift in converted coordinate
-            key[0] = (key[0] << 2) | (key[1] >> 30);
-            key[1] = (key[1] << 2) | *(d2d[state] + temp);
+        state = *(s3d[state] + temp);
+    }
 
-            state = *(s2d[state] + temp);
-        }
+    return key;
+}
 
-        // convert 2 part Hilbert key to double and return
-        return ldexp ((double) key[0], -24)  +  ldexp ((double) key[1], -56);
+struct hilbert_transform_2d : public thrust::unary_function<double,hilbert_key_type>
+{
+    template<typename Tuple>
+    __host__
+    hilbert_key_type operator()(const Tuple& t) const
+    {
+        return hilbert_key_2d(thrust::get<0>(t), thrust::get<1>(t));
     }
 };
 
-struct hilbert_transform_3d : public thrust::unary_function<double,double>
+struct hilbert_transform_3d : public thrust::unary_function<double,hilbert_key_type>
 {
     template<typename Tuple>
     __host__
-    double operator()(const Tuple& t) const
+    hilbert_key_type operator()(const Tuple& t) const
     {
-        const double x = thrust::get<0>(t);
-        const double y = thrust::get<1>(t);
-        const double z = thrust::get<2>(t);
-
-        int level;
-        unsigned int key[2], c[3], temp, state;
-
-        // convert x,y,z coordinates to integers in range [0, IMAX]
-        c[0] = (unsigned int) (x * (double) IMAX);         // x
-        c[1] = (unsigned int) (y * (double) IMAX);         // y
-        c[2] = (unsigned int) (z * (double) IMAX);     		 // z
-
-        // use state tables to convert nested quadrant's coordinates level by level
-        key[0] = key[1] = 0;
-        state = 0;
-        for (level = 0; level < MAXLEVEL_3d; level++) {
-            temp = ((c[0] >> (29-level)) & 4)  // extract 3 bits at current level
-                   | ((c[1] >> (30-level)) & 2)
-                   | ((c[2] >> (31-level)) & 1);
-
-            // treat key[] as long shift register, shift in converted coordinate
-            key[0] = (key[0] << 3) |  (key[1] >> 29);
-            key[1] = (key[1] << 3) | *(d3d[state] + temp);
-
-            state = *(s3d[state] + temp);
-        }
-
-        // convert 2 part Hilbert key to double and return
-        return ldexp ((double) key[0], -25)  +  ldexp ((double) key[1], -57);
+        return hilbert_key_3d(thrust::get<0>(t), thrust::get<1>(t), thrust::get<2>(t));
     }
 };
 
-} // end namespace detail
+// number of significant bits of the keys of dims dimensional points
+inline int hilbert_key_bits(const size_t dims)
+{
+    return dims == 2 ? 2 * MAXLEVEL_2d : 3 * MAXLEVEL_3d;
+}
 
-template <typename DerivedPolicy, typename Array2d, typename Array1d>
-void hilbert_curve(sequential::execution_policy<DerivedPolicy>& exec,
-                   const Array2d& coord,
-                   size_t num_parts,
-                   Array1d& parts)
+// throws unless the points are 2 or 3 dimensional and inside the unit cube
+template <typename ExecutionPolicy, typename Array2d>
+void hilbert_check_coordinates(ExecutionPolicy& exec, const Array2d& coord)
 {
-    typedef typename Array1d::value_type PartType;
     typedef typename Array2d::const_column_view::iterator Iterator;
     typedef typename Array2d::value_type ValueType;
-    typedef typename Array2d::memory_space MemorySpace;
 
-    size_t num_points = coord.num_rows;
     size_t dims = coord.num_cols;
 
     if( (dims != 2) && (dims != 3) )
         throw cusp::invalid_input_exception("Hilbert curve partitioning only implemented for 2D or 3D data.");
 
-    thrust::pair<Iterator,Iterator> x_iter = thrust::minmax_element(exec, coord.column(0).begin(), coord.column(0).end());
-    thrust::pair<Iterator,Iterator> y_iter = thrust::minmax_element(exec, coord.column(1).begin(), coord.column(1).end());
+    for( size_t i = 0; i < dims; i++ )
+    {
+        thrust::pair<Iterator,Iterator> iter = thrust::minmax_element(exec, coord.column(i).begin(), coord.column(i).end());
+
+        if( coord.num_rows > 0 && (*iter.first < ValueType(0) || *iter.second > ValueType(1)) )
+            throw cusp::invalid_input_exception("Hilbert coordinates should be in the range [0,1]");
+    }
+}
+
+} // end namespace detail
+
+template <typename DerivedPolicy, typename Array2d, typename Array1d, typename ArrayType>
+void hilbert_curve(sequential::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                   size_t num_parts,
+                   Array1d& parts,
+                   ArrayType& permutation)
+{
+    typedef typename ArrayType::value_type IndexType;
 
-    ValueType xmin = *x_iter.first;
-    ValueType xmax = *x_iter.second;
-    ValueType ymin = *y_iter.first;
-    ValueType ymax = *y_iter.second;
+    size_t num_points = coord.num_rows;
 
-    if( xmin < ValueType(0) || xmax > ValueType(1) || ymin < ValueType(0) || ymax > ValueType(1) )
-        throw cusp::invalid_input_exception("Hilbert coordinates should be in the range [0,1]");
+    detail::hilbert_check_coordinates(exec, coord);
 
-    cusp::detail::temporary_array<double, DerivedPolicy> hilbert_keys(exec, coord.num_rows);
+    cusp::detail::temporary_array<detail::hilbert_key_type, DerivedPolicy> hilbert_keys(exec, num_points);
 
-    if( dims == 2 )
+    if( coord.num_cols == 2 )
     {
         thrust::transform(exec,
                           thrust::make_zip_iterator(thrust::make_tuple(coord.column(0).begin(), coord.column(1).begin())),
@@ -249,28 +260,22 @@ void hilbert_curve(sequential::execution_policy<DerivedPolicy>& exec,
     }
     else
     {
-        thrust::pair<Iterator,Iterator> z_iter = thrust::minmax_element(exec, coord.column(2).begin(), coord.column(2).end());
-        ValueType zmin = *z_iter.first;
-        ValueType zmax = *z_iter.second;
-
-        if( zmin < ValueType(0) || zmax > ValueType(1) )
-            throw cusp::invalid_input_exception("Hilbert coordinates should be in the range [0,1]");
-
         thrust::transform(exec,
                           thrust::make_zip_iterator(thrust::make_tuple(coord.column(0).begin(), coord.column(1).begin(), coord.column(2).begin())),
                           thrust::make_zip_iterator(thrust::make_tuple(coord.column(0).end(), coord.column(1).end(), coord.column(2).end())),
                           hilbert_keys.begin(), detail::hilbert_transform_3d());
     }
 
-    cusp::detail::temporary_array<PartType, DerivedPolicy> perm(exec, num_points);
-    thrust::sequence(exec, perm.begin(), perm.end());
-    thrust::sort_by_key(exec, hilbert_keys.begin(), hilbert_keys.end(), perm.begin());
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> order(exec, num_points);
+    thrust::sequence(exec, order.begin(), order.end());
+    thrust::stable_sort_by_key(exec, hilbert_keys.begin(), hilbert_keys.end(), order.begin());
 
-    cusp::detail::temporary_array<PartType, DerivedPolicy> uniform_parts(exec, num_points);
-    thrust::transform(exec,
-                      thrust::counting_iterator<PartType>(0), thrust::counting_iterator<PartType>(num_points),
-                      thrust::constant_iterator<PartType>(num_points/num_parts), uniform_parts.begin(), thrust::divides<PartType>());
-    thrust::gather(exec, perm.begin(), perm.end(), uniform_parts.begin(), parts.begin());
+    // consecutive runs of the curve form the parts
+    for( size_t n = 0; n < num_points; n++ )
+    {
+        permutation[order[n]] = n;
+        parts[order[n]] = n * num_parts / num_points;
+    }
 }
 
 } // end namespace sequential
@@ -22,6 +22,8 @@
 
 #include <cusp/system/detail/sequential/execution_policy.h>
 
+#include <vector>
+
 namespace cusp
 {
 namespace system
@@ -33,24 +35,37 @@ namespace sequential
 namespace detail
 {
 
-template <typename MatrixType, typename IndexType, typename ArrayType>
+// breadth-first sweep of the k-ring around i, lowering the distances to
+// the nearest MIS node. Each vertex is queued at most once per sweep.
+template <typename MatrixType, typename IndexType, typename ArrayType, typename QueueType>
 void propagate_distances(const MatrixType& A,
                          const IndexType i,
-                         const size_t d,
                          const size_t k,
-                         ArrayType& distance)
+                         ArrayType& distance,
+                         QueueType& queue)
 {
-    distance[i] = d;
+    queue.clear();
+    queue.push_back(i);
+    distance[i] = 0;
 
-    if (d < k)
+    for(size_t head = 0; head < queue.size(); head++)
     {
-        for(IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        const IndexType v = queue[head];
+        const size_t    d = distance[v];
+
+        if (d == k)
+            continue;
+
+        for(IndexType jj = A.row_offsets[v]; jj < A.row_offsets[v + 1]; jj++)
         {
             IndexType j = A.column_indices[jj];
 
             // update only if necessary
-            if (d + 1 < distance[j])
-                propagate_distances(A, j, d + 1, k, distance);
+            if (j >= 0 && d + 1 < distance[j])
+            {
+                distance[j] = d + 1;
+                queue.push_back(j);
+            }
         }
     }
 }
@@ -74,6 +89,8 @@ size_t maximal_independent_set(sequential::execution_policy<DerivedPolicy>& exec
     // count number of MIS nodes
     size_t set_nodes = 0;
 
+    std::vector<IndexType> queue;
+
     // pick MIS-k nodes greedily and deactivate all their k-neighbors
     for(IndexType i = 0; i < N; i++)
     {
@@ -82,7 +99,7 @@ size_t maximal_independent_set(sequential::execution_policy<DerivedPolicy>& exec
             set_nodes++;
 
             // reset distances on all k-ring neighbors
-            detail::propagate_distances(G, i, 0, k, distance);
+            detail::propagate_distances(G, i, k, distance, queue);
         }
     }
 
@@ -0,0 +1,666 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/transpose.h>
+
+#include <cusp/precond/aggregation/galerkin_product.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <algorithm>
+#include <deque>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+namespace partition_detail
+{
+
+// graphs with at most this many vertices are bisected directly
+const size_t coarsest_graph_size = 100;
+// number of initial bisections tried on the coarsest graph
+const size_t num_initial_bisections = 4;
+// maximum number of refinement passes per level
+const size_t num_refinement_passes = 8;
+// a refinement pass stops after this many moves without improvement
+const size_t max_unproductive_moves = 64;
+
+// Graph with weighted vertices and edges. The edge weights are stored
+// as the values of a CSR matrix, diagonal entries are ignored.
+template <typename IndexType>
+struct weighted_graph
+{
+    typedef cusp::csr_matrix<IndexType,IndexType,cusp::host_memory> matrix_type;
+    typedef cusp::array1d<IndexType,cusp::host_memory>              array_type;
+
+    matrix_type A;
+    array_type  vertex_weights;
+
+    size_t num_vertices(void) const
+    {
+        return A.num_rows;
+    }
+
+    IndexType total_weight(void) const
+    {
+        IndexType total = 0;
+
+        for(size_t i = 0; i < vertex_weights.size(); i++)
+            total += vertex_weights[i];
+
+        return total;
+    }
+};
+
+inline unsigned int partition_random(unsigned int& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// unit weight graph of a matrix without self loops and invalid entries
+template <typename MatrixType, typename IndexType>
+void matrix_graph(const MatrixType& G, weighted_graph<IndexType>& graph)
+{
+    const IndexType N = G.num_rows;
+
+    size_t num_edges = 0;
+
+    for(IndexType i = 0; i < N; i++)
+        for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+            if(G.column_indices[jj] >= 0 && G.column_indices[jj] != i)
+                num_edges++;
+
+    graph.A.resize(N, N, num_edges);
+    graph.vertex_weights.resize(N);
+
+    size_t n = 0;
+    graph.A.row_offsets[0] = 0;
+
+    for(IndexType i = 0; i < N; i++)
+    {
+        for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = G.column_indices[jj];
+
+            if(j >= 0 && j != i)
+            {
+                graph.A.column_indices[n] = j;
+                graph.A.values[n]         = 1;
+                n++;
+            }
+        }
+
+        graph.A.row_offsets[i + 1] = n;
+        graph.vertex_weights[i]    = 1;
+    }
+}
+
+// subgraph induced by a set of vertices, numbered in the given order
+template <typename IndexType>
+void induced_subgraph(const weighted_graph<IndexType>& graph,
+                      const std::vector<IndexType>& vertices,
+                      std::vector<IndexType>& local,
+                      weighted_graph<IndexType>& subgraph)
+{
+    const size_t N = vertices.size();
+
+    for(size_t i = 0; i < N; i++)
+        local[vertices[i]] = i;
+
+    size_t num_edges = 0;
+
+    for(size_t i = 0; i < N; i++)
+        for(IndexType jj = graph.A.row_offsets[vertices[i]]; jj < graph.A.row_offsets[vertices[i] + 1]; jj++)
+            if(local[graph.A.column_indices[jj]] != -1)
+                num_edges++;
+
+    subgraph.A.resize(N, N, num_edges);
+    subgraph.vertex_weights.resize(N);
+
+    size_t n = 0;
+    subgraph.A.row_offsets[0] = 0;
+
+    for(size_t i = 0; i < N; i++)
+    {
+        const IndexType v = vertices[i];
+
+        for(IndexType jj = graph.A.row_offsets[v]; jj < graph.A.row_offsets[v + 1]; jj++)
+        {
+            const IndexType j = local[graph.A.column_indices[jj]];
+
+            if(j != -1)
+            {
+                subgraph.A.column_indices[n] = j;
+                subgraph.A.values[n]         = graph.A.values[jj];
+                n++;
+            }
+        }
+
+        subgraph.A.row_offsets[i + 1] = n;
+        subgraph.vertex_weights[i]    = graph.vertex_weights[v];
+    }
+
+    for(size_t i = 0; i < N; i++)
+        local[vertices[i]] = -1;
+}
+
+// Heavy edge matching. The vertices are visited in random order and
+// every unmatched vertex is matched with the unmatched neighbor joined
+// by the heaviest edge, provided their combined weight stays below
+// max_weight. Returns the number of coarse vertices.
+template <typename IndexType>
+size_t heavy_edge_matching(const weighted_graph<IndexType>& graph,
+                           const IndexType max_weight,
+                           unsigned int& seed,
+                           cusp::array1d<IndexType,cusp::host_memory>& aggregates)
+{
+    const size_t N = graph.num_vertices();
+
+    std::vector<IndexType> order(N);
+    for(size_t i = 0; i < N; i++)
+        order[i] = i;
+    for(size_t i = N; i > 1; i--)
+        std::swap(order[i - 1], order[partition_random(seed) % i]);
+
+    aggregates.resize(N);
+    std::fill(aggregates.begin(), aggregates.end(), IndexType(-1));
+
+    size_t num_aggregates = 0;
+
+    for(size_t n = 0; n < N; n++)
+    {
+        const IndexType i = order[n];
+
+        if(aggregates[i] != -1)
+            continue;
+
+        IndexType match  = -1;
+        IndexType weight = 0;
+
+        for(IndexType jj = graph.A.row_offsets[i]; jj < graph.A.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = graph.A.column_indices[jj];
+
+            if(j != i && aggregates[j] == -1 &&
+               graph.A.values[jj] > weight &&
+               graph.vertex_weights[i] + graph.vertex_weights[j] <= max_weight)
+            {
+                match  = j;
+                weight = graph.A.values[jj];
+            }
+        }
+
+        aggregates[i] = num_aggregates;
+        if(match != -1)
+            aggregates[match] = num_aggregates;
+
+        num_aggregates++;
+    }
+
+    return num_aggregates;
+}
+
+// coarse graph R * A * P of the matched vertices
+template <typename IndexType>
+void contract_graph(const weighted_graph<IndexType>& graph,
+                    const cusp::array1d<IndexType,cusp::host_memory>& aggregates,
+                    const size_t num_aggregates,
+                    weighted_graph<IndexType>& coarse)
+{
+    typedef typename weighted_graph<IndexType>::matrix_type MatrixType;
+
+    const size_t N = graph.num_vertices();
+
+    MatrixType P(N, num_aggregates, N);
+    MatrixType R;
+
+    for(size_t i = 0; i < N; i++)
+    {
+        P.row_offsets[i]    = i;
+        P.column_indices[i] = aggregates[i];
+        P.values[i]         = 1;
+    }
+    P.row_offsets[N] = N;
+
+    cusp::transpose(P, R);
+    cusp::precond::aggregation::galerkin_product(R, graph.A, P, coarse.A);
+
+    coarse.vertex_weights.resize(num_aggregates);
+    std::fill(coarse.vertex_weights.begin(), coarse.vertex_weights.end(), IndexType(0));
+
+    for(size_t i = 0; i < N; i++)
+        coarse.vertex_weights[aggregates[i]] += graph.vertex_weights[i];
+}
+
+template <typename IndexType, typename ArrayType>
+IndexType bisection_cut(const weighted_graph<IndexType>& graph, const ArrayType& parts)
+{
+    IndexType cut = 0;
+
+    for(size_t i = 0; i < graph.num_vertices(); i++)
+        for(IndexType jj = graph.A.row_offsets[i]; jj < graph.A.row_offsets[i + 1]; jj++)
+            if(parts[graph.A.column_indices[jj]] != parts[i])
+                cut += graph.A.values[jj];
+
+    return cut / 2;
+}
+
+// Quality of a bisection: balanced bisections come first, then the
+// ones with the smaller cut and finally the better balanced ones.
+template <typename IndexType>
+struct bisection_quality
+{
+    bool      infeasible;
+    IndexType cut;
+    IndexType imbalance;
+
+    bisection_quality(IndexType weight0, IndexType target0, IndexType tolerance, IndexType cut)
+        : cut(cut)
+    {
+        imbalance  = weight0 > target0 ? weight0 - target0 : target0 - weight0;
+        infeasible = imbalance > tolerance;
+    }
+
+    bool operator<(const bisection_quality& other) const
+    {
+        if(infeasible != other.infeasible)
+            return other.infeasible;
+        if(cut != other.cut)
+            return cut < other.cut;
+        return imbalance < other.imbalance;
+    }
+};
+
+// Fiduccia-Mattheyses refinement of a bisection. Every pass moves each
+// vertex at most once, always taking the move of largest gain that does
+// not break the balance, and then rolls back to the best bisection seen.
+template <typename IndexType>
+void refine_bisection(const weighted_graph<IndexType>& graph,
+                      cusp::array1d<IndexType,cusp::host_memory>& parts,
+                      const IndexType target0,
+                      const IndexType tolerance)
+{
+    typedef std::set< std::pair<IndexType,IndexType> > GainSet;
+
+    const size_t N = graph.num_vertices();
+
+    std::vector<IndexType> gains(N);
+    std::vector<char>      locked(N);
+    std::vector<IndexType> moves;
+
+    for(size_t pass = 0; pass < num_refinement_passes; pass++)
+    {
+        IndexType weights[2] = {0, 0};
+        GainSet   queues[2];
+
+        for(size_t i = 0; i < N; i++)
+        {
+            IndexType internal = 0;
+            IndexType external = 0;
+
+            for(IndexType jj = graph.A.row_offsets[i]; jj < graph.A.row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = graph.A.column_indices[jj];
+
+                if(j == IndexType(i))
+                    continue;
+
+                if(parts[j] == parts[i])
+                    internal += graph.A.values[jj];
+                else
+                    external += graph.A.values[jj];
+            }
+
+            gains[i]  = external - internal;
+            locked[i] = 0;
+            weights[parts[i]] += graph.vertex_weights[i];
+
+            // only boundary vertices are candidates for a move
+            if(external > 0)
+                queues[parts[i]].insert(std::make_pair(-gains[i], IndexType(i)));
+        }
+
+        IndexType cut = bisection_cut(graph, parts);
+
+        bisection_quality<IndexType> initial(weights[0], target0, tolerance, cut);
+        bisection_quality<IndexType> best(initial);
+        size_t best_moves = 0;
+
+        moves.clear();
+
+        while(moves.size() - best_moves < max_unproductive_moves)
+        {
+            // best move from either side that does not worsen an
+            // infeasible balance or break a feasible one
+            IndexType vertex = -1;
+
+            for(int side = 0; side < 2; side++)
+            {
+                if(queues[side].empty())
+                    continue;
+
+                const IndexType v = queues[side].begin()->second;
+                const IndexType w = graph.vertex_weights[v];
+                const IndexType weight0 = side == 0 ? weights[0] - w : weights[0] + w;
+
+                bisection_quality<IndexType> before(weights[0], target0, tolerance, 0);
+                bisection_quality<IndexType> after(weight0, target0, tolerance, 0);
+
+                if(after.infeasible && after.imbalance >= before.imbalance)
+                    continue;
+
+                if(vertex == -1 || gains[v] > gains[vertex] ||
+                  (gains[v] == gains[vertex] && weights[side] > weights[parts[vertex]]))
+                    vertex = v;
+            }
+
+            if(vertex == -1)
+                break;
+
+            const IndexType from = parts[vertex];
+            const IndexType to   = 1 - from;
+
+            queues[from].erase(std::make_pair(-gains[vertex], vertex));
+            locked[vertex] = 1;
+            parts[vertex]  = to;
+            weights[from] -= graph.vertex_weights[vertex];
+            weights[to]   += graph.vertex_weights[vertex];
+            cut           -= gains[vertex];
+            gains[vertex]  = -gains[vertex];
+            moves.push_back(vertex);
+
+            for(IndexType jj = graph.A.row_offsets[vertex]; jj < graph.A.row_offsets[vertex + 1]; jj++)
+            {
+                const IndexType j = graph.A.column_indices[jj];
+
+                if(j == vertex || locked[j])
+                    continue;
+
+                queues[parts[j]].erase(std::make_pair(-gains[j], j));
+                gains[j] += parts[j] == from ? 2 * graph.A.values[jj] : -2 * graph.A.values[jj];
+                queues[parts[j]].insert(std::make_pair(-gains[j], j));
+            }
+
+            bisection_quality<IndexType> current(weights[0], target0, tolerance, cut);
+
+            if(current < best)
+            {
+                best       = current;
+                best_moves = moves.size();
+            }
+        }
+
+        // roll back the moves made after the best bisection
+        while(moves.size() > best_moves)
+        {
+            parts[moves.back()] = 1 - parts[moves.back()];
+            moves.pop_back();
+        }
+
+        if(!(best < initial))
+            break;
+    }
+}
+
+// Greedy graph growing bisection. Part 0 grows from a random vertex by
+// repeatedly absorbing the vertex of largest gain until it reaches its
+// target weight.
+template <typename IndexType>
+void grow_bisection(const weighted_graph<IndexType>& graph,
+                    const IndexType target0,
+                    unsigned int& seed,
+                    cusp::array1d<IndexType,cusp::host_memory>& parts)
+{
+    typedef std::set< std::pair<IndexType,IndexType> > GainSet;
+
+    const size_t N = graph.num_vertices();
+
+    parts.resize(N);
+    std::fill(parts.begin(), parts.end(), IndexType(1));
+
+    std::vector<IndexType> gains(N, 0);
+    GainSet frontier;
+
+    for(size_t i = 0; i < N; i++)
+        for(IndexType jj = graph.A.row_offsets[i]; jj < graph.A.row_offsets[i + 1]; jj++)
+            if(graph.A.column_indices[jj] != IndexType(i))
+                gains[i] -= graph.A.values[jj];
+
+    IndexType weight0 = 0;
+    size_t    next    = partition_random(seed) % N;
+
+    while(weight0 < target0)
+    {
+        IndexType vertex;
+
+        if(frontier.empty())
+        {
+            // start a new region, the graph may be disconnected
+            while(parts[next] == 0)
+                next = (next + 1) % N;
+
+            vertex = next;
+        }
+        else
+        {
+            vertex = frontier.begin()->second;
+            frontier.erase(frontier.begin());
+        }
+
+        parts[vertex] = 0;
+        weight0 += graph.vertex_weights[vertex];
+
+        for(IndexType jj = graph.A.row_offsets[vertex]; jj < graph.A.row_offsets[vertex + 1]; jj++)
+        {
+            const IndexType j = graph.A.column_indices[jj];
+
+            if(j == vertex || parts[j] == 0)
+                continue;
+
+            frontier.erase(std::make_pair(-gains[j], j));
+            gains[j] += 2 * graph.A.values[jj];
+            frontier.insert(std::make_pair(-gains[j], j));
+        }
+    }
+}
+
+// Multilevel bisection with part 0 of weight close to target0. The graph
+// is coarsened by heavy edge matching, the coarsest graph is bisected by
+// graph growing and the bisection is refined on the way back.
+template <typename IndexType>
+void multilevel_bisection(const weighted_graph<IndexType>& graph,
+                          const IndexType target0,
+                          unsigned int& seed,
+                          cusp::array1d<IndexType,cusp::host_memory>& parts)
+{
+    typedef cusp::array1d<IndexType,cusp::host_memory> ArrayType;
+
+    const IndexType total_weight = graph.total_weight();
+
+    std::deque< weighted_graph<IndexType> > levels;
+    std::vector< ArrayType > aggregates;
+
+    const weighted_graph<IndexType>* current = &graph;
+
+    while(current->num_vertices() > coarsest_graph_size)
+    {
+        const IndexType max_weight = std::max(IndexType(1), IndexType(3 * total_weight / (2 * coarsest_graph_size)));
+
+        aggregates.push_back(ArrayType());
+        size_t num_aggregates = heavy_edge_matching(*current, max_weight, seed, aggregates.back());
+
+        // stop when the matching no longer shrinks the graph
+        if(20 * num_aggregates > 19 * current->num_vertices())
+        {
+            aggregates.pop_back();
+            break;
+        }
+
+        // the elements of a deque stay in place when it grows
+        levels.push_back(weighted_graph<IndexType>());
+        contract_graph(*current, aggregates.back(), num_aggregates, levels.back());
+
+        current = &levels.back();
+    }
+
+    // the largest vertex weight bounds the achievable balance
+    IndexType max_vertex_weight = 0;
+    for(size_t i = 0; i < current->num_vertices(); i++)
+        max_vertex_weight = std::max(max_vertex_weight, IndexType(current->vertex_weights[i]));
+
+    IndexType tolerance = std::max(max_vertex_weight, IndexType(total_weight / 32));
+
+    ArrayType trial;
+    IndexType best_cut = 0;
+
+    for(size_t n = 0; n < num_initial_bisections; n++)
+    {
+        grow_bisection(*current, target0, seed, trial);
+        refine_bisection(*current, trial, target0, tolerance);
+
+        IndexType cut = bisection_cut(*current, trial);
+
+        if(n == 0 || cut < best_cut)
+        {
+            parts    = trial;
+            best_cut = cut;
+        }
+    }
+
+    // project the bisection to the finer graphs and refine it
+    tolerance = std::max(IndexType(1), IndexType(total_weight / 32));
+
+    for(size_t level = aggregates.size(); level > 0; level--)
+    {
+        const weighted_graph<IndexType>& fine = level > 1 ? levels[level - 2] : graph;
+        const ArrayType& aggregate = aggregates[level - 1];
+
+        trial.resize(fine.num_vertices());
+        for(size_t i = 0; i < fine.num_vertices(); i++)
+            trial[i] = parts[aggregate[i]];
+
+        refine_bisection(fine, trial, target0, tolerance);
+        parts.swap(trial);
+    }
+}
+
+// Recursive bisection of the given vertices into num_parts parts
+// numbered from first_part. Part 0 of every bisection receives the
+// weight of num_parts / 2 parts.
+template <typename IndexType, typename ArrayType>
+void recursive_bisection(const weighted_graph<IndexType>& graph,
+                         const std::vector<IndexType>& vertices,
+                         const size_t num_parts,
+                         const size_t first_part,
+                         unsigned int& seed,
+                         std::vector<IndexType>& local,
+                         ArrayType& parts)
+{
+    if(num_parts == 1 || vertices.size() <= 1)
+    {
+        for(size_t i = 0; i < vertices.size(); i++)
+            parts[vertices[i]] = first_part;
+
+        return;
+    }
+
+    weighted_graph<IndexType> subgraph;
+    induced_subgraph(graph, vertices, local, subgraph);
+
+    const size_t    num_parts0 = num_parts / 2;
+    const IndexType target0    = IndexType(double(subgraph.total_weight()) * num_parts0 / num_parts);
+
+    cusp::array1d<IndexType,cusp::host_memory> bisection;
+    multilevel_bisection(subgraph, target0, seed, bisection);
+
+    std::vector<IndexType> vertices0;
+    std::vector<IndexType> vertices1;
+
+    for(size_t i = 0; i < vertices.size(); i++)
+    {
+        if(bisection[i] == 0)
+            vertices0.push_back(vertices[i]);
+        else
+            vertices1.push_back(vertices[i]);
+    }
+
+    subgraph = weighted_graph<IndexType>();
+
+    recursive_bisection(graph, vertices0, num_parts0, first_part, seed, local, parts);
+    recursive_bisection(graph, vertices1, num_parts - num_parts0, first_part + num_parts0, seed, local, parts);
+}
+
+} // end namespace partition_detail
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t multilevel_partition(sequential::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            const size_t num_parts,
+                            ArrayType& parts,
+                            csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType N = G.num_rows;
+
+    partition_detail::weighted_graph<IndexType> graph;
+    partition_detail::matrix_graph(G, graph);
+
+    std::vector<IndexType> vertices(N);
+    std::vector<IndexType> local(N, IndexType(-1));
+
+    for(IndexType i = 0; i < N; i++)
+        vertices[i] = i;
+
+    unsigned int seed = 0x9e3779b9u;
+
+    partition_detail::recursive_bisection(graph, vertices, num_parts, 0, seed, local, parts);
+
+    // number of edges between distinct parts
+    size_t edge_cut = 0;
+
+    for(IndexType i = 0; i < N; i++)
+        for(IndexType jj = graph.A.row_offsets[i]; jj < graph.A.row_offsets[i + 1]; jj++)
+            if(parts[graph.A.column_indices[jj]] != parts[i])
+                edge_cut++;
+
+    return edge_cut / 2;
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::detail::sequential::multilevel_partition;
+
+} // end namespace cusp
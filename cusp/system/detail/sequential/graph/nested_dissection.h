@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/array1d.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+#include <cusp/system/detail/sequential/graph/multilevel_partition.h>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+namespace partition_detail
+{
+
+// subgraphs with at most this many vertices are not dissected further
+const size_t dissection_leaf_size = 64;
+
+// Vertex separator covering the cut edges of a bisection. The vertex
+// with the most uncovered cut edges joins the separator until every cut
+// edge is covered. The separator vertices are marked with part 2.
+template <typename IndexType>
+void vertex_separator(const weighted_graph<IndexType>& graph,
+                      cusp::array1d<IndexType,cusp::host_memory>& parts)
+{
+    typedef std::set< std::pair<IndexType,IndexType> > DegreeSet;
+
+    const size_t N = graph.num_vertices();
+
+    std::vector<IndexType> cut_degrees(N, 0);
+    DegreeSet candidates;
+
+    for(size_t i = 0; i < N; i++)
+    {
+        for(IndexType jj = graph.A.row_offsets[i]; jj < graph.A.row_offsets[i + 1]; jj++)
+            if(parts[graph.A.column_indices[jj]] != parts[i])
+                cut_degrees[i]++;
+
+        if(cut_degrees[i] > 0)
+            candidates.insert(std::make_pair(-cut_degrees[i], IndexType(i)));
+    }
+
+    while(!candidates.empty())
+    {
+        const IndexType vertex = candidates.begin()->second;
+        candidates.erase(candidates.begin());
+
+        for(IndexType jj = graph.A.row_offsets[vertex]; jj < graph.A.row_offsets[vertex + 1]; jj++)
+        {
+            const IndexType j = graph.A.column_indices[jj];
+
+            if(parts[j] == 2 || parts[j] == parts[vertex])
+                continue;
+
+            candidates.erase(std::make_pair(-cut_degrees[j], j));
+
+            if(--cut_degrees[j] > 0)
+                candidates.insert(std::make_pair(-cut_degrees[j], j));
+        }
+
+        parts[vertex] = 2;
+    }
+}
+
+// Nested dissection of the given vertices. Both sides of a separator
+// are ordered recursively before the separator itself, so the
+// separator rows are eliminated last.
+template <typename IndexType>
+void dissect(const weighted_graph<IndexType>& graph,
+             const std::vector<IndexType>& vertices,
+             unsigned int& seed,
+             std::vector<IndexType>& local,
+             std::vector<IndexType>& order)
+{
+    if(vertices.size() <= dissection_leaf_size)
+    {
+        order.insert(order.end(), vertices.begin(), vertices.end());
+        return;
+    }
+
+    weighted_graph<IndexType> subgraph;
+    induced_subgraph(graph, vertices, local, subgraph);
+
+    cusp::array1d<IndexType,cusp::host_memory> parts;
+    multilevel_bisection(subgraph, subgraph.total_weight() / 2, seed, parts);
+    vertex_separator(subgraph, parts);
+
+    std::vector<IndexType> vertices0;
+    std::vector<IndexType> vertices1;
+    std::vector<IndexType> separator;
+
+    for(size_t i = 0; i < vertices.size(); i++)
+    {
+        if(parts[i] == 0)
+            vertices0.push_back(vertices[i]);
+        else if(parts[i] == 1)
+            vertices1.push_back(vertices[i]);
+        else
+            separator.push_back(vertices[i]);
+    }
+
+    subgraph = weighted_graph<IndexType>();
+
+    // the separator does not split the subgraph
+    if(vertices0.empty() || vertices1.empty())
+    {
+        order.insert(order.end(), vertices.begin(), vertices.end());
+        return;
+    }
+
+    dissect(graph, vertices0, seed, local, order);
+    dissect(graph, vertices1, seed, local, order);
+
+    order.insert(order.end(), separator.begin(), separator.end());
+}
+
+} // end namespace partition_detail
+
+template<typename DerivedPolicy, typename MatrixType, typename PermutationType>
+void nested_dissection(sequential::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       PermutationType& P,
+                       csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType N = G.num_rows;
+
+    partition_detail::weighted_graph<IndexType> graph;
+    partition_detail::matrix_graph(G, graph);
+
+    std::vector<IndexType> vertices(N);
+    std::vector<IndexType> local(N, IndexType(-1));
+    std::vector<IndexType> order;
+
+    for(IndexType i = 0; i < N; i++)
+        vertices[i] = i;
+
+    order.reserve(N);
+
+    unsigned int seed = 0x9e3779b9u;
+
+    partition_detail::dissect(graph, vertices, seed, local, order);
+
+    for(IndexType i = 0; i < N; i++)
+        P.permutation[order[i]] = i;
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::detail::sequential::nested_dissection;
+
+} // end namespace cusp
@@ -15,4 +15,158 @@
  */
 #pragma once
 
-// this system has no special version of this algorithm
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <thrust/copy.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+namespace peripheral_detail
+{
+
+// Level structure rooted at src. The vertices are stored in queue in
+// the order they are reached, so the last level forms the tail of the
+// queue. Returns the number of vertices reached.
+template <typename MatrixType, typename IndexType>
+size_t level_structure(const MatrixType& G,
+                       const IndexType src,
+                       IndexType * levels,
+                       IndexType * queue)
+{
+    std::fill(levels, levels + G.num_rows, IndexType(-1));
+
+    size_t head = 0;
+    size_t tail = 1;
+
+    levels[src] = 0;
+    queue[0]    = src;
+
+    while(head < tail)
+    {
+        const IndexType u = queue[head++];
+
+        for(IndexType jj = G.row_offsets[u]; jj < G.row_offsets[u + 1]; jj++)
+        {
+            const IndexType v = G.column_indices[jj];
+
+            if(v >= 0 && levels[v] == -1)
+            {
+                levels[v]     = levels[u] + 1;
+                queue[tail++] = v;
+            }
+        }
+    }
+
+    return tail;
+}
+
+// Up to max_candidates vertices of the last level of a level structure
+// in order of increasing degree, ties broken by index.
+template <typename MatrixType, typename IndexType>
+size_t last_level_candidates(const MatrixType& G,
+                             const IndexType * levels,
+                             const IndexType * queue,
+                             const size_t num_reached,
+                             const size_t max_candidates,
+                             std::vector< std::pair<IndexType,IndexType> >& candidates)
+{
+    const IndexType depth = levels[queue[num_reached - 1]];
+
+    candidates.clear();
+
+    for(size_t n = num_reached; n > 0 && levels[queue[n - 1]] == depth; n--)
+    {
+        const IndexType v = queue[n - 1];
+        candidates.push_back(std::make_pair(G.row_offsets[v + 1] - G.row_offsets[v], v));
+    }
+
+    const size_t num_candidates = std::min(max_candidates, candidates.size());
+
+    std::partial_sort(candidates.begin(), candidates.begin() + num_candidates, candidates.end());
+    candidates.resize(num_candidates);
+
+    return num_candidates;
+}
+
+} // end namespace peripheral_detail
+
+////////////////////////////////////////////////////////////////////////
+// George-Liu pseudo-peripheral vertex search
+///////////////////////////////////////////////////////////////////////
+//
+// A level structure is rooted at the vertex of smallest degree in the
+// last level of the previous one until the eccentricity stops growing.
+// The two level structures alternate between two preallocated buffers
+// and the levels returned are those of the returned vertex.
+//
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(sequential::execution_policy<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                         ArrayType& levels,
+                         cusp::csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const size_t N = G.num_rows;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> level_buffers(exec, 2 * N);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> queue_buffers(exec, 2 * N);
+    std::vector< std::pair<IndexType,IndexType> > candidates;
+
+    IndexType * level_ptrs[2] = { &level_buffers[0], &level_buffers[N] };
+    IndexType * queue_ptrs[2] = { &queue_buffers[0], &queue_buffers[N] };
+
+    IndexType x = rand() % N;
+    size_t    num_reached = peripheral_detail::level_structure(G, x, level_ptrs[0], queue_ptrs[0]);
+    IndexType depth = level_ptrs[0][queue_ptrs[0][num_reached - 1]];
+
+    while(true)
+    {
+        peripheral_detail::last_level_candidates(G, level_ptrs[0], queue_ptrs[0], num_reached, 1, candidates);
+
+        const IndexType y         = candidates[0].second;
+        const size_t    y_reached = peripheral_detail::level_structure(G, y, level_ptrs[1], queue_ptrs[1]);
+        const IndexType y_depth   = level_ptrs[1][queue_ptrs[1][y_reached - 1]];
+
+        std::swap(level_ptrs[0], level_ptrs[1]);
+        std::swap(queue_ptrs[0], queue_ptrs[1]);
+
+        x           = y;
+        num_reached = y_reached;
+
+        // the eccentricity of y is at least that of the previous root
+        if(y_depth <= depth)
+            break;
+
+        depth = y_depth;
+    }
+
+    thrust::copy(exec, level_ptrs[0], level_ptrs[0] + N, levels.begin());
+
+    return x;
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::detail::sequential::pseudo_peripheral_vertex;
+
+} // end namespace cusp
@@ -25,6 +25,12 @@
 
 #include <cusp/system/detail/sequential/execution_policy.h>
 
+#include <thrust/fill.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 namespace cusp
 {
 namespace system
@@ -33,35 +39,270 @@ namespace detail
 {
 namespace sequential
 {
+namespace coloring_detail
+{
+
+// degree of every vertex, ignoring self loops and invalid entries
+template <typename MatrixType, typename ArrayType>
+typename MatrixType::index_type
+vertex_degrees(const MatrixType& G, ArrayType& degrees)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    IndexType max_degree = 0;
+
+    for(IndexType i = 0; i < IndexType(G.num_rows); i++)
+    {
+        IndexType degree = 0;
+
+        for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = G.column_indices[jj];
+
+            if(j >= 0 && j != i)
+                degree++;
+        }
+
+        degrees[i] = degree;
+        max_degree = std::max(max_degree, degree);
+    }
+
+    return max_degree;
+}
+
+// Fills order with the vertices of G in the sequence they are colored.
+// Largest-degree-first is a counting sort by degree and smallest-last
+// is the bucket based core decomposition of [Batagelj and Zaversnik].
+template <typename MatrixType, typename ArrayType>
+void vertex_order(const MatrixType& G,
+                  const cusp::graph::vertex_ordering ordering,
+                  ArrayType& order)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType N = G.num_rows;
+
+    if(ordering == cusp::graph::natural_ordering)
+    {
+        for(IndexType i = 0; i < N; i++)
+            order[i] = i;
+
+        return;
+    }
+
+    std::vector<IndexType> degrees(N);
+    const IndexType max_degree = vertex_degrees(G, degrees);
+
+    // start of every degree bucket
+    std::vector<IndexType> bins(max_degree + 2, 0);
+
+    for(IndexType i = 0; i < N; i++)
+        bins[degrees[i] + 1]++;
+
+    for(IndexType d = 0; d <= max_degree; d++)
+        bins[d + 1] += bins[d];
+
+    if(ordering == cusp::graph::largest_degree_first)
+    {
+        // ties are kept in increasing index order
+        for(IndexType i = N; i > 0; i--)
+            order[N - 1 - bins[degrees[i - 1]]++] = i - 1;
+
+        return;
+    }
+
+    // vertices sorted by their current degree, removed front to back
+    std::vector<IndexType> positions(N);
+    std::vector<IndexType> vertices(N);
+
+    for(IndexType i = 0; i < N; i++)
+    {
+        positions[i] = bins[degrees[i]]++;
+        vertices[positions[i]] = i;
+    }
+
+    for(IndexType d = max_degree; d > 0; d--)
+        bins[d] = bins[d - 1];
+    bins[0] = 0;
+
+    for(IndexType n = 0; n < N; n++)
+    {
+        const IndexType v = vertices[n];
+
+        for(IndexType jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+        {
+            const IndexType u = G.column_indices[jj];
+
+            if(u < 0 || u == v || degrees[u] <= degrees[v])
+                continue;
+
+            // move u to the front of its bucket and shrink the bucket
+            const IndexType du = degrees[u];
+            const IndexType pu = positions[u];
+            const IndexType pw = bins[du];
+            const IndexType w  = vertices[pw];
+
+            if(u != w)
+            {
+                positions[u] = pw;
+                positions[w] = pu;
+                vertices[pu] = w;
+                vertices[pw] = u;
+            }
+
+            bins[du]++;
+            degrees[u]--;
+        }
+
+        order[N - 1 - n] = v;
+    }
+}
+
+// Scratch space of visit_distance_k, kept across calls
+template <typename IndexType>
+struct distance_k_workspace
+{
+    std::vector<size_t>    stamps;
+    std::vector<IndexType> queue;
+    size_t                 stamp;
+
+    distance_k_workspace(void) : stamp(0) {}
+};
+
+// Calls visitor(u) for every vertex u != v within the given distance of
+// v and stops as soon as the visitor returns true. Distances 1 and 2
+// walk the rows directly and may visit a vertex more than once, larger
+// distances run a breadth-first search that marks the reached vertices
+// with a stamp unique to the call.
+template <typename MatrixType, typename Visitor>
+bool visit_distance_k(const MatrixType& G,
+                      const typename MatrixType::index_type v,
+                      const size_t distance,
+                      distance_k_workspace<typename MatrixType::index_type>& workspace,
+                      Visitor& visitor)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    if(distance <= 2)
+    {
+        for(IndexType jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+        {
+            const IndexType u = G.column_indices[jj];
+
+            if(u < 0 || u == v)
+                continue;
+
+            if(visitor(u))
+                return true;
+
+            if(distance == 1)
+                continue;
+
+            for(IndexType kk = G.row_offsets[u]; kk < G.row_offsets[u + 1]; kk++)
+            {
+                const IndexType w = G.column_indices[kk];
+
+                if(w >= 0 && w != v && visitor(w))
+                    return true;
+            }
+        }
+
+        return false;
+    }
+
+    if(workspace.stamps.size() < G.num_rows)
+        workspace.stamps.resize(G.num_rows, 0);
+
+    const size_t stamp = ++workspace.stamp;
+
+    workspace.queue.clear();
+    workspace.queue.push_back(v);
+    workspace.stamps[v] = stamp;
+
+    size_t level_begin = 0;
+
+    for(size_t level = 0; level < distance; level++)
+    {
+        const size_t level_end = workspace.queue.size();
+
+        for(size_t n = level_begin; n < level_end; n++)
+        {
+            const IndexType x = workspace.queue[n];
+
+            for(IndexType jj = G.row_offsets[x]; jj < G.row_offsets[x + 1]; jj++)
+            {
+                const IndexType u = G.column_indices[jj];
+
+                if(u < 0 || workspace.stamps[u] == stamp)
+                    continue;
+
+                workspace.stamps[u] = stamp;
+                workspace.queue.push_back(u);
+
+                if(visitor(u))
+                    return true;
+            }
+        }
+
+        level_begin = level_end;
+    }
+
+    return false;
+}
+
+// marks the colors used around a vertex
+template <typename ColorArray, typename MarkArray, typename IndexType>
+struct mark_colors
+{
+    const ColorArray& colors;
+    MarkArray& mark;
+    const IndexType vertex;
+
+    mark_colors(const ColorArray& colors, MarkArray& mark, const IndexType vertex)
+        : colors(colors), mark(mark), vertex(vertex) {}
+
+    bool operator()(const IndexType u)
+    {
+        mark[colors[u]] = vertex;
+        return false;
+    }
+};
+
+} // end namespace coloring_detail
 
 template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
 size_t vertex_coloring(sequential::execution_policy<DerivedPolicy>& exec,
                        const MatrixType& G,
                        ArrayType& colors,
+                       const cusp::graph::vertex_ordering ordering,
+                       const size_t distance,
                        csr_format)
 {
     typedef typename MatrixType::index_type IndexType;
+    typedef cusp::detail::temporary_array<size_t, DerivedPolicy> MarkArray;
 
     size_t max_color = 0;
     size_t N = G.num_rows;
 
     thrust::fill(exec, colors.begin(), colors.end(), N-1);
 
-    cusp::detail::temporary_array<size_t, DerivedPolicy> mark(exec, N, std::numeric_limits<IndexType>::max());
+    MarkArray mark(exec, N, std::numeric_limits<IndexType>::max());
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> order(exec, N);
+    coloring_detail::distance_k_workspace<IndexType> workspace;
+
+    coloring_detail::vertex_order(G, ordering, order);
 
-    for(size_t vertex = 0; vertex < N; vertex++)
+    for(size_t n = 0; n < N; n++)
     {
-        IndexType row_begin = G.row_offsets[vertex];
-        IndexType row_end   = G.row_offsets[vertex + 1];
+        IndexType vertex = order[n];
 
-        for(IndexType offset = row_begin; offset < row_end; offset++)
-        {
-            IndexType neighbor = G.column_indices[offset];
-            mark[colors[neighbor]] = vertex;
-        }
+        // uncolored vertices hold color N-1, which only the last vertex
+        // colored can need
+        coloring_detail::mark_colors<ArrayType, MarkArray, IndexType> visitor(colors, mark, vertex);
+        coloring_detail::visit_distance_k(G, vertex, distance, workspace, visitor);
 
         size_t vertex_color = 0;
-        while(vertex_color < max_color && mark[vertex_color] == vertex)
+        while(vertex_color < max_color && mark[vertex_color] == size_t(vertex))
             vertex_color++;
 
         if(vertex_color == max_color)
@@ -29,6 +29,9 @@
 #include <cusp/system/detail/sequential/multiply/array2d_mv.h>
 #include <cusp/system/detail/sequential/multiply/array2d_mm.h>
 
+#include <cusp/system/detail/sequential/multiply/csr_spmm.h>
+#include <cusp/system/detail/sequential/multiply/ell_spmm.h>
+
 #include <cusp/system/detail/sequential/multiply/csr_spgemm.h>
 #include <cusp/system/detail/sequential/multiply/coo_spgemm.h>
 
@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+#include <cusp/system/detail/sequential/multiply/spmm_utils.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+namespace spmm_detail
+{
+
+// C(i,:) <- reduce(initialize(C(i,:)), combine(A(i,:), B)) for rows
+// [row_begin, row_end). Columns of B and C are processed in tiles of
+// tile_width so every entry of A is loaded once per tile and the
+// innermost loop runs over contiguous accumulators.
+template <typename MatrixType,
+          typename ValueType1,
+          typename ValueType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void csr_spmm_rows(const MatrixType& A,
+                   const ValueType1* B, const size_t B_row_stride, const size_t B_column_stride,
+                   ValueType2* C,       const size_t C_row_stride, const size_t C_column_stride,
+                   const size_t num_columns,
+                   const size_t row_begin,
+                   const size_t row_end,
+                   UnaryFunction   initialize,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    ValueType2 accumulator[tile_width];
+
+    for(size_t tile_begin = 0; tile_begin < num_columns; tile_begin += tile_width)
+    {
+        const size_t width = std::min(tile_width, num_columns - tile_begin);
+
+        const ValueType1* B_tile = B + tile_begin * B_column_stride;
+        ValueType2*       C_tile = C + tile_begin * C_column_stride;
+
+        for(size_t i = row_begin; i < row_end; i++)
+        {
+            ValueType2* C_row = C_tile + i * C_row_stride;
+
+            for(size_t t = 0; t < width; t++)
+                accumulator[t] = initialize(C_row[t * C_column_stride]);
+
+            const IndexType row_start = A.row_offsets[i];
+            const IndexType row_stop  = A.row_offsets[i + 1];
+
+            for(IndexType jj = row_start; jj < row_stop; jj++)
+            {
+                const ValueType2  Aij   = A.values[jj];
+                const ValueType1* B_row = B_tile + A.column_indices[jj] * B_row_stride;
+
+                for(size_t t = 0; t < width; t++)
+                    accumulator[t] = reduce(accumulator[t], combine(Aij, ValueType2(B_row[t * B_column_stride])));
+            }
+
+            for(size_t t = 0; t < width; t++)
+                C_row[t * C_column_stride] = accumulator[t];
+        }
+    }
+}
+
+} // end namespace spmm_detail
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(sequential::execution_policy<DerivedPolicy>& exec,
+              const MatrixType1& A,
+              const MatrixType2& B,
+              MatrixType3& C,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csr_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    if(C.num_entries == 0)
+        return;
+
+    spmm_detail::csr_spmm_rows(A,
+                               spmm_detail::raw_values(B), spmm_detail::row_stride(B), spmm_detail::column_stride(B),
+                               spmm_detail::raw_values(C), spmm_detail::row_stride(C), spmm_detail::column_stride(C),
+                               C.num_cols, 0, A.num_rows,
+                               initialize, combine, reduce);
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
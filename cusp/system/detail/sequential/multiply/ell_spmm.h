@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+#include <cusp/system/detail/sequential/multiply/spmm_utils.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+namespace spmm_detail
+{
+
+// ELL counterpart of csr_spmm_rows, padded entries are skipped
+template <typename MatrixType,
+          typename ValueType1,
+          typename ValueType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void ell_spmm_rows(const MatrixType& A,
+                   const ValueType1* B, const size_t B_row_stride, const size_t B_column_stride,
+                   ValueType2* C,       const size_t C_row_stride, const size_t C_column_stride,
+                   const size_t num_columns,
+                   const size_t row_begin,
+                   const size_t row_end,
+                   UnaryFunction   initialize,
+                   BinaryFunction1 combine,
+                   BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const size_t num_entries_per_row = A.column_indices.num_cols;
+
+    const IndexType invalid_index = MatrixType::invalid_index;
+
+    ValueType2 accumulator[tile_width];
+
+    for(size_t tile_begin = 0; tile_begin < num_columns; tile_begin += tile_width)
+    {
+        const size_t width = std::min(tile_width, num_columns - tile_begin);
+
+        const ValueType1* B_tile = B + tile_begin * B_column_stride;
+        ValueType2*       C_tile = C + tile_begin * C_column_stride;
+
+        for(size_t i = row_begin; i < row_end; i++)
+        {
+            ValueType2* C_row = C_tile + i * C_row_stride;
+
+            for(size_t t = 0; t < width; t++)
+                accumulator[t] = initialize(C_row[t * C_column_stride]);
+
+            for(size_t n = 0; n < num_entries_per_row; n++)
+            {
+                const IndexType j = A.column_indices(i, n);
+
+                if(j == invalid_index)
+                    continue;
+
+                const ValueType2  Aij   = A.values(i, n);
+                const ValueType1* B_row = B_tile + j * B_row_stride;
+
+                for(size_t t = 0; t < width; t++)
+                    accumulator[t] = reduce(accumulator[t], combine(Aij, ValueType2(B_row[t * B_column_stride])));
+            }
+
+            for(size_t t = 0; t < width; t++)
+                C_row[t * C_column_stride] = accumulator[t];
+        }
+    }
+}
+
+} // end namespace spmm_detail
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(sequential::execution_policy<DerivedPolicy>& exec,
+              const MatrixType1& A,
+              const MatrixType2& B,
+              MatrixType3& C,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::ell_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    if(C.num_entries == 0)
+        return;
+
+    spmm_detail::ell_spmm_rows(A,
+                               spmm_detail::raw_values(B), spmm_detail::row_stride(B), spmm_detail::column_stride(B),
+                               spmm_detail::raw_values(C), spmm_detail::row_stride(C), spmm_detail::column_stride(C),
+                               C.num_cols, 0, A.num_rows,
+                               initialize, combine, reduce);
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/array2d_format_utils.h>
+
+#include <thrust/memory.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+namespace spmm_detail
+{
+
+// Number of dense columns accumulated in registers during one pass over
+// a sparse row. Blocks with more columns are processed in tiles of this
+// width so the working set of B and C stays in cache.
+const size_t tile_width = 16;
+
+// raw pointer to the first entry of a host dense block, NULL if empty
+template <typename Array2d>
+const typename Array2d::value_type* raw_values(const Array2d& A)
+{
+    return A.num_entries == 0 ? NULL : thrust::raw_pointer_cast(&A.values[0]);
+}
+
+template <typename Array2d>
+typename Array2d::value_type* raw_values(Array2d& A)
+{
+    return A.num_entries == 0 ? NULL : thrust::raw_pointer_cast(&A.values[0]);
+}
+
+// distance between consecutive rows of a dense block
+template <typename Array2d>
+size_t row_stride(const Array2d& A)
+{
+    return cusp::detail::index_of(size_t(1), size_t(0), size_t(A.pitch), typename Array2d::orientation());
+}
+
+// distance between consecutive columns of a dense block
+template <typename Array2d>
+size_t column_stride(const Array2d& A)
+{
+    return cusp::detail::index_of(size_t(0), size_t(1), size_t(A.pitch), typename Array2d::orientation());
+}
+
+} // end namespace spmm_detail
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -17,5 +17,331 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/copy.h>
+#include <cusp/format_utils.h>
+
+#include <thrust/sort.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+
+////////////////////////////////////////////////////////////////////////
+// Direction-optimizing BFS for the OpenMP system [Beamer et al. 2012]
+///////////////////////////////////////////////////////////////////////
+//
+// The traversal is level synchronous and every level is expanded in
+// one of two directions.
+//
+// top-down
+//   Threads scan the out-edges of the vertices in the frontier queue
+//   and claim undiscovered neighbors with an atomic exchange on a
+//   visited flag. Claimed vertices are gathered in per-thread queues.
+//
+// bottom-up
+//   Every undiscovered vertex scans its in-edges for a parent in the
+//   frontier bitmap and stops at the first one found. Each vertex is
+//   only written by the thread owning it so no atomics are needed.
+//   The in-edges are those of the transposed pattern, which is built
+//   the first time the search switches to this direction.
+//
+// The search goes bottom-up once the out-edges of the frontier exceed
+// a fraction 1/alpha of the edges still unexplored, and returns to
+// top-down once the frontier is growing no more and holds fewer than
+// num_vertices/beta vertices.
+//
+
+namespace detail
+{
+
+const int bfs_alpha = 15;
+const int bfs_beta  = 18;
+
+// atomically sets the visited flag of v, true if it was not set yet
+inline bool bfs_claim(char * visited, const int v)
+{
+    char old;
+
+    #pragma omp atomic capture
+    { old = visited[v]; visited[v] = 1; }
+
+    return old == 0;
+}
+
+inline bool bfs_is_visited(char * visited, const int v)
+{
+    char flag;
+
+    #pragma omp atomic read
+    flag = visited[v];
+
+    return flag != 0;
+}
+
+// appends the per-thread list to the shared queue
+template <typename VertexId>
+void bfs_append(const std::vector<VertexId>& local, VertexId * queue, size_t& queue_size)
+{
+    size_t offset;
+
+    #pragma omp atomic capture
+    { offset = queue_size; queue_size += local.size(); }
+
+    std::copy(local.begin(), local.end(), queue + offset);
+}
+
+// expands the frontier queue along the out-edges of G, returns the
+// number of out-edges of the next frontier
+template <typename MatrixType, typename VertexId>
+size_t bfs_top_down_step(const MatrixType& G,
+                         const VertexId * queue, const size_t queue_size,
+                         VertexId * next_queue,  size_t& next_queue_size,
+                         VertexId * levels, VertexId * predecessors, char * visited,
+                         const VertexId depth)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    size_t scout_count = 0;
+
+    next_queue_size = 0;
+
+    #pragma omp parallel
+    {
+        std::vector<VertexId> local;
+        size_t local_scout_count = 0;
+
+        #pragma omp for schedule(dynamic, 64) nowait
+        for(int q = 0; q < int(queue_size); q++)
+        {
+            const VertexId u = queue[q];
+
+            for(IndexType jj = G.row_offsets[u]; jj < G.row_offsets[u + 1]; jj++)
+            {
+                const VertexId v = G.column_indices[jj];
+
+                if(v == VertexId(-1) || bfs_is_visited(visited, v) || !bfs_claim(visited, v))
+                    continue;
+
+                levels[v] = depth + 1;
+
+                if(predecessors != NULL)
+                    predecessors[v] = u;
+
+                local.push_back(v);
+                local_scout_count += G.row_offsets[v + 1] - G.row_offsets[v];
+            }
+        }
+
+        bfs_append(local, next_queue, next_queue_size);
+
+        #pragma omp atomic
+        scout_count += local_scout_count;
+    }
+
+    return scout_count;
+}
+
+// every undiscovered vertex looks for a parent in the frontier bitmap,
+// returns the size of the next frontier
+template <typename Array1, typename Array2, typename VertexId>
+size_t bfs_bottom_up_step(const Array1& GT_row_offsets, const Array2& GT_column_indices,
+                          const int num_vertices,
+                          const char * frontier, char * next_frontier,
+                          VertexId * levels, VertexId * predecessors, char * visited,
+                          const VertexId depth)
+{
+    typedef typename Array1::value_type IndexType;
+
+    long awake_count = 0;
+
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+:awake_count)
+    for(int v = 0; v < num_vertices; v++)
+    {
+        next_frontier[v] = 0;
+
+        if(levels[v] != VertexId(-1))
+            continue;
+
+        for(IndexType jj = GT_row_offsets[v]; jj < GT_row_offsets[v + 1]; jj++)
+        {
+            const VertexId u = GT_column_indices[jj];
+
+            if(frontier[u])
+            {
+                levels[v] = depth + 1;
+
+                if(predecessors != NULL)
+                    predecessors[v] = u;
+
+                visited[v]       = 1;
+                next_frontier[v] = 1;
+                awake_count++;
+                break;
+            }
+        }
+    }
+
+    return awake_count;
+}
+
+template <typename VertexId>
+void bfs_queue_to_bitmap(const VertexId * queue, const size_t queue_size,
+                         const int num_vertices, char * frontier)
+{
+    #pragma omp parallel for
+    for(int v = 0; v < num_vertices; v++)
+        frontier[v] = 0;
+
+    #pragma omp parallel for
+    for(int q = 0; q < int(queue_size); q++)
+        frontier[queue[q]] = 1;
+}
+
+template <typename VertexId>
+void bfs_bitmap_to_queue(const char * frontier, const int num_vertices,
+                         VertexId * queue, size_t& queue_size)
+{
+    queue_size = 0;
+
+    #pragma omp parallel
+    {
+        std::vector<VertexId> local;
+
+        #pragma omp for schedule(static) nowait
+        for(int v = 0; v < num_vertices; v++)
+            if(frontier[v])
+                local.push_back(v);
+
+        bfs_append(local, queue, queue_size);
+    }
+}
+
+} // end namespace detail
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void breadth_first_search(omp::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const typename MatrixType::index_type src,
+                          ArrayType& labels,
+                          const bool mark_levels,
+                          cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const int num_vertices = G.num_rows;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> levels(exec, num_vertices, VertexId(-1));
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> predecessors(exec, mark_levels ? 0 : num_vertices, VertexId(-1));
+    cusp::detail::temporary_array<char, DerivedPolicy>     visited(exec, num_vertices, 0);
+
+    if(G.num_entries == 0)
+    {
+        cusp::copy(exec, levels, labels);
+        return;
+    }
+
+    // the frontier is kept as a queue while going top-down and as a
+    // bitmap while going bottom-up
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> queue(exec, num_vertices);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> next_queue(exec, num_vertices);
+    cusp::detail::temporary_array<char, DerivedPolicy>     frontier(exec, num_vertices);
+    cusp::detail::temporary_array<char, DerivedPolicy>     next_frontier(exec, num_vertices);
+
+    // in-edges for the bottom-up steps
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> GT_row_offsets(exec);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> GT_column_indices(exec);
+
+    VertexId * levels_ptr       = thrust::raw_pointer_cast(levels.data());
+    VertexId * predecessors_ptr = mark_levels ? NULL : thrust::raw_pointer_cast(predecessors.data());
+    char     * visited_ptr      = thrust::raw_pointer_cast(visited.data());
+
+    VertexId * queue_ptr         = thrust::raw_pointer_cast(queue.data());
+    VertexId * next_queue_ptr    = thrust::raw_pointer_cast(next_queue.data());
+    char     * frontier_ptr      = thrust::raw_pointer_cast(frontier.data());
+    char     * next_frontier_ptr = thrust::raw_pointer_cast(next_frontier.data());
+
+    levels_ptr[src]  = 0;
+    visited_ptr[src] = 1;
+
+    if(!mark_levels)
+        predecessors_ptr[src] = -2;
+
+    queue_ptr[0] = src;
+
+    size_t   queue_size     = 1;
+    size_t   edges_to_check = G.num_entries;
+    size_t   scout_count    = G.row_offsets[src + 1] - G.row_offsets[src];
+    VertexId depth          = 0;
+
+    while(queue_size > 0)
+    {
+        if(scout_count > edges_to_check / detail::bfs_alpha)
+        {
+            if(GT_row_offsets.size() == 0)
+            {
+                // transpose the pattern of G by sorting its entries by column
+                GT_row_offsets.resize(num_vertices + 1);
+                GT_column_indices.resize(G.num_entries);
+
+                cusp::detail::temporary_array<VertexId, DerivedPolicy> column_indices(exec, G.column_indices.begin(), G.column_indices.end());
+
+                cusp::offsets_to_indices(exec, G.row_offsets, GT_column_indices);
+                thrust::stable_sort_by_key(exec, column_indices.begin(), column_indices.end(), GT_column_indices.begin());
+                cusp::indices_to_offsets(exec, column_indices, GT_row_offsets);
+            }
+
+            detail::bfs_queue_to_bitmap(queue_ptr, queue_size, num_vertices, frontier_ptr);
+
+            size_t awake_count = queue_size;
+            size_t old_awake_count;
+
+            do
+            {
+                old_awake_count = awake_count;
+                awake_count = detail::bfs_bottom_up_step(GT_row_offsets, GT_column_indices, num_vertices,
+                                                         frontier_ptr, next_frontier_ptr,
+                                                         levels_ptr, predecessors_ptr, visited_ptr, depth);
+                std::swap(frontier_ptr, next_frontier_ptr);
+                depth++;
+            } while(awake_count > 0 &&
+                    (awake_count >= old_awake_count || awake_count > size_t(num_vertices / detail::bfs_beta)));
+
+            detail::bfs_bitmap_to_queue(frontier_ptr, num_vertices, queue_ptr, queue_size);
+            scout_count = 1;
+        }
+        else
+        {
+            size_t next_queue_size;
+
+            edges_to_check -= std::min(scout_count, edges_to_check);
+            scout_count = detail::bfs_top_down_step(G, queue_ptr, queue_size, next_queue_ptr, next_queue_size,
+                                                    levels_ptr, predecessors_ptr, visited_ptr, depth);
+            std::swap(queue_ptr, next_queue_ptr);
+            queue_size = next_queue_size;
+            depth++;
+        }
+    }
+
+    // copy levels or predecessors into the outgoing array
+    if(mark_levels)
+        cusp::copy(exec, levels, labels);
+    else
+        cusp::copy(exec, predecessors, labels);
+}
+
+} // end namespace omp
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::omp::breadth_first_search;
+
+} // end namespace cusp
@@ -17,5 +17,237 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+
+////////////////////////////////////////////////////////////////////////
+// Afforest connected components for the OpenMP system [Sutton et al. 2018]
+///////////////////////////////////////////////////////////////////////
+//
+// Every vertex holds a parent pointer and the components are trees of
+// parents. The trees are merged by Shiloach-Vishkin hooking, where an
+// edge (u,v) attaches the root of the larger label below the smaller
+// label, and flattened again by pointer jumping after every pass. The
+// hooking races are benign: a lost hook is redone in the next pass and
+// a parent only ever moves to a smaller label, so no cycles are formed
+// and the root of every tree is the smallest vertex of its component.
+//
+// The first neighbor_rounds neighbors of every vertex are linked first.
+// This is enough to merge most of the largest component, which is then
+// found by sampling the parents and skipped while the remaining edges
+// are processed. The skip relies on the graph being symmetric.
+//
+
+namespace detail
+{
+
+const int cc_neighbor_rounds = 2;
+const int cc_num_samples     = 1024;
+
+template <typename VertexId>
+inline VertexId cc_load(VertexId * parents, const VertexId v)
+{
+    VertexId p;
+
+    #pragma omp atomic read
+    p = parents[v];
+
+    return p;
+}
+
+template <typename VertexId>
+inline void cc_store(VertexId * parents, const VertexId v, const VertexId p)
+{
+    #pragma omp atomic write
+    parents[v] = p;
+}
+
+// hooks the roots across the edges [row_offsets[u] + first, row_offsets[u] + last)
+// of every vertex u not labeled skip, true if any root was hooked
+template <typename MatrixType, typename VertexId>
+bool cc_hook(const MatrixType& G, VertexId * parents,
+             const size_t first, const size_t last, const VertexId skip)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const int num_vertices = G.num_rows;
+
+    int changed = 0;
+
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(|:changed)
+    for(int u = 0; u < num_vertices; u++)
+    {
+        if(cc_load(parents, VertexId(u)) == skip)
+            continue;
+
+        const size_t degree = G.row_offsets[u + 1] - G.row_offsets[u];
+        const IndexType jj_begin = G.row_offsets[u] + std::min(first, degree);
+        const IndexType jj_end   = G.row_offsets[u] + std::min(last,  degree);
+
+        for(IndexType jj = jj_begin; jj < jj_end; jj++)
+        {
+            const VertexId v = G.column_indices[jj];
+
+            if(v < 0)
+                continue;
+
+            const VertexId pu = cc_load(parents, VertexId(u));
+            const VertexId pv = cc_load(parents, v);
+
+            if(pu < pv && cc_load(parents, pv) == pv)
+            {
+                cc_store(parents, pv, pu);
+                changed = 1;
+            }
+            else if(pv < pu && cc_load(parents, pu) == pu)
+            {
+                cc_store(parents, pu, pv);
+                changed = 1;
+            }
+        }
+    }
+
+    return changed != 0;
+}
+
+// pointer jumping, points every vertex to the root of its tree
+template <typename VertexId>
+void cc_compress(VertexId * parents, const int num_vertices)
+{
+    #pragma omp parallel for schedule(static, 1024)
+    for(int v = 0; v < num_vertices; v++)
+    {
+        VertexId p  = cc_load(parents, VertexId(v));
+        VertexId pp = cc_load(parents, p);
+
+        while(p != pp)
+        {
+            cc_store(parents, VertexId(v), pp);
+            p  = pp;
+            pp = cc_load(parents, p);
+        }
+    }
+}
+
+// hooks and compresses until the edges in the window are all inside trees
+template <typename MatrixType, typename VertexId>
+void cc_link(const MatrixType& G, VertexId * parents,
+             const size_t first, const size_t last, const VertexId skip)
+{
+    bool changed;
+
+    do
+    {
+        changed = cc_hook(G, parents, first, last, skip);
+        cc_compress(parents, G.num_rows);
+    } while(changed);
+}
+
+// most frequent parent among a fixed sample of the vertices
+template <typename VertexId>
+VertexId cc_sample_frequent_element(const VertexId * parents, const int num_vertices)
+{
+    std::vector<VertexId> samples(cc_num_samples);
+
+    unsigned int seed = 0;
+
+    for(int i = 0; i < cc_num_samples; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        samples[i] = parents[seed % num_vertices];
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    VertexId frequent = samples[0];
+    int      max_run  = 0;
+
+    for(int i = 0; i < cc_num_samples;)
+    {
+        int j = i;
+
+        while(j < cc_num_samples && samples[j] == samples[i])
+            j++;
+
+        if(j - i > max_run)
+        {
+            max_run  = j - i;
+            frequent = samples[i];
+        }
+
+        i = j;
+    }
+
+    return frequent;
+}
+
+} // end namespace detail
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t connected_components(omp::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            ArrayType& components,
+                            cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const int num_vertices = G.num_rows;
+
+    if(num_vertices == 0)
+        return 0;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> parents(exec, num_vertices);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> roots(exec, num_vertices);
+
+    VertexId * parents_ptr = thrust::raw_pointer_cast(parents.data());
+    VertexId * roots_ptr   = thrust::raw_pointer_cast(roots.data());
+
+    #pragma omp parallel for
+    for(int v = 0; v < num_vertices; v++)
+        parents_ptr[v] = v;
+
+    // link a few neighbors of every vertex
+    for(int r = 0; r < detail::cc_neighbor_rounds; r++)
+        detail::cc_link(G, parents_ptr, r, r + 1, VertexId(-1));
+
+    // link the remaining edges outside of the largest component
+    VertexId skip = detail::cc_sample_frequent_element(parents_ptr, num_vertices);
+
+    detail::cc_link(G, parents_ptr, detail::cc_neighbor_rounds, size_t(-1), skip);
+
+    // label the components in order of their smallest vertex
+    #pragma omp parallel for
+    for(int v = 0; v < num_vertices; v++)
+        roots_ptr[v] = parents_ptr[v] == v ? 1 : 0;
+
+    const size_t num_components = thrust::reduce(exec, roots.begin(), roots.end());
+
+    thrust::exclusive_scan(exec, roots.begin(), roots.end(), roots.begin());
+
+    #pragma omp parallel for
+    for(int v = 0; v < num_vertices; v++)
+        components[v] = roots_ptr[parents_ptr[v]];
+
+    return num_components;
+}
+
+} // end namespace omp
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::omp::connected_components;
+
+} // end namespace cusp
@@ -17,6 +17,181 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system inherits elementwise
 #include <cusp/system/detail/sequential/graph/hilbert_curve.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+
+////////////////////////////////////////////////////////////////////////
+// Hilbert curve ordering for the OpenMP system
+///////////////////////////////////////////////////////////////////////
+//
+// The integer Hilbert keys of the points are computed in parallel and
+// sorted by a least significant digit radix sort. Every thread counts
+// the digits of one contiguous chunk of keys and scatters the chunk to
+// the offsets computed from all counts, so every pass is stable. Passes
+// over a digit shared by all the keys are skipped.
+//
+
+namespace detail
+{
+
+// bits sorted per radix sort pass
+const int hilbert_radix_bits = 8;
+const int hilbert_radix_size = 1 << hilbert_radix_bits;
+
+template <typename KeyType, typename IndexType>
+void hilbert_radix_sort(KeyType * keys, IndexType * order,
+                        KeyType * temp_keys, IndexType * temp_order,
+                        const int num_keys, const int key_bits)
+{
+    const int num_chunks = max_threads();
+    const int chunk_size = (num_keys + num_chunks - 1) / num_chunks;
+
+    std::vector<size_t> counts(num_chunks * hilbert_radix_size);
+    size_t * counts_ptr = &counts[0];
+
+    KeyType   * src_keys  = keys;
+    IndexType * src_order = order;
+    KeyType   * dst_keys  = temp_keys;
+    IndexType * dst_order = temp_order;
+
+    for(int shift = 0; shift < key_bits; shift += hilbert_radix_bits)
+    {
+        #pragma omp parallel for schedule(static, 1)
+        for(int c = 0; c < num_chunks; c++)
+        {
+            size_t * chunk_counts = counts_ptr + c * hilbert_radix_size;
+            const int begin = std::min(c * chunk_size, num_keys);
+            const int end   = std::min(begin + chunk_size, num_keys);
+
+            std::fill(chunk_counts, chunk_counts + hilbert_radix_size, size_t(0));
+
+            for(int n = begin; n < end; n++)
+                chunk_counts[(src_keys[n] >> shift) & (hilbert_radix_size - 1)]++;
+        }
+
+        // offsets of every chunk into every digit, digit major
+        bool uniform = false;
+        size_t offset = 0;
+
+        for(int d = 0; d < hilbert_radix_size; d++)
+        {
+            const size_t digit_begin = offset;
+
+            for(int c = 0; c < num_chunks; c++)
+            {
+                const size_t count = counts_ptr[c * hilbert_radix_size + d];
+                counts_ptr[c * hilbert_radix_size + d] = offset;
+                offset += count;
+            }
+
+            uniform = uniform || (offset - digit_begin == size_t(num_keys));
+        }
+
+        if(uniform)
+            continue;
+
+        #pragma omp parallel for schedule(static, 1)
+        for(int c = 0; c < num_chunks; c++)
+        {
+            size_t * chunk_offsets = counts_ptr + c * hilbert_radix_size;
+            const int begin = std::min(c * chunk_size, num_keys);
+            const int end   = std::min(begin + chunk_size, num_keys);
+
+            for(int n = begin; n < end; n++)
+            {
+                const size_t position = chunk_offsets[(src_keys[n] >> shift) & (hilbert_radix_size - 1)]++;
+                dst_keys[position]  = src_keys[n];
+                dst_order[position] = src_order[n];
+            }
+        }
+
+        std::swap(src_keys, dst_keys);
+        std::swap(src_order, dst_order);
+    }
+
+    if(src_order != order)
+    {
+        #pragma omp parallel for
+        for(int n = 0; n < num_keys; n++)
+            order[n] = src_order[n];
+    }
+}
+
+} // end namespace detail
+
+template <typename DerivedPolicy, typename Array2d, typename Array1d, typename ArrayType>
+void hilbert_curve(omp::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                   size_t num_parts,
+                   Array1d& parts,
+                   ArrayType& permutation)
+{
+    namespace hilbert_detail = cusp::system::detail::sequential::detail;
+
+    typedef hilbert_detail::hilbert_key_type KeyType;
+    typedef typename ArrayType::value_type   IndexType;
+
+    const int num_points = coord.num_rows;
+
+    hilbert_detail::hilbert_check_coordinates(exec, coord);
+
+    cusp::detail::temporary_array<KeyType, DerivedPolicy>   keys(exec, num_points);
+    cusp::detail::temporary_array<KeyType, DerivedPolicy>   temp_keys(exec, num_points);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> order(exec, num_points);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> temp_order(exec, num_points);
+
+    KeyType   * keys_ptr  = thrust::raw_pointer_cast(keys.data());
+    IndexType * order_ptr = thrust::raw_pointer_cast(order.data());
+
+    if( coord.num_cols == 2 )
+    {
+        #pragma omp parallel for
+        for(int n = 0; n < num_points; n++)
+        {
+            keys_ptr[n]  = hilbert_detail::hilbert_key_2d(coord(n,0), coord(n,1));
+            order_ptr[n] = n;
+        }
+    }
+    else
+    {
+        #pragma omp parallel for
+        for(int n = 0; n < num_points; n++)
+        {
+            keys_ptr[n]  = hilbert_detail::hilbert_key_3d(coord(n,0), coord(n,1), coord(n,2));
+            order_ptr[n] = n;
+        }
+    }
+
+    detail::hilbert_radix_sort(keys_ptr, order_ptr,
+                               thrust::raw_pointer_cast(temp_keys.data()),
+                               thrust::raw_pointer_cast(temp_order.data()),
+                               num_points, hilbert_detail::hilbert_key_bits(coord.num_cols));
+
+    // consecutive runs of the curve form the parts
+    #pragma omp parallel for
+    for(int n = 0; n < num_points; n++)
+    {
+        permutation[order_ptr[n]] = n;
+        parts[order_ptr[n]] = size_t(n) * num_parts / num_points;
+    }
+}
+
+} // end namespace omp
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::omp::hilbert_curve;
+
+} // end namespace cusp
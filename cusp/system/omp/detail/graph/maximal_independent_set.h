@@ -14,8 +14,192 @@
  *  limitations under the License.
  */
 
+
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+
+////////////////////////////////////////////////////////////////////////
+// Luby style MIS-k for the OpenMP system
+///////////////////////////////////////////////////////////////////////
+//
+// Every vertex is undecided, in the MIS or out of it, and is ranked by
+// the tuple (state, random priority, index) packed into a 64-bit key.
+// Each round finds the largest key within distance k of every vertex
+// with k sweeps of max-propagation over the rows of G. Undecided
+// vertices holding the largest key of their k-ring join the MIS, and
+// the undecided vertices whose largest key then belongs to a MIS node
+// leave the graph. The largest undecided vertex always joins, so every
+// round makes progress and no recursion over the k-rings is needed.
+//
+
+namespace detail
+{
+
+const char mis_out_node       = 0;
+const char mis_undecided_node = 1;
+const char mis_node           = 2;
+
+typedef unsigned long long mis_key;
+
+// random priority of a vertex, a fixed integer hash of its index
+inline unsigned int mis_priority(unsigned int a)
+{
+    a ^= a >> 16;
+    a *= 0x7feb352dU;
+    a ^= a >> 15;
+    a *= 0x846ca68bU;
+    a ^= a >> 16;
+    return a;
+}
+
+// packs the (state, priority, index) tuple of a vertex into one key so
+// that comparing keys compares tuples, the index takes the low 31 bits
+inline mis_key mis_make_key(const char state, const unsigned int i)
+{
+    return (mis_key(state) << 62) | (mis_key(mis_priority(i) >> 1) << 31) | mis_key(i);
+}
+
+inline unsigned int mis_key_index(const mis_key key)
+{
+    return (unsigned int)(key & 0x7fffffffU);
+}
+
+// one sweep of max-propagation, every vertex takes the largest key
+// among its own and those of its neighbors
+template <typename MatrixType>
+void mis_propagate(const MatrixType& G, const mis_key * maximal, mis_key * next_maximal)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const int N = G.num_rows;
+
+    #pragma omp parallel for schedule(static, 1024)
+    for(int i = 0; i < N; i++)
+    {
+        mis_key m = maximal[i];
+
+        for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = G.column_indices[jj];
+
+            if(j >= 0)
+                m = std::max(m, maximal[j]);
+        }
+
+        next_maximal[i] = m;
+    }
+}
+
+} // end namespace detail
+
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t maximal_independent_set(omp::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                               ArrayType& stencil,
+                               const size_t k,
+                               cusp::csr_format)
+{
+    using detail::mis_key;
+
+    const int N = G.num_rows;
+
+    cusp::detail::temporary_array<char, DerivedPolicy>    states(exec, N, detail::mis_undecided_node);
+    cusp::detail::temporary_array<char, DerivedPolicy>    next_states(exec, N);
+    cusp::detail::temporary_array<mis_key, DerivedPolicy> keys(exec, N);
+    cusp::detail::temporary_array<mis_key, DerivedPolicy> maximal(exec, N);
+    cusp::detail::temporary_array<mis_key, DerivedPolicy> next_maximal(exec, N);
+
+    char    * states_ptr       = thrust::raw_pointer_cast(states.data());
+    char    * next_states_ptr  = thrust::raw_pointer_cast(next_states.data());
+    mis_key * keys_ptr         = thrust::raw_pointer_cast(keys.data());
+    mis_key * maximal_ptr      = thrust::raw_pointer_cast(maximal.data());
+    mis_key * next_maximal_ptr = thrust::raw_pointer_cast(next_maximal.data());
+
+    #pragma omp parallel for
+    for(int i = 0; i < N; i++)
+        keys_ptr[i] = detail::mis_make_key(detail::mis_undecided_node, i);
+
+    size_t active_nodes = N;
+
+    while(active_nodes > 0)
+    {
+        // find the largest key in the k-ring of every vertex
+        detail::mis_propagate(G, keys_ptr, maximal_ptr);
+
+        for(size_t ring = 1; ring < k; ring++)
+        {
+            detail::mis_propagate(G, maximal_ptr, next_maximal_ptr);
+            std::swap(maximal_ptr, next_maximal_ptr);
+        }
+
+        // label local maxima as MIS nodes
+        #pragma omp parallel for
+        for(int i = 0; i < N; i++)
+        {
+            if(states_ptr[i] == detail::mis_undecided_node && maximal_ptr[i] == keys_ptr[i])
+            {
+                states_ptr[i] = detail::mis_node;
+                keys_ptr[i]   = detail::mis_make_key(detail::mis_node, i);
+            }
+        }
+
+        // label k-ring neighbors of MIS nodes as non-MIS nodes
+        long undecided_nodes = 0;
+
+        #pragma omp parallel for reduction(+:undecided_nodes)
+        for(int i = 0; i < N; i++)
+        {
+            next_states_ptr[i] = states_ptr[i];
+
+            if(states_ptr[i] == detail::mis_undecided_node)
+            {
+                if(states_ptr[detail::mis_key_index(maximal_ptr[i])] == detail::mis_node)
+                {
+                    next_states_ptr[i] = detail::mis_out_node;
+                    keys_ptr[i]        = detail::mis_make_key(detail::mis_out_node, i);
+                }
+                else
+                {
+                    undecided_nodes++;
+                }
+            }
+        }
+
+        std::swap(states_ptr, next_states_ptr);
+        active_nodes = undecided_nodes;
+    }
+
+    // write output
+    stencil.resize(N);
+
+    size_t set_nodes = 0;
+
+    #pragma omp parallel for reduction(+:set_nodes)
+    for(int i = 0; i < N; i++)
+    {
+        stencil[i] = states_ptr[i] == detail::mis_node;
+        set_nodes += states_ptr[i] == detail::mis_node;
+    }
+
+    return set_nodes;
+}
+
+} // end namespace omp
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::omp::maximal_independent_set;
 
-// this system has no special version of this algorithm
+} // end namespace cusp
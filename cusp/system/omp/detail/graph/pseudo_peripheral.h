@@ -17,5 +17,119 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/system/detail/sequential/graph/pseudo_peripheral.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <thrust/copy.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+
+////////////////////////////////////////////////////////////////////////
+// Multi-source pseudo-peripheral vertex search for the OpenMP system
+///////////////////////////////////////////////////////////////////////
+//
+// Every iteration roots level structures at several vertices of
+// smallest degree in the last level of the current one, one per thread,
+// and continues from the candidate of largest eccentricity. The search
+// stops at the best candidate once none improves the eccentricity. The
+// level structures are written to one buffer preallocated for all
+// iterations.
+//
+
+namespace detail
+{
+
+// maximum number of level structures computed per iteration
+const size_t peripheral_max_candidates = 8;
+
+} // end namespace detail
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(omp::execution_policy<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                         ArrayType& levels,
+                         cusp::csr_format)
+{
+    namespace peripheral_detail = cusp::system::detail::sequential::peripheral_detail;
+
+    typedef typename MatrixType::index_type IndexType;
+
+    const size_t N = G.num_rows;
+    const size_t max_candidates = std::min(size_t(detail::max_threads()), detail::peripheral_max_candidates);
+
+    // slot 0 holds the current level structure, the others the candidates
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> level_buffer(exec, (max_candidates + 1) * N);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> queue_buffer(exec, (max_candidates + 1) * N);
+    std::vector<size_t>    num_reached(max_candidates + 1);
+    std::vector<IndexType> depths(max_candidates + 1);
+    std::vector<size_t>    slots(max_candidates + 1);
+    std::vector< std::pair<IndexType,IndexType> > candidates;
+
+    IndexType * level_ptr = thrust::raw_pointer_cast(level_buffer.data());
+    IndexType * queue_ptr = thrust::raw_pointer_cast(queue_buffer.data());
+
+    for(size_t s = 0; s <= max_candidates; s++)
+        slots[s] = s * N;
+
+    IndexType x = rand() % N;
+    num_reached[0] = peripheral_detail::level_structure(G, x, level_ptr + slots[0], queue_ptr + slots[0]);
+    depths[0]      = level_ptr[slots[0] + queue_ptr[slots[0] + num_reached[0] - 1]];
+
+    while(true)
+    {
+        const int num_candidates =
+            peripheral_detail::last_level_candidates(G, level_ptr + slots[0], queue_ptr + slots[0],
+                                                     num_reached[0], max_candidates, candidates);
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for(int c = 0; c < num_candidates; c++)
+        {
+            const size_t slot = slots[c + 1];
+
+            num_reached[c + 1] = peripheral_detail::level_structure(G, candidates[c].second, level_ptr + slot, queue_ptr + slot);
+            depths[c + 1]      = level_ptr[slot + queue_ptr[slot + num_reached[c + 1] - 1]];
+        }
+
+        // the candidates are ordered by degree, so ties keep the smallest
+        int best = 0;
+        for(int c = 1; c < num_candidates; c++)
+            if(depths[c + 1] > depths[best + 1])
+                best = c;
+
+        const bool improved = depths[best + 1] > depths[0];
+
+        x = candidates[best].second;
+        std::swap(slots[0], slots[best + 1]);
+        num_reached[0] = num_reached[best + 1];
+        depths[0]      = depths[best + 1];
+
+        if(!improved)
+            break;
+    }
+
+    thrust::copy(exec, level_ptr + slots[0], level_ptr + slots[0] + N, levels.begin());
+
+    return x;
+}
+
+} // end namespace omp
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::omp::pseudo_peripheral_vertex;
+
+} // end namespace cusp
@@ -14,8 +14,247 @@
  *  limitations under the License.
  */
 
+
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/system/detail/sequential/graph/vertex_coloring.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+
+////////////////////////////////////////////////////////////////////////
+// Speculative greedy coloring for the OpenMP system [Gebremedhin & Manne 2000]
+///////////////////////////////////////////////////////////////////////
+//
+// All vertices of the worklist are colored in parallel, each with the
+// smallest color not used by its neighbors at the time it is visited.
+// Neighbors colored at the same time may end up with the same color,
+// so every vertex of the worklist is checked afterwards and moved to
+// the next worklist when it shares its color with a neighbor of higher
+// priority. The vertex of highest priority in a worklist never loses,
+// hence the worklist shrinks every round and usually empties in a few.
+//
+// The priority of a vertex is its position in the requested ordering,
+// which also sets the order of the first worklist. A distance-k coloring
+// treats all vertices within k edges of a vertex as its neighbors.
+//
+
+namespace detail
+{
+
+template <typename VertexId>
+inline VertexId coloring_load(const VertexId * colors, const VertexId v)
+{
+    VertexId c;
+
+    #pragma omp atomic read
+    c = colors[v];
+
+    return c;
+}
+
+template <typename VertexId>
+inline void coloring_store(VertexId * colors, const VertexId v, const VertexId c)
+{
+    #pragma omp atomic write
+    colors[v] = c;
+}
+
+// marks the tentative colors around a vertex, growing the marks when
+// the neighborhood of a distance-k coloring holds more colors
+template <typename VertexId>
+struct coloring_mark_visitor
+{
+    const VertexId * colors;
+    std::vector<VertexId>& mark;
+    const VertexId vertex;
+
+    coloring_mark_visitor(const VertexId * colors, std::vector<VertexId>& mark, const VertexId vertex)
+        : colors(colors), mark(mark), vertex(vertex) {}
+
+    bool operator()(const VertexId u)
+    {
+        const VertexId c = coloring_load(colors, u);
+
+        if(c >= 0)
+        {
+            if(size_t(c) >= mark.size())
+                mark.resize(c + 1, VertexId(-1));
+
+            mark[c] = vertex;
+        }
+
+        return false;
+    }
+};
+
+// finds a vertex of higher priority with the same color
+template <typename VertexId>
+struct coloring_conflict_visitor
+{
+    const VertexId * colors;
+    const VertexId * ranks;
+    const VertexId vertex;
+
+    coloring_conflict_visitor(const VertexId * colors, const VertexId * ranks, const VertexId vertex)
+        : colors(colors), ranks(ranks), vertex(vertex) {}
+
+    bool operator()(const VertexId u)
+    {
+        return colors[u] == colors[vertex] && ranks[u] < ranks[vertex];
+    }
+};
+
+// colors every vertex of the worklist with the smallest color missing
+// among the vertices within the coloring distance
+template <typename MatrixType, typename VertexId>
+void coloring_tentative_step(const MatrixType& G,
+                             const VertexId * worklist, const size_t worklist_size,
+                             VertexId * colors, const VertexId max_degree,
+                             const size_t distance)
+{
+    namespace coloring_detail = cusp::system::detail::sequential::coloring_detail;
+
+    #pragma omp parallel
+    {
+        std::vector<VertexId> mark(max_degree + 1, VertexId(-1));
+        coloring_detail::distance_k_workspace<VertexId> workspace;
+
+        #pragma omp for schedule(dynamic, 256)
+        for(int n = 0; n < int(worklist_size); n++)
+        {
+            const VertexId v = worklist[n];
+
+            coloring_mark_visitor<VertexId> visitor(colors, mark, v);
+            coloring_detail::visit_distance_k(G, v, distance, workspace, visitor);
+
+            VertexId c = 0;
+            while(size_t(c) < mark.size() && mark[c] == v)
+                c++;
+
+            coloring_store(colors, v, c);
+        }
+    }
+}
+
+// gathers the vertices of the worklist sharing their color with a
+// vertex of higher priority within the coloring distance
+template <typename MatrixType, typename VertexId>
+void coloring_conflict_step(const MatrixType& G,
+                            const VertexId * worklist, const size_t worklist_size,
+                            const VertexId * colors, const VertexId * ranks,
+                            const size_t distance,
+                            VertexId * next_worklist, size_t& next_worklist_size)
+{
+    namespace coloring_detail = cusp::system::detail::sequential::coloring_detail;
+
+    next_worklist_size = 0;
+
+    #pragma omp parallel
+    {
+        std::vector<VertexId> local;
+        coloring_detail::distance_k_workspace<VertexId> workspace;
+
+        #pragma omp for schedule(dynamic, 256) nowait
+        for(int n = 0; n < int(worklist_size); n++)
+        {
+            const VertexId v = worklist[n];
+
+            coloring_conflict_visitor<VertexId> visitor(colors, ranks, v);
+
+            if(coloring_detail::visit_distance_k(G, v, distance, workspace, visitor))
+                local.push_back(v);
+        }
+
+        size_t offset;
+
+        #pragma omp atomic capture
+        { offset = next_worklist_size; next_worklist_size += local.size(); }
+
+        std::copy(local.begin(), local.end(), next_worklist + offset);
+    }
+}
+
+} // end namespace detail
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t vertex_coloring(omp::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const cusp::graph::vertex_ordering ordering,
+                       const size_t distance,
+                       cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+
+    const int N = G.num_rows;
+
+    if(N == 0)
+        return 0;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> worklist(exec, N);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> next_worklist(exec, N);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> ranks(exec, N);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> vertex_colors(exec, N, VertexId(-1));
+
+    VertexId * worklist_ptr      = thrust::raw_pointer_cast(worklist.data());
+    VertexId * next_worklist_ptr = thrust::raw_pointer_cast(next_worklist.data());
+    VertexId * ranks_ptr         = thrust::raw_pointer_cast(ranks.data());
+    VertexId * colors_ptr        = thrust::raw_pointer_cast(vertex_colors.data());
+
+    // the ordering is computed sequentially, the natural one is trivial
+    cusp::system::detail::sequential::coloring_detail::vertex_order(G, ordering, worklist);
+
+    VertexId max_degree = 0;
+
+    #pragma omp parallel for reduction(max:max_degree)
+    for(int n = 0; n < N; n++)
+    {
+        ranks_ptr[worklist_ptr[n]] = n;
+        max_degree = std::max(max_degree, VertexId(G.row_offsets[n + 1] - G.row_offsets[n]));
+    }
+
+    size_t worklist_size = N;
+
+    while(worklist_size > 0)
+    {
+        size_t next_worklist_size;
+
+        detail::coloring_tentative_step(G, worklist_ptr, worklist_size, colors_ptr, max_degree, distance);
+        detail::coloring_conflict_step(G, worklist_ptr, worklist_size, colors_ptr, ranks_ptr, distance,
+                                       next_worklist_ptr, next_worklist_size);
+
+        std::swap(worklist_ptr, next_worklist_ptr);
+        worklist_size = next_worklist_size;
+    }
+
+    VertexId max_color = 0;
+
+    #pragma omp parallel for reduction(max:max_color)
+    for(int n = 0; n < N; n++)
+    {
+        colors[n]  = colors_ptr[n];
+        max_color = std::max(max_color, colors_ptr[n]);
+    }
+
+    return max_color + 1;
+}
+
+} // end namespace omp
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::omp::vertex_coloring;
 
-// this system has no special version of this algorithm
+} // end namespace cusp
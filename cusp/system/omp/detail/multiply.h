@@ -19,6 +19,8 @@
 #include <cusp/detail/config.h>
 
 #include <cusp/system/omp/detail/multiply/csr_spmv.h>
+#include <cusp/system/omp/detail/multiply/csr_spmm.h>
+#include <cusp/system/omp/detail/multiply/ell_spmm.h>
 #include <cusp/system/omp/detail/multiply/coo_spgemm.h>
 #include <cusp/system/omp/detail/multiply/csr_spgemm.h>
 
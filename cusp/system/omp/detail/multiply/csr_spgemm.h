@@ -19,6 +19,9 @@
 
 #include <cusp/detail/temporary_array.h>
 
+#include <thrust/iterator/iterator_traits.h>
+
+#include <algorithm>
 #include <iostream>
 #include <list>
 
@@ -29,6 +32,141 @@ namespace system
 namespace omp
 {
 
+////////////////////////////////////////////////////////////////////////
+// CSR SpGEMM for the OpenMP system
+///////////////////////////////////////////////////////////////////////
+//
+// Both passes accumulate one row of C at a time and choose the
+// accumulator of every row from its number of products, i.e. the sum
+// of the lengths of the rows of B referenced by the row of A.
+//
+// expand-sort-compress
+//   Rows with few products gather them in a small buffer, sort it by
+//   column and merge duplicate columns. No per-column state is needed.
+//
+// dense accumulator
+//   The products are scattered into arrays of length num_cols that are
+//   linked together in a list of touched columns. Fastest for narrow B.
+//
+// hash accumulator
+//   The products are accumulated in an open addressing table whose size
+//   follows the number of products (pass 1) or the exact number of
+//   nonzeros found by pass 1 (pass 2). Used for the remaining rows when
+//   B is too wide for a dense accumulator per thread.
+//
+
+namespace detail
+{
+
+// rows with at most this many products use expand-sort-compress
+const size_t spgemm_esc_limit = 32;
+
+// dense accumulators are only allocated for matrices up to this width
+const size_t spgemm_dense_limit = 1 << 16;
+
+// smallest power of two holding n keys at a load factor of at most 1/2
+inline size_t spgemm_hash_size(const size_t n)
+{
+    size_t size = 16;
+
+    while(size < 2 * n)
+        size *= 2;
+
+    return size;
+}
+
+template <typename IndexType>
+size_t spgemm_hash_slot(const IndexType key, const size_t mask)
+{
+    return (size_t(key) * 107) & mask;
+}
+
+// number of products of every row of A*B, returns the largest one
+template <typename DerivedPolicy,
+          typename Array1, typename Array2,
+          typename Array3, typename Array4>
+size_t spgemm_row_products(omp::execution_policy<DerivedPolicy>& exec,
+                           const size_t num_rows,
+                           const Array1& A_row_offsets, const Array2& A_column_indices,
+                           const Array3& B_row_offsets,
+                           Array4& row_products)
+{
+    typedef typename Array1::value_type IndexType1;
+
+    size_t max_products = 0;
+
+    #pragma omp parallel
+    {
+        size_t thread_max = 0;
+
+        #pragma omp for
+        for(int i = 0; i < int(num_rows); i++)
+        {
+            size_t num_products = 0;
+
+            for(IndexType1 jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+            {
+                const size_t j = A_column_indices[jj];
+                num_products += B_row_offsets[j + 1] - B_row_offsets[j];
+            }
+
+            row_products[i] = num_products;
+            thread_max = std::max(thread_max, num_products);
+        }
+
+        #pragma omp critical
+        max_products = std::max(max_products, thread_max);
+    }
+
+    return max_products;
+}
+
+// sorts the first n columns
+template <typename Iterator>
+void spgemm_insertion_sort(Iterator columns, const size_t n)
+{
+    typedef typename thrust::iterator_value<Iterator>::type IndexType;
+
+    for(size_t i = 1; i < n; i++)
+    {
+        const IndexType column = columns[i];
+
+        size_t j = i;
+
+        for(; j > 0 && IndexType(columns[j - 1]) > column; j--)
+            columns[j] = columns[j - 1];
+
+        columns[j] = column;
+    }
+}
+
+// sorts the first n (column, value) pairs by column, stable
+template <typename Iterator1, typename Iterator2>
+void spgemm_insertion_sort(Iterator1 columns, Iterator2 values, const size_t n)
+{
+    typedef typename thrust::iterator_value<Iterator1>::type IndexType;
+    typedef typename thrust::iterator_value<Iterator2>::type ValueType;
+
+    for(size_t i = 1; i < n; i++)
+    {
+        const IndexType column = columns[i];
+        const ValueType value  = values[i];
+
+        size_t j = i;
+
+        for(; j > 0 && IndexType(columns[j - 1]) > column; j--)
+        {
+            columns[j] = columns[j - 1];
+            values[j]  = values[j - 1];
+        }
+
+        columns[j] = column;
+        values[j]  = value;
+    }
+}
+
+} // end namespace detail
+
 //MW: note that this function is also used by coo.h
 //MW: computes the total number of nonzeors of C
 template <typename DerivedPolicy,
@@ -43,34 +181,102 @@ size_t spmm_csr_pass1(omp::execution_policy<DerivedPolicy>& exec,
 {
     typedef typename Array1::value_type IndexType1;
     typedef typename Array2::value_type IndexType2;
+    typedef typename Array5::value_type IndexType;
+
+    const IndexType unseen = static_cast<IndexType>(-1);
+
+    cusp::detail::temporary_array<size_t, DerivedPolicy> row_products(exec, num_rows);
+
+    const size_t max_products =
+        detail::spgemm_row_products(exec, num_rows, A_row_offsets, A_column_indices, B_row_offsets, row_products);
+
+    const bool   use_dense  = num_cols <= detail::spgemm_dense_limit;
+    const size_t dense_size = use_dense ? num_cols : 0;
+    const size_t hash_size  = use_dense ? 0 : detail::spgemm_hash_size(std::min(max_products, num_cols));
+    const size_t esc_size   = std::min(max_products, detail::spgemm_esc_limit);
 
     C_row_offsets[0] = 0;
 
     #pragma omp parallel
     {
-        cusp::detail::temporary_array<int, DerivedPolicy> mask(exec, num_cols, -1);
+        cusp::detail::temporary_array<int, DerivedPolicy>       mask(exec, dense_size, -1);
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> keys(exec, hash_size, unseen);
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> esc_columns(exec, esc_size);
 
         // Compute nnz in C (including explicit zeros)
         #pragma omp for
         for(int i = 0; i < int(num_rows); i++)
         {
+            const size_t num_products = row_products[i];
+
             size_t num_nonzeros = 0;
 
-            for(IndexType1 jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+            if(num_products <= detail::spgemm_esc_limit)
             {
-                IndexType1 j = A_column_indices[jj];
+                size_t n = 0;
 
-                for(IndexType2 kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+                for(IndexType1 jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
                 {
-                    IndexType2 k = B_column_indices[kk];
+                    IndexType1 j = A_column_indices[jj];
 
-                    if(mask[k] != i)
-                    {
-                        mask[k] = i;
+                    for(IndexType2 kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+                        esc_columns[n++] = B_column_indices[kk];
+                }
+
+                detail::spgemm_insertion_sort(esc_columns.begin(), n);
+
+                for(size_t n_i = 0; n_i < n; n_i++)
+                    if(n_i == 0 || IndexType(esc_columns[n_i]) != IndexType(esc_columns[n_i - 1]))
                         num_nonzeros++;
+            }
+            else if(use_dense)
+            {
+                for(IndexType1 jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+                {
+                    IndexType1 j = A_column_indices[jj];
+
+                    for(IndexType2 kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+                    {
+                        IndexType2 k = B_column_indices[kk];
+
+                        if(mask[k] != i)
+                        {
+                            mask[k] = i;
+                            num_nonzeros++;
+                        }
                     }
                 }
             }
+            else
+            {
+                const size_t table_size = detail::spgemm_hash_size(std::min(num_products, num_cols));
+                const size_t table_mask = table_size - 1;
+
+                for(IndexType1 jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+                {
+                    IndexType1 j = A_column_indices[jj];
+
+                    for(IndexType2 kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+                    {
+                        const IndexType k = B_column_indices[kk];
+
+                        size_t slot = detail::spgemm_hash_slot(k, table_mask);
+
+                        while(keys[slot] != unseen && keys[slot] != k)
+                            slot = (slot + 1) & table_mask;
+
+                        if(keys[slot] == unseen)
+                        {
+                            keys[slot] = k;
+                            num_nonzeros++;
+                        }
+                    }
+                }
+
+                // clear table
+                for(size_t slot = 0; slot < table_size; slot++)
+                    keys[slot] = unseen;
+            }
 
             C_row_offsets[i + 1] = num_nonzeros;
         } // end for loop
@@ -101,59 +307,158 @@ void spmm_csr_pass2(omp::execution_policy<DerivedPolicy>& exec,
     const IndexType unseen = static_cast<IndexType>(-1);
     const IndexType init   = static_cast<IndexType>(-2);
 
+    cusp::detail::temporary_array<size_t, DerivedPolicy> row_products(exec, num_rows);
+
+    const size_t max_products =
+        detail::spgemm_row_products(exec, num_rows, A_row_offsets, A_column_indices, B_row_offsets, row_products);
+
+    // the exact row lengths of C bound the hash tables of this pass
+    size_t max_row_length = 0;
+    for(size_t i = 0; i < num_rows; i++)
+        max_row_length = std::max<size_t>(max_row_length, C_row_offsets[i + 1] - C_row_offsets[i]);
+
+    const bool   use_dense  = num_cols <= detail::spgemm_dense_limit;
+    const size_t dense_size = use_dense ? num_cols : 0;
+    const size_t hash_size  = use_dense ? 0 : detail::spgemm_hash_size(max_row_length);
+    const size_t esc_size   = std::min(max_products, detail::spgemm_esc_limit);
+
     #pragma omp parallel
     {
         // Compute entries of C
-        cusp::detail::temporary_array<IndexType, DerivedPolicy> next(exec, num_cols, unseen);
-        cusp::detail::temporary_array<ValueType, DerivedPolicy> sums(exec, num_cols, ValueType(0));
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> next(exec, dense_size, unseen);
+        cusp::detail::temporary_array<ValueType, DerivedPolicy> sums(exec, dense_size, ValueType(0));
+
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> keys(exec, hash_size, unseen);
+        cusp::detail::temporary_array<ValueType, DerivedPolicy> table(exec, hash_size, ValueType(0));
+
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> esc_columns(exec, esc_size);
+        cusp::detail::temporary_array<ValueType, DerivedPolicy> esc_values(exec, esc_size);
 
         #pragma omp for
         for (int i = 0; i < int(num_rows); i++)
         {
-            IndexType head   = init;
-            IndexType length = 0;
+            const size_t num_products = row_products[i];
 
             IndexType jj_start = A_row_offsets[i];
             IndexType jj_end   = A_row_offsets[i + 1];
 
-            for (IndexType jj = jj_start; jj < jj_end; jj++)
+            size_t offset = C_row_offsets[i];
+
+            if (num_products <= detail::spgemm_esc_limit)
             {
-                IndexType j = A_column_indices[jj];
-                ValueType v = A_values[jj];
+                // expand
+                size_t n = 0;
 
-                IndexType kk_start = B_row_offsets[j];
-                IndexType kk_end   = B_row_offsets[j + 1];
+                for (IndexType jj = jj_start; jj < jj_end; jj++)
+                {
+                    IndexType j = A_column_indices[jj];
+                    ValueType v = A_values[jj];
 
-                for (IndexType kk = kk_start; kk < kk_end; kk++)
+                    for (IndexType kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+                    {
+                        esc_columns[n] = B_column_indices[kk];
+                        esc_values[n]  = combine(v, ValueType(B_values[kk]));
+                        n++;
+                    }
+                }
+
+                // sort
+                detail::spgemm_insertion_sort(esc_columns.begin(), esc_values.begin(), n);
+
+                // compress
+                for (size_t n_i = 0; n_i < n; offset++)
                 {
-                    IndexType k = B_column_indices[kk];
-                    ValueType b = B_values[kk];
+                    const IndexType column = esc_columns[n_i];
+
+                    ValueType sum = ValueType(0);
+
+                    for (; n_i < n && IndexType(esc_columns[n_i]) == column; n_i++)
+                        sum = reduce(sum, ValueType(esc_values[n_i]));
 
-                    sums[k] = reduce(sums[k], combine(v, b));
+                    C_column_indices[offset] = column;
+                    C_values[offset]         = sum;
+                }
+            }
+            else if (use_dense)
+            {
+                IndexType head   = init;
+                IndexType length = 0;
 
-                    if (next[k] == unseen)
+                for (IndexType jj = jj_start; jj < jj_end; jj++)
+                {
+                    IndexType j = A_column_indices[jj];
+                    ValueType v = A_values[jj];
+
+                    IndexType kk_start = B_row_offsets[j];
+                    IndexType kk_end   = B_row_offsets[j + 1];
+
+                    for (IndexType kk = kk_start; kk < kk_end; kk++)
                     {
-                        next[k] = head;
-                        head = k;
-                        length++;
+                        IndexType k = B_column_indices[kk];
+                        ValueType b = B_values[kk];
+
+                        sums[k] = reduce(sums[k], combine(v, b));
+
+                        if (next[k] == unseen)
+                        {
+                            next[k] = head;
+                            head = k;
+                            length++;
+                        }
                     }
                 }
-            }
 
-            size_t offset = C_row_offsets[i];
+                for (IndexType jj = 0; jj < length; jj++)
+                {
+                    C_column_indices[offset] = head;
+                    C_values[offset] = sums[head];
+                    offset++;
 
-            for (IndexType jj = 0; jj < length; jj++)
+                    IndexType temp = head;
+                    head = next[head];
+
+                    // clear arrays
+                    next[temp] = unseen;
+                    sums[temp] = ValueType(0);
+                }
+            }
+            else
             {
-                C_column_indices[offset] = head;
-                C_values[offset] = sums[head];
-                offset++;
+                const size_t table_size = detail::spgemm_hash_size(C_row_offsets[i + 1] - C_row_offsets[i]);
+                const size_t table_mask = table_size - 1;
+
+                for (IndexType jj = jj_start; jj < jj_end; jj++)
+                {
+                    IndexType j = A_column_indices[jj];
+                    ValueType v = A_values[jj];
+
+                    for (IndexType kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+                    {
+                        const IndexType k = B_column_indices[kk];
+
+                        size_t slot = detail::spgemm_hash_slot(k, table_mask);
 
-                IndexType temp = head;
-                head = next[head];
+                        while (keys[slot] != unseen && keys[slot] != k)
+                            slot = (slot + 1) & table_mask;
 
-                // clear arrays
-                next[temp] = unseen;
-                sums[temp] = ValueType(0);
+                        keys[slot]  = k;
+                        table[slot] = reduce(table[slot], combine(v, ValueType(B_values[kk])));
+                    }
+                }
+
+                for (size_t slot = 0; slot < table_size; slot++)
+                {
+                    if (keys[slot] == unseen)
+                        continue;
+
+                    C_column_indices[offset] = keys[slot];
+                    C_values[offset] = table[slot];
+                    offset++;
+
+                    // clear table
+                    keys[slot]  = unseen;
+                    table[slot] = ValueType(0);
+                }
             }
         } // end for loop
     } //omp parallel
@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/multiply/csr_spmm.h>
+#include <cusp/system/omp/detail/utils.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+
+// CSR times dense block for the OpenMP system. The rows are split into
+// one contiguous partition per thread holding roughly the same number
+// of nonzeros and each partition runs the tiled sequential kernel.
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType1& A,
+              const MatrixType2& B,
+              MatrixType3& C,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csr_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    namespace spmm_detail = cusp::system::detail::sequential::spmm_detail;
+
+    typedef typename MatrixType1::index_type IndexType;
+
+    if(C.num_entries == 0)
+        return;
+
+    const IndexType num_rows       = A.num_rows;
+    const IndexType num_entries    = A.row_offsets[num_rows];
+    const int       num_partitions = detail::max_threads();
+
+    #pragma omp parallel for schedule(static, 1)
+    for(int p = 0; p < num_partitions; p++)
+    {
+        const IndexType entry_begin = IndexType((size_t(num_entries) * p) / num_partitions);
+        const IndexType entry_end   = IndexType((size_t(num_entries) * (p + 1)) / num_partitions);
+
+        // first rows whose offsets reach the partition boundaries
+        const size_t row_begin = p == 0 ? 0 :
+            std::lower_bound(A.row_offsets.begin(), A.row_offsets.begin() + num_rows, entry_begin) - A.row_offsets.begin();
+        const size_t row_end   = p == num_partitions - 1 ? num_rows :
+            std::lower_bound(A.row_offsets.begin(), A.row_offsets.begin() + num_rows, entry_end) - A.row_offsets.begin();
+
+        spmm_detail::csr_spmm_rows(A,
+                                   spmm_detail::raw_values(B), spmm_detail::row_stride(B), spmm_detail::column_stride(B),
+                                   spmm_detail::raw_values(C), spmm_detail::row_stride(C), spmm_detail::column_stride(C),
+                                   C.num_cols, row_begin, row_end,
+                                   initialize, combine, reduce);
+    }
+}
+
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
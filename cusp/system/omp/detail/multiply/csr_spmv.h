@@ -32,6 +32,10 @@
 #include <cusp/detail/utils.h>
 #include <cusp/detail/array2d_format_utils.h>
 
+#include <cusp/system/omp/detail/utils.h>
+
+#include <algorithm>
+
 namespace cusp
 {
 namespace system
@@ -39,28 +43,76 @@ namespace system
 namespace omp
 {
 
+////////////////////////////////////////////////////////////////////////
+// CSR SpMV kernels for the OpenMP system
+///////////////////////////////////////////////////////////////////////
+//
+// spmv_csr_row_parallel
+//   Straightforward translation of standard CSR SpMV where each row
+//   is assigned to one thread by a parallel loop over the rows.
+//
+// spmv_csr_merge_path
+//   Load-balanced CSR SpMV based on the merge-path decomposition of
+//   the row end offsets and the nonzero indices [Merrill & Garland 2016].
+//   Every partition consumes the same number of rows plus nonzeros so a
+//   few very long rows do not serialize the computation. Rows spanning
+//   several partitions are completed by a sequential fix-up pass.
+//
+
+namespace detail
+{
+
+// upper bound on the partitions of spmv_csr_merge_path
+const int max_merge_path_partitions = 256;
+
+// Locates the (row, entry) coordinate where the given diagonal
+// intersects the merge path of row_end_offsets and [0, num_entries)
+template <typename IndexType, typename RowEndIterator>
+void merge_path_search(const IndexType diagonal,
+                       const IndexType num_rows,
+                       const IndexType num_entries,
+                       RowEndIterator row_end_offsets,
+                       IndexType& row,
+                       IndexType& entry)
+{
+    IndexType x_min = diagonal > num_entries ? diagonal - num_entries : IndexType(0);
+    IndexType x_max = diagonal < num_rows    ? diagonal               : num_rows;
+
+    while(x_min < x_max)
+    {
+        const IndexType pivot = x_min + (x_max - x_min) / 2;
+
+        if(IndexType(row_end_offsets[pivot]) <= diagonal - pivot - 1)
+            x_min = pivot + 1;
+        else
+            x_max = pivot;
+    }
+
+    row   = x_min;
+    entry = diagonal - x_min;
+}
+
+} // end namespace detail
+
 template <typename DerivedPolicy,
-		  typename MatrixType,
+          typename MatrixType,
           typename VectorType1,
           typename VectorType2,
           typename UnaryFunction,
           typename BinaryFunction1,
           typename BinaryFunction2>
-void multiply(omp::execution_policy<DerivedPolicy>& exec,
-              const MatrixType& A,
-              const VectorType1& x,
-              VectorType2& y,
-              UnaryFunction   initialize,
-              BinaryFunction1 combine,
-              BinaryFunction2 reduce,
-              cusp::csr_format,
-              cusp::array1d_format,
-              cusp::array1d_format)
+void spmv_csr_row_parallel(omp::execution_policy<DerivedPolicy>& exec,
+                           const MatrixType& A,
+                           const VectorType1& x,
+                           VectorType2& y,
+                           UnaryFunction   initialize,
+                           BinaryFunction1 combine,
+                           BinaryFunction2 reduce)
 {
     typedef typename MatrixType::index_type  IndexType;
     typedef typename VectorType2::value_type ValueType;
 
-	int N = A.num_rows;
+    int N = A.num_rows;
 
     #pragma omp parallel for
     for(int i = 0; i < N; i++)
@@ -83,6 +135,124 @@ void multiply(omp::execution_policy<DerivedPolicy>& exec,
     }
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void spmv_csr_merge_path(omp::execution_policy<DerivedPolicy>& exec,
+                         const MatrixType& A,
+                         const VectorType1& x,
+                         VectorType2& y,
+                         UnaryFunction   initialize,
+                         BinaryFunction1 combine,
+                         BinaryFunction2 reduce)
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    if(A.num_rows == 0)
+        return;
+
+    const IndexType num_rows        = A.num_rows;
+    const IndexType num_entries     = A.row_offsets[num_rows];
+    const IndexType num_merge_items = num_rows + num_entries;
+
+    const int num_partitions = std::min(detail::max_threads(), detail::max_merge_path_partitions);
+    const IndexType items_per_partition = (num_merge_items + num_partitions - 1) / num_partitions;
+
+    // partial results of the last (unfinished) row of each partition, kept
+    // on the stack so the product never allocates
+    IndexType carry_rows[detail::max_merge_path_partitions];
+    ValueType carry_values[detail::max_merge_path_partitions];
+
+    std::fill(carry_rows, carry_rows + num_partitions, num_rows);
+
+    #pragma omp parallel for schedule(static, 1)
+    for(int p = 0; p < num_partitions; p++)
+    {
+        const IndexType diagonal_start = std::min<IndexType>(items_per_partition * p, num_merge_items);
+        const IndexType diagonal_end   = std::min<IndexType>(diagonal_start + items_per_partition, num_merge_items);
+
+        IndexType row_start, entry_start;
+        IndexType row_end,   entry_end;
+
+        detail::merge_path_search(diagonal_start, num_rows, num_entries, A.row_offsets.begin() + 1, row_start, entry_start);
+        detail::merge_path_search(diagonal_end,   num_rows, num_entries, A.row_offsets.begin() + 1, row_end,   entry_end);
+
+        IndexType jj = entry_start;
+
+        // every row ending inside this partition is written here
+        for(IndexType i = row_start; i < row_end; i++)
+        {
+            const IndexType row_stop = A.row_offsets[i + 1];
+
+            ValueType accumulator = initialize(y[i]);
+
+            for(; jj < row_stop; jj++)
+            {
+                const IndexType j   = A.column_indices[jj];
+                const ValueType Aij = A.values[jj];
+                const ValueType xj  = x[j];
+
+                accumulator = reduce(accumulator, combine(Aij, xj));
+            }
+
+            y[i] = accumulator;
+        }
+
+        // the trailing row continues past the end of this partition
+        if(jj < entry_end)
+        {
+            ValueType accumulator = combine(ValueType(A.values[jj]), ValueType(x[A.column_indices[jj]]));
+
+            for(jj++; jj < entry_end; jj++)
+            {
+                const IndexType j   = A.column_indices[jj];
+                const ValueType Aij = A.values[jj];
+                const ValueType xj  = x[j];
+
+                accumulator = reduce(accumulator, combine(Aij, xj));
+            }
+
+            carry_rows[p]   = row_end;
+            carry_values[p] = accumulator;
+        }
+    }
+
+    // fold the partial results into the rows spanning partitions
+    for(int p = 0; p < num_partitions; p++)
+    {
+        const IndexType row = carry_rows[p];
+
+        if(row < num_rows)
+            y[row] = reduce(ValueType(y[row]), ValueType(carry_values[p]));
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csr_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    spmv_csr_merge_path(exec, A, x, y, initialize, combine, reduce);
+}
+
 } // end namespace omp
 } // end namespace system
 } // end namespace cusp
@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/detail/sequential/multiply/ell_spmm.h>
+#include <cusp/system/omp/detail/utils.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+
+// ELL times dense block for the OpenMP system. Every ELL row holds the
+// same number of slots so the rows are split evenly between threads.
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(omp::execution_policy<DerivedPolicy>& exec,
+              const MatrixType1& A,
+              const MatrixType2& B,
+              MatrixType3& C,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::ell_format,
+              cusp::array2d_format,
+              cusp::array2d_format)
+{
+    namespace spmm_detail = cusp::system::detail::sequential::spmm_detail;
+
+    if(C.num_entries == 0)
+        return;
+
+    const size_t num_rows       = A.num_rows;
+    const int    num_partitions = detail::max_threads();
+
+    #pragma omp parallel for schedule(static, 1)
+    for(int p = 0; p < num_partitions; p++)
+    {
+        const size_t row_begin = (num_rows * p) / num_partitions;
+        const size_t row_end   = (num_rows * (p + 1)) / num_partitions;
+
+        spmm_detail::ell_spmm_rows(A,
+                                   spmm_detail::raw_values(B), spmm_detail::row_stride(B), spmm_detail::column_stride(B),
+                                   spmm_detail::raw_values(C), spmm_detail::row_stride(C), spmm_detail::column_stride(C),
+                                   C.num_cols, row_begin, row_end,
+                                   initialize, combine, reduce);
+    }
+}
+
+} // end namespace omp
+} // end namespace system
+} // end namespace cusp
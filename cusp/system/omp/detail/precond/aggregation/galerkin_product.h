@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/exception.h>
+
+#include <cusp/precond/aggregation/system/detail/sequential/galerkin_product.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace omp
+{
+
+// Row-wise R * A * P. Every chunk of galerkin_chunk_size coarse rows is
+// computed into its own buffer with a per-thread accumulator, the row
+// lengths are scanned and the buffers are copied into RAP in parallel.
+// A * P is never formed and the buffers hold only the entries of RAP.
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void galerkin_product(omp::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType1& R,
+                      const MatrixType2& A,
+                      const MatrixType1& P,
+                      MatrixType3& RAP,
+                      cusp::csr_format,
+                      cusp::csr_format,
+                      cusp::csr_format)
+{
+    using cusp::precond::aggregation::detail::galerkin_chunk_size;
+    using cusp::precond::aggregation::detail::galerkin_rows;
+
+    typedef typename MatrixType3::index_type IndexType;
+    typedef typename MatrixType3::value_type ValueType;
+
+    const size_t num_rows   = R.num_rows;
+    const size_t num_cols   = P.num_cols;
+    const size_t num_chunks = (num_rows + galerkin_chunk_size - 1) / galerkin_chunk_size;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_offsets(exec, num_rows + 1);
+
+    std::vector< std::vector<IndexType> > columns(num_chunks);
+    std::vector< std::vector<ValueType> > values(num_chunks);
+
+    #pragma omp parallel
+    {
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> marker(exec, num_cols, IndexType(-1));
+        cusp::detail::temporary_array<ValueType, DerivedPolicy> sums(exec, num_cols);
+
+        #pragma omp for schedule(dynamic, 1)
+        for(int c = 0; c < int(num_chunks); c++)
+        {
+            const size_t row_begin = c * galerkin_chunk_size;
+            const size_t row_end   = std::min(row_begin + galerkin_chunk_size, num_rows);
+
+            galerkin_rows(R, A, P, row_begin, row_end, marker, sums, columns[c], values[c], row_offsets);
+        }
+    }
+
+    row_offsets[0] = 0;
+
+    for(size_t i = 0; i < num_rows; i++)
+        row_offsets[i + 1] += row_offsets[i];
+
+    RAP.resize(num_rows, num_cols, row_offsets[num_rows]);
+
+    std::copy(row_offsets.begin(), row_offsets.end(), RAP.row_offsets.begin());
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for(int c = 0; c < int(num_chunks); c++)
+    {
+        const size_t offset = row_offsets[c * galerkin_chunk_size];
+
+        std::copy(columns[c].begin(), columns[c].end(), RAP.column_indices.begin() + offset);
+        std::copy(values[c].begin(),  values[c].end(),  RAP.values.begin()         + offset);
+
+        // release the buffer as soon as it has been copied
+        std::vector<IndexType>().swap(columns[c]);
+        std::vector<ValueType>().swap(values[c]);
+    }
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void numeric_galerkin_product(omp::execution_policy<DerivedPolicy>& exec,
+                              const MatrixType1& R,
+                              const MatrixType2& A,
+                              const MatrixType1& P,
+                              MatrixType3& RAP,
+                              cusp::csr_format,
+                              cusp::csr_format,
+                              cusp::csr_format)
+{
+    using cusp::precond::aggregation::detail::galerkin_chunk_size;
+    using cusp::precond::aggregation::detail::galerkin_row_values;
+
+    typedef typename MatrixType3::index_type IndexType;
+
+    const size_t num_rows = RAP.num_rows;
+    const size_t num_cols = P.num_cols;
+
+    bool valid = true;
+
+    #pragma omp parallel reduction(&&:valid)
+    {
+        cusp::detail::temporary_array<IndexType, DerivedPolicy> marker(exec, num_cols);
+
+        #pragma omp for schedule(dynamic, galerkin_chunk_size)
+        for(int i = 0; i < int(num_rows); i++)
+            valid = galerkin_row_values(R, A, P, i, RAP, marker) && valid;
+    }
+
+    if(!valid)
+        throw cusp::invalid_input_exception("sparsity pattern of RAP does not contain R * A * P");
+}
+
+} // end namespace omp
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::omp::galerkin_product;
+using cusp::system::omp::numeric_galerkin_product;
+
+} // end namespace cusp
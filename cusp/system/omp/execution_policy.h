@@ -56,3 +56,5 @@ using namespace thrust::system::omp;
 #include <cusp/system/omp/detail/graph/pseudo_peripheral.h>
 #include <cusp/system/omp/detail/graph/symmetric_rcm.h>
 #include <cusp/system/omp/detail/graph/vertex_coloring.h>
+
+#include <cusp/system/omp/detail/precond/aggregation/galerkin_product.h>
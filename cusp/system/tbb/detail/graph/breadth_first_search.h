@@ -17,5 +17,394 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/copy.h>
+#include <cusp/format_utils.h>
+
+#include <thrust/sort.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#if TBB_INTERFACE_VERSION >= 12000
+#include <atomic>
+#else
+#include <tbb/atomic.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Direction switching thresholds of the hybrid BFS [Beamer et al. 2012],
+// see the OpenMP version for a description of the traversal
+const int bfs_alpha = 15;
+const int bfs_beta  = 18;
+
+// visited flags are claimed with an atomic exchange
+#if TBB_INTERFACE_VERSION >= 12000
+typedef std::atomic<char> bfs_flag;
+
+inline bool bfs_claim(bfs_flag& flag)
+{
+    return flag.exchange(1) == 0;
+}
+#else
+typedef ::tbb::atomic<char> bfs_flag;
+
+inline bool bfs_claim(bfs_flag& flag)
+{
+    return flag.fetch_and_store(1) == 0;
+}
+#endif
+
+template <typename VertexId>
+struct bfs_local_frontier
+{
+    std::vector<VertexId> vertices;
+    size_t scout_count;
+
+    bfs_local_frontier(void) : scout_count(0) {}
+};
+
+template <typename T>
+struct bfs_fill_body
+{
+    T *  first;
+    char value;
+
+    bfs_fill_body(T * first, char value) : first(first), value(value) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t i = r.begin(); i < r.end(); i++)
+            first[i] = value;
+    }
+};
+
+// Claims the undiscovered out-neighbors of the frontier queue
+template <typename MatrixType, typename VertexId>
+struct bfs_top_down_body
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef ::tbb::enumerable_thread_specific< bfs_local_frontier<VertexId> > LocalType;
+
+    const MatrixType& G;
+    const VertexId * queue;
+    VertexId * levels;
+    VertexId * predecessors;
+    bfs_flag * visited;
+    const VertexId depth;
+    LocalType& locals;
+
+    bfs_top_down_body(const MatrixType& G, const VertexId * queue,
+                      VertexId * levels, VertexId * predecessors, bfs_flag * visited,
+                      const VertexId depth, LocalType& locals)
+        : G(G), queue(queue), levels(levels), predecessors(predecessors), visited(visited),
+          depth(depth), locals(locals) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        bfs_local_frontier<VertexId>& local = locals.local();
+
+        for(size_t q = r.begin(); q < r.end(); q++)
+        {
+            const VertexId u = queue[q];
+
+            for(IndexType jj = G.row_offsets[u]; jj < G.row_offsets[u + 1]; jj++)
+            {
+                const VertexId v = G.column_indices[jj];
+
+                if(v == VertexId(-1) || visited[v] != 0 || !bfs_claim(visited[v]))
+                    continue;
+
+                levels[v] = depth + 1;
+
+                if(predecessors != NULL)
+                    predecessors[v] = u;
+
+                local.vertices.push_back(v);
+                local.scout_count += G.row_offsets[v + 1] - G.row_offsets[v];
+            }
+        }
+    }
+};
+
+// Every undiscovered vertex looks for a parent in the frontier bitmap,
+// each vertex is only written by the task owning it
+template <typename Array1, typename Array2, typename VertexId>
+struct bfs_bottom_up_body
+{
+    typedef typename Array1::value_type IndexType;
+    typedef ::tbb::enumerable_thread_specific<size_t> CountType;
+
+    const Array1& GT_row_offsets;
+    const Array2& GT_column_indices;
+    const char * frontier;
+    char * next_frontier;
+    VertexId * levels;
+    VertexId * predecessors;
+    bfs_flag * visited;
+    const VertexId depth;
+    CountType& awake_counts;
+
+    bfs_bottom_up_body(const Array1& GT_row_offsets, const Array2& GT_column_indices,
+                       const char * frontier, char * next_frontier,
+                       VertexId * levels, VertexId * predecessors, bfs_flag * visited,
+                       const VertexId depth, CountType& awake_counts)
+        : GT_row_offsets(GT_row_offsets), GT_column_indices(GT_column_indices),
+          frontier(frontier), next_frontier(next_frontier),
+          levels(levels), predecessors(predecessors), visited(visited),
+          depth(depth), awake_counts(awake_counts) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        size_t& awake_count = awake_counts.local();
+
+        for(size_t v = r.begin(); v < r.end(); v++)
+        {
+            next_frontier[v] = 0;
+
+            if(levels[v] != VertexId(-1))
+                continue;
+
+            for(IndexType jj = GT_row_offsets[v]; jj < GT_row_offsets[v + 1]; jj++)
+            {
+                const VertexId u = GT_column_indices[jj];
+
+                if(frontier[u])
+                {
+                    levels[v] = depth + 1;
+
+                    if(predecessors != NULL)
+                        predecessors[v] = u;
+
+                    visited[v]       = 1;
+                    next_frontier[v] = 1;
+                    awake_count++;
+                    break;
+                }
+            }
+        }
+    }
+};
+
+template <typename VertexId>
+struct bfs_queue_to_bitmap_body
+{
+    const VertexId * queue;
+    char * frontier;
+
+    bfs_queue_to_bitmap_body(const VertexId * queue, char * frontier)
+        : queue(queue), frontier(frontier) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t q = r.begin(); q < r.end(); q++)
+            frontier[queue[q]] = 1;
+    }
+};
+
+template <typename VertexId>
+struct bfs_bitmap_to_queue_body
+{
+    typedef ::tbb::enumerable_thread_specific< bfs_local_frontier<VertexId> > LocalType;
+
+    const char * frontier;
+    LocalType& locals;
+
+    bfs_bitmap_to_queue_body(const char * frontier, LocalType& locals)
+        : frontier(frontier), locals(locals) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        bfs_local_frontier<VertexId>& local = locals.local();
+
+        for(size_t v = r.begin(); v < r.end(); v++)
+            if(frontier[v])
+                local.vertices.push_back(v);
+    }
+};
+
+// concatenates and clears the per-thread frontiers, returns the total
+// number of out-edges of the gathered vertices
+template <typename LocalType, typename VertexId>
+size_t bfs_gather(LocalType& locals, VertexId * queue, size_t& queue_size)
+{
+    size_t scout_count = 0;
+
+    queue_size = 0;
+
+    for(typename LocalType::iterator i = locals.begin(); i != locals.end(); ++i)
+    {
+        std::copy(i->vertices.begin(), i->vertices.end(), queue + queue_size);
+        queue_size  += i->vertices.size();
+        scout_count += i->scout_count;
+
+        i->vertices.clear();
+        i->scout_count = 0;
+    }
+
+    return scout_count;
+}
+
+} // end namespace detail
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void breadth_first_search(tbb::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const typename MatrixType::index_type src,
+                          ArrayType& labels,
+                          const bool mark_levels,
+                          cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+    typedef ::tbb::enumerable_thread_specific< detail::bfs_local_frontier<VertexId> > LocalType;
+    typedef ::tbb::enumerable_thread_specific<size_t> CountType;
+
+    const size_t num_vertices = G.num_rows;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> levels(exec, num_vertices, VertexId(-1));
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> predecessors(exec, mark_levels ? 0 : num_vertices, VertexId(-1));
+
+    if(G.num_entries == 0)
+    {
+        cusp::copy(exec, levels, labels);
+        return;
+    }
+
+    std::vector<detail::bfs_flag> visited(num_vertices);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_vertices),
+                        detail::bfs_fill_body<detail::bfs_flag>(&visited[0], 0));
+
+    // the frontier is kept as a queue while going top-down and as a
+    // bitmap while going bottom-up
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> queue(exec, num_vertices);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> next_queue(exec, num_vertices);
+    cusp::detail::temporary_array<char, DerivedPolicy>     frontier(exec, num_vertices);
+    cusp::detail::temporary_array<char, DerivedPolicy>     next_frontier(exec, num_vertices);
+
+    // in-edges for the bottom-up steps
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> GT_row_offsets(exec);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> GT_column_indices(exec);
+
+    VertexId * levels_ptr       = thrust::raw_pointer_cast(levels.data());
+    VertexId * predecessors_ptr = mark_levels ? NULL : thrust::raw_pointer_cast(predecessors.data());
+
+    VertexId * queue_ptr         = thrust::raw_pointer_cast(queue.data());
+    VertexId * next_queue_ptr    = thrust::raw_pointer_cast(next_queue.data());
+    char     * frontier_ptr      = thrust::raw_pointer_cast(frontier.data());
+    char     * next_frontier_ptr = thrust::raw_pointer_cast(next_frontier.data());
+
+    levels_ptr[src] = 0;
+    visited[src]    = 1;
+
+    if(!mark_levels)
+        predecessors_ptr[src] = -2;
+
+    queue_ptr[0] = src;
+
+    LocalType locals;
+    CountType awake_counts(0);
+
+    size_t   queue_size     = 1;
+    size_t   edges_to_check = G.num_entries;
+    size_t   scout_count    = G.row_offsets[src + 1] - G.row_offsets[src];
+    VertexId depth          = 0;
+
+    while(queue_size > 0)
+    {
+        if(scout_count > edges_to_check / detail::bfs_alpha)
+        {
+            if(GT_row_offsets.size() == 0)
+            {
+                // transpose the pattern of G by sorting its entries by column
+                GT_row_offsets.resize(num_vertices + 1);
+                GT_column_indices.resize(G.num_entries);
+
+                cusp::detail::temporary_array<VertexId, DerivedPolicy> column_indices(exec, G.column_indices.begin(), G.column_indices.end());
+
+                cusp::offsets_to_indices(exec, G.row_offsets, GT_column_indices);
+                thrust::stable_sort_by_key(exec, column_indices.begin(), column_indices.end(), GT_column_indices.begin());
+                cusp::indices_to_offsets(exec, column_indices, GT_row_offsets);
+            }
+
+            ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_vertices),
+                                detail::bfs_fill_body<char>(frontier_ptr, 0));
+            ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, queue_size),
+                                detail::bfs_queue_to_bitmap_body<VertexId>(queue_ptr, frontier_ptr));
+
+            size_t awake_count = queue_size;
+            size_t old_awake_count;
+
+            do
+            {
+                detail::bfs_bottom_up_body<
+                    cusp::detail::temporary_array<VertexId, DerivedPolicy>,
+                    cusp::detail::temporary_array<VertexId, DerivedPolicy>,
+                    VertexId> body(GT_row_offsets, GT_column_indices,
+                                   frontier_ptr, next_frontier_ptr,
+                                   levels_ptr, predecessors_ptr, &visited[0],
+                                   depth, awake_counts);
+
+                ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_vertices, 1024), body);
+
+                old_awake_count = awake_count;
+                awake_count     = 0;
+
+                for(typename CountType::iterator i = awake_counts.begin(); i != awake_counts.end(); ++i)
+                {
+                    awake_count += *i;
+                    *i = 0;
+                }
+
+                std::swap(frontier_ptr, next_frontier_ptr);
+                depth++;
+            } while(awake_count > 0 &&
+                    (awake_count >= old_awake_count || awake_count > num_vertices / detail::bfs_beta));
+
+            ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_vertices),
+                                detail::bfs_bitmap_to_queue_body<VertexId>(frontier_ptr, locals));
+            detail::bfs_gather(locals, queue_ptr, queue_size);
+            scout_count = 1;
+        }
+        else
+        {
+            edges_to_check -= std::min(scout_count, edges_to_check);
+
+            ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, queue_size, 64),
+                                detail::bfs_top_down_body<MatrixType,VertexId>(G, queue_ptr,
+                                                                               levels_ptr, predecessors_ptr, &visited[0],
+                                                                               depth, locals));
+
+            scout_count = detail::bfs_gather(locals, next_queue_ptr, queue_size);
+            std::swap(queue_ptr, next_queue_ptr);
+            depth++;
+        }
+    }
+
+    // copy levels or predecessors into the outgoing array
+    if(mark_levels)
+        cusp::copy(exec, levels, labels);
+    else
+        cusp::copy(exec, predecessors, labels);
+}
+
+} // end namespace tbb
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::tbb::breadth_first_search;
+
+} // end namespace cusp
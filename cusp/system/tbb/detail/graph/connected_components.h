@@ -17,5 +17,290 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#if TBB_INTERFACE_VERSION >= 12000
+#include <atomic>
+#else
+#include <tbb/atomic.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Afforest connected components [Sutton et al. 2018], see the OpenMP
+// version for a description of the hooking and sampling phases
+const int cc_neighbor_rounds = 2;
+const int cc_num_samples     = 1024;
+
+// parent pointers are shared between the tasks
+template <typename T>
+struct cc_atomic
+{
+#if TBB_INTERFACE_VERSION >= 12000
+    typedef std::atomic<T> type;
+#else
+    typedef ::tbb::atomic<T> type;
+#endif
+};
+
+template <typename VertexId>
+struct cc_init_body
+{
+    typedef typename cc_atomic<VertexId>::type Parent;
+
+    Parent * parents;
+
+    cc_init_body(Parent * parents) : parents(parents) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t v = r.begin(); v < r.end(); v++)
+            parents[v] = VertexId(v);
+    }
+};
+
+// Hooks the roots across a window of the out-edges of every vertex not
+// labeled skip
+template <typename MatrixType, typename VertexId>
+struct cc_hook_body
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename cc_atomic<VertexId>::type Parent;
+    typedef typename cc_atomic<int>::type Flag;
+
+    const MatrixType& G;
+    Parent * parents;
+    const size_t first;
+    const size_t last;
+    const VertexId skip;
+    Flag& changed;
+
+    cc_hook_body(const MatrixType& G, Parent * parents,
+                 const size_t first, const size_t last, const VertexId skip, Flag& changed)
+        : G(G), parents(parents), first(first), last(last), skip(skip), changed(changed) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t u = r.begin(); u < r.end(); u++)
+        {
+            if(parents[u] == skip)
+                continue;
+
+            const size_t degree = G.row_offsets[u + 1] - G.row_offsets[u];
+            const IndexType jj_begin = G.row_offsets[u] + std::min(first, degree);
+            const IndexType jj_end   = G.row_offsets[u] + std::min(last,  degree);
+
+            for(IndexType jj = jj_begin; jj < jj_end; jj++)
+            {
+                const VertexId v = G.column_indices[jj];
+
+                if(v < 0)
+                    continue;
+
+                const VertexId pu = parents[u];
+                const VertexId pv = parents[v];
+
+                if(pu < pv && parents[pv] == pv)
+                {
+                    parents[pv] = pu;
+                    changed = 1;
+                }
+                else if(pv < pu && parents[pu] == pu)
+                {
+                    parents[pu] = pv;
+                    changed = 1;
+                }
+            }
+        }
+    }
+};
+
+// Pointer jumping, points every vertex to the root of its tree
+template <typename VertexId>
+struct cc_compress_body
+{
+    typedef typename cc_atomic<VertexId>::type Parent;
+
+    Parent * parents;
+
+    cc_compress_body(Parent * parents) : parents(parents) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t v = r.begin(); v < r.end(); v++)
+        {
+            VertexId p  = parents[v];
+            VertexId pp = parents[p];
+
+            while(p != pp)
+            {
+                parents[v] = pp;
+                p  = pp;
+                pp = parents[p];
+            }
+        }
+    }
+};
+
+template <typename VertexId>
+struct cc_roots_body
+{
+    typedef typename cc_atomic<VertexId>::type Parent;
+
+    const Parent * parents;
+    VertexId * roots;
+
+    cc_roots_body(const Parent * parents, VertexId * roots) : parents(parents), roots(roots) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t v = r.begin(); v < r.end(); v++)
+            roots[v] = VertexId(parents[v]) == VertexId(v) ? 1 : 0;
+    }
+};
+
+template <typename ArrayType, typename VertexId>
+struct cc_label_body
+{
+    typedef typename cc_atomic<VertexId>::type Parent;
+
+    const Parent * parents;
+    const VertexId * roots;
+    ArrayType& components;
+
+    cc_label_body(const Parent * parents, const VertexId * roots, ArrayType& components)
+        : parents(parents), roots(roots), components(components) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t v = r.begin(); v < r.end(); v++)
+            components[v] = roots[VertexId(parents[v])];
+    }
+};
+
+// hooks and compresses until the edges in the window are all inside trees
+template <typename MatrixType, typename Parent, typename VertexId>
+void cc_link(const MatrixType& G, Parent * parents,
+             const size_t first, const size_t last, const VertexId skip)
+{
+    typename cc_atomic<int>::type changed;
+
+    do
+    {
+        changed = 0;
+
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, G.num_rows, 1024),
+                            cc_hook_body<MatrixType, VertexId>(G, parents, first, last, skip, changed));
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, G.num_rows, 1024),
+                            cc_compress_body<VertexId>(parents));
+    } while(changed != 0);
+}
+
+// most frequent parent among a fixed sample of the vertices
+template <typename Parent, typename VertexId>
+VertexId cc_sample_frequent_element(const Parent * parents, const VertexId num_vertices)
+{
+    std::vector<VertexId> samples(cc_num_samples);
+
+    unsigned int seed = 0;
+
+    for(int i = 0; i < cc_num_samples; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        samples[i] = parents[seed % num_vertices];
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    VertexId frequent = samples[0];
+    int      max_run  = 0;
+
+    for(int i = 0; i < cc_num_samples;)
+    {
+        int j = i;
+
+        while(j < cc_num_samples && samples[j] == samples[i])
+            j++;
+
+        if(j - i > max_run)
+        {
+            max_run  = j - i;
+            frequent = samples[i];
+        }
+
+        i = j;
+    }
+
+    return frequent;
+}
+
+} // end namespace detail
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t connected_components(tbb::execution_policy<DerivedPolicy>& exec,
+                            const MatrixType& G,
+                            ArrayType& components,
+                            cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+    typedef typename detail::cc_atomic<VertexId>::type Parent;
+
+    const VertexId num_vertices = G.num_rows;
+
+    if(num_vertices == 0)
+        return 0;
+
+    std::vector<Parent> parents(num_vertices);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_vertices),
+                        detail::cc_init_body<VertexId>(&parents[0]));
+
+    // link a few neighbors of every vertex
+    for(int r = 0; r < detail::cc_neighbor_rounds; r++)
+        detail::cc_link(G, &parents[0], r, r + 1, VertexId(-1));
+
+    // link the remaining edges outside of the largest component
+    VertexId skip = detail::cc_sample_frequent_element(&parents[0], num_vertices);
+
+    detail::cc_link(G, &parents[0], detail::cc_neighbor_rounds, size_t(-1), skip);
+
+    // label the components in order of their smallest vertex
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> roots(exec, num_vertices);
+    VertexId * roots_ptr = thrust::raw_pointer_cast(roots.data());
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_vertices),
+                        detail::cc_roots_body<VertexId>(&parents[0], roots_ptr));
+
+    const size_t num_components = thrust::reduce(exec, roots.begin(), roots.end());
+
+    thrust::exclusive_scan(exec, roots.begin(), roots.end(), roots.begin());
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_vertices),
+                        detail::cc_label_body<ArrayType, VertexId>(&parents[0], roots_ptr, components));
+
+    return num_components;
+}
+
+} // end namespace tbb
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::tbb::connected_components;
+
+} // end namespace cusp
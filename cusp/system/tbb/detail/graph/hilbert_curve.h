@@ -17,6 +17,254 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system inherits elementwise
 #include <cusp/system/detail/sequential/graph/hilbert_curve.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#if TBB_INTERFACE_VERSION >= 9100
+#include <tbb/task_arena.h>
+#else
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+
+////////////////////////////////////////////////////////////////////////
+// Hilbert curve ordering for the TBB system
+///////////////////////////////////////////////////////////////////////
+//
+// The integer Hilbert keys of the points are computed in parallel and
+// sorted by a least significant digit radix sort. Every task counts the
+// digits of one contiguous chunk of keys and scatters the chunk to the
+// offsets computed from all counts, so every pass is stable. Passes
+// over a digit shared by all the keys are skipped.
+//
+
+namespace detail
+{
+
+// bits sorted per radix sort pass
+const int hilbert_radix_bits = 8;
+const int hilbert_radix_size = 1 << hilbert_radix_bits;
+
+inline int hilbert_concurrency(void)
+{
+#if TBB_INTERFACE_VERSION >= 9100
+    return ::tbb::this_task_arena::max_concurrency();
+#else
+    return ::tbb::task_scheduler_init::default_num_threads();
+#endif
+}
+
+template <typename Array2d, typename KeyType, typename IndexType>
+struct hilbert_key_body
+{
+    const Array2d& coord;
+    KeyType   * const keys;
+    IndexType * const order;
+
+    hilbert_key_body(const Array2d& coord, KeyType * keys, IndexType * order)
+        : coord(coord), keys(keys), order(order)
+    {}
+
+    void operator()(const ::tbb::blocked_range<int>& r) const
+    {
+        namespace hilbert_detail = cusp::system::detail::sequential::detail;
+
+        for(int n = r.begin(); n < r.end(); n++)
+        {
+            if( coord.num_cols == 2 )
+                keys[n] = hilbert_detail::hilbert_key_2d(coord(n,0), coord(n,1));
+            else
+                keys[n] = hilbert_detail::hilbert_key_3d(coord(n,0), coord(n,1), coord(n,2));
+
+            order[n] = n;
+        }
+    }
+};
+
+template <typename KeyType, typename IndexType>
+struct hilbert_radix_body
+{
+    const KeyType   * const src_keys;
+    const IndexType * const src_order;
+    KeyType   * const dst_keys;
+    IndexType * const dst_order;
+    size_t    * const counts;
+    const int num_keys;
+    const int chunk_size;
+    const int shift;
+    const bool scatter;
+
+    hilbert_radix_body(const KeyType * src_keys, const IndexType * src_order,
+                       KeyType * dst_keys, IndexType * dst_order, size_t * counts,
+                       const int num_keys, const int chunk_size, const int shift, const bool scatter)
+        : src_keys(src_keys), src_order(src_order), dst_keys(dst_keys), dst_order(dst_order), counts(counts),
+          num_keys(num_keys), chunk_size(chunk_size), shift(shift), scatter(scatter)
+    {}
+
+    void operator()(const ::tbb::blocked_range<int>& r) const
+    {
+        for(int c = r.begin(); c < r.end(); c++)
+        {
+            size_t * chunk_counts = counts + c * hilbert_radix_size;
+            const int begin = std::min(c * chunk_size, num_keys);
+            const int end   = std::min(begin + chunk_size, num_keys);
+
+            if( !scatter )
+            {
+                std::fill(chunk_counts, chunk_counts + hilbert_radix_size, size_t(0));
+
+                for(int n = begin; n < end; n++)
+                    chunk_counts[(src_keys[n] >> shift) & (hilbert_radix_size - 1)]++;
+            }
+            else
+            {
+                for(int n = begin; n < end; n++)
+                {
+                    const size_t position = chunk_counts[(src_keys[n] >> shift) & (hilbert_radix_size - 1)]++;
+                    dst_keys[position]  = src_keys[n];
+                    dst_order[position] = src_order[n];
+                }
+            }
+        }
+    }
+};
+
+template <typename IndexType, typename Array1d, typename ArrayType>
+struct hilbert_part_body
+{
+    const IndexType * const order;
+    Array1d&   parts;
+    ArrayType& permutation;
+    const size_t num_points;
+    const size_t num_parts;
+
+    hilbert_part_body(const IndexType * order, Array1d& parts, ArrayType& permutation,
+                      const size_t num_points, const size_t num_parts)
+        : order(order), parts(parts), permutation(permutation), num_points(num_points), num_parts(num_parts)
+    {}
+
+    void operator()(const ::tbb::blocked_range<int>& r) const
+    {
+        for(int n = r.begin(); n < r.end(); n++)
+        {
+            permutation[order[n]] = n;
+            parts[order[n]] = size_t(n) * num_parts / num_points;
+        }
+    }
+};
+
+template <typename KeyType, typename IndexType>
+void hilbert_radix_sort(KeyType * keys, IndexType * order,
+                        KeyType * temp_keys, IndexType * temp_order,
+                        const int num_keys, const int key_bits)
+{
+    const int num_chunks = std::max(1, hilbert_concurrency());
+    const int chunk_size = (num_keys + num_chunks - 1) / num_chunks;
+
+    std::vector<size_t> counts(num_chunks * hilbert_radix_size);
+    size_t * counts_ptr = &counts[0];
+
+    KeyType   * src_keys  = keys;
+    IndexType * src_order = order;
+    KeyType   * dst_keys  = temp_keys;
+    IndexType * dst_order = temp_order;
+
+    for(int shift = 0; shift < key_bits; shift += hilbert_radix_bits)
+    {
+        ::tbb::parallel_for(::tbb::blocked_range<int>(0, num_chunks, 1),
+                            hilbert_radix_body<KeyType,IndexType>(src_keys, src_order, dst_keys, dst_order, counts_ptr,
+                                                                  num_keys, chunk_size, shift, false));
+
+        // offsets of every chunk into every digit, digit major
+        bool uniform = false;
+        size_t offset = 0;
+
+        for(int d = 0; d < hilbert_radix_size; d++)
+        {
+            const size_t digit_begin = offset;
+
+            for(int c = 0; c < num_chunks; c++)
+            {
+                const size_t count = counts_ptr[c * hilbert_radix_size + d];
+                counts_ptr[c * hilbert_radix_size + d] = offset;
+                offset += count;
+            }
+
+            uniform = uniform || (offset - digit_begin == size_t(num_keys));
+        }
+
+        if(uniform)
+            continue;
+
+        ::tbb::parallel_for(::tbb::blocked_range<int>(0, num_chunks, 1),
+                            hilbert_radix_body<KeyType,IndexType>(src_keys, src_order, dst_keys, dst_order, counts_ptr,
+                                                                  num_keys, chunk_size, shift, true));
+
+        std::swap(src_keys, dst_keys);
+        std::swap(src_order, dst_order);
+    }
+
+    if(src_order != order)
+        std::copy(src_order, src_order + num_keys, order);
+}
+
+} // end namespace detail
+
+template <typename DerivedPolicy, typename Array2d, typename Array1d, typename ArrayType>
+void hilbert_curve(tbb::execution_policy<DerivedPolicy>& exec,
+                   const Array2d& coord,
+                   size_t num_parts,
+                   Array1d& parts,
+                   ArrayType& permutation)
+{
+    namespace hilbert_detail = cusp::system::detail::sequential::detail;
+
+    typedef hilbert_detail::hilbert_key_type KeyType;
+    typedef typename ArrayType::value_type   IndexType;
+
+    const int num_points = coord.num_rows;
+
+    hilbert_detail::hilbert_check_coordinates(exec, coord);
+
+    cusp::detail::temporary_array<KeyType, DerivedPolicy>   keys(exec, num_points);
+    cusp::detail::temporary_array<KeyType, DerivedPolicy>   temp_keys(exec, num_points);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> order(exec, num_points);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> temp_order(exec, num_points);
+
+    KeyType   * keys_ptr  = thrust::raw_pointer_cast(keys.data());
+    IndexType * order_ptr = thrust::raw_pointer_cast(order.data());
+
+    ::tbb::parallel_for(::tbb::blocked_range<int>(0, num_points),
+                        detail::hilbert_key_body<Array2d,KeyType,IndexType>(coord, keys_ptr, order_ptr));
+
+    detail::hilbert_radix_sort(keys_ptr, order_ptr,
+                               thrust::raw_pointer_cast(temp_keys.data()),
+                               thrust::raw_pointer_cast(temp_order.data()),
+                               num_points, hilbert_detail::hilbert_key_bits(coord.num_cols));
+
+    // consecutive runs of the curve form the parts
+    ::tbb::parallel_for(::tbb::blocked_range<int>(0, num_points),
+                        detail::hilbert_part_body<IndexType,Array1d,ArrayType>(order_ptr, parts, permutation,
+                                                                               num_points, num_parts));
+}
+
+} // end namespace tbb
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::tbb::hilbert_curve;
+
+} // end namespace cusp
@@ -14,8 +14,260 @@
  *  limitations under the License.
  */
 
+
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <functional>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Luby style MIS-k, see the OpenMP version for a description of the rounds
+const char mis_out_node       = 0;
+const char mis_undecided_node = 1;
+const char mis_node           = 2;
+
+typedef unsigned long long mis_key;
+
+// random priority of a vertex, a fixed integer hash of its index
+inline unsigned int mis_priority(unsigned int a)
+{
+    a ^= a >> 16;
+    a *= 0x7feb352dU;
+    a ^= a >> 15;
+    a *= 0x846ca68bU;
+    a ^= a >> 16;
+    return a;
+}
+
+// packs the (state, priority, index) tuple of a vertex into one key so
+// that comparing keys compares tuples, the index takes the low 31 bits
+inline mis_key mis_make_key(const char state, const unsigned int i)
+{
+    return (mis_key(state) << 62) | (mis_key(mis_priority(i) >> 1) << 31) | mis_key(i);
+}
+
+inline unsigned int mis_key_index(const mis_key key)
+{
+    return (unsigned int)(key & 0x7fffffffU);
+}
+
+struct mis_init_body
+{
+    mis_key * keys;
+
+    mis_init_body(mis_key * keys) : keys(keys) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t i = r.begin(); i < r.end(); i++)
+            keys[i] = mis_make_key(mis_undecided_node, i);
+    }
+};
+
+// One sweep of max-propagation, every vertex takes the largest key
+// among its own and those of its neighbors
+template <typename MatrixType>
+struct mis_propagate_body
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const MatrixType& G;
+    const mis_key * maximal;
+    mis_key * next_maximal;
+
+    mis_propagate_body(const MatrixType& G, const mis_key * maximal, mis_key * next_maximal)
+        : G(G), maximal(maximal), next_maximal(next_maximal) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t i = r.begin(); i < r.end(); i++)
+        {
+            mis_key m = maximal[i];
+
+            for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = G.column_indices[jj];
+
+                if(j >= 0)
+                    m = std::max(m, maximal[j]);
+            }
+
+            next_maximal[i] = m;
+        }
+    }
+};
+
+// Labels the undecided local maxima as MIS nodes
+struct mis_select_body
+{
+    char * states;
+    mis_key * keys;
+    const mis_key * maximal;
+
+    mis_select_body(char * states, mis_key * keys, const mis_key * maximal)
+        : states(states), keys(keys), maximal(maximal) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        for(size_t i = r.begin(); i < r.end(); i++)
+        {
+            if(states[i] == mis_undecided_node && maximal[i] == keys[i])
+            {
+                states[i] = mis_node;
+                keys[i]   = mis_make_key(mis_node, i);
+            }
+        }
+    }
+};
+
+// Labels the k-ring neighbors of MIS nodes as non-MIS nodes and counts
+// the vertices still undecided
+struct mis_remove_body
+{
+    typedef ::tbb::enumerable_thread_specific<size_t> CountType;
+
+    const char * states;
+    char * next_states;
+    mis_key * keys;
+    const mis_key * maximal;
+    CountType& counts;
+
+    mis_remove_body(const char * states, char * next_states, mis_key * keys,
+                    const mis_key * maximal, CountType& counts)
+        : states(states), next_states(next_states), keys(keys), maximal(maximal), counts(counts) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        size_t& count = counts.local();
+
+        for(size_t i = r.begin(); i < r.end(); i++)
+        {
+            next_states[i] = states[i];
+
+            if(states[i] == mis_undecided_node)
+            {
+                if(states[mis_key_index(maximal[i])] == mis_node)
+                {
+                    next_states[i] = mis_out_node;
+                    keys[i]        = mis_make_key(mis_out_node, i);
+                }
+                else
+                {
+                    count++;
+                }
+            }
+        }
+    }
+};
+
+template <typename ArrayType>
+struct mis_output_body
+{
+    typedef ::tbb::enumerable_thread_specific<size_t> CountType;
+
+    const char * states;
+    ArrayType& stencil;
+    CountType& counts;
+
+    mis_output_body(const char * states, ArrayType& stencil, CountType& counts)
+        : states(states), stencil(stencil), counts(counts) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        size_t& count = counts.local();
+
+        for(size_t i = r.begin(); i < r.end(); i++)
+        {
+            stencil[i] = states[i] == mis_node;
+            count += states[i] == mis_node;
+        }
+    }
+};
+
+} // end namespace detail
+
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t maximal_independent_set(tbb::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                               ArrayType& stencil,
+                               const size_t k,
+                               cusp::csr_format)
+{
+    using detail::mis_key;
+    typedef ::tbb::enumerable_thread_specific<size_t> CountType;
+
+    const size_t N = G.num_rows;
+
+    cusp::detail::temporary_array<char, DerivedPolicy>    states(exec, N, detail::mis_undecided_node);
+    cusp::detail::temporary_array<char, DerivedPolicy>    next_states(exec, N);
+    cusp::detail::temporary_array<mis_key, DerivedPolicy> keys(exec, N);
+    cusp::detail::temporary_array<mis_key, DerivedPolicy> maximal(exec, N);
+    cusp::detail::temporary_array<mis_key, DerivedPolicy> next_maximal(exec, N);
+
+    char    * states_ptr       = thrust::raw_pointer_cast(states.data());
+    char    * next_states_ptr  = thrust::raw_pointer_cast(next_states.data());
+    mis_key * keys_ptr         = thrust::raw_pointer_cast(keys.data());
+    mis_key * maximal_ptr      = thrust::raw_pointer_cast(maximal.data());
+    mis_key * next_maximal_ptr = thrust::raw_pointer_cast(next_maximal.data());
+
+    ::tbb::blocked_range<size_t> range(0, N, 1024);
+
+    ::tbb::parallel_for(range, detail::mis_init_body(keys_ptr));
+
+    size_t active_nodes = N;
+
+    while(active_nodes > 0)
+    {
+        // find the largest key in the k-ring of every vertex
+        ::tbb::parallel_for(range, detail::mis_propagate_body<MatrixType>(G, keys_ptr, maximal_ptr));
+
+        for(size_t ring = 1; ring < k; ring++)
+        {
+            ::tbb::parallel_for(range, detail::mis_propagate_body<MatrixType>(G, maximal_ptr, next_maximal_ptr));
+            std::swap(maximal_ptr, next_maximal_ptr);
+        }
+
+        // label local maxima as MIS nodes
+        ::tbb::parallel_for(range, detail::mis_select_body(states_ptr, keys_ptr, maximal_ptr));
+
+        // label k-ring neighbors of MIS nodes as non-MIS nodes
+        CountType undecided_nodes(0);
+        ::tbb::parallel_for(range, detail::mis_remove_body(states_ptr, next_states_ptr, keys_ptr,
+                                                           maximal_ptr, undecided_nodes));
+
+        std::swap(states_ptr, next_states_ptr);
+        active_nodes = undecided_nodes.combine(std::plus<size_t>());
+    }
+
+    // write output
+    stencil.resize(N);
+
+    CountType set_nodes(0);
+    ::tbb::parallel_for(range, detail::mis_output_body<ArrayType>(states_ptr, stencil, set_nodes));
+
+    return set_nodes.combine(std::plus<size_t>());
+}
+
+} // end namespace tbb
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::tbb::maximal_independent_set;
 
-// this system has no special version of this algorithm
+} // end namespace cusp
@@ -17,5 +17,163 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
 
-// this system has no special version of this algorithm
+#include <cusp/system/detail/sequential/graph/pseudo_peripheral.h>
+
+#include <thrust/copy.h>
+
+#include <tbb/task_group.h>
+
+#if TBB_INTERFACE_VERSION >= 9100
+#include <tbb/task_arena.h>
+#else
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+
+////////////////////////////////////////////////////////////////////////
+// Multi-source pseudo-peripheral vertex search for the TBB system
+///////////////////////////////////////////////////////////////////////
+//
+// Every iteration roots level structures at several vertices of
+// smallest degree in the last level of the current one, as tasks of a
+// task group, and continues from the candidate of largest eccentricity.
+// The search stops at the best candidate once none improves the
+// eccentricity. The level structures are written to one buffer
+// preallocated for all iterations.
+//
+
+namespace detail
+{
+
+// maximum number of level structures computed per iteration
+const size_t peripheral_max_candidates = 8;
+
+inline size_t peripheral_concurrency(void)
+{
+#if TBB_INTERFACE_VERSION >= 9100
+    return ::tbb::this_task_arena::max_concurrency();
+#else
+    return ::tbb::task_scheduler_init::default_num_threads();
+#endif
+}
+
+template <typename MatrixType, typename IndexType>
+struct peripheral_level_structure
+{
+    const MatrixType& G;
+    const IndexType   src;
+    IndexType * const levels;
+    IndexType * const queue;
+    size_t    * const num_reached;
+    IndexType * const depth;
+
+    peripheral_level_structure(const MatrixType& G, const IndexType src,
+                               IndexType * levels, IndexType * queue,
+                               size_t * num_reached, IndexType * depth)
+        : G(G), src(src), levels(levels), queue(queue), num_reached(num_reached), depth(depth)
+    {}
+
+    void operator()(void) const
+    {
+        *num_reached = cusp::system::detail::sequential::peripheral_detail::level_structure(G, src, levels, queue);
+        *depth       = levels[queue[*num_reached - 1]];
+    }
+};
+
+} // end namespace detail
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(tbb::execution_policy<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                         ArrayType& levels,
+                         cusp::csr_format)
+{
+    namespace peripheral_detail = cusp::system::detail::sequential::peripheral_detail;
+
+    typedef typename MatrixType::index_type IndexType;
+
+    const size_t N = G.num_rows;
+    const size_t max_candidates =
+        std::max(size_t(1), std::min(detail::peripheral_concurrency(), detail::peripheral_max_candidates));
+
+    // slot 0 holds the current level structure, the others the candidates
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> level_buffer(exec, (max_candidates + 1) * N);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> queue_buffer(exec, (max_candidates + 1) * N);
+    std::vector<size_t>    num_reached(max_candidates + 1);
+    std::vector<IndexType> depths(max_candidates + 1);
+    std::vector<size_t>    slots(max_candidates + 1);
+    std::vector< std::pair<IndexType,IndexType> > candidates;
+
+    IndexType * level_ptr = thrust::raw_pointer_cast(level_buffer.data());
+    IndexType * queue_ptr = thrust::raw_pointer_cast(queue_buffer.data());
+
+    for(size_t s = 0; s <= max_candidates; s++)
+        slots[s] = s * N;
+
+    IndexType x = rand() % N;
+    num_reached[0] = peripheral_detail::level_structure(G, x, level_ptr + slots[0], queue_ptr + slots[0]);
+    depths[0]      = level_ptr[slots[0] + queue_ptr[slots[0] + num_reached[0] - 1]];
+
+    while(true)
+    {
+        const size_t num_candidates =
+            peripheral_detail::last_level_candidates(G, level_ptr + slots[0], queue_ptr + slots[0],
+                                                     num_reached[0], max_candidates, candidates);
+
+        ::tbb::task_group group;
+
+        for(size_t c = 0; c < num_candidates; c++)
+        {
+            const size_t slot = slots[c + 1];
+
+            group.run(detail::peripheral_level_structure<MatrixType,IndexType>(G, candidates[c].second,
+                                                                               level_ptr + slot, queue_ptr + slot,
+                                                                               &num_reached[c + 1], &depths[c + 1]));
+        }
+
+        group.wait();
+
+        // the candidates are ordered by degree, so ties keep the smallest
+        size_t best = 0;
+        for(size_t c = 1; c < num_candidates; c++)
+            if(depths[c + 1] > depths[best + 1])
+                best = c;
+
+        const bool improved = depths[best + 1] > depths[0];
+
+        x = candidates[best].second;
+        std::swap(slots[0], slots[best + 1]);
+        num_reached[0] = num_reached[best + 1];
+        depths[0]      = depths[best + 1];
+
+        if(!improved)
+            break;
+    }
+
+    thrust::copy(exec, level_ptr + slots[0], level_ptr + slots[0] + N, levels.begin());
+
+    return x;
+}
+
+} // end namespace tbb
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::tbb::pseudo_peripheral_vertex;
+
+} // end namespace cusp
@@ -14,8 +14,330 @@
  *  limitations under the License.
  */
 
+
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/system/detail/sequential/graph/vertex_coloring.h>
+
+#include <thrust/functional.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#if TBB_INTERFACE_VERSION >= 12000
+#include <atomic>
+#else
+#include <tbb/atomic.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Speculative greedy coloring [Gebremedhin & Manne 2000], see the OpenMP
+// version for a description of the rounds
+
+// tentative colors are shared between the tasks
+template <typename T>
+struct coloring_atomic
+{
+#if TBB_INTERFACE_VERSION >= 12000
+    typedef std::atomic<T> type;
+#else
+    typedef ::tbb::atomic<T> type;
+#endif
+};
+
+// Marks the tentative colors around a vertex, growing the marks when
+// the neighborhood of a distance-k coloring holds more colors
+template <typename VertexId>
+struct coloring_mark_visitor
+{
+    typedef typename coloring_atomic<VertexId>::type Color;
+
+    const Color * colors;
+    std::vector<VertexId>& mark;
+    const VertexId vertex;
+
+    coloring_mark_visitor(const Color * colors, std::vector<VertexId>& mark, const VertexId vertex)
+        : colors(colors), mark(mark), vertex(vertex) {}
+
+    bool operator()(const VertexId u)
+    {
+        const VertexId c = colors[u];
+
+        if(c >= 0)
+        {
+            if(size_t(c) >= mark.size())
+                mark.resize(c + 1, VertexId(-1));
+
+            mark[c] = vertex;
+        }
+
+        return false;
+    }
+};
+
+// Finds a vertex of higher priority with the same color
+template <typename VertexId>
+struct coloring_conflict_visitor
+{
+    typedef typename coloring_atomic<VertexId>::type Color;
+
+    const Color * colors;
+    const VertexId * ranks;
+    const VertexId vertex;
+    const VertexId color;
+
+    coloring_conflict_visitor(const Color * colors, const VertexId * ranks, const VertexId vertex)
+        : colors(colors), ranks(ranks), vertex(vertex), color(colors[vertex]) {}
+
+    bool operator()(const VertexId u)
+    {
+        return VertexId(colors[u]) == color && ranks[u] < ranks[vertex];
+    }
+};
+
+// Colors every vertex of the worklist with the smallest color missing
+// among the vertices within the coloring distance
+template <typename MatrixType, typename VertexId>
+struct coloring_tentative_body
+{
+    typedef typename coloring_atomic<VertexId>::type Color;
+    typedef ::tbb::enumerable_thread_specific< std::vector<VertexId> > MarkType;
+    typedef cusp::system::detail::sequential::coloring_detail::distance_k_workspace<VertexId> Workspace;
+    typedef ::tbb::enumerable_thread_specific<Workspace> WorkspaceType;
+
+    const MatrixType& G;
+    const VertexId * worklist;
+    Color * colors;
+    const VertexId max_degree;
+    const size_t distance;
+    MarkType& marks;
+    WorkspaceType& workspaces;
+
+    coloring_tentative_body(const MatrixType& G, const VertexId * worklist, Color * colors,
+                            const VertexId max_degree, const size_t distance,
+                            MarkType& marks, WorkspaceType& workspaces)
+        : G(G), worklist(worklist), colors(colors), max_degree(max_degree), distance(distance),
+          marks(marks), workspaces(workspaces) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        std::vector<VertexId>& mark = marks.local();
+        Workspace& workspace = workspaces.local();
+
+        if(mark.empty())
+            mark.resize(max_degree + 1, VertexId(-1));
+
+        for(size_t n = r.begin(); n < r.end(); n++)
+        {
+            const VertexId v = worklist[n];
+
+            coloring_mark_visitor<VertexId> visitor(colors, mark, v);
+            cusp::system::detail::sequential::coloring_detail::visit_distance_k(G, v, distance, workspace, visitor);
+
+            VertexId c = 0;
+            while(size_t(c) < mark.size() && mark[c] == v)
+                c++;
+
+            colors[v] = c;
+        }
+    }
+};
+
+// Gathers the vertices of the worklist sharing their color with a
+// vertex of higher priority within the coloring distance
+template <typename MatrixType, typename VertexId>
+struct coloring_conflict_body
+{
+    typedef typename coloring_atomic<VertexId>::type Color;
+    typedef ::tbb::enumerable_thread_specific< std::vector<VertexId> > LocalType;
+    typedef cusp::system::detail::sequential::coloring_detail::distance_k_workspace<VertexId> Workspace;
+    typedef ::tbb::enumerable_thread_specific<Workspace> WorkspaceType;
+
+    const MatrixType& G;
+    const VertexId * worklist;
+    const Color * colors;
+    const VertexId * ranks;
+    const size_t distance;
+    LocalType& locals;
+    WorkspaceType& workspaces;
+
+    coloring_conflict_body(const MatrixType& G, const VertexId * worklist, const Color * colors,
+                           const VertexId * ranks, const size_t distance,
+                           LocalType& locals, WorkspaceType& workspaces)
+        : G(G), worklist(worklist), colors(colors), ranks(ranks), distance(distance),
+          locals(locals), workspaces(workspaces) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        std::vector<VertexId>& local = locals.local();
+        Workspace& workspace = workspaces.local();
+
+        for(size_t n = r.begin(); n < r.end(); n++)
+        {
+            const VertexId v = worklist[n];
+
+            coloring_conflict_visitor<VertexId> visitor(colors, ranks, v);
+
+            if(cusp::system::detail::sequential::coloring_detail::visit_distance_k(G, v, distance, workspace, visitor))
+                local.push_back(v);
+        }
+    }
+};
+
+template <typename MatrixType, typename VertexId>
+struct coloring_setup_body
+{
+    typedef typename coloring_atomic<VertexId>::type Color;
+    typedef ::tbb::enumerable_thread_specific<VertexId> DegreeType;
+
+    const MatrixType& G;
+    const VertexId * worklist;
+    VertexId * ranks;
+    Color * colors;
+    DegreeType& max_degrees;
+
+    coloring_setup_body(const MatrixType& G, const VertexId * worklist, VertexId * ranks,
+                        Color * colors, DegreeType& max_degrees)
+        : G(G), worklist(worklist), ranks(ranks), colors(colors), max_degrees(max_degrees) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        VertexId& max_degree = max_degrees.local();
+
+        for(size_t n = r.begin(); n < r.end(); n++)
+        {
+            ranks[worklist[n]] = n;
+            colors[n] = VertexId(-1);
+            max_degree = std::max(max_degree, VertexId(G.row_offsets[n + 1] - G.row_offsets[n]));
+        }
+    }
+};
+
+template <typename ArrayType, typename VertexId>
+struct coloring_copy_body
+{
+    typedef typename coloring_atomic<VertexId>::type Color;
+    typedef ::tbb::enumerable_thread_specific<VertexId> ColorType;
+
+    const Color * colors;
+    ArrayType& output;
+    ColorType& max_colors;
+
+    coloring_copy_body(const Color * colors, ArrayType& output, ColorType& max_colors)
+        : colors(colors), output(output), max_colors(max_colors) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        VertexId& max_color = max_colors.local();
+
+        for(size_t n = r.begin(); n < r.end(); n++)
+        {
+            output[n] = VertexId(colors[n]);
+            max_color = std::max(max_color, VertexId(colors[n]));
+        }
+    }
+};
+
+} // end namespace detail
+
+template<typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t vertex_coloring(tbb::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                       ArrayType& colors,
+                       const cusp::graph::vertex_ordering ordering,
+                       const size_t distance,
+                       cusp::csr_format)
+{
+    typedef typename MatrixType::index_type VertexId;
+    typedef typename detail::coloring_atomic<VertexId>::type Color;
+    typedef ::tbb::enumerable_thread_specific< std::vector<VertexId> > LocalType;
+    typedef ::tbb::enumerable_thread_specific<VertexId> MaxType;
+    typedef typename detail::coloring_tentative_body<MatrixType, VertexId>::WorkspaceType WorkspaceType;
+
+    const size_t N = G.num_rows;
+
+    if(N == 0)
+        return 0;
+
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> worklist(exec, N);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> next_worklist(exec, N);
+    cusp::detail::temporary_array<VertexId, DerivedPolicy> ranks(exec, N);
+    std::vector<Color> vertex_colors(N);
+
+    VertexId * worklist_ptr      = thrust::raw_pointer_cast(worklist.data());
+    VertexId * next_worklist_ptr = thrust::raw_pointer_cast(next_worklist.data());
+    VertexId * ranks_ptr         = thrust::raw_pointer_cast(ranks.data());
+
+    // the ordering is computed sequentially, the natural one is trivial
+    cusp::system::detail::sequential::coloring_detail::vertex_order(G, ordering, worklist);
+
+    MaxType max_degrees(0);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, N),
+                        detail::coloring_setup_body<MatrixType, VertexId>(G, worklist_ptr, ranks_ptr,
+                                                                          &vertex_colors[0], max_degrees));
+    const VertexId max_degree = max_degrees.combine(thrust::maximum<VertexId>());
+
+    LocalType marks;
+    LocalType locals;
+    WorkspaceType workspaces;
+    size_t worklist_size = N;
+
+    while(worklist_size > 0)
+    {
+        // marks left by an earlier round may hold the id of a vertex that
+        // is colored again, which would make its old colors look taken
+        for(typename LocalType::iterator i = marks.begin(); i != marks.end(); ++i)
+            std::fill(i->begin(), i->end(), VertexId(-1));
+
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, worklist_size, 256),
+                            detail::coloring_tentative_body<MatrixType, VertexId>(G, worklist_ptr, &vertex_colors[0],
+                                                                                  max_degree, distance,
+                                                                                  marks, workspaces));
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, worklist_size, 256),
+                            detail::coloring_conflict_body<MatrixType, VertexId>(G, worklist_ptr, &vertex_colors[0],
+                                                                                 ranks_ptr, distance,
+                                                                                 locals, workspaces));
+
+        // concatenate the per-thread conflicts into the next worklist
+        worklist_size = 0;
+
+        for(typename LocalType::iterator i = locals.begin(); i != locals.end(); ++i)
+        {
+            std::copy(i->begin(), i->end(), next_worklist_ptr + worklist_size);
+            worklist_size += i->size();
+            i->clear();
+        }
+
+        std::swap(worklist_ptr, next_worklist_ptr);
+    }
+
+    MaxType max_colors(0);
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, N),
+                        detail::coloring_copy_body<ArrayType, VertexId>(&vertex_colors[0], colors, max_colors));
+
+    return max_colors.combine(thrust::maximum<VertexId>()) + 1;
+}
+
+} // end namespace tbb
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::tbb::vertex_coloring;
 
-// this system has no special version of this algorithm
+} // end namespace cusp
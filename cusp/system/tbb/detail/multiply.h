@@ -18,5 +18,29 @@
 
 #include <cusp/detail/config.h>
 
-// this system inherits multiply
+#include <cusp/system/tbb/detail/multiply/coo_spmv.h>
+#include <cusp/system/tbb/detail/multiply/csr_spmv.h>
+#include <cusp/system/tbb/detail/multiply/dia_spmv.h>
+#include <cusp/system/tbb/detail/multiply/ell_spmv.h>
+#include <cusp/system/tbb/detail/multiply/hyb_spmv.h>
+
+#include <cusp/system/tbb/detail/multiply/coo_spgemm.h>
+#include <cusp/system/tbb/detail/multiply/csr_spgemm.h>
+
+// this system inherits the remaining multiply variants
 #include <cusp/system/cpp/detail/multiply.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+
+} // end namespace tbb
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::tbb::multiply;
+
+} // end namespace cusp
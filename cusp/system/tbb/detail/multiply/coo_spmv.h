@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+template <typename VectorType, typename UnaryFunction>
+struct initialize_body
+{
+    typedef typename VectorType::value_type ValueType;
+
+    VectorType&   y;
+    UnaryFunction initialize;
+
+    initialize_body(VectorType& y, UnaryFunction initialize)
+        : y(y), initialize(initialize) {}
+
+    template <typename IndexType>
+    void operator()(const ::tbb::blocked_range<IndexType>& r) const
+    {
+        for(IndexType i = r.begin(); i < r.end(); i++)
+            y[i] = initialize(ValueType(y[i]));
+    }
+};
+
+// Each range of entries is widened to the row boundaries that follow its
+// endpoints, so adjacent ranges own disjoint sets of complete rows and
+// no two tasks ever update the same output entry.
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+struct coo_spmv_body
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const MatrixType&  A;
+    const VectorType1& x;
+    VectorType2&       y;
+    BinaryFunction1 combine;
+    BinaryFunction2 reduce;
+
+    coo_spmv_body(const MatrixType& A, const VectorType1& x, VectorType2& y,
+                  BinaryFunction1 combine, BinaryFunction2 reduce)
+        : A(A), x(x), y(y), combine(combine), reduce(reduce) {}
+
+    IndexType row_boundary(IndexType n) const
+    {
+        const IndexType num_entries = A.num_entries;
+
+        while(n > 0 && n < num_entries && A.row_indices[n] == A.row_indices[n - 1])
+            n++;
+
+        return n;
+    }
+
+    void operator()(const ::tbb::blocked_range<IndexType>& r) const
+    {
+        const IndexType n_start = row_boundary(r.begin());
+        const IndexType n_end   = row_boundary(r.end());
+
+        for(IndexType n = n_start; n < n_end; n++)
+        {
+            const IndexType i   = A.row_indices[n];
+            const IndexType j   = A.column_indices[n];
+            const ValueType Aij = A.values[n];
+            const ValueType xj  = x[j];
+
+            y[i] = reduce(ValueType(y[i]), combine(Aij, xj));
+        }
+    }
+};
+
+} // end namespace detail
+
+// The row indices of A are assumed to be sorted
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(tbb::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::coo_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    detail::initialize_body<VectorType2,UnaryFunction> init_body(y, initialize);
+    ::tbb::parallel_for(::tbb::blocked_range<IndexType>(0, A.num_rows), init_body);
+
+    detail::coo_spmv_body<MatrixType,VectorType1,VectorType2,BinaryFunction1,BinaryFunction2>
+      body(A, x, y, combine, reduce);
+    ::tbb::parallel_for(::tbb::blocked_range<IndexType>(0, A.num_entries), body);
+}
+
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
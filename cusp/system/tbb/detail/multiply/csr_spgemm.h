@@ -0,0 +1,269 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <thrust/scan.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Counts the entries of every row of C = A * B using a dense
+// per-thread mask of the columns that have already been visited
+template <typename Array1, typename Array2,
+          typename Array3, typename Array4,
+          typename Array5>
+struct spmm_csr_pass1_body
+{
+    typedef typename Array5::value_type IndexType;
+    typedef ::tbb::enumerable_thread_specific< std::vector<IndexType> > MaskType;
+
+    const Array1& A_row_offsets;
+    const Array2& A_column_indices;
+    const Array3& B_row_offsets;
+    const Array4& B_column_indices;
+    Array5& C_row_offsets;
+    MaskType& masks;
+
+    spmm_csr_pass1_body(const Array1& A_row_offsets, const Array2& A_column_indices,
+                        const Array3& B_row_offsets, const Array4& B_column_indices,
+                        Array5& C_row_offsets, MaskType& masks)
+        : A_row_offsets(A_row_offsets), A_column_indices(A_column_indices),
+          B_row_offsets(B_row_offsets), B_column_indices(B_column_indices),
+          C_row_offsets(C_row_offsets), masks(masks) {}
+
+    void operator()(const ::tbb::blocked_range<IndexType>& r) const
+    {
+        std::vector<IndexType>& mask = masks.local();
+
+        for(IndexType i = r.begin(); i < r.end(); i++)
+        {
+            IndexType num_nonzeros = 0;
+
+            for(IndexType jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+            {
+                IndexType j = A_column_indices[jj];
+
+                for(IndexType kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+                {
+                    IndexType k = B_column_indices[kk];
+
+                    if(mask[k] != i)
+                    {
+                        mask[k] = i;
+                        num_nonzeros++;
+                    }
+                }
+            }
+
+            C_row_offsets[i + 1] = num_nonzeros;
+        }
+    }
+};
+
+// Accumulates the rows of C = A * B into a dense per-thread workspace
+// threaded by a linked list of the columns touched in the current row
+template <typename Array1, typename Array2, typename Array3,
+          typename Array4, typename Array5, typename Array6,
+          typename Array7, typename Array8, typename Array9,
+          typename BinaryFunction1, typename BinaryFunction2>
+struct spmm_csr_pass2_body
+{
+    typedef typename Array7::value_type IndexType;
+    typedef typename Array9::value_type ValueType;
+    typedef ::tbb::enumerable_thread_specific< std::vector<IndexType> > NextType;
+    typedef ::tbb::enumerable_thread_specific< std::vector<ValueType> > SumsType;
+
+    const Array1& A_row_offsets; const Array2& A_column_indices; const Array3& A_values;
+    const Array4& B_row_offsets; const Array5& B_column_indices; const Array6& B_values;
+    const Array7& C_row_offsets; Array8& C_column_indices;       Array9& C_values;
+    BinaryFunction1 combine;
+    BinaryFunction2 reduce;
+    NextType& nexts;
+    SumsType& sums;
+
+    spmm_csr_pass2_body(const Array1& A_row_offsets, const Array2& A_column_indices, const Array3& A_values,
+                        const Array4& B_row_offsets, const Array5& B_column_indices, const Array6& B_values,
+                        const Array7& C_row_offsets, Array8& C_column_indices,       Array9& C_values,
+                        BinaryFunction1 combine, BinaryFunction2 reduce,
+                        NextType& nexts, SumsType& sums)
+        : A_row_offsets(A_row_offsets), A_column_indices(A_column_indices), A_values(A_values),
+          B_row_offsets(B_row_offsets), B_column_indices(B_column_indices), B_values(B_values),
+          C_row_offsets(C_row_offsets), C_column_indices(C_column_indices), C_values(C_values),
+          combine(combine), reduce(reduce), nexts(nexts), sums(sums) {}
+
+    void operator()(const ::tbb::blocked_range<IndexType>& r) const
+    {
+        const IndexType unseen = static_cast<IndexType>(-1);
+        const IndexType init   = static_cast<IndexType>(-2);
+
+        std::vector<IndexType>& next = nexts.local();
+        std::vector<ValueType>& sum  = sums.local();
+
+        for(IndexType i = r.begin(); i < r.end(); i++)
+        {
+            IndexType head   = init;
+            IndexType length = 0;
+
+            for(IndexType jj = A_row_offsets[i]; jj < A_row_offsets[i + 1]; jj++)
+            {
+                IndexType j = A_column_indices[jj];
+                ValueType v = A_values[jj];
+
+                for(IndexType kk = B_row_offsets[j]; kk < B_row_offsets[j + 1]; kk++)
+                {
+                    IndexType k = B_column_indices[kk];
+                    ValueType b = B_values[kk];
+
+                    sum[k] = reduce(sum[k], combine(v, b));
+
+                    if(next[k] == unseen)
+                    {
+                        next[k] = head;
+                        head = k;
+                        length++;
+                    }
+                }
+            }
+
+            IndexType offset = C_row_offsets[i];
+
+            for(IndexType jj = 0; jj < length; jj++)
+            {
+                C_column_indices[offset] = head;
+                C_values[offset] = sum[head];
+                offset++;
+
+                IndexType temp = head;
+                head = next[head];
+
+                // clear arrays
+                next[temp] = unseen;
+                sum[temp]  = ValueType(0);
+            }
+        }
+    }
+};
+
+} // end namespace detail
+
+template <typename DerivedPolicy,
+          typename Array1, typename Array2,
+          typename Array3, typename Array4,
+          typename Array5>
+size_t spmm_csr_pass1(tbb::execution_policy<DerivedPolicy>& exec,
+                      const size_t num_rows, const size_t num_cols,
+                      const Array1& A_row_offsets, const Array2& A_column_indices,
+                      const Array3& B_row_offsets, const Array4& B_column_indices,
+                      Array5& C_row_offsets)
+{
+    typedef typename Array5::value_type IndexType;
+    typedef detail::spmm_csr_pass1_body<Array1,Array2,Array3,Array4,Array5> Body;
+
+    typename Body::MaskType masks(std::vector<IndexType>(num_cols, static_cast<IndexType>(-1)));
+
+    C_row_offsets[0] = 0;
+
+    Body body(A_row_offsets, A_column_indices, B_row_offsets, B_column_indices, C_row_offsets, masks);
+    ::tbb::parallel_for(::tbb::blocked_range<IndexType>(0, num_rows), body);
+
+    thrust::inclusive_scan(exec, C_row_offsets.begin(), C_row_offsets.begin() + num_rows + 1, C_row_offsets.begin());
+
+    return C_row_offsets[num_rows];
+}
+
+template <typename DerivedPolicy,
+          typename Array1, typename Array2, typename Array3,
+          typename Array4, typename Array5, typename Array6,
+          typename Array7, typename Array8, typename Array9,
+          typename UnaryFunction, typename BinaryFunction1, typename BinaryFunction2>
+void spmm_csr_pass2(tbb::execution_policy<DerivedPolicy>& exec,
+                    const size_t num_rows, const size_t num_cols,
+                    const Array1& A_row_offsets, const Array2& A_column_indices, const Array3& A_values,
+                    const Array4& B_row_offsets, const Array5& B_column_indices, const Array6& B_values,
+                    Array7& C_row_offsets,       Array8& C_column_indices,       Array9& C_values,
+                    UnaryFunction initialize,    BinaryFunction1 combine,        BinaryFunction2 reduce)
+{
+    typedef typename Array7::value_type IndexType;
+    typedef typename Array9::value_type ValueType;
+    typedef detail::spmm_csr_pass2_body<Array1,Array2,Array3,Array4,Array5,Array6,Array7,Array8,Array9,
+                                        BinaryFunction1,BinaryFunction2> Body;
+
+    typename Body::NextType nexts(std::vector<IndexType>(num_cols, static_cast<IndexType>(-1)));
+    typename Body::SumsType sums(std::vector<ValueType>(num_cols, ValueType(0)));
+
+    Body body(A_row_offsets, A_column_indices, A_values,
+              B_row_offsets, B_column_indices, B_values,
+              C_row_offsets, C_column_indices, C_values,
+              combine, reduce, nexts, sums);
+    ::tbb::parallel_for(::tbb::blocked_range<IndexType>(0, num_rows), body);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(tbb::execution_policy<DerivedPolicy>& exec,
+              const MatrixType1& A,
+              const MatrixType2& B,
+              MatrixType3& C,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::csr_format,
+              cusp::csr_format,
+              cusp::csr_format)
+{
+    C.resize(A.num_rows, B.num_cols, 0);
+
+    size_t num_nonzeros =
+        spmm_csr_pass1(exec, A.num_rows, B.num_cols,
+                       A.row_offsets, A.column_indices,
+                       B.row_offsets, B.column_indices,
+                       C.row_offsets);
+
+    // Resize output
+    C.resize(A.num_rows, B.num_cols, num_nonzeros);
+
+    spmm_csr_pass2(exec, A.num_rows, B.num_cols,
+                   A.row_offsets, A.column_indices, A.values,
+                   B.row_offsets, B.column_indices, B.values,
+                   C.row_offsets, C.column_indices, C.values,
+                   initialize, combine, reduce);
+}
+
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
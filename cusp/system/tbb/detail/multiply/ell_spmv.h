@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+template <typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+struct ell_spmv_body
+{
+    typedef typename MatrixType::index_type  IndexType;
+    typedef typename VectorType2::value_type ValueType;
+
+    const MatrixType&  A;
+    const VectorType1& x;
+    VectorType2&       y;
+    UnaryFunction   initialize;
+    BinaryFunction1 combine;
+    BinaryFunction2 reduce;
+
+    ell_spmv_body(const MatrixType& A, const VectorType1& x, VectorType2& y,
+                  UnaryFunction initialize, BinaryFunction1 combine, BinaryFunction2 reduce)
+        : A(A), x(x), y(y), initialize(initialize), combine(combine), reduce(reduce) {}
+
+    void operator()(const ::tbb::blocked_range<IndexType>& r) const
+    {
+        const size_t num_entries_per_row = A.column_indices.num_cols;
+        const IndexType invalid_index = MatrixType::invalid_index;
+
+        for(IndexType i = r.begin(); i < r.end(); i++)
+            y[i] = initialize(ValueType(y[i]));
+
+        // sweep the columns of the block of rows to follow the storage order
+        for(size_t n = 0; n < num_entries_per_row; n++)
+        {
+            for(IndexType i = r.begin(); i < r.end(); i++)
+            {
+                const IndexType j = A.column_indices(i, n);
+
+                if(j != invalid_index)
+                {
+                    const ValueType Aij = A.values(i, n);
+                    const ValueType xj  = x[j];
+
+                    y[i] = reduce(ValueType(y[i]), combine(Aij, xj));
+                }
+            }
+        }
+    }
+};
+
+} // end namespace detail
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename VectorType1,
+          typename VectorType2,
+          typename UnaryFunction,
+          typename BinaryFunction1,
+          typename BinaryFunction2>
+void multiply(tbb::execution_policy<DerivedPolicy>& exec,
+              const MatrixType& A,
+              const VectorType1& x,
+              VectorType2& y,
+              UnaryFunction   initialize,
+              BinaryFunction1 combine,
+              BinaryFunction2 reduce,
+              cusp::ell_format,
+              cusp::array1d_format,
+              cusp::array1d_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    detail::ell_spmv_body<MatrixType,VectorType1,VectorType2,UnaryFunction,BinaryFunction1,BinaryFunction2>
+      body(A, x, y, initialize, combine, reduce);
+
+    ::tbb::parallel_for(::tbb::blocked_range<IndexType>(0, A.num_rows), body);
+}
+
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
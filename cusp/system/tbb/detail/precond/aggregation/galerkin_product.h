@@ -0,0 +1,245 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/exception.h>
+
+#include <cusp/precond/aggregation/system/detail/sequential/galerkin_product.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Computes chunks of rows of R * A * P into their own buffers, see the
+// OpenMP version for a description
+template <typename MatrixType1, typename MatrixType2, typename IndexType, typename ValueType, typename ArrayType>
+struct galerkin_rows_body
+{
+    typedef ::tbb::enumerable_thread_specific< std::vector<IndexType> > MarkerType;
+    typedef ::tbb::enumerable_thread_specific< std::vector<ValueType> > SumsType;
+
+    const MatrixType1& R;
+    const MatrixType2& A;
+    const MatrixType1& P;
+    std::vector< std::vector<IndexType> >& columns;
+    std::vector< std::vector<ValueType> >& values;
+    ArrayType& row_offsets;
+    MarkerType& markers;
+    SumsType& sums;
+
+    galerkin_rows_body(const MatrixType1& R, const MatrixType2& A, const MatrixType1& P,
+                       std::vector< std::vector<IndexType> >& columns,
+                       std::vector< std::vector<ValueType> >& values,
+                       ArrayType& row_offsets, MarkerType& markers, SumsType& sums)
+        : R(R), A(A), P(P), columns(columns), values(values), row_offsets(row_offsets),
+          markers(markers), sums(sums) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        using cusp::precond::aggregation::detail::galerkin_chunk_size;
+        using cusp::precond::aggregation::detail::galerkin_rows;
+
+        std::vector<IndexType>& marker = markers.local();
+        std::vector<ValueType>& sum    = sums.local();
+
+        if(marker.empty())
+        {
+            marker.resize(P.num_cols, IndexType(-1));
+            sum.resize(P.num_cols);
+        }
+
+        for(size_t c = r.begin(); c < r.end(); c++)
+        {
+            const size_t row_begin = c * galerkin_chunk_size;
+            const size_t row_end   = std::min<size_t>(row_begin + galerkin_chunk_size, R.num_rows);
+
+            galerkin_rows(R, A, P, row_begin, row_end, marker, sum, columns[c], values[c], row_offsets);
+        }
+    }
+};
+
+// Copies the buffers of the chunks into place and releases them
+template <typename MatrixType, typename IndexType, typename ValueType, typename ArrayType>
+struct galerkin_copy_body
+{
+    MatrixType& RAP;
+    std::vector< std::vector<IndexType> >& columns;
+    std::vector< std::vector<ValueType> >& values;
+    const ArrayType& row_offsets;
+
+    galerkin_copy_body(MatrixType& RAP,
+                       std::vector< std::vector<IndexType> >& columns,
+                       std::vector< std::vector<ValueType> >& values,
+                       const ArrayType& row_offsets)
+        : RAP(RAP), columns(columns), values(values), row_offsets(row_offsets) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        using cusp::precond::aggregation::detail::galerkin_chunk_size;
+
+        for(size_t c = r.begin(); c < r.end(); c++)
+        {
+            const size_t offset = row_offsets[c * galerkin_chunk_size];
+
+            std::copy(columns[c].begin(), columns[c].end(), RAP.column_indices.begin() + offset);
+            std::copy(values[c].begin(),  values[c].end(),  RAP.values.begin()         + offset);
+
+            std::vector<IndexType>().swap(columns[c]);
+            std::vector<ValueType>().swap(values[c]);
+        }
+    }
+};
+
+// Recomputes the values of rows of R * A * P in the pattern of RAP
+template <typename MatrixType1, typename MatrixType2, typename MatrixType3>
+struct galerkin_values_body
+{
+    typedef typename MatrixType3::index_type IndexType;
+    typedef ::tbb::enumerable_thread_specific< std::vector<IndexType> > MarkerType;
+    typedef ::tbb::enumerable_thread_specific<bool> ValidType;
+
+    const MatrixType1& R;
+    const MatrixType2& A;
+    const MatrixType1& P;
+    MatrixType3& RAP;
+    MarkerType& markers;
+    ValidType& valids;
+
+    galerkin_values_body(const MatrixType1& R, const MatrixType2& A, const MatrixType1& P, MatrixType3& RAP,
+                         MarkerType& markers, ValidType& valids)
+        : R(R), A(A), P(P), RAP(RAP), markers(markers), valids(valids) {}
+
+    void operator()(const ::tbb::blocked_range<size_t>& r) const
+    {
+        using cusp::precond::aggregation::detail::galerkin_row_values;
+
+        std::vector<IndexType>& marker = markers.local();
+        bool& valid = valids.local();
+
+        if(marker.empty())
+            marker.resize(P.num_cols);
+
+        for(size_t i = r.begin(); i < r.end(); i++)
+            valid = galerkin_row_values(R, A, P, i, RAP, marker) && valid;
+    }
+};
+
+} // end namespace detail
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void galerkin_product(tbb::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType1& R,
+                      const MatrixType2& A,
+                      const MatrixType1& P,
+                      MatrixType3& RAP,
+                      cusp::csr_format,
+                      cusp::csr_format,
+                      cusp::csr_format)
+{
+    using cusp::precond::aggregation::detail::galerkin_chunk_size;
+
+    typedef typename MatrixType3::index_type IndexType;
+    typedef typename MatrixType3::value_type ValueType;
+    typedef cusp::detail::temporary_array<IndexType, DerivedPolicy> OffsetsType;
+    typedef detail::galerkin_rows_body<MatrixType1, MatrixType2, IndexType, ValueType, OffsetsType> RowsBody;
+    typedef detail::galerkin_copy_body<MatrixType3, IndexType, ValueType, OffsetsType> CopyBody;
+
+    const size_t num_rows   = R.num_rows;
+    const size_t num_cols   = P.num_cols;
+    const size_t num_chunks = (num_rows + galerkin_chunk_size - 1) / galerkin_chunk_size;
+
+    OffsetsType row_offsets(exec, num_rows + 1);
+
+    std::vector< std::vector<IndexType> > columns(num_chunks);
+    std::vector< std::vector<ValueType> > values(num_chunks);
+
+    {
+        typename RowsBody::MarkerType markers;
+        typename RowsBody::SumsType sums;
+
+        ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks, 1),
+                            RowsBody(R, A, P, columns, values, row_offsets, markers, sums));
+    }
+
+    row_offsets[0] = 0;
+
+    for(size_t i = 0; i < num_rows; i++)
+        row_offsets[i + 1] += row_offsets[i];
+
+    RAP.resize(num_rows, num_cols, row_offsets[num_rows]);
+
+    std::copy(row_offsets.begin(), row_offsets.end(), RAP.row_offsets.begin());
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_chunks, 1),
+                        CopyBody(RAP, columns, values, row_offsets));
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType1,
+          typename MatrixType2,
+          typename MatrixType3>
+void numeric_galerkin_product(tbb::execution_policy<DerivedPolicy>& exec,
+                              const MatrixType1& R,
+                              const MatrixType2& A,
+                              const MatrixType1& P,
+                              MatrixType3& RAP,
+                              cusp::csr_format,
+                              cusp::csr_format,
+                              cusp::csr_format)
+{
+    using cusp::precond::aggregation::detail::galerkin_chunk_size;
+
+    typedef detail::galerkin_values_body<MatrixType1, MatrixType2, MatrixType3> ValuesBody;
+
+    typename ValuesBody::MarkerType markers;
+    typename ValuesBody::ValidType valids(true);
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, RAP.num_rows, galerkin_chunk_size),
+                        ValuesBody(R, A, P, RAP, markers, valids));
+
+    if(!valids.combine(std::logical_and<bool>()))
+        throw cusp::invalid_input_exception("sparsity pattern of RAP does not contain R * A * P");
+}
+
+} // end namespace tbb
+} // end namespace system
+
+// hack until ADL is operational
+using cusp::system::tbb::galerkin_product;
+using cusp::system::tbb::numeric_galerkin_product;
+
+} // end namespace cusp
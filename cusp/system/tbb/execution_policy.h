@@ -28,6 +28,17 @@
 // get the definition of par
 #include <thrust/system/tbb/detail/par.h>
 
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+using namespace thrust::system::tbb;
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
+
 // now get all the algorithm definitions
 
 #include <cusp/system/tbb/detail/convert.h>
@@ -37,7 +48,6 @@
 #include <cusp/system/tbb/detail/sort.h>
 #include <cusp/system/tbb/detail/transpose.h>
 
-#include <cusp/system/tbb/detail/graph/breadth_first_search.h>
 #include <cusp/system/tbb/detail/graph/breadth_first_search.h>
 #include <cusp/system/tbb/detail/graph/connected_components.h>
 #include <cusp/system/tbb/detail/graph/hilbert_curve.h>
@@ -45,3 +55,5 @@
 #include <cusp/system/tbb/detail/graph/pseudo_peripheral.h>
 #include <cusp/system/tbb/detail/graph/symmetric_rcm.h>
 #include <cusp/system/tbb/detail/graph/vertex_coloring.h>
+
+#include <cusp/system/tbb/detail/precond/aggregation/galerkin_product.h>
@@ -0,0 +1,58 @@
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/detail/cholesky.h>
+#include <cusp/detail/lu.h>
+#include <cusp/gallery/poisson.h>
+
+#include <cstdlib>
+#include <iostream>
+
+#include "../timer.h"
+
+template <typename Solver, typename MatrixType>
+void benchmark(const char* name, const MatrixType& A, size_t num_solves = 10)
+{
+    typedef typename MatrixType::value_type ValueType;
+
+    cusp::array1d<ValueType, cusp::host_memory> b(A.num_rows, 1);
+    cusp::array1d<ValueType, cusp::host_memory> x(A.num_rows, 0);
+    cusp::array1d<ValueType, cusp::host_memory> r(A.num_rows, 0);
+
+    host_timer t0;
+    Solver M(A);
+    const float setup_time = t0.milliseconds_elapsed();
+
+    host_timer t1;
+    for (size_t i = 0; i < num_solves; i++)
+        M(b, x);
+    const float solve_time = t1.milliseconds_elapsed() / num_solves;
+
+    // residual r = b - A*x
+    cusp::multiply(A, x, r);
+    cusp::blas::axpby(b, r, r, ValueType(1), ValueType(-1));
+
+    std::cout << name << " : setup " << setup_time << " (ms), solve " << solve_time
+              << " (ms), residual " << cusp::blas::nrm2(r) << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    typedef int    IndexType;
+    typedef double ValueType;
+
+    // usage: coarse_solver [N], an N x N grid stands in for the coarsest level
+    const size_t N = argc < 2 ? 48 : atoi(argv[1]);
+
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, N, N);
+
+    std::cout << "Coarse matrix with " << A.num_rows << " rows and " << A.num_entries << " entries" << std::endl;
+
+    benchmark< cusp::detail::cholesky_solver<ValueType, cusp::host_memory> >("sparse Cholesky", A);
+    benchmark< cusp::detail::lu_solver<ValueType, cusp::host_memory> >("dense LU       ", A);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <cusp/gallery/poisson.h>
+
+#include <cusp/precond/aggregation/aggregate.h>
+#include <cusp/precond/aggregation/galerkin_product.h>
+#include <cusp/precond/aggregation/smooth_prolongator.h>
+#include <cusp/precond/aggregation/tentative.h>
+
+#include <cusp/system/omp/execution_policy.h>
+
+#include <thrust/functional.h>
+#include <thrust/reduce.h>
+
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include "../timer.h"
+
+#include <sys/resource.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// row-wise triple product, A * P is never formed
+struct fused_rap
+{
+    template <typename Policy, typename MatrixType>
+    void operator()(Policy& exec, const MatrixType& R, const MatrixType& A, const MatrixType& P, MatrixType& RAP) const
+    {
+        cusp::precond::aggregation::galerkin_product(exec, R, A, P, RAP);
+    }
+};
+
+// R * (A * P) with two SpGEMMs
+struct spgemm_rap
+{
+    template <typename Policy, typename MatrixType>
+    void operator()(Policy& exec, const MatrixType& R, const MatrixType& A, const MatrixType& P, MatrixType& RAP) const
+    {
+        MatrixType AP;
+        cusp::multiply(exec, A, P, AP);
+        cusp::multiply(exec, R, AP, RAP);
+    }
+};
+
+// peak resident set size of the process in MB
+double peak_memory(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+#if defined(__APPLE__)
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+template <typename MatrixType>
+double matrix_memory(const MatrixType& A)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    return ((A.num_rows + 1 + A.num_entries) * sizeof(IndexType) + A.num_entries * sizeof(ValueType)) / (1024.0 * 1024.0);
+}
+
+template <typename Policy, typename MatrixType, typename Kernel>
+float time_kernel(Policy& exec, const MatrixType& R, const MatrixType& A, const MatrixType& P, MatrixType& RAP,
+                  Kernel kernel, size_t num_iterations = 5)
+{
+    // warmup
+    kernel(exec, R, A, P, RAP);
+
+    host_timer t;
+    for(size_t i = 0; i < num_iterations; i++)
+        kernel(exec, R, A, P, RAP);
+
+    return t.milliseconds_elapsed() / num_iterations;
+}
+
+template <typename Kernel>
+void benchmark(const size_t N, Kernel kernel)
+{
+    typedef int                                             IndexType;
+    typedef double                                          ValueType;
+    typedef cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> MatrixType;
+
+    MatrixType A;
+    cusp::gallery::poisson5pt(A, N, N);
+
+    // smoothed aggregation prolongator of the first level
+    cusp::array1d<IndexType,cusp::host_memory> aggregates(A.num_rows);
+    cusp::precond::aggregation::standard_aggregate(A, aggregates);
+
+    const IndexType num_aggregates =
+        thrust::reduce(aggregates.begin(), aggregates.end(), IndexType(0), thrust::maximum<IndexType>()) + 1;
+
+    cusp::array1d<ValueType,cusp::host_memory> B(A.num_rows, 1);
+    cusp::array1d<ValueType,cusp::host_memory> B_coarse(num_aggregates);
+
+    MatrixType T;
+    MatrixType P;
+    MatrixType R;
+    cusp::precond::aggregation::fit_candidates(aggregates, B, T, B_coarse);
+    cusp::precond::aggregation::smooth_prolongator(A, T, P);
+    cusp::transpose(P, R);
+
+    std::cout << "A   : " << A.num_rows << " rows, " << A.num_entries << " entries" << std::endl;
+    std::cout << "P   : " << P.num_rows << " x " << P.num_cols << ", " << P.num_entries << " entries" << std::endl;
+
+    const double setup_memory = peak_memory();
+
+    thrust::system::cpp::tag seq;
+    thrust::system::omp::tag omp;
+
+    MatrixType RAP;
+
+    const float seq_time = time_kernel(seq, R, A, P, RAP, kernel);
+    const float omp_time = time_kernel(omp, R, A, P, RAP, kernel);
+
+    std::cout << "RAP : " << RAP.num_rows << " x " << RAP.num_cols << ", " << RAP.num_entries
+              << " entries, " << matrix_memory(RAP) << " (MB)" << std::endl;
+    std::cout << " sequential : " << seq_time << " (ms)" << std::endl;
+    std::cout << " OpenMP     : " << omp_time << " (ms), speedup " << seq_time / omp_time << std::endl;
+    std::cout << " peak memory above setup : " << peak_memory() - setup_memory << " (MB)" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    // the peak memory of a process only grows, so run one method per process
+    // usage: galerkin_product [fused|spgemm] [N]
+    const bool fused = argc < 2 || strcmp(argv[1], "spgemm") != 0;
+    const size_t N   = argc < 3 ? 1024 : atoi(argv[2]);
+
+    std::cout << (fused ? "Fused RAP" : "SpGEMM R * (A * P)") << " on a " << N << "x" << N << " grid" << std::endl;
+
+    if(fused)
+        benchmark(N, fused_rap());
+    else
+        benchmark(N, spgemm_rap());
+
+    return EXIT_SUCCESS;
+}
@@ -6,6 +6,7 @@
 #include <cusp/precond/smoother/gauss_seidel_smoother.h>
 #include <cusp/precond/smoother/polynomial_smoother.h>
 
+#include <cmath>
 #include <iostream>
 
 #include "../timer.h"
@@ -111,6 +112,27 @@ int main(int argc, char ** argv)
         run_amg(A_csr,M);
     }
 
+    // compare the cycle types on an anisotropic diffusion problem
+    {
+        cusp::hyb_matrix<IndexType, ValueType, MemorySpace> B;
+        cusp::gallery::diffusion<cusp::gallery::FD>(B, N, N, 0.001, M_PI / 4.0);
+
+        const char* names[] = {"V-cycle", "W-cycle", "F-cycle", "K-cycle"};
+        cusp::cycle_type cycles[] = {cusp::v_cycle, cusp::w_cycle, cusp::f_cycle, cusp::k_cycle};
+
+        cusp::precond::aggregation::smoothed_aggregation<IndexType, ValueType, MemorySpace> M(B);
+
+        for(size_t c = 0; c < 4; c++)
+        {
+            std::cout << "\nSolving anisotropic diffusion with smoothed aggregation preconditioner and " << names[c] << std::endl;
+
+            M.set_cycle(cycles[c]);
+            std::cout << "cycle complexity " << M.cycle_complexity() << std::endl;
+
+            run_amg(B,M);
+        }
+    }
+
     return 0;
 }
 
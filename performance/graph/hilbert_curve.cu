@@ -4,6 +4,9 @@
 
 #include <thrust/functional.h>
 
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+
 #include "../timer.h"
 
 int main(int argc, char*argv[])
@@ -23,10 +26,22 @@ int main(int argc, char*argv[])
             cusp::copy(cusp::random_array<ValueType>(i*num_points), coords.values);
 
             cusp::array1d<IndexType,MemorySpace> parts(num_points);
-            timer t;
-            cusp::graph::hilbert_curve(coords, i, parts);
+            cusp::array1d<IndexType,MemorySpace> permutation(num_points);
+
+            thrust::system::cpp::tag seq;
+            thrust::system::omp::tag omp;
+
+            host_timer t1;
+            cusp::graph::hilbert_curve(seq, coords, i, parts, permutation);
+            float seq_time = t1.milliseconds_elapsed();
+
+            host_timer t2;
+            cusp::graph::hilbert_curve(omp, coords, i, parts, permutation);
+            float omp_time = t2.milliseconds_elapsed();
+
             std::cout << "Number of points : " << num_points << std::endl;
-            std::cout << " hsfc(" << i << "D) : " << t.milliseconds_elapsed() << " (ms)\n" << std::endl;
+            std::cout << " hsfc(" << i << "D) sequential : " << seq_time << " (ms)" << std::endl;
+            std::cout << " hsfc(" << i << "D) OpenMP     : " << omp_time << " (ms), speedup " << seq_time / omp_time << "\n" << std::endl;
         }
         num_points <<= 1;
     }
@@ -5,10 +5,13 @@
 #include <cusp/graph/maximal_independent_set.h>
 #include <cusp/io/matrix_market.h>
 
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+
 #include "../timer.h"
 
 template<typename MemorySpace, typename MatrixType>
-void MIS(const MatrixType& G)
+void MIS(const MatrixType& G, const size_t k)
 {
     typedef typename MatrixType::index_type IndexType;
     typedef cusp::csr_matrix<IndexType,IndexType,MemorySpace> GraphType;
@@ -17,11 +20,38 @@ void MIS(const MatrixType& G)
     cusp::array1d<bool,MemorySpace> stencil(G.num_rows);
 
     timer t;
-    size_t num_mis = cusp::graph::maximal_independent_set(G_mis, stencil);
+    size_t num_mis = cusp::graph::maximal_independent_set(G_mis, stencil, k);
     std::cout << "MIS time : " << t.milliseconds_elapsed() << " (ms)." << std::endl;
     std::cout << "Number of MIS vertices : " << num_mis << std::endl;
 }
 
+// compares the sequential greedy MIS-k with the parallel one of the
+// OpenMP system on the same host graph
+template<typename MatrixType>
+void HostMIS(const MatrixType& G, const size_t k)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef cusp::csr_matrix<IndexType,IndexType,cusp::host_memory> GraphType;
+
+    GraphType G_mis(G);
+    cusp::array1d<bool,cusp::host_memory> stencil(G.num_rows);
+
+    thrust::system::cpp::tag seq;
+    thrust::system::omp::tag omp;
+
+    host_timer t1;
+    size_t num_seq = cusp::graph::maximal_independent_set(seq, G_mis, stencil, k);
+    float seq_time = t1.milliseconds_elapsed();
+
+    host_timer t2;
+    size_t num_omp = cusp::graph::maximal_independent_set(omp, G_mis, stencil, k);
+    float omp_time = t2.milliseconds_elapsed();
+
+    std::cout << " MIS-" << k << " sequential : " << seq_time << " (ms), " << num_seq << " vertices" << std::endl;
+    std::cout << " MIS-" << k << " OpenMP     : " << omp_time << " (ms), " << num_omp << " vertices"
+              << ", speedup " << seq_time / omp_time << std::endl;
+}
+
 int main(int argc, char*argv[])
 {
     srand(time(NULL));
@@ -50,11 +80,20 @@ int main(int argc, char*argv[])
               << A.num_entries << " entries" << "\n\n";
 
     std::cout << " Device ";
-    MIS<cusp::device_memory>(A);
+    MIS<cusp::device_memory>(A, 1);
 
     std::cout << " Host ";
-    MIS<cusp::host_memory>(A);
+    MIS<cusp::host_memory>(A, 1);
+
+    // 3D meshes where the k-rings grow quickly with k
+    cusp::csr_matrix<IndexType, ValueType, MemorySpace> B;
+    cusp::gallery::poisson27pt(B, 64, 64, 64);
+
+    std::cout << "\nGenerated matrix (poisson27pt) with shape (" << B.num_rows << "," << B.num_cols
+              << ") and " << B.num_entries << " entries" << "\n\n";
+
+    for(size_t k = 1; k <= 3; k++)
+        HostMIS(B, k);
 
     return EXIT_SUCCESS;
 }
-
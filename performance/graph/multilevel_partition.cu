@@ -0,0 +1,72 @@
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/permutation_matrix.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/graph/multilevel_partition.h>
+#include <cusp/graph/nested_dissection.h>
+#include <cusp/io/matrix_market.h>
+
+#include <algorithm>
+#include <iostream>
+
+#include "../timer.h"
+
+template<typename MatrixType>
+void Partition(const MatrixType& G)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    for(size_t num_parts = 2; num_parts <= 64; num_parts *= 2)
+    {
+        cusp::array1d<IndexType,cusp::host_memory> parts(G.num_rows);
+
+        timer t;
+        size_t edge_cut = cusp::graph::multilevel_partition(G, num_parts, parts);
+        float elapsed = t.milliseconds_elapsed();
+
+        cusp::array1d<size_t,cusp::host_memory> sizes(num_parts, 0);
+        for(size_t i = 0; i < G.num_rows; i++)
+            sizes[parts[i]]++;
+
+        std::cout << " parts : " << num_parts
+                  << ", edge cut : " << edge_cut
+                  << ", largest part : " << *std::max_element(sizes.begin(), sizes.end())
+                  << " (" << G.num_rows / num_parts << " average)"
+                  << ", time : " << elapsed << " (ms)" << std::endl;
+    }
+
+    cusp::permutation_matrix<IndexType,cusp::host_memory> P(G.num_rows);
+
+    timer t;
+    cusp::graph::nested_dissection(G, P);
+    std::cout << " nested dissection time : " << t.milliseconds_elapsed() << " (ms)" << std::endl;
+}
+
+int main(int argc, char*argv[])
+{
+    typedef int   IndexType;
+    typedef float ValueType;
+
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> A;
+
+    if (argc == 1)
+    {
+        // no input file was specified, generate an example
+        std::cout << "Generated matrix (poisson7pt) ";
+        cusp::gallery::poisson7pt(A, 64, 64, 64);
+    }
+    else if (argc == 2)
+    {
+        // an input file was specified, read it from disk
+        cusp::io::read_matrix_market_file(A, argv[1]);
+        std::cout << "Read matrix (" << argv[1] << ") ";
+    }
+
+    std::cout << "with shape ("  << A.num_rows << "," << A.num_cols << ") and "
+              << A.num_entries << " entries" << "\n\n";
+
+    Partition(A);
+
+    return EXIT_SUCCESS;
+}
@@ -5,6 +5,11 @@
 #include <cusp/graph/pseudo_peripheral.h>
 #include <cusp/io/matrix_market.h>
 
+#include <thrust/extrema.h>
+
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+
 #include "../timer.h"
 
 template<typename MemorySpace, typename MatrixType>
@@ -18,6 +23,36 @@ void PSEUDO(const MatrixType& G)
     std::cout << " pseudo-peripheral vertex : " << cusp::graph::pseudo_peripheral_vertex(G_bfs) << std::endl;
 }
 
+// compares the sequential search with the multi-source one of the
+// OpenMP system on the same host graph
+template<typename MatrixType>
+void HostPSEUDO(const MatrixType& G)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef cusp::csr_matrix<IndexType,IndexType,cusp::host_memory> BFSType;
+    typedef cusp::array1d<IndexType,cusp::host_memory> Array;
+
+    BFSType G_bfs(G);
+    Array levels(G.num_rows);
+
+    thrust::system::cpp::tag seq;
+    thrust::system::omp::tag omp;
+
+    host_timer t1;
+    IndexType seq_vertex = cusp::graph::pseudo_peripheral_vertex(seq, G_bfs, levels);
+    float seq_time = t1.milliseconds_elapsed();
+    IndexType seq_depth = *thrust::max_element(levels.begin(), levels.end());
+
+    host_timer t2;
+    IndexType omp_vertex = cusp::graph::pseudo_peripheral_vertex(omp, G_bfs, levels);
+    float omp_time = t2.milliseconds_elapsed();
+    IndexType omp_depth = *thrust::max_element(levels.begin(), levels.end());
+
+    std::cout << " sequential : " << seq_time << " (ms), vertex " << seq_vertex << ", eccentricity " << seq_depth << std::endl;
+    std::cout << " OpenMP     : " << omp_time << " (ms), vertex " << omp_vertex << ", eccentricity " << omp_depth
+              << ", speedup " << seq_time / omp_time << std::endl;
+}
+
 int main(int argc, char*argv[])
 {
     srand(time(NULL));
@@ -51,6 +86,8 @@ int main(int argc, char*argv[])
     std::cout << " Host ";
     PSEUDO<cusp::host_memory>(A);
 
+    HostPSEUDO(A);
+
     return EXIT_SUCCESS;
 }
 
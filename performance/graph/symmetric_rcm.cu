@@ -1,14 +1,18 @@
 #include <cusp/csr_matrix.h>
 #include <cusp/permutation_matrix.h>
 #include <cusp/print.h>
+#include <cusp/reorder.h>
 
 #include <cusp/gallery/poisson.h>
 #include <cusp/graph/symmetric_rcm.h>
 #include <cusp/io/matrix_market.h>
 
 #include <thrust/functional.h>
+#include <thrust/replace.h>
 #include "../timer.h"
 
+using namespace thrust::placeholders;
+
 template<typename MatrixType>
 size_t bandwidth(const MatrixType& G)
 {
@@ -41,6 +45,33 @@ size_t bandwidth(const MatrixType& G)
     return *thrust::max_element(rowwise_bandwidth.begin(), rowwise_bandwidth.end()) + 1;
 }
 
+template<typename MatrixType>
+size_t profile(const MatrixType& G)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    cusp::coo_matrix<IndexType,ValueType,MemorySpace> G_coo(G);
+
+    cusp::array1d<IndexType, MemorySpace> rows(G.num_rows, 0);
+    cusp::array1d<IndexType, MemorySpace> min_column(G.num_rows, 0);
+
+    size_t num_rows = thrust::reduce_by_key(G_coo.row_indices.begin(),
+                                            G_coo.row_indices.end(),
+                                            G_coo.column_indices.begin(),
+                                            rows.begin(),
+                                            min_column.begin(),
+                                            thrust::equal_to<IndexType>(),
+                                            thrust::minimum<IndexType>()).first - rows.begin();
+
+    // sum of the distances from the diagonal to the first entry of every row
+    thrust::transform(rows.begin(), rows.begin() + num_rows, min_column.begin(), min_column.begin(), thrust::minus<IndexType>());
+    thrust::replace_if(min_column.begin(), min_column.begin() + num_rows, _1 < 0, 0);
+
+    return thrust::reduce(min_column.begin(), min_column.begin() + num_rows, size_t(0));
+}
+
 template<typename MemorySpace, typename MatrixType>
 void RCM(const MatrixType& G)
 {
@@ -55,8 +86,13 @@ void RCM(const MatrixType& G)
     cusp::graph::symmetric_rcm(G_rcm, P);
     std::cout << " RCM time : " << t.milliseconds_elapsed() << " (ms)." << std::endl;
 
-    P.symmetric_permute(G_rcm);
-    std::cout << " Bandwidth after RCM : " << bandwidth(G_rcm) << std::endl;
+    GraphType G_perm;
+    timer t_reorder;
+    cusp::reorder(G_rcm, P.permutation, G_perm);
+    std::cout << " Reorder time : " << t_reorder.milliseconds_elapsed() << " (ms)." << std::endl;
+
+    std::cout << " Bandwidth after RCM : " << bandwidth(G_perm) << std::endl;
+    std::cout << " Profile after RCM : " << profile(G_perm) << std::endl;
 }
 
 int main(int argc, char*argv[])
@@ -87,6 +123,7 @@ int main(int argc, char*argv[])
               << A.num_entries << " entries" << "\n\n";
 
     std::cout << "Bandwidth before RCM : " << bandwidth(A) << std::endl;
+    std::cout << "Profile before RCM : " << profile(A) << std::endl;
 
     std::cout << " Device ";
     RCM<cusp::device_memory>(A);
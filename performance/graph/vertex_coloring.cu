@@ -8,7 +8,7 @@
 #include "../timer.h"
 
 template<typename MemorySpace, typename MatrixType>
-void coloring(const MatrixType& G)
+void coloring(const MatrixType& G, const cusp::graph::vertex_ordering ordering, const size_t distance = 1)
 {
     typedef typename MatrixType::index_type IndexType;
     typedef cusp::csr_matrix<IndexType,IndexType,MemorySpace> GraphType;
@@ -17,7 +17,7 @@ void coloring(const MatrixType& G)
     cusp::array1d<IndexType,MemorySpace> colors(G.num_rows, 0);
 
     timer t;
-    size_t max_color = cusp::graph::vertex_coloring(G_csr, colors);
+    size_t max_color = cusp::graph::vertex_coloring(G_csr, colors, ordering, distance);
     std::cout << "Coloring time    : " << t.milliseconds_elapsed() << " (ms)." << std::endl;
     std::cout << "Number of colors : " << max_color << std::endl;
 
@@ -61,11 +61,26 @@ int main(int argc, char*argv[])
     std::cout << "with shape ("  << A.num_rows << "," << A.num_cols << ") and "
               << A.num_entries << " entries" << "\n\n";
 
-    std::cout << " Device ";
-    coloring<cusp::device_memory>(A);
+    const char * names[] = {"natural", "largest degree first", "smallest last"};
+    const cusp::graph::vertex_ordering orderings[] = {cusp::graph::natural_ordering,
+                                                      cusp::graph::largest_degree_first,
+                                                      cusp::graph::smallest_last};
 
-    std::cout << " Host ";
-    coloring<cusp::host_memory>(A);
+    for(int i = 0; i < 3; i++)
+    {
+        std::cout << " Device (" << names[i] << " ordering) ";
+        coloring<cusp::device_memory>(A, orderings[i]);
+
+        std::cout << " Host (" << names[i] << " ordering) ";
+        coloring<cusp::host_memory>(A, orderings[i]);
+    }
+
+    // distance-2 colorings for the multicolor smoothers
+    for(int i = 0; i < 3; i++)
+    {
+        std::cout << " Host (" << names[i] << " ordering, distance 2) ";
+        coloring<cusp::host_memory>(A, orderings[i], 2);
+    }
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,111 @@
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/io/matrix_market.h>
+
+#include "../timer.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <stdio.h>
+
+// the entry-at-a-time iostream writer that write_matrix_market_file replaced
+template <typename MatrixType>
+void write_iostream(const MatrixType& A, const std::string& filename)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> coo(A);
+
+    std::ofstream output(filename.c_str());
+
+    output << "%%MatrixMarket matrix coordinate real general\n";
+    output << "\t" << coo.num_rows << "\t" << coo.num_cols << "\t" << coo.num_entries << "\n";
+
+    for(size_t i = 0; i < coo.num_entries; i++)
+    {
+        output << (coo.row_indices[i]    + 1) << " ";
+        output << (coo.column_indices[i] + 1) << " ";
+        output << coo.values[i] << "\n";
+    }
+}
+
+size_t file_size(const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    file.seekg(0, std::ios::end);
+    return size_t(file.tellg());
+}
+
+template <typename MatrixType>
+void benchmark(const MatrixType& A)
+{
+    const std::string filename = "benchmark_matrix_market.mtx";
+
+    std::cout << "with shape ("  << A.num_rows << "," << A.num_cols << ") and "
+              << A.num_entries << " entries" << "\n\n";
+
+    {
+        host_timer t;
+        write_iostream(A, filename);
+        float time = t.milliseconds_elapsed();
+        printf("\t%-24s: %10.2f ms ( %7.2f MB )\n", "write (iostream)", time, file_size(filename) / 1e6);
+    }
+
+    {
+        host_timer t;
+        cusp::io::write_matrix_market_file(A, filename, cusp::io::exact_precision);
+        float time = t.milliseconds_elapsed();
+        printf("\t%-24s: %10.2f ms ( %7.2f MB )\n", "write (exact precision)", time, file_size(filename) / 1e6);
+    }
+
+    {
+        host_timer t;
+        cusp::io::write_matrix_market_file(A, filename, cusp::io::fast_precision);
+        float time = t.milliseconds_elapsed();
+        printf("\t%-24s: %10.2f ms ( %7.2f MB )\n", "write (fast precision)", time, file_size(filename) / 1e6);
+    }
+
+    {
+        MatrixType B;
+
+        host_timer t;
+        cusp::io::read_matrix_market_file(B, filename);
+        float time = t.milliseconds_elapsed();
+        printf("\t%-24s: %10.2f ms\n\n", "read", time);
+    }
+
+    remove(filename.c_str());
+}
+
+int main(int argc, char** argv)
+{
+    typedef int    IndexType;
+    typedef double ValueType;
+
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> A;
+
+    if (argc == 1)
+    {
+        std::cout << "Generated matrix (poisson5pt) ";
+        cusp::gallery::poisson5pt(A, 1024, 1024);
+
+        // perturb the values so they need all significant digits
+        for(size_t n = 0; n < A.num_entries; n++)
+            A.values[n] += 1.0 / (n + 3);
+
+        benchmark(A);
+    }
+    else
+    {
+        cusp::io::read_matrix_market_file(A, argv[1]);
+        std::cout << "Read matrix (" << argv[1] << ") ";
+        benchmark(A);
+    }
+
+    return EXIT_SUCCESS;
+}
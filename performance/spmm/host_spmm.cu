@@ -0,0 +1,164 @@
+#include <cusp/array2d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/ell_matrix.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/io/matrix_market.h>
+
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include "../timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdio.h>
+
+// one SpMV per column of the dense block
+struct column_by_column
+{
+    template <typename MatrixType, typename Array2d>
+    void operator()(const MatrixType& A, const Array2d& B, Array2d& C) const
+    {
+        thrust::system::cpp::tag exec;
+
+        for(size_t j = 0; j < B.num_cols; j++)
+        {
+            typename Array2d::column_view c(C.column(j));
+            cusp::multiply(exec, A, B.column(j), c);
+        }
+    }
+};
+
+struct sequential_spmm
+{
+    template <typename MatrixType, typename Array2d>
+    void operator()(const MatrixType& A, const Array2d& B, Array2d& C) const
+    {
+        thrust::system::cpp::tag exec;
+        cusp::multiply(exec, A, B, C);
+    }
+};
+
+struct omp_spmm
+{
+    template <typename MatrixType, typename Array2d>
+    void operator()(const MatrixType& A, const Array2d& B, Array2d& C) const
+    {
+        thrust::system::omp::tag exec;
+        cusp::multiply(exec, A, B, C);
+    }
+};
+
+template <typename MatrixType, typename Array2d, typename Kernel>
+float time_kernel(const MatrixType& A, const Array2d& B, Array2d& C, Kernel kernel, size_t num_iterations = 20)
+{
+    // warmup
+    kernel(A, B, C);
+
+    host_timer t;
+    for(size_t i = 0; i < num_iterations; i++)
+        kernel(A, B, C);
+
+    return t.milliseconds_elapsed() / num_iterations;
+}
+
+template <typename Array2d>
+float max_error(const Array2d& C1, const Array2d& C2)
+{
+    typedef typename Array2d::value_type ValueType;
+
+    ValueType error = 0;
+    for(size_t i = 0; i < C1.num_rows; i++)
+        for(size_t j = 0; j < C1.num_cols; j++)
+            error = std::max<ValueType>(error, std::abs(C1(i,j) - C2(i,j)));
+
+    return float(error);
+}
+
+template <typename MatrixType, typename Orientation>
+void benchmark(const char * name, const MatrixType& A, const size_t num_vectors, Orientation)
+{
+    typedef typename MatrixType::value_type ValueType;
+    typedef cusp::array2d<ValueType, cusp::host_memory, Orientation> Array2d;
+
+    Array2d B(A.num_cols, num_vectors);
+    for(size_t i = 0; i < B.num_rows; i++)
+        for(size_t j = 0; j < B.num_cols; j++)
+            B(i,j) = int((i + 3 * j) % 21) - 10;
+
+    Array2d C_column(A.num_rows, num_vectors, 0);
+    Array2d C_seq(A.num_rows, num_vectors, 0);
+    Array2d C_omp(A.num_rows, num_vectors, 0);
+
+    float column_time = time_kernel(A, B, C_column, column_by_column());
+    float seq_time    = time_kernel(A, B, C_seq,    sequential_spmm());
+    float omp_time    = time_kernel(A, B, C_omp,    omp_spmm());
+
+    float flops = 2.0f * A.num_entries * num_vectors;
+
+    printf("\t%-4s k = %3d | %8.3f ms | %8.3f ms ( %5.2f GFLOP/s ) | %8.3f ms ( %5.2f GFLOP/s ) [max error %f]\n",
+           name, int(num_vectors),
+           column_time,
+           seq_time, (flops / seq_time) / 1e6,
+           omp_time, (flops / omp_time) / 1e6,
+           std::max(max_error(C_column, C_seq), max_error(C_column, C_omp)));
+}
+
+template <typename Orientation>
+void benchmark(const cusp::csr_matrix<int, double, cusp::host_memory>& A, Orientation orientation)
+{
+    cusp::ell_matrix<int, double, cusp::host_memory> E;
+
+    bool has_ell = true;
+    try
+    {
+        E = A;
+    }
+    catch (cusp::format_conversion_exception)
+    {
+        has_ell = false;
+    }
+
+    printf("\t           | column SpMV | sequential SpMM                 | OpenMP SpMM\n");
+
+    const size_t num_vectors[] = {1, 4, 8, 16, 32, 64};
+
+    for(size_t n = 0; n < sizeof(num_vectors) / sizeof(size_t); n++)
+    {
+        benchmark("csr", A, num_vectors[n], orientation);
+
+        if (has_ell)
+            benchmark("ell", E, num_vectors[n], orientation);
+    }
+
+    printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+    cusp::csr_matrix<int, double, cusp::host_memory> A;
+
+    if (argc == 1)
+    {
+        // no input file was specified, generate an example
+        cusp::gallery::poisson5pt(A, 256, 256);
+    }
+    else
+    {
+        cusp::io::read_matrix_market_file(A, argv[1]);
+    }
+
+    std::cout << "Input matrix has shape (" << A.num_rows << "," << A.num_cols << ") and " << A.num_entries << " entries" << "\n\n";
+
+    printf("Host Sparse Matrix-Dense Matrix Multiply, column-major blocks\n");
+    benchmark(A, cusp::column_major());
+
+    printf("Host Sparse Matrix-Dense Matrix Multiply, row-major blocks\n");
+    benchmark(A, cusp::row_major());
+
+    return EXIT_SUCCESS;
+}
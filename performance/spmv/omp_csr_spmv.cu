@@ -0,0 +1,168 @@
+#include <cusp/csr_matrix.h>
+#include <cusp/functional.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/io/matrix_market.h>
+
+#include <cusp/system/omp/detail/multiply/csr_spmv.h>
+
+#include <thrust/functional.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include "../timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdio.h>
+#include <vector>
+
+// Generates a matrix whose row lengths follow a power law, i.e. row i
+// holds roughly max_row_length / (i + 1)^alpha entries. The rows are
+// shuffled so that the dense rows are scattered throughout the matrix.
+template <typename MatrixType>
+void power_law(MatrixType& A, size_t num_rows, size_t max_row_length, double alpha)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    std::vector<size_t> row_lengths(num_rows);
+    for(size_t i = 0; i < num_rows; i++)
+        row_lengths[i] = std::max<size_t>(1, size_t(max_row_length / std::pow(double(i + 1), alpha)));
+    std::random_shuffle(row_lengths.begin(), row_lengths.end());
+
+    size_t num_entries = 0;
+    for(size_t i = 0; i < num_rows; i++)
+        num_entries += row_lengths[i];
+
+    A.resize(num_rows, num_rows, num_entries);
+
+    size_t offset = 0;
+    for(size_t i = 0; i < num_rows; i++)
+    {
+        A.row_offsets[i] = offset;
+
+        // evenly spaced columns keep the rows sorted and free of duplicates
+        size_t stride = num_rows / row_lengths[i];
+        for(size_t n = 0; n < row_lengths[i]; n++, offset++)
+        {
+            A.column_indices[offset] = IndexType((n * stride + rand() % stride) % num_rows);
+            A.values[offset]         = ValueType(1);
+        }
+    }
+    A.row_offsets[num_rows] = offset;
+}
+
+template <typename MatrixType, typename ArrayType, typename Kernel>
+float time_kernel(const MatrixType& A, const ArrayType& x, ArrayType& y, Kernel kernel, size_t num_iterations = 100)
+{
+    // warmup
+    kernel(A, x, y);
+
+    host_timer t;
+    for(size_t i = 0; i < num_iterations; i++)
+        kernel(A, x, y);
+
+    return t.milliseconds_elapsed() / num_iterations;
+}
+
+struct row_parallel
+{
+    template <typename MatrixType, typename ArrayType>
+    void operator()(const MatrixType& A, const ArrayType& x, ArrayType& y) const
+    {
+        typedef typename ArrayType::value_type ValueType;
+
+        thrust::system::omp::tag exec;
+        cusp::system::omp::spmv_csr_row_parallel(exec, A, x, y,
+                                                 cusp::constant_functor<ValueType>(0),
+                                                 thrust::multiplies<ValueType>(),
+                                                 thrust::plus<ValueType>());
+    }
+};
+
+struct merge_path
+{
+    template <typename MatrixType, typename ArrayType>
+    void operator()(const MatrixType& A, const ArrayType& x, ArrayType& y) const
+    {
+        typedef typename ArrayType::value_type ValueType;
+
+        thrust::system::omp::tag exec;
+        cusp::system::omp::spmv_csr_merge_path(exec, A, x, y,
+                                               cusp::constant_functor<ValueType>(0),
+                                               thrust::multiplies<ValueType>(),
+                                               thrust::plus<ValueType>());
+    }
+};
+
+template <typename MatrixType>
+void benchmark(const MatrixType& A)
+{
+    typedef typename MatrixType::value_type ValueType;
+    typedef cusp::array1d<ValueType, cusp::host_memory> ArrayType;
+
+    std::cout << "with shape ("  << A.num_rows << "," << A.num_cols << ") and "
+              << A.num_entries << " entries" << "\n\n";
+
+    size_t max_row_length = 0;
+    for(size_t i = 0; i < A.num_rows; i++)
+        max_row_length = std::max<size_t>(max_row_length, A.row_offsets[i + 1] - A.row_offsets[i]);
+    std::cout << "\tlongest row         : " << max_row_length << " entries\n";
+
+    ArrayType x(A.num_cols);
+    for(size_t i = 0; i < x.size(); i++)
+        x[i] = int(i % 21) - 10;
+
+    ArrayType y_row(A.num_rows, 0);
+    ArrayType y_merge(A.num_rows, 0);
+
+    float row_time   = time_kernel(A, x, y_row,   row_parallel());
+    float merge_time = time_kernel(A, x, y_merge, merge_path());
+
+    ValueType error = 0;
+    for(size_t i = 0; i < A.num_rows; i++)
+        error = std::max<ValueType>(error, std::abs(y_row[i] - y_merge[i]));
+
+    float GFLOPs_row   = (2 * A.num_entries / row_time)   / 1e6;
+    float GFLOPs_merge = (2 * A.num_entries / merge_time) / 1e6;
+
+    printf("\t%-20s: %8.4f ms ( %5.2f GFLOP/s )\n", "csr_row_parallel", row_time, GFLOPs_row);
+    printf("\t%-20s: %8.4f ms ( %5.2f GFLOP/s ) [max error %f]\n", "csr_merge_path", merge_time, GFLOPs_merge, float(error));
+    printf("\t%-20s: %8.2fx\n\n", "speedup", row_time / merge_time);
+}
+
+int main(int argc, char** argv)
+{
+    typedef int    IndexType;
+    typedef double ValueType;
+
+    srand(13);
+
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> A;
+
+    if (argc == 1)
+    {
+        std::cout << "Generated matrix (poisson5pt) ";
+        cusp::gallery::poisson5pt(A, 1024, 1024);
+        benchmark(A);
+
+        std::cout << "Generated matrix (power law, alpha=1.0) ";
+        power_law(A, 1 << 20, 1 << 18, 1.0);
+        benchmark(A);
+
+        std::cout << "Generated matrix (power law, alpha=0.5) ";
+        power_law(A, 1 << 20, 1 << 14, 0.5);
+        benchmark(A);
+    }
+    else
+    {
+        cusp::io::read_matrix_market_file(A, argv[1]);
+        std::cout << "Read matrix (" << argv[1] << ") ";
+        benchmark(A);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -20,6 +20,12 @@
 
 #include <cuda.h>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
 class timer
 {
     cudaEvent_t start;
@@ -53,5 +59,39 @@ public:
     }
 };
 
+// A wall-clock timer for kernels running on the host
+
+class host_timer
+{
+    double start;
 
+    static double now()
+    {
+#if defined(_WIN32)
+        LARGE_INTEGER frequency, count;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&count);
+        return double(count.QuadPart) / double(frequency.QuadPart);
+#else
+        timeval tv;
+        gettimeofday(&tv, NULL);
+        return tv.tv_sec + 1e-6 * tv.tv_usec;
+#endif
+    }
+
+public:
+    host_timer()
+    {
+        start = now();
+    }
+
+    float milliseconds_elapsed()
+    {
+        return 1000.0 * (now() - start);
+    }
+    float seconds_elapsed()
+    {
+        return now() - start;
+    }
+};
 
@@ -0,0 +1,119 @@
+#include <unittest/unittest.h>
+
+#include <cusp/csr_matrix.h>
+
+#include <cusp/gallery/poisson.h>
+
+#include <cusp/precond/aggregation/smoothed_aggregation.h>
+#include <cusp/precond/smoother/polynomial_smoother.h>
+
+#include <cstdlib>
+
+#if defined(__GLIBC__)
+
+// Count heap allocations at the malloc level, where operator new as well
+// as the temporary buffers of the thrust host systems get their memory.
+//
+// NOTE: the replacement applies to the whole program, including the
+// OpenMP and TBB runtimes, so these tests are linked into their own
+// tester. Allocations are only counted while a test sets
+// counting_allocations.
+extern "C"
+{
+void* __libc_malloc(size_t n);
+void* __libc_calloc(size_t n, size_t m);
+void* __libc_realloc(void* p, size_t n);
+void  __libc_free(void* p);
+}
+
+static size_t num_allocations       = 0;
+static int    counting_allocations  = 0;
+
+static inline void count_allocation(void)
+{
+    // worker threads of the OpenMP and TBB systems allocate concurrently
+    if (__atomic_load_n(&counting_allocations, __ATOMIC_ACQUIRE))
+        __atomic_fetch_add(&num_allocations, size_t(1), __ATOMIC_RELAXED);
+}
+
+extern "C"
+{
+void* malloc(size_t n)
+{
+    count_allocation();
+    return __libc_malloc(n);
+}
+
+void* calloc(size_t n, size_t m)
+{
+    count_allocation();
+    return __libc_calloc(n, m);
+}
+
+void* realloc(void* p, size_t n)
+{
+    count_allocation();
+    return __libc_realloc(p, n);
+}
+
+void free(void* p)
+{
+    __libc_free(p);
+}
+}
+
+template <typename Preconditioner, typename ArrayType>
+size_t count_cycle_allocations(Preconditioner& M, const ArrayType& b, ArrayType& x)
+{
+    __atomic_store_n(&num_allocations, size_t(0), __ATOMIC_RELAXED);
+    __atomic_store_n(&counting_allocations, 1, __ATOMIC_RELEASE);
+
+    for(size_t i = 0; i < 10; i++)
+        M(b, x);
+
+    __atomic_store_n(&counting_allocations, 0, __ATOMIC_RELEASE);
+
+    return __atomic_load_n(&num_allocations, __ATOMIC_RELAXED);
+}
+
+void TestMultilevelCycleDoesNotAllocate(void)
+{
+    typedef int                 IndexType;
+    typedef double              ValueType;
+    typedef cusp::host_memory   MemorySpace;
+
+    cusp::csr_matrix<IndexType,ValueType,MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 100, 100);
+
+    cusp::array1d<ValueType,MemorySpace> b = unittest::random_samples<ValueType>(A.num_rows);
+    cusp::array1d<ValueType,MemorySpace> x(A.num_rows, 0);
+
+    {
+        cusp::precond::aggregation::smoothed_aggregation<IndexType,ValueType,MemorySpace> M(A);
+
+        ASSERT_EQUAL(M.levels.size() >= 3, true);
+
+        ASSERT_EQUAL(count_cycle_allocations(M, b, x), size_t(0));
+
+#if THRUST_HOST_SYSTEM == THRUST_HOST_SYSTEM_CPP
+        // the K-cycle workspace is sized when the cycle is selected, the
+        // inner products of the parallel host systems use temporaries
+        M.set_cycle(cusp::k_cycle, 2);
+
+        ASSERT_EQUAL(count_cycle_allocations(M, b, x), size_t(0));
+#endif
+    }
+
+#if THRUST_HOST_SYSTEM == THRUST_HOST_SYSTEM_CPP
+    {
+        typedef cusp::precond::polynomial_smoother<ValueType,MemorySpace> Smoother;
+
+        cusp::precond::aggregation::smoothed_aggregation<IndexType,ValueType,MemorySpace,Smoother> M(A);
+
+        ASSERT_EQUAL(count_cycle_allocations(M, b, x), size_t(0));
+    }
+#endif
+}
+DECLARE_UNITTEST(TestMultilevelCycleDoesNotAllocate);
+
+#endif // __GLIBC__
@@ -3,7 +3,9 @@
 #include <cusp/array2d.h>
 #include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
 
+#include <cusp/gallery/poisson.h>
 #include <cusp/io/binary.h>
 
 #include <stdio.h>
@@ -127,3 +129,90 @@ void TestWriteBinaryFileCoordinateRealGeneral(void)
     ASSERT_EQUAL(D == E, true);
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestWriteBinaryFileCoordinateRealGeneral);
+
+template <typename MemorySpace>
+void TestWriteCsrBinaryFile(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 11, 13);
+
+    // write from a device container
+    cusp::csr_matrix<int, float, MemorySpace> B(A);
+    cusp::io::write_csr_binary_file(B, random_file_name);
+
+    // read back into CSR and COO containers
+    cusp::csr_matrix<int, float, MemorySpace> C;
+    cusp::io::read_csr_binary_file(C, random_file_name);
+
+    cusp::coo_matrix<int, float, MemorySpace> D;
+    cusp::io::read_csr_binary_file(D, random_file_name);
+
+    remove(random_file_name);
+
+    ASSERT_EQUAL(C.num_rows,    A.num_rows);
+    ASSERT_EQUAL(C.num_cols,    A.num_cols);
+    ASSERT_EQUAL(C.num_entries, A.num_entries);
+    ASSERT_EQUAL(C.row_offsets,    A.row_offsets);
+    ASSERT_EQUAL(C.column_indices, A.column_indices);
+    ASSERT_EQUAL(C.values,         A.values);
+
+    cusp::array2d<float, cusp::host_memory> E(A);
+    cusp::array2d<float, cusp::host_memory> F(D);
+    ASSERT_EQUAL(E == F, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestWriteCsrBinaryFile);
+
+void TestReadCsrBinaryFileTypeMismatch(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 4, 4);
+
+    cusp::io::write_csr_binary_file(A, random_file_name);
+
+    cusp::csr_matrix<int, double, cusp::host_memory> B;
+    ASSERT_THROWS(cusp::io::read_csr_binary_file(B, random_file_name), cusp::io_exception);
+
+    cusp::csr_matrix<long long, float, cusp::host_memory> C;
+    ASSERT_THROWS(cusp::io::read_csr_binary_file(C, random_file_name), cusp::io_exception);
+
+    remove(random_file_name);
+
+    // legacy COO binary files are rejected
+    cusp::io::write_binary_file(A, random_file_name);
+    ASSERT_THROWS(cusp::io::read_csr_binary_file(A, random_file_name), cusp::io_exception);
+    remove(random_file_name);
+}
+DECLARE_UNITTEST(TestReadCsrBinaryFileTypeMismatch);
+
+void TestMappedCsrMatrix(void)
+{
+    cusp::csr_matrix<int, double, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 17, 9);
+
+    cusp::io::write_csr_binary_file(A, random_file_name);
+
+    {
+        cusp::io::mapped_csr_matrix<int, double> M(random_file_name);
+
+        ASSERT_EQUAL(M.num_rows,    A.num_rows);
+        ASSERT_EQUAL(M.num_cols,    A.num_cols);
+        ASSERT_EQUAL(M.num_entries, A.num_entries);
+        ASSERT_EQUAL(M.row_offsets,    A.row_offsets);
+        ASSERT_EQUAL(M.column_indices, A.column_indices);
+        ASSERT_EQUAL(M.values,         A.values);
+
+        cusp::array1d<double, cusp::host_memory> x(A.num_cols, 1);
+        cusp::array1d<double, cusp::host_memory> y(A.num_rows, 0);
+        cusp::array1d<double, cusp::host_memory> z(A.num_rows, 0);
+
+        cusp::multiply(M, x, y);
+        cusp::multiply(A, x, z);
+
+        ASSERT_EQUAL(y, z);
+
+        ASSERT_THROWS((cusp::io::mapped_csr_matrix<int, float>(random_file_name)), cusp::io_exception);
+    }
+
+    remove(random_file_name);
+}
+DECLARE_UNITTEST(TestMappedCsrMatrix);
@@ -1,5 +1,6 @@
 #include <unittest/unittest.h>
 
+#include <cusp/array2d.h>
 #include <cusp/complex.h>
 #include <cusp/blas/blas.h>
 
@@ -352,6 +353,124 @@ void TestDotc(void)
 DECLARE_HOST_DEVICE_UNITTEST(TestDotc);
 
 
+template <class MemorySpace>
+void TestAxpyDotc(void)
+{
+    typedef typename cusp::array1d<cusp::complex<float>, MemorySpace> Array;
+
+    Array x(4);
+    Array y(4);
+    Array z(4);
+
+    x[0] = cusp::complex<float>( 1.0f, 0.0f);
+    y[0] = cusp::complex<float>( 1.0f, 1.0f);
+    z[0] = cusp::complex<float>( 0.0f, 1.0f);
+
+    x[1] = cusp::complex<float>( 2.0f, 0.0f);
+    y[1] = cusp::complex<float>( 0.0f, 0.0f);
+    z[1] = cusp::complex<float>( 1.0f, 0.0f);
+
+    x[2] = cusp::complex<float>( 0.0f, 1.0f);
+    y[2] = cusp::complex<float>( 3.0f, 0.0f);
+    z[2] = cusp::complex<float>( 2.0f, 0.0f);
+
+    x[3] = cusp::complex<float>(-1.0f, 0.0f);
+    y[3] = cusp::complex<float>( 1.0f, 0.0f);
+    z[3] = cusp::complex<float>( 0.0f, 0.0f);
+
+    Array y_ref(y);
+    cusp::blas::axpy(x, y_ref, 2.0f);
+    cusp::complex<float> expected = cusp::blas::dotc(z, y_ref);
+
+    ASSERT_EQUAL(cusp::blas::axpy_dotc(x, y, z, 2.0f), expected);
+    ASSERT_EQUAL(y, y_ref);
+
+    // z aliasing y yields the squared norm of the updated y
+    cusp::blas::axpy(x, y_ref, 2.0f);
+    expected = cusp::blas::dotc(y_ref, y_ref);
+
+    ASSERT_EQUAL(cusp::blas::axpy_dotc(x, y, y, 2.0f), expected);
+    ASSERT_EQUAL(y, y_ref);
+
+    // test size checking
+    Array w(3);
+    ASSERT_THROWS(cusp::blas::axpy_dotc(x, w, z, 1.0f), cusp::invalid_input_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestAxpyDotc);
+
+
+template <class MemorySpace>
+void TestAxpbyNrm2(void)
+{
+    typedef typename cusp::array1d<float, MemorySpace> Array;
+
+    Array x(4);
+    Array y(4);
+    Array z(4);
+
+    x[0] =  7.0f;   y[0] =  0.0f;
+    x[1] =  5.0f;   y[1] = -2.0f;
+    x[2] =  4.0f;   y[2] =  0.0f;
+    x[3] = -3.0f;   y[3] =  5.0f;
+
+    Array z_ref(4);
+    cusp::blas::axpby(x, y, z_ref, 2.0f, 1.0f);
+
+    ASSERT_ALMOST_EQUAL(cusp::blas::axpby_nrm2(x, y, z, 2.0f, 1.0f), cusp::blas::nrm2(z_ref));
+    ASSERT_EQUAL(z, z_ref);
+
+    // output aliasing an input
+    ASSERT_ALMOST_EQUAL(cusp::blas::axpby_nrm2(x, y, y, 2.0f, 1.0f), cusp::blas::nrm2(z_ref));
+    ASSERT_EQUAL(y, z_ref);
+
+    // test size checking
+    Array w(3);
+    ASSERT_THROWS(cusp::blas::axpby_nrm2(x, y, w, 1.0f, 1.0f), cusp::invalid_input_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestAxpbyNrm2);
+
+
+template <class MemorySpace>
+void TestMdotc(void)
+{
+    typedef typename cusp::array1d<cusp::complex<float>, MemorySpace>                     Array;
+    typedef typename cusp::array2d<cusp::complex<float>, MemorySpace, cusp::column_major> ColumnMajor;
+    typedef typename cusp::array2d<cusp::complex<float>, MemorySpace, cusp::row_major>    RowMajor;
+
+    Array x(3);
+    x[0] = cusp::complex<float>( 1.0f, 1.0f);
+    x[1] = cusp::complex<float>( 2.0f, 0.0f);
+    x[2] = cusp::complex<float>( 0.0f,-1.0f);
+
+    ColumnMajor Y(3, 4);
+    for (size_t i = 0; i < Y.num_rows; i++)
+        for (size_t j = 0; j < Y.num_cols; j++)
+            Y(i,j) = cusp::complex<float>(float(i + j), float(i) - float(j));
+
+    Array expected(4);
+    for (size_t j = 0; j < Y.num_cols; j++)
+        expected[j] = cusp::blas::dotc(x, Y.column(j));
+
+    {
+        Array result(4);
+        cusp::blas::mdotc(x, Y, result);
+        ASSERT_EQUAL(result, expected);
+    }
+
+    {
+        RowMajor Z(Y);
+        Array result(4);
+        cusp::blas::mdotc(x, Z, result);
+        ASSERT_EQUAL(result, expected);
+    }
+
+    // test size checking
+    Array w(3);
+    ASSERT_THROWS(cusp::blas::mdotc(x, Y, w), cusp::invalid_input_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestMdotc);
+
+
 template <class MemorySpace>
 void TestFill(void)
 {
@@ -0,0 +1,92 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/block_monitor.h>
+
+template <typename MemorySpace>
+void TestBlockMonitorSimple(void)
+{
+    cusp::array2d<float,MemorySpace,cusp::column_major> B(2, 3, 0.0f);
+    B(0,0) = 10;
+    B(0,1) =  1;
+    B(1,2) = 20;
+
+    cusp::array2d<float,MemorySpace,cusp::column_major> R(B);
+
+    cusp::block_monitor<float> monitor(B, 5, 0.5, 1.0);
+
+    ASSERT_EQUAL(monitor.num_columns(),        3);
+    ASSERT_EQUAL(monitor.iteration_limit(),    5);
+    ASSERT_EQUAL(monitor.relative_tolerance(), 0.5);
+    ASSERT_EQUAL(monitor.absolute_tolerance(), 1.0);
+    ASSERT_EQUAL(monitor.tolerance(0),         6.0);
+    ASSERT_EQUAL(monitor.tolerance(1),         1.5);
+    ASSERT_EQUAL(monitor.tolerance(2),        11.0);
+
+    // column 1 converges immediately
+    ASSERT_EQUAL(monitor.finished(R),    false);
+    ASSERT_EQUAL(monitor.num_converged(),    1);
+    ASSERT_EQUAL(monitor.converged(0),   false);
+    ASSERT_EQUAL(monitor.converged(1),    true);
+    ASSERT_EQUAL(monitor.converged(2),   false);
+    ASSERT_EQUAL(monitor.residual_norm(),  20.0);
+
+    ++monitor;
+
+    // only the active columns 0 and 2 are checked
+    cusp::array2d<float,MemorySpace,cusp::column_major> R_active(2, 2, 0.0f);
+    R_active(0,0) = 2;
+    R_active(1,1) = 12;
+
+    cusp::array1d<int,cusp::host_memory> columns(2);
+    columns[0] = 0;
+    columns[1] = 2;
+
+    ASSERT_EQUAL(monitor.finished(R_active, columns), false);
+    ASSERT_EQUAL(monitor.iteration_count(),  1);
+    ASSERT_EQUAL(monitor.num_converged(),    2);
+    ASSERT_EQUAL(monitor.converged(0),    true);
+    ASSERT_EQUAL(monitor.converged(1),    true);
+    ASSERT_EQUAL(monitor.converged(2),   false);
+    ASSERT_EQUAL(monitor.residual_norm(0),  2.0);
+    ASSERT_EQUAL(monitor.residual_norm(2), 12.0);
+
+    cusp::array2d<float,MemorySpace,cusp::column_major> R_last(2, 1, 0.0f);
+    R_last(1,0) = 3;
+
+    columns.resize(1);
+    columns[0] = 2;
+
+    ASSERT_EQUAL(monitor.finished(R_last, columns), true);
+    ASSERT_EQUAL(monitor.converged(),  true);
+    ASSERT_EQUAL(monitor.residuals.size(), 3);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockMonitorSimple);
+
+template <typename MemorySpace>
+void TestBlockMonitorIterationLimit(void)
+{
+    cusp::array2d<float,MemorySpace,cusp::column_major> B(2, 2, 1.0f);
+
+    cusp::block_monitor<float> monitor(B, 2, 1e-5);
+
+    ASSERT_EQUAL(monitor.finished(B), false);
+
+    ++monitor;
+
+    ASSERT_EQUAL(monitor.finished(B), false);
+
+    ++monitor;
+
+    ASSERT_EQUAL(monitor.finished(B),  true);
+    ASSERT_EQUAL(monitor.converged(), false);
+    ASSERT_EQUAL(monitor.num_converged(),  0);
+
+    monitor.reset(B);
+
+    ASSERT_EQUAL(monitor.iteration_count(),  0);
+    ASSERT_EQUAL(monitor.residuals.size(),   0);
+    ASSERT_EQUAL(monitor.finished(B),    false);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockMonitorIterationLimit);
@@ -11,6 +11,8 @@
 
 #include <cusp/gallery/poisson.h>
 
+#include <deque>
+
 // check whether the MIS is valid
 template <typename MatrixType, typename ArrayType1, typename ArrayType2>
 bool is_valid_level_set(const MatrixType& A, const ArrayType1& tree, const ArrayType2& levels)
@@ -159,6 +161,68 @@ void TestBreadthFirstSearch(void)
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestBreadthFirstSearch);
 
+template <typename TestMatrix>
+void TestBreadthFirstSearchDirected(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::value_type   ValueType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    // an unsymmetric graph with a small diameter so the frontier grows
+    // large enough to be expanded bottom-up along the in-edges
+    const size_t num_vertices = 2000;
+    const size_t out_degree   = 16;
+
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> G(num_vertices, num_vertices, num_vertices * out_degree);
+    for(size_t i = 0; i < num_vertices; i++)
+    {
+        for(size_t n = 0; n < out_degree; n++)
+        {
+            G.row_indices[i * out_degree + n]    = i;
+            G.column_indices[i * out_degree + n] = (i * 7 + (n + 1) * (n + 1) * 131) % num_vertices;
+            G.values[i * out_degree + n]         = 1;
+        }
+    }
+    G.sort_by_row_and_column();
+
+    // reference levels by a plain queue based traversal
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> G_csr(G);
+    cusp::array1d<IndexType, cusp::host_memory> reference(num_vertices, -1);
+    std::deque<IndexType> queue(1, IndexType(0));
+    reference[0] = 0;
+
+    while(!queue.empty())
+    {
+        IndexType u = queue.front();
+        queue.pop_front();
+
+        for(IndexType jj = G_csr.row_offsets[u]; jj < G_csr.row_offsets[u + 1]; jj++)
+        {
+            IndexType v = G_csr.column_indices[jj];
+
+            if(reference[v] == -1)
+            {
+                reference[v] = reference[u] + 1;
+                queue.push_back(v);
+            }
+        }
+    }
+
+    TestMatrix test_matrix(G);
+
+    cusp::array1d<IndexType, MemorySpace> levels(num_vertices);
+    cusp::graph::breadth_first_search(test_matrix, 0, levels, true);
+
+    ASSERT_EQUAL(cusp::array1d<IndexType, cusp::host_memory>(levels), reference);
+
+    cusp::array1d<IndexType, MemorySpace> tree(num_vertices);
+    cusp::graph::breadth_first_search(test_matrix, 0, tree, false);
+
+    ASSERT_EQUAL(is_valid_level_set(test_matrix, tree, reference), true);
+}
+DECLARE_SPARSE_FORMAT_UNITTEST(TestBreadthFirstSearchDirected, Coo, coo);
+DECLARE_SPARSE_FORMAT_UNITTEST(TestBreadthFirstSearchDirected, Csr, csr);
+
 template <typename MatrixType, typename ArrayType>
 void breadth_first_search(my_system& system,
                           const MatrixType& G,
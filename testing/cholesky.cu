@@ -0,0 +1,50 @@
+#include <unittest/unittest.h>
+
+#include <cusp/detail/cholesky.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+
+template <class SparseMatrix>
+void TestCholeskySolver(void)
+{
+    typedef typename SparseMatrix::value_type ValueType;
+
+    SparseMatrix A;
+    cusp::gallery::poisson5pt(A, 12, 10);
+
+    cusp::detail::cholesky_solver<ValueType, cusp::host_memory> M(A);
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> B(A);
+    cusp::array1d<ValueType, cusp::host_memory> b = unittest::random_samples<ValueType>(B.num_rows);
+    cusp::array1d<ValueType, cusp::host_memory> x(B.num_rows, 0);
+    cusp::array1d<ValueType, cusp::host_memory> y(B.num_rows, 0);
+
+    M(b, x);
+
+    // A*x should reproduce b
+    cusp::multiply(B, x, y);
+
+    ASSERT_ALMOST_EQUAL(y, b);
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestCholeskySolver);
+
+void TestCholeskySolverIndefinite(void)
+{
+    typedef cusp::detail::cholesky_solver<float, cusp::host_memory> Solver;
+
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+
+    // shift the spectrum of A to make it indefinite
+    for (size_t i = 0; i < A.num_rows; i++)
+        for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            if (A.column_indices[jj] == int(i))
+                A.values[jj] -= 6.0f;
+
+    ASSERT_THROWS(Solver M(A), cusp::runtime_exception);
+}
+DECLARE_UNITTEST(TestCholeskySolverIndefinite);
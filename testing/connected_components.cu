@@ -2,7 +2,15 @@
 
 #include <cusp/graph/connected_components.h>
 
+#include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
+#include <cusp/gallery/poisson.h>
+
+#include <thrust/sort.h>
+#include <thrust/unique.h>
+
+#include <algorithm>
+#include <stack>
 
 template <typename MatrixType, typename ArrayType>
 size_t connected_components(my_system& system,
@@ -29,3 +37,102 @@ void TestConnectedComponentsDispatch()
 }
 DECLARE_UNITTEST(TestConnectedComponentsDispatch);
 
+
+template <typename TestMatrix>
+void TestConnectedComponents(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::value_type   ValueType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    // a grid graph with a third of its edges removed symmetrically,
+    // which leaves many small islands and isolated vertices
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> E;
+    cusp::gallery::poisson5pt(E, 61, 67);
+
+    cusp::array1d<IndexType, cusp::host_memory> row_indices;
+    cusp::array1d<IndexType, cusp::host_memory> column_indices;
+
+    for(size_t n = 0; n < E.num_entries; n++)
+    {
+        const IndexType i = E.row_indices[n];
+        const IndexType j = E.column_indices[n];
+        const IndexType hash = (std::min(i, j) * 31 + std::max(i, j) * 17) % 3;
+
+        if(i != j && hash != 0)
+        {
+            row_indices.push_back(i);
+            column_indices.push_back(j);
+        }
+    }
+
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> G(E.num_rows, E.num_cols, row_indices.size());
+    G.row_indices    = row_indices;
+    G.column_indices = column_indices;
+    thrust::fill(G.values.begin(), G.values.end(), ValueType(1));
+
+    // reference labels by a depth first search from the smallest vertex
+    // of every component
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> G_csr(G);
+    cusp::array1d<IndexType, cusp::host_memory> reference(G.num_rows, -1);
+    IndexType num_components = 0;
+
+    for(IndexType i = 0; i < IndexType(G.num_rows); i++)
+    {
+        if(reference[i] != -1)
+            continue;
+
+        std::stack<IndexType> stack;
+        stack.push(i);
+        reference[i] = num_components;
+
+        while(!stack.empty())
+        {
+            IndexType u = stack.top();
+            stack.pop();
+
+            for(IndexType jj = G_csr.row_offsets[u]; jj < G_csr.row_offsets[u + 1]; jj++)
+            {
+                IndexType v = G_csr.column_indices[jj];
+
+                if(reference[v] == -1)
+                {
+                    reference[v] = num_components;
+                    stack.push(v);
+                }
+            }
+        }
+
+        num_components++;
+    }
+
+    TestMatrix test_matrix(G);
+    cusp::array1d<IndexType, MemorySpace> components(G.num_rows);
+
+    size_t result = cusp::graph::connected_components(test_matrix, components);
+
+    ASSERT_EQUAL(result, size_t(num_components));
+
+    // the components must match up to a renumbering
+    cusp::array1d<IndexType, cusp::host_memory> h_components(components);
+    cusp::array1d<IndexType, cusp::host_memory> relabel(num_components, -1);
+
+    bool consistent = true;
+
+    for(size_t i = 0; i < G.num_rows; i++)
+    {
+        if(relabel[reference[i]] == -1)
+            relabel[reference[i]] = h_components[i];
+
+        if(relabel[reference[i]] != h_components[i])
+            consistent = false;
+    }
+
+    // and distinct components must keep distinct labels
+    thrust::sort(relabel.begin(), relabel.end());
+    if(thrust::unique(relabel.begin(), relabel.end()) != relabel.end())
+        consistent = false;
+
+    ASSERT_EQUAL(consistent, true);
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestConnectedComponents);
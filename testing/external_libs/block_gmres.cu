@@ -0,0 +1,188 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/block_monitor.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/block_gmres.h>
+#include <cusp/precond/diagonal.h>
+
+template <class LinearOperator, class Array2d>
+void block_gmres(my_system& system, LinearOperator& A, Array2d& X, Array2d& B, const size_t restart)
+{
+    system.validate_dispatch();
+    return;
+}
+
+template <class LinearOperator, class Array2d, class Monitor>
+void block_gmres(my_system& system, LinearOperator& A, Array2d& X, Array2d& B, const size_t restart, Monitor& monitor)
+{
+    system.validate_dispatch();
+    return;
+}
+
+template <class LinearOperator, class Array2d, class Monitor, class Preconditioner>
+void block_gmres(my_system& system, LinearOperator& A, Array2d& X, Array2d& B, const size_t restart, Monitor& monitor, Preconditioner& M)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestBlockGmresDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+    cusp::array2d<float, cusp::device_memory, cusp::column_major> X(A.num_rows, 2, 0.0f);
+    cusp::block_monitor<float> monitor(X, 20, 1e-4);
+    cusp::identity_operator<float,cusp::device_memory> M(A.num_rows, A.num_cols);
+
+    {
+        my_system sys(0);
+
+        // call with explicit dispatching
+        cusp::krylov::block_gmres(sys, A, X, X, 10);
+
+        // check if dispatch policy was used
+        ASSERT_EQUAL(true, sys.is_valid());
+    }
+
+    {
+        my_system sys(0);
+
+        // call with explicit dispatching
+        cusp::krylov::block_gmres(sys, A, X, X, 10, monitor);
+
+        // check if dispatch policy was used
+        ASSERT_EQUAL(true, sys.is_valid());
+    }
+
+    {
+        my_system sys(0);
+
+        // call with explicit dispatching
+        cusp::krylov::block_gmres(sys, A, X, X, 10, monitor, M);
+
+        // check if dispatch policy was used
+        ASSERT_EQUAL(true, sys.is_valid());
+    }
+}
+DECLARE_UNITTEST(TestBlockGmresDispatch);
+
+template <class Matrix, class Array2d>
+bool CheckBlockGmresResiduals(const Matrix& A, const Array2d& X, const Array2d& B, const double tolerance)
+{
+    Array2d R(B.num_rows, B.num_cols);
+    cusp::multiply(A, X, R);
+
+    for (size_t j = 0; j < B.num_cols; j++)
+    {
+        typename Array2d::column_view r(R.column(j));
+        cusp::blas::axpby(B.column(j), r, r, 1.0, -1.0);
+
+        if (cusp::blas::nrm2(r) > tolerance * cusp::blas::nrm2(B.column(j)))
+            return false;
+    }
+
+    return true;
+}
+
+// convection-diffusion operator on a 10x10 grid
+template <class MemorySpace>
+void ConvectionDiffusion(cusp::csr_matrix<int, double, MemorySpace>& A)
+{
+    cusp::csr_matrix<int, double, cusp::host_memory> A_host;
+    cusp::gallery::poisson5pt(A_host, 10, 10);
+
+    for (size_t i = 0; i < A_host.num_rows; i++)
+        for (int jj = A_host.row_offsets[i]; jj < A_host.row_offsets[i + 1]; jj++)
+            if (A_host.column_indices[jj] != int(i))
+                A_host.values[jj] = A_host.column_indices[jj] > int(i) ? -1.6 : -0.4;
+
+    A = A_host;
+}
+
+template <class MemorySpace>
+void TestBlockGmres(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    ConvectionDiffusion(A);
+
+    cusp::array2d<double, cusp::host_memory, cusp::column_major> B_host(A.num_rows, 4);
+
+    for (size_t i = 0; i < A.num_rows; i++)
+    {
+        B_host(i,0) = 1.0;
+        B_host(i,1) = double(i % 7);
+        B_host(i,2) = double((i * i) % 11) - 5.0;
+        B_host(i,3) = i < A.num_rows / 2 ? 1.0 : -2.0;
+    }
+
+    cusp::array2d<double, MemorySpace, cusp::column_major> B(B_host);
+    cusp::array2d<double, MemorySpace, cusp::column_major> X(A.num_rows, 4, 0.0);
+
+    cusp::block_monitor<double> monitor(B, 200, 1e-8);
+
+    cusp::krylov::block_gmres(A, X, B, 6, monitor);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+    ASSERT_EQUAL(CheckBlockGmresResiduals(A, X, B, 1e-7), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockGmres);
+
+template <class MemorySpace>
+void TestBlockGmresDeflation(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    ConvectionDiffusion(A);
+
+    cusp::array2d<double, MemorySpace, cusp::column_major> X(A.num_rows, 3, 0.0);
+    cusp::array2d<double, MemorySpace, cusp::column_major> B(A.num_rows, 3, 1.0);
+
+    // the second column starts from its exact solution
+    cusp::array2d<double, MemorySpace, cusp::column_major> ones(A.num_rows, 1, 1.0);
+    cusp::array2d<double, MemorySpace, cusp::column_major> A_ones(A.num_rows, 1);
+    cusp::multiply(A, ones, A_ones);
+
+    cusp::blas::copy(ones.column(0),   X.column(1));
+    cusp::blas::copy(A_ones.column(0), B.column(1));
+    cusp::blas::fill(B.column(2), 2.0);
+    B(0,2) = -1.0;
+
+    cusp::block_monitor<double> monitor(B, 200, 1e-8);
+
+    cusp::krylov::block_gmres(A, X, B, 10, monitor);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+    ASSERT_EQUAL(monitor.residual_norm(1), 0.0);
+    ASSERT_EQUAL(CheckBlockGmresResiduals(A, X, B, 1e-7), true);
+
+    // the deflated column is left untouched
+    cusp::array1d<double, MemorySpace> x_1(X.column(1));
+    ASSERT_EQUAL(x_1, cusp::array1d<double, MemorySpace>(A.num_rows, 1.0));
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockGmresDeflation);
+
+template <class MemorySpace>
+void TestBlockGmresPreconditioned(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    ConvectionDiffusion(A);
+
+    cusp::array2d<double, MemorySpace, cusp::column_major> X(A.num_rows, 2, 0.0);
+    cusp::array2d<double, MemorySpace, cusp::column_major> B(A.num_rows, 2, 1.0);
+    cusp::blas::fill(B.column(1), -3.0);
+    B(0,1) = 5.0;
+
+    cusp::precond::diagonal<double, MemorySpace> M(A);
+
+    cusp::block_monitor<double> monitor(B, 200, 1e-8);
+
+    cusp::krylov::block_gmres(A, X, B, 10, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+    ASSERT_EQUAL(CheckBlockGmresResiduals(A, X, B, 1e-6), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockGmresPreconditioned);
@@ -174,6 +174,41 @@ void TestCBLASdotc(void)
 }
 DECLARE_COMPLEX_UNITTEST(TestCBLASdotc);
 
+template<typename ValueType>
+void TestCBLASmdotc(void)
+{
+    typedef cusp::array1d<ValueType, cusp::host_memory>                     Array;
+    typedef cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> ColumnMajor;
+    typedef cusp::array2d<ValueType, cusp::host_memory, cusp::row_major>    RowMajor;
+
+    Array x(3);
+    x[0] = ValueType( 1.0f, 1.0f);
+    x[1] = ValueType( 2.0f, 0.0f);
+    x[2] = ValueType( 0.0f,-1.0f);
+
+    ColumnMajor Y(3, 4);
+    for (size_t i = 0; i < Y.num_rows; i++)
+        for (size_t j = 0; j < Y.num_cols; j++)
+            Y(i,j) = ValueType(float(i + j), float(i) - float(j));
+
+    Array expected(4);
+    cusp::blas::mdotc(x, Y, expected);
+
+    {
+        Array result(4);
+        cusp::blas::mdotc(cusp::cblas, x, Y, result);
+        ASSERT_EQUAL(result, expected);
+    }
+
+    {
+        RowMajor Z(Y);
+        Array result(4);
+        cusp::blas::mdotc(cusp::cblas, x, Z, result);
+        ASSERT_EQUAL(result, expected);
+    }
+}
+DECLARE_COMPLEX_UNITTEST(TestCBLASmdotc);
+
 template<typename ValueType>
 void TestCBLASnrm2(void)
 {
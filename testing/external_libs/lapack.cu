@@ -1,7 +1,10 @@
 #include <unittest/unittest.h>
 #include <cusp/array2d.h>
 #include <cusp/gallery/poisson.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
 #include <cusp/lapack/lapack.h>
+#include <cusp/lapack/solver.h>
 
 template<typename ValueType>
 void TestGETRF(void)
@@ -257,3 +260,39 @@ void TestSYEVDispatch()
 }
 DECLARE_UNITTEST(TestSYEVDispatch);
 
+
+template<typename Solver>
+void TestLapackSolver(void)
+{
+    typedef typename Solver::value_type ValueType;
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 8, 8);
+
+    Solver M(A);
+
+    cusp::array1d<ValueType, cusp::host_memory> b = unittest::random_samples<ValueType>(A.num_rows);
+    cusp::array1d<ValueType, cusp::host_memory> x(A.num_rows, 0);
+    cusp::array1d<ValueType, cusp::host_memory> y(A.num_rows, 0);
+
+    M(b, x);
+
+    // A*x should reproduce b
+    cusp::multiply(A, x, y);
+
+    ASSERT_ALMOST_EQUAL(y, b);
+}
+
+template<typename ValueType>
+void TestLapackLUSolver(void)
+{
+    TestLapackSolver< cusp::lapack::lu_solver<ValueType, cusp::host_memory> >();
+}
+DECLARE_REAL_UNITTEST(TestLapackLUSolver);
+
+template<typename ValueType>
+void TestLapackCholeskySolver(void)
+{
+    TestLapackSolver< cusp::lapack::cholesky_solver<ValueType, cusp::host_memory> >();
+}
+DECLARE_REAL_UNITTEST(TestLapackCholeskySolver);
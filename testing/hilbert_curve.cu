@@ -4,6 +4,8 @@
 
 #include <cusp/array2d.h>
 
+#include <cmath>
+
 template <typename Array2dType, typename ArrayType>
 void hilbert_curve(my_system& system, const Array2dType& coord, const size_t num_parts, ArrayType& parts)
 {
@@ -27,3 +29,66 @@ void TestHilbertCurveDispatch()
 }
 DECLARE_UNITTEST(TestHilbertCurveDispatch);
 
+
+template <typename MemorySpace>
+void TestHilbertCurveGrid(const size_t dims)
+{
+    // cell centers of a grid, shuffled
+    const size_t side = dims == 2 ? 16 : 8;
+    const size_t N = dims == 2 ? side * side : side * side * side;
+    const size_t num_parts = 4;
+
+    cusp::array2d<double, cusp::host_memory, cusp::column_major> h_coords(N, dims);
+
+    for(size_t i = 0; i < N; i++)
+    {
+        size_t point = (i * 37) % N;
+
+        for(size_t d = 0; d < dims; d++, point /= side)
+            h_coords(i, d) = (double(point % side) + 0.5) / double(side);
+    }
+
+    cusp::array2d<double, MemorySpace, cusp::column_major> coords(h_coords);
+    cusp::array1d<int, MemorySpace> parts(N);
+    cusp::array1d<int, MemorySpace> permutation(N);
+
+    cusp::graph::hilbert_curve(coords, num_parts, parts, permutation);
+
+    cusp::array1d<int, cusp::host_memory> h_parts(parts);
+    cusp::array1d<int, cusp::host_memory> h_permutation(permutation);
+    cusp::array1d<int, cusp::host_memory> order(N, -1);
+
+    for(size_t i = 0; i < N; i++)
+    {
+        ASSERT_EQUAL(true, h_permutation[i] >= 0 && h_permutation[i] < int(N));
+        ASSERT_EQUAL(-1, order[h_permutation[i]]);
+        ASSERT_EQUAL(int(h_permutation[i] * num_parts / N), h_parts[i]);
+
+        order[h_permutation[i]] = i;
+    }
+
+    // consecutive points along the curve are neighboring cells
+    for(size_t n = 1; n < N; n++)
+    {
+        double distance = 0;
+
+        for(size_t d = 0; d < dims; d++)
+            distance += std::abs(h_coords(order[n], d) - h_coords(order[n - 1], d));
+
+        ASSERT_EQUAL(true, std::abs(distance * side - 1.0) < 1e-6);
+    }
+
+    // the partitioning alone matches the parts returned with the permutation
+    cusp::array1d<int, MemorySpace> parts2(N);
+    cusp::graph::hilbert_curve(coords, num_parts, parts2);
+
+    ASSERT_EQUAL(parts, parts2);
+}
+
+template <typename MemorySpace>
+void TestHilbertCurve(void)
+{
+    TestHilbertCurveGrid<MemorySpace>(2);
+    TestHilbertCurveGrid<MemorySpace>(3);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestHilbertCurve);
@@ -83,3 +83,36 @@ void TestLUSolver(void)
 }
 DECLARE_UNITTEST(TestLUSolver);
 
+
+void TestLUFactorBlocked(void)
+{
+    // larger than one block and not a multiple of the block size
+    const int n = 150;
+
+    cusp::array2d<double, cusp::host_memory> A(n, n);
+    cusp::array1d<double, cusp::host_memory> samples = unittest::random_samples<double>(n * n);
+
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            A(i,j) = samples[i * n + j];
+
+    cusp::array2d<double, cusp::host_memory> LU(A);
+    cusp::array1d<double, cusp::host_memory> b = unittest::random_samples<double>(n);
+    cusp::array1d<double, cusp::host_memory> x(n);
+    cusp::array1d<int, cusp::host_memory>    pivot(n);
+
+    ASSERT_EQUAL(cusp::detail::lu_factor(LU, pivot), 0);
+    ASSERT_EQUAL(cusp::detail::lu_solve(LU, pivot, b, x), 0);
+
+    // check the residual b - A*x
+    for (int i = 0; i < n; i++)
+    {
+        double sum = 0;
+
+        for (int j = 0; j < n; j++)
+            sum += A(i,j) * x[j];
+
+        ASSERT_EQUAL(std::fabs(b[i] - sum) < 1e-8, true);
+    }
+}
+DECLARE_UNITTEST(TestLUFactorBlocked);
@@ -6,6 +6,7 @@
 #include <cusp/csr_matrix.h>
 #include <cusp/array2d.h>
 
+#include <fstream>
 #include <stdio.h>
 
 const char random_file_name[] = "test_93298409283221.mtx";
@@ -324,3 +325,173 @@ void TestWriteMatrixMarketFileCoordinateComplexGeneral(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestWriteMatrixMarketFileCoordinateComplexGeneral);
 
+
+void TestReadMatrixMarketFileCoordinateRealSkewSymmetric(void)
+{
+    FILE * file = fopen(random_file_name, "w");
+    fprintf(file, "%%%%MatrixMarket matrix coordinate real skew-symmetric\n");
+    fprintf(file, "%% lower triangle only\n");
+    fprintf(file, "3 3 3\n");
+    fprintf(file, "2 1 1.5\n");
+    fprintf(file, "3 1 -2.0e+00\n");
+    fprintf(file, "3 2 .25\n");
+    fclose(file);
+
+    cusp::csr_matrix<int, float, cusp::host_memory> csr;
+    cusp::io::read_matrix_market_file(csr, random_file_name);
+
+    remove(random_file_name);
+
+    cusp::array2d<float, cusp::host_memory> D(csr);
+
+    cusp::array2d<float, cusp::host_memory> E(3, 3, 0.0f);
+    E(1,0) =  1.50f;  E(0,1) = -1.50f;
+    E(2,0) = -2.00f;  E(0,2) =  2.00f;
+    E(2,1) =  0.25f;  E(1,2) = -0.25f;
+
+    ASSERT_EQUAL(csr.num_entries, 6);
+    ASSERT_EQUAL(D == E, true);
+}
+DECLARE_UNITTEST(TestReadMatrixMarketFileCoordinateRealSkewSymmetric);
+
+void TestReadMatrixMarketFileCoordinateComplexHermitian(void)
+{
+    typedef cusp::complex<float> ValueType;
+
+    FILE * file = fopen(random_file_name, "w");
+    fprintf(file, "%%%%MatrixMarket matrix coordinate complex hermitian\n");
+    fprintf(file, "2 2 2\n");
+    fprintf(file, "1 1 4.0 0.0\n");
+    fprintf(file, "2 1 1.0 2.0\n");
+    fclose(file);
+
+    cusp::coo_matrix<int, ValueType, cusp::host_memory> coo;
+    cusp::io::read_matrix_market_file(coo, random_file_name);
+
+    remove(random_file_name);
+
+    ASSERT_EQUAL(coo.num_entries, 3);
+    ASSERT_EQUAL(coo.row_indices[0], 0);  ASSERT_EQUAL(coo.column_indices[0], 0);
+    ASSERT_EQUAL(coo.row_indices[1], 0);  ASSERT_EQUAL(coo.column_indices[1], 1);
+    ASSERT_EQUAL(coo.row_indices[2], 1);  ASSERT_EQUAL(coo.column_indices[2], 0);
+    ASSERT_EQUAL(coo.values[0], ValueType(4.0f,  0.0f));
+    ASSERT_EQUAL(coo.values[1], ValueType(1.0f, -2.0f));
+    ASSERT_EQUAL(coo.values[2], ValueType(1.0f,  2.0f));
+}
+DECLARE_UNITTEST(TestReadMatrixMarketFileCoordinateComplexHermitian);
+
+void TestReadMatrixMarketFileCoordinateInvalidIndex(void)
+{
+    FILE * file = fopen(random_file_name, "w");
+    fprintf(file, "%%%%MatrixMarket matrix coordinate real general\n");
+    fprintf(file, "2 2 1\n");
+    fprintf(file, "3 1 1.0\n");
+    fclose(file);
+
+    cusp::csr_matrix<int, float, cusp::host_memory> csr;
+
+    ASSERT_THROWS(cusp::io::read_matrix_market_file(csr, random_file_name), cusp::io_exception);
+
+    remove(random_file_name);
+}
+DECLARE_UNITTEST(TestReadMatrixMarketFileCoordinateInvalidIndex);
+
+void TestReadMatrixMarketFileCoordinateTruncatedLine(void)
+{
+    // the value of the first entry is missing and must not be read from
+    // the following line
+    FILE * file = fopen(random_file_name, "w");
+    fprintf(file, "%%%%MatrixMarket matrix coordinate real general\n");
+    fprintf(file, "3 3 2\n");
+    fprintf(file, "1 1\n");
+    fprintf(file, "2 2 2.0\n");
+    fclose(file);
+
+    cusp::csr_matrix<int, float, cusp::host_memory> csr;
+
+    ASSERT_THROWS(cusp::io::read_matrix_market_file(csr, random_file_name), cusp::io_exception);
+
+    remove(random_file_name);
+}
+DECLARE_UNITTEST(TestReadMatrixMarketFileCoordinateTruncatedLine);
+
+template <typename MemorySpace>
+void TestReadMatrixMarketFileLarge(void)
+{
+    // large enough to be split into several chunks
+    const int N = 20000;
+
+    FILE * file = fopen(random_file_name, "w");
+    fprintf(file, "%%%%MatrixMarket matrix coordinate real symmetric\n");
+    fprintf(file, "%d %d %d\n", N, N, 2 * N - 1);
+    for (int i = N; i > 0; i--)
+    {
+        fprintf(file, "%d %d %.9e\n", i, i, 2.0 + i / 7.0);
+        if (i > 1)
+            fprintf(file, "%d %d %.9e\n", i, i - 1, -1.0 / i);
+    }
+    fclose(file);
+
+    cusp::csr_matrix<int, double, MemorySpace> csr;
+    cusp::io::read_matrix_market_file(csr, random_file_name);
+
+    // the stream reader serves as reference
+    cusp::coo_matrix<int, double, cusp::host_memory> coo;
+    {
+        std::ifstream stream(random_file_name);
+        cusp::io::read_matrix_market_stream(coo, stream);
+    }
+
+    remove(random_file_name);
+
+    cusp::coo_matrix<int, double, cusp::host_memory> result(csr);
+
+    ASSERT_EQUAL(result.num_entries, 3 * N - 2);
+    ASSERT_EQUAL(result.row_indices,    coo.row_indices);
+    ASSERT_EQUAL(result.column_indices, coo.column_indices);
+    ASSERT_EQUAL(result.values,         coo.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestReadMatrixMarketFileLarge);
+
+template <typename MemorySpace>
+void TestWriteMatrixMarketFilePrecision(void)
+{
+    cusp::array1d<double, cusp::host_memory> values(4);
+    values[0] = 0.1;
+    values[1] = 0.1 + 0.2;
+    values[2] = 1.0 / 3.0;
+    values[3] = -2.5e-300;
+
+    cusp::coo_matrix<int, double, MemorySpace> coo(2, 3, 4);
+    coo.row_indices[0] = 0;  coo.column_indices[0] = 0;  coo.values[0] = values[0];
+    coo.row_indices[1] = 0;  coo.column_indices[1] = 2;  coo.values[1] = values[1];
+    coo.row_indices[2] = 1;  coo.column_indices[2] = 1;  coo.values[2] = values[2];
+    coo.row_indices[3] = 1;  coo.column_indices[3] = 2;  coo.values[3] = values[3];
+
+    // exact precision values read back unchanged
+    {
+        cusp::coo_matrix<int, double, cusp::host_memory> result;
+
+        cusp::io::write_matrix_market_file(coo, random_file_name, cusp::io::exact_precision);
+        cusp::io::read_matrix_market_file(result, random_file_name);
+
+        ASSERT_EQUAL(result.row_indices,    coo.row_indices);
+        ASSERT_EQUAL(result.column_indices, coo.column_indices);
+        ASSERT_EQUAL(result.values,         values);
+    }
+
+    // fast precision values agree to single precision
+    {
+        cusp::coo_matrix<int, double, cusp::host_memory> result;
+
+        cusp::io::write_matrix_market_file(coo, random_file_name, cusp::io::fast_precision);
+        cusp::io::read_matrix_market_file(result, random_file_name);
+
+        ASSERT_EQUAL(result.row_indices,    coo.row_indices);
+        ASSERT_EQUAL(result.column_indices, coo.column_indices);
+        ASSERT_ALMOST_EQUAL(result.values,  values);
+    }
+
+    remove(random_file_name);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestWriteMatrixMarketFilePrecision);
@@ -170,6 +170,11 @@ void TestMaximalIndependentSet(void)
     cusp::gallery::poisson5pt(H, 105, 107);
     thrust::fill(H.values.begin(), H.values.end(), 1.0f);
 
+    // 3D mesh with large k-rings
+    cusp::coo_matrix<int,ValueType,cusp::host_memory> I;
+    cusp::gallery::poisson27pt(I, 9, 10, 11);
+    thrust::fill(I.values.begin(), I.values.end(), 1.0f);
+
     _TestMaximalIndependentSet<TestMatrix>(A);
     _TestMaximalIndependentSet<TestMatrix>(B);
     _TestMaximalIndependentSet<TestMatrix>(C);
@@ -178,6 +183,7 @@ void TestMaximalIndependentSet(void)
     _TestMaximalIndependentSet<TestMatrix>(F);
     _TestMaximalIndependentSet<TestMatrix>(G);
     _TestMaximalIndependentSet<TestMatrix>(H);
+    _TestMaximalIndependentSet<TestMatrix>(I);
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestMaximalIndependentSet);
 
@@ -0,0 +1,79 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/multilevel_partition.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/gallery/poisson.h>
+
+template <typename MatrixType, typename ArrayType>
+size_t multilevel_partition(my_system& system,
+                            const MatrixType& G,
+                            const size_t num_parts,
+                            ArrayType& parts)
+{
+    system.validate_dispatch();
+    return 0;
+}
+
+void TestMultilevelPartitionDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::array1d<int, cusp::device_memory> parts;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::multilevel_partition(sys, A, 2, parts);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestMultilevelPartitionDispatch);
+
+template <typename TestMatrix>
+void TestMultilevelPartition(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    cusp::csr_matrix<IndexType, float, cusp::host_memory> G;
+    cusp::gallery::poisson5pt(G, 32, 32);
+
+    TestMatrix test_matrix(G);
+
+    for(size_t num_parts = 1; num_parts <= 8; num_parts *= 2)
+    {
+        cusp::array1d<IndexType, MemorySpace> parts(G.num_rows);
+
+        size_t edge_cut = cusp::graph::multilevel_partition(test_matrix, num_parts, parts);
+
+        cusp::array1d<IndexType, cusp::host_memory> h_parts(parts);
+        cusp::array1d<size_t, cusp::host_memory> sizes(num_parts, 0);
+        size_t cut = 0;
+
+        for(size_t i = 0; i < G.num_rows; i++)
+        {
+            ASSERT_EQUAL(h_parts[i] >= 0 && h_parts[i] < IndexType(num_parts), true);
+
+            sizes[h_parts[i]]++;
+
+            for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+                if(h_parts[G.column_indices[jj]] != h_parts[i])
+                    cut++;
+        }
+
+        // the returned edge cut counts every cut edge once
+        ASSERT_EQUAL(edge_cut, cut / 2);
+
+        // the parts are balanced up to a few percent
+        for(size_t p = 0; p < num_parts; p++)
+            ASSERT_EQUAL(sizes[p] * num_parts * 10 <= 11 * G.num_rows, true);
+
+        // and the cut is within 50% of the optimal straight cuts
+        size_t optimal = num_parts == 1 ? 0 : (num_parts == 2 ? 32 : (num_parts == 4 ? 64 : 128));
+        ASSERT_EQUAL(2 * edge_cut <= 3 * optimal, true);
+    }
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestMultilevelPartition);
@@ -127,6 +127,73 @@ void TestSparseMatrixMatrixMultiply(void)
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixMatrixMultiply);
 
+template <typename TestMatrix>
+void TestSparseMatrixMatrixMultiplyWide(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::value_type   ValueType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    // B is too wide for dense accumulators and the first row of A
+    // references every row of B while the others hold one entry
+    const size_t num_rows   = 30;
+    const size_t num_inner  = 200;
+    const size_t num_cols   = 100000;
+    const size_t row_length = 5;
+
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> A(num_rows, num_inner, num_inner + num_rows - 1);
+    for(size_t n = 0; n < num_inner; n++)
+    {
+        A.row_indices[n]    = 0;
+        A.column_indices[n] = n;
+        A.values[n]         = ValueType(n % 3 + 1);
+    }
+    for(size_t i = 1; i < num_rows; i++)
+    {
+        A.row_indices[num_inner + i - 1]    = i;
+        A.column_indices[num_inner + i - 1] = (i * 37) % num_inner;
+        A.values[num_inner + i - 1]         = ValueType(i % 2 + 1);
+    }
+
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> B(num_inner, num_cols, num_inner * row_length);
+    for(size_t i = 0; i < num_inner; i++)
+    {
+        for(size_t n = 0; n < row_length; n++)
+        {
+            // rows of B overlap in a few columns
+            B.row_indices[i * row_length + n]    = i;
+            B.column_indices[i * row_length + n] = ((i % 17) * 491 + n * 20011) % num_cols;
+            B.values[i * row_length + n]         = ValueType(n % 2 + 1);
+        }
+    }
+    B.sort_by_row_and_column();
+
+    TestMatrix _A(A), _B(B), _C;
+    cusp::multiply(_A, _B, _C);
+
+    ASSERT_EQUAL(_C.num_rows, num_rows);
+    ASSERT_EQUAL(_C.num_cols, num_cols);
+
+    // compare C*x against A*(B*x)
+    cusp::array1d<ValueType, cusp::host_memory> x_host(num_cols);
+    for(size_t i = 0; i < num_cols; i++)
+        x_host[i] = ValueType(i % 10);
+
+    cusp::array1d<ValueType, MemorySpace> x(x_host);
+
+    cusp::array1d<ValueType, MemorySpace> Bx(num_inner);
+    cusp::array1d<ValueType, MemorySpace> ABx(num_rows);
+    cusp::array1d<ValueType, MemorySpace> Cx(num_rows);
+
+    cusp::multiply(_B, x, Bx);
+    cusp::multiply(_A, Bx, ABx);
+    cusp::multiply(_C, x, Cx);
+
+    ASSERT_EQUAL(Cx, ABx);
+}
+DECLARE_SPARSE_FORMAT_UNITTEST(TestSparseMatrixMatrixMultiplyWide, Coo, coo);
+DECLARE_SPARSE_FORMAT_UNITTEST(TestSparseMatrixMatrixMultiplyWide, Csr, csr);
+
 template <typename SparseMatrixType, typename DenseMatrixType>
 void CompareScaledSparseMatrixMatrixMultiply(DenseMatrixType A, DenseMatrixType B)
 {
@@ -373,7 +440,45 @@ void TestSparseMatrixDenseMatrixMultiply(void)
     }
 
 }
-/* DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixDenseMatrixMultiply); */
+DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixDenseMatrixMultiply);
+
+template <typename TestMatrix>
+void TestSparseMatrixDenseMatrixMultiplyRowMajor(void)
+{
+    typedef typename TestMatrix::value_type   ValueType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    cusp::array2d<ValueType,cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 5, 6);
+
+    // more columns than a single tile of the host kernels
+    cusp::array2d<ValueType,cusp::host_memory> B(A.num_cols, 20);
+    for(size_t i = 0; i < B.num_rows; i++)
+        for(size_t j = 0; j < B.num_cols; j++)
+            B(i,j) = ValueType(int((i * 7 + j * 3) % 11) - 5);
+
+    cusp::array2d<ValueType,cusp::host_memory> C(A.num_rows, B.num_cols);
+    cusp::multiply(A, B, C);
+
+    TestMatrix _A(A);
+
+    {
+        cusp::array2d<ValueType,MemorySpace,cusp::row_major> _B(B);
+        cusp::array2d<ValueType,MemorySpace,cusp::row_major> _C(C.num_rows, C.num_cols, ValueType(1));
+        cusp::multiply(_A, _B, _C);
+
+        ASSERT_EQUAL(C == cusp::array2d<ValueType,cusp::host_memory>(_C), true);
+    }
+
+    {
+        cusp::array2d<ValueType,MemorySpace,cusp::row_major>    _B(B);
+        cusp::array2d<ValueType,MemorySpace,cusp::column_major> _C(C.num_rows, C.num_cols, ValueType(1));
+        cusp::multiply(_A, _B, _C);
+
+        ASSERT_EQUAL(C == cusp::array2d<ValueType,cusp::host_memory>(_C), true);
+    }
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixDenseMatrixMultiplyRowMajor);
 
 
 /////////////////////////////////////////
@@ -512,6 +617,34 @@ void TestSparseMatrixVectorMultiply()
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestSparseMatrixVectorMultiply);
 
+template <class TestMatrix>
+void TestSparseMatrixVectorMultiplySkewed()
+{
+    typedef typename TestMatrix::value_type   ValueType;
+
+    // a few dense rows surrounded by many short and empty rows
+    cusp::array2d<ValueType, cusp::host_memory> A(300, 250, ValueType(0));
+    for(size_t j = 0; j < A.num_cols; j++)
+    {
+        A(0,   j) = ValueType(j % 7);
+        A(150, j) = ValueType(1);
+        A(299, j) = ValueType(j % 3);
+    }
+    for(size_t i = 1; i < A.num_rows; i += 3)
+        A(i, i % A.num_cols) = ValueType(i % 5 + 1);
+
+    cusp::array2d<ValueType, cusp::host_memory> B(1, 1000, ValueType(2));
+
+    cusp::array2d<ValueType, cusp::host_memory> C(1000, 1, ValueType(0));
+    C(999, 0) = ValueType(4);
+
+    CompareSparseMatrixVectorMultiply<TestMatrix>(A);
+    CompareSparseMatrixVectorMultiply<TestMatrix>(B);
+    CompareSparseMatrixVectorMultiply<TestMatrix>(C);
+}
+DECLARE_SPARSE_FORMAT_UNITTEST(TestSparseMatrixVectorMultiplySkewed, Coo, coo);
+DECLARE_SPARSE_FORMAT_UNITTEST(TestSparseMatrixVectorMultiplySkewed, Csr, csr);
+
 template <typename SparseMatrixType, typename DenseMatrixType>
 void CompareScaledSparseMatrixVectorMultiply(DenseMatrixType A)
 {
@@ -0,0 +1,108 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/nested_dissection.h>
+
+#include <cusp/csr_matrix.h>
+#include <cusp/permutation_matrix.h>
+#include <cusp/gallery/poisson.h>
+
+#include <vector>
+
+template <typename MatrixType, typename PermutationType>
+void nested_dissection(my_system& system, const MatrixType& G, PermutationType& P)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestNestedDissectionDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::permutation_matrix<int,cusp::device_memory> P;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::nested_dissection(sys, A, P);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestNestedDissectionDispatch);
+
+// number of nonzeros of the Cholesky factor of the permuted matrix,
+// computed row by row from the elimination tree
+template <typename MatrixType, typename ArrayType>
+size_t cholesky_nonzeros(const MatrixType& G, const ArrayType& permutation)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType N = G.num_rows;
+
+    std::vector<IndexType> vertices(N);
+    std::vector<IndexType> parent(N, -1);
+    std::vector<IndexType> mark(N, -1);
+
+    for(IndexType i = 0; i < N; i++)
+        vertices[permutation[i]] = i;
+
+    size_t nonzeros = N;
+
+    for(IndexType i = 0; i < N; i++)
+    {
+        const IndexType v = vertices[i];
+        mark[i] = i;
+
+        for(IndexType jj = G.row_offsets[v]; jj < G.row_offsets[v + 1]; jj++)
+        {
+            for(IndexType j = permutation[G.column_indices[jj]]; j < i && mark[j] != i; j = parent[j])
+            {
+                mark[j] = i;
+                nonzeros++;
+
+                if(parent[j] == -1)
+                {
+                    parent[j] = i;
+                    break;
+                }
+            }
+        }
+    }
+
+    return nonzeros;
+}
+
+template <typename TestMatrix>
+void TestNestedDissection(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    cusp::csr_matrix<IndexType, float, cusp::host_memory> G;
+    cusp::gallery::poisson5pt(G, 40, 40);
+
+    const IndexType N = G.num_rows;
+
+    TestMatrix test_matrix(G);
+    cusp::permutation_matrix<IndexType, MemorySpace> P(N);
+
+    cusp::graph::nested_dissection(test_matrix, P);
+
+    cusp::array1d<IndexType, cusp::host_memory> permutation(P.permutation);
+    cusp::array1d<IndexType, cusp::host_memory> identity(N);
+    cusp::array1d<IndexType, cusp::host_memory> vertices(N, -1);
+
+    // the result must be a permutation
+    for(IndexType i = 0; i < N; i++)
+    {
+        ASSERT_EQUAL(permutation[i] >= 0 && permutation[i] < N, true);
+        ASSERT_EQUAL(vertices[permutation[i]], IndexType(-1));
+        vertices[permutation[i]] = i;
+        identity[i] = i;
+    }
+
+    // which saves a third of the fill of the natural ordering
+    ASSERT_EQUAL(3 * cholesky_nonzeros(G, permutation) < 2 * cholesky_nonzeros(G, identity), true);
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestNestedDissection);
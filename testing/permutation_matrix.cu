@@ -96,3 +96,47 @@ void TestPermutationMatrixRebind(void)
 }
 DECLARE_UNITTEST(TestPermutationMatrixRebind);
 
+void TestPermutationMatrixSymmetricPermuteMixedSpace(void)
+{
+    typedef cusp::csr_matrix<int, float, cusp::host_memory>   HostMatrix;
+    typedef cusp::csr_matrix<int, float, cusp::device_memory> DeviceMatrix;
+
+    HostMatrix A(3, 3, 5);
+    A.row_offsets[0] = 0;
+    A.row_offsets[1] = 2;
+    A.row_offsets[2] = 3;
+    A.row_offsets[3] = 5;
+    A.column_indices[0] = 0; A.values[0] = 10;
+    A.column_indices[1] = 2; A.values[1] = 11;
+    A.column_indices[2] = 1; A.values[2] = 12;
+    A.column_indices[3] = 0; A.values[3] = 13;
+    A.column_indices[4] = 2; A.values[4] = 14;
+
+    cusp::permutation_matrix<int, cusp::host_memory> P(3);
+    P.permutation[0] = 2;
+    P.permutation[1] = 0;
+    P.permutation[2] = 1;
+
+    // a host permutation applied to a device matrix
+    DeviceMatrix d_A(A);
+    P.symmetric_permute(d_A);
+
+    HostMatrix h_A(A);
+    P.symmetric_permute(h_A);
+
+    cusp::array2d<float, cusp::host_memory> expected(h_A);
+    cusp::array2d<float, cusp::host_memory> result(d_A);
+
+    ASSERT_EQUAL(result.values, expected.values);
+
+    // and a device permutation applied to a host matrix
+    cusp::permutation_matrix<int, cusp::device_memory> d_P(P);
+    HostMatrix B(A);
+    d_P.symmetric_permute(B);
+
+    cusp::array2d<float, cusp::host_memory> result2(B);
+
+    ASSERT_EQUAL(result2.values, expected.values);
+}
+DECLARE_UNITTEST(TestPermutationMatrixSymmetricPermuteMixedSpace);
+
@@ -2,7 +2,9 @@
 
 #include <cusp/graph/pseudo_peripheral.h>
 
+#include <cusp/array1d.h>
 #include <cusp/csr_matrix.h>
+#include <cusp/gallery/poisson.h>
 
 template <typename MatrixType>
 typename MatrixType::index_type
@@ -27,3 +29,37 @@ void TestPseudoPeripheralDispatch()
 }
 DECLARE_UNITTEST(TestPseudoPeripheralDispatch);
 
+
+template <typename TestMatrix>
+void TestPseudoPeripheral(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    // the search ends at a corner of a grid whatever its start
+    cusp::csr_matrix<IndexType, float, cusp::host_memory> G;
+    cusp::gallery::poisson5pt(G, 23, 31);
+
+    TestMatrix test_matrix(G);
+    cusp::array1d<IndexType, MemorySpace> levels(G.num_rows);
+
+    IndexType vertex = cusp::graph::pseudo_peripheral_vertex(test_matrix, levels);
+
+    IndexType x = vertex % 23;
+    IndexType y = vertex / 23;
+
+    ASSERT_EQUAL(x == 0 || x == 22, true);
+    ASSERT_EQUAL(y == 0 || y == 30, true);
+
+    // and the levels are those of the returned vertex
+    cusp::array1d<IndexType, cusp::host_memory> h_levels(levels);
+
+    for(IndexType i = 0; i < IndexType(G.num_rows); i++)
+    {
+        IndexType dx = i % 23 > x ? i % 23 - x : x - i % 23;
+        IndexType dy = i / 23 > y ? i / 23 - y : y - i / 23;
+
+        ASSERT_EQUAL(h_levels[i], dx + dy);
+    }
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestPseudoPeripheral);
@@ -0,0 +1,166 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+#include <cusp/reorder.h>
+
+#include <cusp/gallery/poisson.h>
+
+template <typename MatrixType>
+void initialize_matrix(MatrixType& matrix)
+{
+    cusp::array2d<float, cusp::host_memory> D(4, 4, 0);
+
+    D(0,0) = 10.25;  D(0,1) = 11.00;
+    D(1,1) = 12.50;  D(1,3) = 13.75;
+    D(2,0) = 14.00;  D(2,2) = 15.25;
+    D(3,2) = 16.50;  D(3,3) = 17.00;
+
+    matrix = D;
+}
+
+template <class Matrix>
+void TestReorder(void)
+{
+    typedef typename Matrix::index_type   IndexType;
+    typedef typename Matrix::memory_space MemorySpace;
+
+    Matrix A;
+    initialize_matrix(A);
+
+    cusp::array1d<IndexType, MemorySpace> permutation(4);
+    permutation[0] = 2;
+    permutation[1] = 0;
+    permutation[2] = 3;
+    permutation[3] = 1;
+
+    Matrix B;
+    cusp::reorder(A, permutation, B);
+
+    cusp::array2d<float, cusp::host_memory> dense_A(A);
+    cusp::array2d<float, cusp::host_memory> dense_B(B);
+
+    ASSERT_EQUAL(dense_B.num_rows, 4);
+    ASSERT_EQUAL(dense_B.num_cols, 4);
+
+    for(int i = 0; i < 4; i++)
+        for(int j = 0; j < 4; j++)
+            ASSERT_EQUAL(dense_B(permutation[i], permutation[j]), dense_A(i,j));
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestReorder);
+
+template <class Matrix>
+void TestReorderSorted(void)
+{
+    typedef typename Matrix::index_type   IndexType;
+    typedef typename Matrix::value_type   ValueType;
+    typedef typename Matrix::memory_space MemorySpace;
+
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 7, 9);
+
+    for(size_t n = 0; n < A.num_entries; n++)
+        A.values[n] = A.row_indices[n] + ValueType(0.5) * A.column_indices[n];
+
+    const IndexType N = A.num_rows;
+    cusp::array1d<IndexType, cusp::host_memory> permutation(N);
+
+    for(IndexType i = 0; i < N; i++)
+        permutation[i] = (i * 17) % N;
+
+    Matrix B;
+    cusp::reorder(Matrix(A), cusp::array1d<IndexType, MemorySpace>(permutation), B);
+
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> C(B);
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> D(A);
+
+    for(size_t n = 0; n < D.num_entries; n++)
+    {
+        D.row_indices[n]    = permutation[A.row_indices[n]];
+        D.column_indices[n] = permutation[A.column_indices[n]];
+    }
+    D.sort_by_row_and_column();
+
+    ASSERT_EQUAL(C.num_rows,       D.num_rows);
+    ASSERT_EQUAL(C.num_entries,    D.num_entries);
+    ASSERT_EQUAL(C.row_indices,    D.row_indices);
+    ASSERT_EQUAL(C.column_indices, D.column_indices);
+    ASSERT_EQUAL(C.values,         D.values);
+}
+DECLARE_SPARSE_FORMAT_UNITTEST(TestReorderSorted,Coo,coo);
+DECLARE_SPARSE_FORMAT_UNITTEST(TestReorderSorted,Csr,csr);
+
+template <class MemorySpace>
+void TestReordering(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 5, 6);
+
+    const int N = A.num_rows;
+    cusp::array1d<int, MemorySpace> permutation(N);
+
+    for(int i = 0; i < N; i++)
+        permutation[i] = N - 1 - (i * 7) % N;
+
+    cusp::array1d<float, MemorySpace> x(N);
+    cusp::array1d<float, MemorySpace> y(N);
+
+    for(int i = 0; i < N; i++)
+        x[i] = i;
+
+    cusp::multiply(A, x, y);
+
+    cusp::array1d<float, MemorySpace> x_copy(x);
+    cusp::array1d<float, MemorySpace> y_copy(y);
+
+    cusp::reordering<int, MemorySpace> R = cusp::reorder(A, permutation);
+
+    ASSERT_EQUAL(R.permutation, permutation);
+
+    for(int i = 0; i < N; i++)
+        ASSERT_EQUAL(R.inverse[permutation[i]], i);
+
+    R.permute(x);
+    R.permute(y);
+
+    for(int i = 0; i < N; i++)
+        ASSERT_EQUAL(x[permutation[i]], x_copy[i]);
+
+    // the reordered system is solved by the permuted vectors
+    cusp::array1d<float, MemorySpace> z(N);
+    cusp::multiply(A, x, z);
+
+    ASSERT_EQUAL(z, y);
+
+    R.unpermute(x);
+    R.unpermute(y);
+
+    ASSERT_EQUAL(x, x_copy);
+    ASSERT_EQUAL(y, y_copy);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestReordering);
+
+template <typename MatrixType1, typename ArrayType, typename MatrixType2>
+void reorder(my_system& system, const MatrixType1& A, const ArrayType& permutation, MatrixType2& B)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestReorderDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A, B;
+    cusp::array1d<int, cusp::device_memory> permutation;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::reorder(sys, A, permutation, B);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestReorderDispatch);
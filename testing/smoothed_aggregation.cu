@@ -3,15 +3,21 @@
 #include <cusp/precond/aggregation/smoothed_aggregation.h>
 
 #include <cusp/array2d.h>
+#include <cusp/blas/blas.h>
 #include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 #include <cusp/dia_matrix.h>
 #include <cusp/ell_matrix.h>
 #include <cusp/hyb_matrix.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
 
 #include <cusp/gallery/poisson.h>
 #include <cusp/krylov/cg.h>
 
+#include <thrust/functional.h>
+#include <thrust/reduce.h>
+
 template <class MemorySpace>
 void TestStandardAggregation(void)
 {
@@ -283,6 +289,49 @@ void TestSmoothProlongator(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestSmoothProlongator);
 
+template <class MemorySpace>
+void TestGalerkinProduct(void)
+{
+    typedef typename cusp::precond::aggregation::detail::select_sa_matrix_type<int,float,MemorySpace>::type SetupMatrixType;
+
+    SetupMatrixType A;
+    cusp::gallery::poisson5pt(A, 20, 17);
+
+    cusp::array1d<int,MemorySpace> aggregates(A.num_rows);
+    cusp::precond::aggregation::standard_aggregate(A, aggregates);
+
+    const int num_aggregates = thrust::reduce(aggregates.begin(), aggregates.end(), 0, thrust::maximum<int>()) + 1;
+
+    cusp::array1d<float,MemorySpace> B(A.num_rows, 1.0f);
+    cusp::array1d<float,MemorySpace> B_coarse(num_aggregates);
+
+    SetupMatrixType T;
+    cusp::precond::aggregation::fit_candidates(aggregates, B, T, B_coarse);
+
+    SetupMatrixType P;
+    SetupMatrixType R;
+    cusp::precond::aggregation::smooth_prolongator(A, T, P);
+    cusp::transpose(P, R);
+
+    SetupMatrixType RAP;
+    cusp::precond::aggregation::galerkin_product(R, A, P, RAP);
+
+    // reference R * (A * P)
+    SetupMatrixType AP;
+    SetupMatrixType reference;
+    cusp::multiply(A, P, AP);
+    cusp::multiply(R, AP, reference);
+
+    // the SpGEMMs may drop entries that cancel, compare the dense matrices
+    cusp::array2d<float,cusp::host_memory> h_RAP(RAP);
+    cusp::array2d<float,cusp::host_memory> h_reference(reference);
+
+    ASSERT_EQUAL(h_RAP.num_rows, num_aggregates);
+    ASSERT_EQUAL(h_RAP.num_cols, num_aggregates);
+    ASSERT_ALMOST_EQUAL(h_RAP.values, h_reference.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGalerkinProduct);
+
 template <typename SparseMatrix>
 void TestSmoothedAggregation(void)
 {
@@ -367,6 +416,200 @@ void TestSmoothedAggregationHostToDevice(void)
 }
 DECLARE_UNITTEST(TestSmoothedAggregationHostToDevice);
 
+template <class MemorySpace>
+void TestSmoothedAggregationUpdateValues(void)
+{
+    typedef int                 IndexType;
+    typedef float               ValueType;
+
+    typedef cusp::precond::aggregation::smoothed_aggregation<IndexType,ValueType,MemorySpace> SolverType;
+
+    cusp::csr_matrix<IndexType,ValueType,MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 40, 40);
+
+    SolverType M(A);
+
+    ASSERT_EQUAL(M.levels.size() > 2, true);
+
+    cusp::array2d<ValueType,cusp::host_memory> coarse(M.levels[1].A);
+
+    // scaling A scales every coarse matrix and leaves the prolongators unchanged
+    cusp::blas::scal(A.values, ValueType(2));
+    M.update_values(A);
+
+    {
+        cusp::array2d<ValueType,cusp::host_memory> expected(coarse);
+        cusp::blas::scal(expected.values, ValueType(2));
+
+        cusp::array2d<ValueType,cusp::host_memory> result(M.levels[1].A);
+
+        ASSERT_EQUAL(result.num_rows, expected.num_rows);
+        ASSERT_EQUAL(result.num_cols, expected.num_cols);
+        ASSERT_ALMOST_EQUAL(result.values, expected.values);
+    }
+
+    // shift the diagonal and precondition with the updated hierarchy
+    {
+        cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> B(A);
+
+        for(size_t i = 0; i < B.num_rows; i++)
+            for(IndexType jj = B.row_offsets[i]; jj < B.row_offsets[i + 1]; jj++)
+                if(B.column_indices[jj] == IndexType(i))
+                    B.values[jj] += ValueType(1) / ValueType(i % 7 + 1);
+
+        A = B;
+        M.update_values(A);
+
+        cusp::array1d<ValueType,MemorySpace> b = unittest::random_samples<ValueType>(A.num_rows);
+        cusp::array1d<ValueType,MemorySpace> x = unittest::random_samples<ValueType>(A.num_rows);
+
+        // set stopping criteria (iteration_limit = 20, relative_tolerance = 1e-4)
+        cusp::monitor<ValueType> monitor(b, 20, 1e-4);
+        cusp::krylov::cg(A, x, b, monitor, M);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        ASSERT_EQUAL(monitor.geometric_rate() < 0.5, true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSmoothedAggregationUpdateValues);
+
+template <class MemorySpace>
+void TestSmoothedAggregationCholeskyCoarseSolver(void)
+{
+    typedef int                 IndexType;
+    typedef float               ValueType;
+
+    typedef cusp::detail::cholesky_solver<ValueType,cusp::host_memory> CoarseSolver;
+    typedef cusp::precond::aggregation::smoothed_aggregation<IndexType,ValueType,MemorySpace,
+                                                             thrust::use_default,CoarseSolver> SolverType;
+
+    cusp::csr_matrix<IndexType,ValueType,MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 100, 100);
+
+    // keep a large coarsest level
+    SolverType M;
+    M.set_min_level_size(2000);
+    M.initialize(A);
+
+    ASSERT_EQUAL(M.levels.back().A.num_rows > 500, true);
+
+    cusp::array1d<ValueType,MemorySpace> b = unittest::random_samples<ValueType>(A.num_rows);
+    cusp::array1d<ValueType,MemorySpace> x = unittest::random_samples<ValueType>(A.num_rows);
+
+    // set stopping criteria (iteration_limit = 20, relative_tolerance = 1e-4)
+    cusp::monitor<ValueType> monitor(b, 20, 1e-4);
+    cusp::krylov::cg(A, x, b, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+    ASSERT_EQUAL(monitor.geometric_rate() < 0.5, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSmoothedAggregationCholeskyCoarseSolver);
+
+template <class MemorySpace>
+void TestSmoothedAggregationCycles(void)
+{
+    typedef int                 IndexType;
+    typedef float               ValueType;
+
+    typedef cusp::precond::aggregation::smoothed_aggregation<IndexType,ValueType,MemorySpace> SolverType;
+
+    cusp::csr_matrix<IndexType,ValueType,MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 100, 100);
+
+    SolverType M(A);
+
+    ASSERT_EQUAL(M.levels.size() >= 3, true);
+
+    // the V-cycle visits every level once
+    {
+        std::vector<size_t> visits = M.level_visits();
+
+        for(size_t i = 0; i < visits.size(); i++)
+            ASSERT_EQUAL(visits[i], size_t(1));
+
+        ASSERT_ALMOST_EQUAL(M.cycle_complexity(), M.operator_complexity());
+    }
+
+    ASSERT_THROWS(M.set_cycle(cusp::k_cycle, 3), cusp::invalid_input_exception);
+
+    cusp::cycle_type cycles[]      = {cusp::v_cycle, cusp::w_cycle, cusp::f_cycle, cusp::k_cycle, cusp::k_cycle};
+    size_t k_cycle_iterations[]    = {2, 2, 2, 1, 2};
+    size_t expected_visits[]       = {1, 2, 2, 1, 2};
+
+    for(size_t c = 0; c < 5; c++)
+    {
+        M.set_cycle(cycles[c], k_cycle_iterations[c]);
+
+        // the V-cycle and the one step K-cycle visit the second level once
+        std::vector<size_t> visits = M.level_visits();
+
+        ASSERT_EQUAL(visits[0], size_t(1));
+        ASSERT_EQUAL(visits[1], expected_visits[c]);
+        ASSERT_EQUAL(M.cycle_complexity() >= M.operator_complexity(), true);
+
+        cusp::array1d<ValueType,MemorySpace> b = unittest::random_samples<ValueType>(A.num_rows);
+        cusp::array1d<ValueType,MemorySpace> x = unittest::random_samples<ValueType>(A.num_rows);
+
+        // set stopping criteria (iteration_limit = 20, relative_tolerance = 1e-4)
+        cusp::monitor<ValueType> monitor(b, 20, 1e-4);
+
+        // the K-cycle is nonlinear and is applied as a stand-alone solver
+        if(cycles[c] == cusp::k_cycle)
+            M.solve(b, x, monitor);
+        else
+            cusp::krylov::cg(A, x, b, monitor, M);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        ASSERT_EQUAL(monitor.geometric_rate() < 0.5, true);
+    }
+
+    // an empty hierarchy has no work per cycle
+    SolverType E;
+    ASSERT_EQUAL(E.cycle_complexity(), 0.0);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSmoothedAggregationCycles);
+
+template <class MemorySpace>
+void TestSmoothedAggregationKCycleBeforeInitialize(void)
+{
+    typedef int                 IndexType;
+    typedef float               ValueType;
+
+    typedef cusp::precond::aggregation::smoothed_aggregation<IndexType,ValueType,MemorySpace> SolverType;
+
+    cusp::csr_matrix<IndexType,ValueType,MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 100, 100);
+
+    // the K-cycle workspace is sized while the levels are set up
+    SolverType M;
+    M.set_cycle(cusp::k_cycle, 2);
+    M.initialize(A);
+
+    ASSERT_EQUAL(M.levels.size() >= 3, true);
+
+    for(size_t lvl = 1; lvl < M.levels.size(); lvl++)
+    {
+        ASSERT_EQUAL(M.levels[lvl].k_residual.size(),  size_t(M.levels[lvl].A.num_rows));
+        ASSERT_EQUAL(M.levels[lvl].k_direction.size(), size_t(M.levels[lvl].A.num_rows));
+        ASSERT_EQUAL(M.levels[lvl].k_product.size(),   size_t(M.levels[lvl].A.num_rows));
+    }
+
+    cusp::array1d<ValueType,MemorySpace> b = unittest::random_samples<ValueType>(A.num_rows);
+    cusp::array1d<ValueType,MemorySpace> x(A.num_rows, 0);
+
+    cusp::monitor<ValueType> monitor(b, 20, 1e-4);
+    M.solve(b, x, monitor);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    // as does setting the hierarchy up again
+    M.initialize(A);
+
+    for(size_t lvl = 1; lvl < M.levels.size(); lvl++)
+        ASSERT_EQUAL(M.levels[lvl].k_product.size(), size_t(M.levels[lvl].A.num_rows));
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSmoothedAggregationKCycleBeforeInitialize);
+
 
 template <typename SparseMatrix>
 void TestSymmetricStrengthOfConnection(void)
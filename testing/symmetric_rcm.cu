@@ -2,8 +2,15 @@
 
 #include <cusp/graph/symmetric_rcm.h>
 
+#include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 #include <cusp/permutation_matrix.h>
+#include <cusp/gallery/poisson.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
 
 template <typename MatrixType, typename PermutationType>
 void symmetric_rcm(my_system& system, const MatrixType& G, PermutationType& P)
@@ -28,3 +35,136 @@ void TestSymmetricRCMDispatch()
 }
 DECLARE_UNITTEST(TestSymmetricRCMDispatch);
 
+
+template <typename TestMatrix>
+void TestSymmetricRCM(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::value_type   ValueType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    // two grids and an isolated vertex with their vertices shuffled
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> A;
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> B;
+    cusp::gallery::poisson5pt(A, 13, 17);
+    cusp::gallery::poisson5pt(B, 9, 7);
+
+    const IndexType N = A.num_rows + B.num_rows + 1;
+    cusp::array1d<IndexType, cusp::host_memory> shuffle(N);
+    cusp::array1d<IndexType, cusp::host_memory> block(N);
+
+    for(IndexType i = 0; i < N; i++)
+    {
+        shuffle[i] = (i * 101) % N;
+        block[shuffle[i]] = i < IndexType(A.num_rows) ? 0 : (i < IndexType(A.num_rows + B.num_rows) ? 1 : 2);
+    }
+
+    cusp::coo_matrix<IndexType, ValueType, cusp::host_memory> G(N, N, A.num_entries + B.num_entries + 1);
+
+    for(size_t n = 0; n < A.num_entries; n++)
+    {
+        G.row_indices[n]    = shuffle[A.row_indices[n]];
+        G.column_indices[n] = shuffle[A.column_indices[n]];
+        G.values[n]         = A.values[n];
+    }
+    for(size_t n = 0; n < B.num_entries; n++)
+    {
+        G.row_indices[A.num_entries + n]    = shuffle[A.num_rows + B.row_indices[n]];
+        G.column_indices[A.num_entries + n] = shuffle[A.num_rows + B.column_indices[n]];
+        G.values[A.num_entries + n]         = B.values[n];
+    }
+    G.row_indices[G.num_entries - 1]    = shuffle[N - 1];
+    G.column_indices[G.num_entries - 1] = shuffle[N - 1];
+    G.values[G.num_entries - 1]         = ValueType(1);
+    G.sort_by_row_and_column();
+
+    TestMatrix test_matrix(G);
+    cusp::permutation_matrix<IndexType, MemorySpace> P(N);
+
+    cusp::graph::symmetric_rcm(test_matrix, P);
+
+    cusp::array1d<IndexType, cusp::host_memory> permutation(P.permutation);
+
+    // the result must be a permutation
+    cusp::array1d<IndexType, cusp::host_memory> vertices(N, -1);
+
+    for(IndexType i = 0; i < N; i++)
+    {
+        ASSERT_EQUAL(permutation[i] >= 0 && permutation[i] < N, true);
+        ASSERT_EQUAL(vertices[permutation[i]], IndexType(-1));
+        vertices[permutation[i]] = i;
+    }
+
+    // every component must occupy a contiguous range
+    size_t num_blocks = 1;
+    for(IndexType i = 1; i < N; i++)
+        if(block[vertices[i]] != block[vertices[i - 1]])
+            num_blocks++;
+
+    ASSERT_EQUAL(num_blocks, size_t(3));
+
+    // the bandwidth is bounded by the width of the widest pair of levels
+    IndexType bandwidth = 0;
+    for(size_t n = 0; n < G.num_entries; n++)
+        bandwidth = std::max(bandwidth, std::abs(permutation[G.row_indices[n]] - permutation[G.column_indices[n]]));
+
+    ASSERT_EQUAL(bandwidth <= 2 * 13, true);
+
+    // every component reversed must be the Cuthill-McKee ordering started
+    // from the vertex of minimum degree with ties broken by index
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> G_csr(G);
+    cusp::array1d<IndexType, cusp::host_memory> visited(N, 0);
+
+    for(IndexType last = N - 1; last >= 0;)
+    {
+        IndexType start = -1;
+        IndexType first = last;
+
+        while(first > 0 && block[vertices[first - 1]] == block[vertices[last]])
+            first--;
+
+        for(IndexType i = first; i <= last; i++)
+        {
+            IndexType v = vertices[i];
+            IndexType degree = G_csr.row_offsets[v + 1] - G_csr.row_offsets[v];
+
+            if(start == -1 ||
+               degree <  G_csr.row_offsets[start + 1] - G_csr.row_offsets[start] ||
+              (degree == G_csr.row_offsets[start + 1] - G_csr.row_offsets[start] && v < start))
+                start = v;
+        }
+
+        std::vector<IndexType> order(1, start);
+        visited[start] = 1;
+
+        for(size_t k = 0; k < order.size(); k++)
+        {
+            IndexType u = order[k];
+            std::vector< std::pair<IndexType,IndexType> > neighbors;
+
+            for(IndexType jj = G_csr.row_offsets[u]; jj < G_csr.row_offsets[u + 1]; jj++)
+            {
+                IndexType v = G_csr.column_indices[jj];
+
+                if(!visited[v])
+                {
+                    visited[v] = 1;
+                    neighbors.push_back(std::make_pair(G_csr.row_offsets[v + 1] - G_csr.row_offsets[v], v));
+                }
+            }
+
+            std::sort(neighbors.begin(), neighbors.end());
+
+            for(size_t i = 0; i < neighbors.size(); i++)
+                order.push_back(neighbors[i].second);
+        }
+
+        ASSERT_EQUAL(IndexType(order.size()), last - first + 1);
+
+        for(size_t k = 0; k < order.size(); k++)
+            ASSERT_EQUAL(vertices[last - k], order[k]);
+
+        last = first - 1;
+    }
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestSymmetricRCM);
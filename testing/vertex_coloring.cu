@@ -3,6 +3,9 @@
 #include <cusp/graph/vertex_coloring.h>
 
 #include <cusp/csr_matrix.h>
+#include <cusp/gallery/poisson.h>
+
+#include <vector>
 
 template <typename MatrixType, typename ArrayType>
 size_t vertex_coloring(my_system& system, const MatrixType& G, ArrayType& colors)
@@ -27,3 +30,158 @@ void TestVertexColoringDispatch()
 }
 DECLARE_UNITTEST(TestVertexColoringDispatch);
 
+
+template <typename TestMatrix>
+void TestVertexColoring(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::value_type   ValueType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> G;
+    cusp::gallery::poisson9pt(G, 37, 41);
+
+    const cusp::graph::vertex_ordering orderings[] = {cusp::graph::natural_ordering,
+                                                      cusp::graph::largest_degree_first,
+                                                      cusp::graph::smallest_last};
+
+    TestMatrix test_matrix(G);
+
+    for(int i = 0; i < 3; i++)
+    {
+        cusp::array1d<IndexType, MemorySpace> colors(G.num_rows);
+
+        size_t num_colors = cusp::graph::vertex_coloring(test_matrix, colors, orderings[i]);
+
+        cusp::array1d<IndexType, cusp::host_memory> h_colors(colors);
+
+        // every vertex has a valid color that differs from its neighbors
+        bool valid = true;
+
+        for(IndexType row = 0; row < IndexType(G.num_rows); row++)
+        {
+            if(h_colors[row] < 0 || size_t(h_colors[row]) >= num_colors)
+                valid = false;
+
+            for(IndexType jj = G.row_offsets[row]; jj < G.row_offsets[row + 1]; jj++)
+            {
+                IndexType col = G.column_indices[jj];
+
+                if(col != row && h_colors[col] == h_colors[row])
+                    valid = false;
+            }
+        }
+
+        ASSERT_EQUAL(valid, true);
+
+        // a greedy coloring uses at most one color more than the maximum degree
+        ASSERT_EQUAL(num_colors <= 9, true);
+    }
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestVertexColoring);
+
+template <typename MemorySpace>
+void TestVertexColoringDistance(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> G;
+    cusp::gallery::poisson5pt(G, 23, 19);
+
+    const int N = G.num_rows;
+
+    cusp::csr_matrix<int, float, MemorySpace> test_matrix(G);
+
+    for(size_t distance = 2; distance <= 3; distance++)
+    {
+        cusp::array1d<int, MemorySpace> colors(N);
+
+        size_t num_colors = cusp::graph::vertex_coloring(test_matrix, colors, cusp::graph::natural_ordering, distance);
+
+        cusp::array1d<int, cusp::host_memory> h_colors(colors);
+
+        // vertices within the coloring distance of each other differ
+        bool valid = true;
+
+        for(int v = 0; v < N; v++)
+        {
+            std::vector<int> levels(N, -1);
+            std::vector<int> queue(1, v);
+            levels[v] = 0;
+
+            if(h_colors[v] < 0 || size_t(h_colors[v]) >= num_colors)
+                valid = false;
+
+            for(size_t n = 0; n < queue.size(); n++)
+            {
+                const int u = queue[n];
+
+                if(size_t(levels[u]) == distance)
+                    continue;
+
+                for(int jj = G.row_offsets[u]; jj < G.row_offsets[u + 1]; jj++)
+                {
+                    const int w = G.column_indices[jj];
+
+                    if(levels[w] >= 0)
+                        continue;
+
+                    levels[w] = levels[u] + 1;
+                    queue.push_back(w);
+
+                    if(h_colors[w] == h_colors[v])
+                        valid = false;
+                }
+            }
+        }
+
+        ASSERT_EQUAL(valid, true);
+
+        // at least the size of the largest distance-k neighborhood
+        ASSERT_EQUAL(num_colors >= (distance == 2 ? 5 : 8), true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestVertexColoringDistance);
+
+template <typename MemorySpace>
+void TestBlockColoring(void)
+{
+    // a 12x12 grid split into 3x3 tiles
+    cusp::csr_matrix<int, float, cusp::host_memory> G;
+    cusp::gallery::poisson5pt(G, 12, 12);
+
+    const int N = G.num_rows;
+
+    cusp::array1d<int, cusp::host_memory> h_blocks(N);
+
+    for(int i = 0; i < N; i++)
+        h_blocks[i] = ((i / 12) / 3) * 4 + (i % 12) / 3;
+
+    cusp::csr_matrix<int, float, MemorySpace> test_matrix(G);
+    cusp::array1d<int, MemorySpace> blocks(h_blocks);
+    cusp::array1d<int, MemorySpace> colors(N);
+
+    size_t num_colors = cusp::graph::block_coloring(test_matrix, blocks, colors);
+
+    cusp::array1d<int, cusp::host_memory> h_colors(colors);
+
+    // the tiles form a 4x4 grid of maximum degree 4
+    ASSERT_EQUAL(num_colors >= 2 && num_colors <= 5, true);
+
+    std::vector<int> block_colors(16, -1);
+
+    for(int i = 0; i < N; i++)
+    {
+        if(block_colors[h_blocks[i]] < 0)
+            block_colors[h_blocks[i]] = h_colors[i];
+
+        ASSERT_EQUAL(h_colors[i], block_colors[h_blocks[i]]);
+
+        for(int jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+        {
+            const int j = G.column_indices[jj];
+
+            if(h_blocks[j] != h_blocks[i])
+                ASSERT_EQUAL(h_colors[j] != h_colors[i], true);
+        }
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockColoring);